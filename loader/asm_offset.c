@@ -54,10 +54,10 @@ int main(int argc, char **argv) {
             .comment = "The numerical value of the enum value 'VK_DEBUG_REPORT_ERROR_BIT_EXT'" },
         { .name = "PTR_SIZE", .value = sizeof(void*),
             .comment = "The size of a pointer" },
-        { .name = "HASH_SIZE", .value = sizeof(struct loader_dispatch_hash_entry),
-            .comment = "The size of a 'loader_dispatch_hash_entry' struct" },
-        { .name = "HASH_OFFSET_INSTANCE", .value = offsetof(struct loader_instance, phys_dev_ext_disp_hash),
-            .comment = "The offset of 'phys_dev_ext_disp_hash' within a 'loader_instance' struct" },
+        { .name = "HASH_SIZE", .value = sizeof(((struct loader_unknown_ext_map *)0)->func_names[0]),
+            .comment = "The size of an entry in 'loader_unknown_ext_map.func_names'" },
+        { .name = "HASH_OFFSET_INSTANCE", .value = offsetof(struct loader_instance, phys_dev_ext_map.func_names),
+            .comment = "The offset of 'phys_dev_ext_map.func_names' within a 'loader_instance' struct" },
         { .name = "PHYS_DEV_OFFSET_INST_DISPATCH", .value = offsetof(struct loader_instance_dispatch_table, phys_dev_ext),
             .comment = "The offset of 'phys_dev_ext' within in 'loader_instance_dispatch_table' struct" },
         { .name = "PHYS_DEV_OFFSET_PHYS_DEV_TRAMP", .value = offsetof(struct loader_physical_device_tramp, phys_dev),
@@ -70,10 +70,10 @@ int main(int argc, char **argv) {
             .comment = "The offset of 'this_instance' within a 'loader_icd_term' struct" },
         { .name = "DISPATCH_OFFSET_ICD_TERM", .value = offsetof(struct loader_icd_term, phys_dev_ext),
             .comment = "The offset of 'phys_dev_ext' within a 'loader_icd_term' struct" },
-        { .name = "FUNC_NAME_OFFSET_HASH", .value = offsetof(struct loader_dispatch_hash_entry, func_name),
-            .comment = "The offset of 'func_name' within a 'loader_dispatch_hash_entry' struct" },
+        { .name = "FUNC_NAME_OFFSET_HASH", .value = 0,
+            .comment = "The offset of the name within an entry in 'loader_unknown_ext_map.func_names'" },
         { .name = "EXT_OFFSET_DEVICE_DISPATCH", .value = offsetof(struct loader_dev_dispatch_table, ext_dispatch),
-            .comment = "The offset of 'ext_dispatch' within a 'loader_dev_dispatch_table' struct" },
+            .comment = "The offset of the 'ext_dispatch' pointer within a 'loader_dev_dispatch_table' struct" },
     };
 
     FILE *file = fopen("gen_defines.asm", "w");
@@ -38,6 +38,161 @@
 #include "vulkan/vk_layer.h"
 #include "vk_object_types.h"
 
+// Debug callback index
+
+static const VkDebugUtilsMessageSeverityFlagBitsEXT debug_utils_severities[LOADER_DEBUG_SEVERITY_COUNT] = {
+    VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT,
+    VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT,
+    VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT,
+    VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT,
+};
+
+// The debug report flags debug_utils_AnnotFlagsToReportFlags can turn each severity into
+static const VkDebugReportFlagsEXT debug_utils_severity_report_flags[LOADER_DEBUG_SEVERITY_COUNT] = {
+    VK_DEBUG_REPORT_DEBUG_BIT_EXT,
+    VK_DEBUG_REPORT_INFORMATION_BIT_EXT,
+    VK_DEBUG_REPORT_WARNING_BIT_EXT | VK_DEBUG_REPORT_PERFORMANCE_WARNING_BIT_EXT,
+    VK_DEBUG_REPORT_ERROR_BIT_EXT,
+};
+
+#define DEBUG_UTILS_ALL_MESSAGE_TYPES                                                                    \
+    (VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | \
+     VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)
+
+// Returns the index of the severity, or -1 if it isn't exactly one of the known severity bits
+static int debug_utils_SeverityIndex(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity) {
+    for (int i = 0; i < LOADER_DEBUG_SEVERITY_COUNT; i++) {
+        if (messageSeverity == debug_utils_severities[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns true if the node may want messages of the severity at severity_index, and sets *types to
+// the message types it may want.  Report callbacks are only filtered by severity here.
+static bool debug_utils_NodeWantsSeverity(const VkLayerDbgFunctionNode *node, uint32_t severity_index,
+                                          VkDebugUtilsMessageTypeFlagsEXT *types) {
+    if (node->is_messenger) {
+        *types = node->messenger.messageType;
+        return 0 != (node->messenger.messageSeverity & debug_utils_severities[severity_index]);
+    }
+    *types = DEBUG_UTILS_ALL_MESSAGE_TYPES;
+    return 0 != (node->report.msgFlags & debug_utils_severity_report_flags[severity_index]);
+}
+
+// Used while no callbacks were ever added, and when a rebuild can't allocate its index
+static struct loader_debug_callback_index debug_utils_empty_index;
+static struct loader_debug_callback_index debug_utils_walk_list_index = {
+    {DEBUG_UTILS_ALL_MESSAGE_TYPES, DEBUG_UTILS_ALL_MESSAGE_TYPES, DEBUG_UTILS_ALL_MESSAGE_TYPES, DEBUG_UTILS_ALL_MESSAGE_TYPES},
+    {0, 0, 0, 0},
+    {NULL, NULL, NULL, NULL},
+    ~(VkDebugReportFlagsEXT)0,
+    true,
+};
+
+// Messages are sent from functions that only have a const instance
+static void debug_utils_ReadLock(const struct loader_instance *inst) {
+    loader_platform_thread_read_lock_rwlock((loader_platform_thread_rwlock *)&inst->dbg_lock);
+}
+
+static void debug_utils_ReadUnlock(const struct loader_instance *inst) {
+    loader_platform_thread_read_unlock_rwlock((loader_platform_thread_rwlock *)&inst->dbg_lock);
+}
+
+// Called holding dbg_lock
+static const struct loader_debug_callback_index *debug_utils_GetIndex(const struct loader_instance *inst) {
+    return NULL != inst->dbg_index ? inst->dbg_index : &debug_utils_empty_index;
+}
+
+// Called holding dbg_lock for writing, after every change to inst->DbgFunctionHead.  The index it
+// replaces is freed, since no message can be reading it.
+static void debug_utils_RebuildIndex(struct loader_instance *inst) {
+    struct loader_debug_callback_index counted;
+    struct loader_debug_callback_index *index;
+    struct loader_debug_callback_index *old_index = inst->dbg_index;
+    VkDebugUtilsMessageTypeFlagsEXT types;
+    uint32_t total = 0;
+
+    memset(&counted, 0, sizeof(counted));
+    for (VkLayerDbgFunctionNode *pTrav = inst->DbgFunctionHead; NULL != pTrav; pTrav = pTrav->pNext) {
+        if (!pTrav->is_messenger) {
+            counted.report_flags |= pTrav->report.msgFlags;
+        }
+        for (uint32_t i = 0; i < LOADER_DEBUG_SEVERITY_COUNT; i++) {
+            if (debug_utils_NodeWantsSeverity(pTrav, i, &types)) {
+                counted.wanted_types[i] |= types;
+                counted.counts[i]++;
+                total++;
+            }
+        }
+    }
+
+    // The index and the lists of all severities share one allocation
+    index = (struct loader_debug_callback_index *)loader_instance_heap_alloc(
+        inst, sizeof(struct loader_debug_callback_index) + total * sizeof(VkLayerDbgFunctionNode *),
+        VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+    if (NULL == index) {
+        // Messages are still delivered exactly, since each callback checks its own flags
+        index = &debug_utils_walk_list_index;
+    } else {
+        VkLayerDbgFunctionNode **storage = (VkLayerDbgFunctionNode **)(index + 1);
+        uint32_t offset = 0;
+        *index = counted;
+        for (uint32_t i = 0; i < LOADER_DEBUG_SEVERITY_COUNT; i++) {
+            index->nodes[i] = storage + offset;
+            offset += index->counts[i];
+            index->counts[i] = 0;
+        }
+        for (VkLayerDbgFunctionNode *pTrav = inst->DbgFunctionHead; NULL != pTrav; pTrav = pTrav->pNext) {
+            for (uint32_t i = 0; i < LOADER_DEBUG_SEVERITY_COUNT; i++) {
+                if (debug_utils_NodeWantsSeverity(pTrav, i, &types)) {
+                    index->nodes[i][index->counts[i]++] = pTrav;
+                }
+            }
+        }
+    }
+
+    inst->dbg_index = index;
+    for (uint32_t i = 0; i < LOADER_DEBUG_SEVERITY_COUNT; i++) {
+        loader_platform_atomic_store_u32(&inst->dbg_wanted_types[i], index->wanted_types[i]);
+    }
+    loader_platform_atomic_store_u32(&inst->dbg_report_flags, index->report_flags);
+    if (&debug_utils_walk_list_index != old_index) {
+        loader_instance_heap_free(inst, old_index);
+    }
+}
+
+// Adds a messenger or report callback to the instance
+static void debug_utils_AddNode(struct loader_instance *inst, VkLayerDbgFunctionNode *node) {
+    loader_platform_thread_write_lock_rwlock(&inst->dbg_lock);
+    node->pNext = inst->DbgFunctionHead;
+    inst->DbgFunctionHead = node;
+    debug_utils_RebuildIndex(inst);
+    loader_platform_thread_write_unlock_rwlock(&inst->dbg_lock);
+}
+
+// Returns true if any callback may want a message with this severity and these types, without
+// taking dbg_lock
+static bool debug_utils_Wants(const struct loader_instance *inst, VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+                              VkDebugUtilsMessageTypeFlagsEXT messageTypes) {
+    for (uint32_t i = 0; i < LOADER_DEBUG_SEVERITY_COUNT; i++) {
+        if ((messageSeverity & debug_utils_severities[i]) &&
+            (loader_platform_atomic_load_u32(&inst->dbg_wanted_types[i]) & messageTypes)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Called once no thread can be sending messages on the instance
+void util_DestroyDebugCallbackIndex(struct loader_instance *inst) {
+    if (&debug_utils_walk_list_index != inst->dbg_index) {
+        loader_instance_heap_free(inst, inst->dbg_index);
+    }
+    inst->dbg_index = NULL;
+}
+
 // VK_EXT_debug_report related items
 
 VkResult util_CreateDebugUtilsMessenger(struct loader_instance *inst, const VkDebugUtilsMessengerCreateInfoEXT *pCreateInfo,
@@ -66,8 +221,7 @@ VkResult util_CreateDebugUtilsMessenger(struct loader_instance *inst, const VkDe
     pNewDbgFuncNode->messenger.messageSeverity = pCreateInfo->messageSeverity;
     pNewDbgFuncNode->messenger.messageType = pCreateInfo->messageType;
     pNewDbgFuncNode->pUserData = pCreateInfo->pUserData;
-    pNewDbgFuncNode->pNext = inst->DbgFunctionHead;
-    inst->DbgFunctionHead = pNewDbgFuncNode;
+    debug_utils_AddNode(inst, pNewDbgFuncNode);
 
     return VK_SUCCESS;
 }
@@ -76,19 +230,40 @@ static VKAPI_ATTR VkResult VKAPI_CALL
 debug_utils_CreateDebugUtilsMessengerEXT(VkInstance instance, const VkDebugUtilsMessengerCreateInfoEXT *pCreateInfo,
                                          const VkAllocationCallbacks *pAllocator, VkDebugUtilsMessengerEXT *pMessenger) {
     struct loader_instance *inst = loader_get_instance(instance);
-    loader_platform_thread_lock_mutex(&loader_lock);
+    loader_platform_thread_lock_mutex(&inst->lock);
     VkResult result = inst->disp->layer_inst_disp.CreateDebugUtilsMessengerEXT(instance, pCreateInfo, pAllocator, pMessenger);
-    loader_platform_thread_unlock_mutex(&loader_lock);
+    loader_platform_thread_unlock_mutex(&inst->lock);
     return result;
 }
 
+static VkBool32 debug_utils_SubmitToNode(const VkLayerDbgFunctionNode *pTrav,
+                                         VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+                                         VkDebugUtilsMessageTypeFlagsEXT messageTypes,
+                                         const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData,
+                                         VkDebugReportFlagsEXT object_flags, VkDebugReportObjectTypeEXT object_type,
+                                         uint64_t object_handle) {
+    VkBool32 bail = false;
+    if (pTrav->is_messenger && (pTrav->messenger.messageSeverity & messageSeverity) &&
+        (pTrav->messenger.messageType & messageTypes)) {
+        if (pTrav->messenger.pfnUserCallback(messageSeverity, messageTypes, pCallbackData, pTrav->pUserData)) {
+            bail = true;
+        }
+    }
+    if (!pTrav->is_messenger && pTrav->report.msgFlags & object_flags) {
+        if (pTrav->report.pfnMsgCallback(object_flags, object_type, object_handle, 0, pCallbackData->messageIdNumber,
+                                         pCallbackData->pMessageIdName, pCallbackData->pMessage, pTrav->pUserData)) {
+            bail = true;
+        }
+    }
+    return bail;
+}
+
 VkBool32 util_SubmitDebugUtilsMessageEXT(const struct loader_instance *inst, VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
                                          VkDebugUtilsMessageTypeFlagsEXT messageTypes,
                                          const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData) {
     VkBool32 bail = false;
 
-    if (NULL != pCallbackData) {
-        VkLayerDbgFunctionNode *pTrav = inst->DbgFunctionHead;
+    if (NULL != pCallbackData && debug_utils_Wants(inst, messageSeverity, messageTypes)) {
         VkDebugReportObjectTypeEXT object_type = VK_DEBUG_REPORT_OBJECT_TYPE_UNKNOWN_EXT;
         VkDebugReportFlagsEXT object_flags = 0;
         uint64_t object_handle = 0;
@@ -98,29 +273,43 @@ VkBool32 util_SubmitDebugUtilsMessageEXT(const struct loader_instance *inst, VkD
             debug_utils_AnnotObjectToDebugReportObject(pCallbackData->pObjects, &object_type, &object_handle);
         }
 
-        while (pTrav) {
-            if (pTrav->is_messenger && (pTrav->messenger.messageSeverity & messageSeverity) &&
-                (pTrav->messenger.messageType & messageTypes)) {
-                if (pTrav->messenger.pfnUserCallback(messageSeverity, messageTypes, pCallbackData, pTrav->pUserData)) {
+        // Callbacks and the index are only freed holding dbg_lock for writing
+        debug_utils_ReadLock(inst);
+        const struct loader_debug_callback_index *index = debug_utils_GetIndex(inst);
+
+        // Messages should have exactly one severity.  Anything else is matched against every callback.
+        int severity_index = debug_utils_SeverityIndex(messageSeverity);
+        if (severity_index >= 0 && !index->walk_list) {
+            for (uint32_t i = 0; i < index->counts[severity_index]; i++) {
+                if (debug_utils_SubmitToNode(index->nodes[severity_index][i], messageSeverity, messageTypes, pCallbackData,
+                                             object_flags, object_type, object_handle)) {
                     bail = true;
                 }
             }
-            if (!pTrav->is_messenger && pTrav->report.msgFlags & object_flags) {
-                if (pTrav->report.pfnMsgCallback(object_flags, object_type, object_handle, 0, pCallbackData->messageIdNumber,
-                                                 pCallbackData->pMessageIdName, pCallbackData->pMessage, pTrav->pUserData)) {
+        } else {
+            for (VkLayerDbgFunctionNode *pTrav = inst->DbgFunctionHead; NULL != pTrav; pTrav = pTrav->pNext) {
+                if (debug_utils_SubmitToNode(pTrav, messageSeverity, messageTypes, pCallbackData, object_flags, object_type,
+                                             object_handle)) {
                     bail = true;
                 }
             }
-
-            pTrav = pTrav->pNext;
         }
+        debug_utils_ReadUnlock(inst);
     }
 
     return bail;
 }
 
+// Returns true if util_SubmitDebugUtilsMessageEXT may pass a message with this severity and type
+// to a messenger or report callback.  Lets callers skip building messages nobody will see.
+bool util_DebugUtilsMessageWanted(const struct loader_instance *inst, VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+                                  VkDebugUtilsMessageTypeFlagsEXT messageTypes) {
+    return debug_utils_Wants(inst, messageSeverity, messageTypes);
+}
+
 void util_DestroyDebugUtilsMessenger(struct loader_instance *inst, VkDebugUtilsMessengerEXT messenger,
                                      const VkAllocationCallbacks *pAllocator) {
+    loader_platform_thread_write_lock_rwlock(&inst->dbg_lock);
     VkLayerDbgFunctionNode *pTrav = inst->DbgFunctionHead;
     VkLayerDbgFunctionNode *pPrev = pTrav;
 
@@ -128,20 +317,26 @@ void util_DestroyDebugUtilsMessenger(struct loader_instance *inst, VkDebugUtilsM
         if (pTrav->is_messenger && pTrav->messenger.messenger == messenger) {
             pPrev->pNext = pTrav->pNext;
             if (inst->DbgFunctionHead == pTrav) inst->DbgFunctionHead = pTrav->pNext;
-#if (DEBUG_DISABLE_APP_ALLOCATORS == 1)
-            {
-#else
-            if (pAllocator != NULL) {
-                pAllocator->pfnFree(pAllocator->pUserData, pTrav);
-            } else {
-#endif
-                loader_instance_heap_free(inst, pTrav);
-            }
+            debug_utils_RebuildIndex(inst);
             break;
         }
         pPrev = pTrav;
         pTrav = pTrav->pNext;
     }
+    loader_platform_thread_write_unlock_rwlock(&inst->dbg_lock);
+
+    // No message can still be using the node once the lock is released
+    if (NULL != pTrav) {
+#if (DEBUG_DISABLE_APP_ALLOCATORS == 1)
+        {
+#else
+        if (pAllocator != NULL) {
+            pAllocator->pfnFree(pAllocator->pUserData, pTrav);
+        } else {
+#endif
+            loader_instance_heap_free(inst, pTrav);
+        }
+    }
 }
 
 // This utility (used by vkInstanceCreateInfo(), looks at a pNext chain.  It
@@ -267,11 +462,11 @@ static VKAPI_ATTR void VKAPI_CALL debug_utils_SubmitDebugUtilsMessageEXT(
 static VKAPI_ATTR void VKAPI_CALL debug_utils_DestroyDebugUtilsMessengerEXT(VkInstance instance, VkDebugUtilsMessengerEXT messenger,
                                                                             const VkAllocationCallbacks *pAllocator) {
     struct loader_instance *inst = loader_get_instance(instance);
-    loader_platform_thread_lock_mutex(&loader_lock);
+    loader_platform_thread_lock_mutex(&inst->lock);
 
     inst->disp->layer_inst_disp.DestroyDebugUtilsMessengerEXT(instance, messenger, pAllocator);
 
-    loader_platform_thread_unlock_mutex(&loader_lock);
+    loader_platform_thread_unlock_mutex(&inst->lock);
 }
 
 // This is the instance chain terminator function for CreateDebugUtilsMessenger
@@ -344,11 +539,9 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateDebugUtilsMessengerEXT(VkInstanc
     pNewDbgFuncNode->messenger.messageSeverity = pCreateInfo->messageSeverity;
     pNewDbgFuncNode->messenger.messageType = pCreateInfo->messageType;
     pNewDbgFuncNode->pUserData = pCreateInfo->pUserData;
-    pNewDbgFuncNode->pNext = inst->DbgFunctionHead;
-    inst->DbgFunctionHead = pNewDbgFuncNode;
-
     *(VkDebugUtilsMessengerEXT **)pMessenger = icd_info;
     pNewDbgFuncNode->messenger.messenger = *pMessenger;
+    debug_utils_AddNode(inst, pNewDbgFuncNode);
 
 out:
 
@@ -429,14 +622,12 @@ VKAPI_ATTR void VKAPI_CALL terminator_SubmitDebugUtilsMessageEXT(VkInstance inst
                                                                  VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
                                                                  VkDebugUtilsMessageTypeFlagsEXT messageTypes,
                                                                  const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData) {
-    loader_platform_thread_lock_mutex(&loader_lock);
     // NOTE: Just make the callback ourselves because there could be one or more ICDs that support this extension
     //       and each one will trigger the callback to the user.  This would result in multiple callback triggers
     //       per message.  Instead, if we get a messaged up to here, then just trigger the message ourselves and
     //       return.  This would still allow the ICDs to trigger their own messages, but won't get any external ones.
     struct loader_instance *inst = (struct loader_instance *)instance;
     util_SubmitDebugUtilsMessageEXT(inst, messageSeverity, messageTypes, pCallbackData);
-    loader_platform_thread_unlock_mutex(&loader_lock);
 }
 
 // VK_EXT_debug_report related items
@@ -466,8 +657,7 @@ VkResult util_CreateDebugReportCallback(struct loader_instance *inst, VkDebugRep
     pNewDbgFuncNode->report.pfnMsgCallback = pCreateInfo->pfnCallback;
     pNewDbgFuncNode->report.msgFlags = pCreateInfo->flags;
     pNewDbgFuncNode->pUserData = pCreateInfo->pUserData;
-    pNewDbgFuncNode->pNext = inst->DbgFunctionHead;
-    inst->DbgFunctionHead = pNewDbgFuncNode;
+    debug_utils_AddNode(inst, pNewDbgFuncNode);
 
     return VK_SUCCESS;
 }
@@ -476,9 +666,9 @@ static VKAPI_ATTR VkResult VKAPI_CALL
 debug_utils_CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugReportCallbackCreateInfoEXT *pCreateInfo,
                                          const VkAllocationCallbacks *pAllocator, VkDebugReportCallbackEXT *pCallback) {
     struct loader_instance *inst = loader_get_instance(instance);
-    loader_platform_thread_lock_mutex(&loader_lock);
+    loader_platform_thread_lock_mutex(&inst->lock);
     VkResult result = inst->disp->layer_inst_disp.CreateDebugReportCallbackEXT(instance, pCreateInfo, pAllocator, pCallback);
-    loader_platform_thread_unlock_mutex(&loader_lock);
+    loader_platform_thread_unlock_mutex(&inst->lock);
     return result;
 }
 
@@ -486,13 +676,16 @@ debug_utils_CreateDebugReportCallbackEXT(VkInstance instance, const VkDebugRepor
 VkBool32 util_DebugReportMessage(const struct loader_instance *inst, VkFlags msgFlags, VkDebugReportObjectTypeEXT objectType,
                                  uint64_t srcObject, size_t location, int32_t msgCode, const char *pLayerPrefix, const char *pMsg) {
     VkBool32 bail = false;
-    VkLayerDbgFunctionNode *pTrav = inst->DbgFunctionHead;
+    VkLayerDbgFunctionNode *pTrav;
     VkDebugUtilsMessageSeverityFlagBitsEXT severity;
     VkDebugUtilsMessageTypeFlagsEXT types;
     VkDebugUtilsMessengerCallbackDataEXT callback_data;
     VkDebugUtilsObjectNameInfoEXT object_name;
 
     debug_utils_ReportFlagsToAnnotFlags(msgFlags, false, &severity, &types);
+    if (0 == (loader_platform_atomic_load_u32(&inst->dbg_report_flags) & msgFlags) && !debug_utils_Wants(inst, severity, types)) {
+        return false;
+    }
     debug_utils_ReportObjectToAnnotObject(objectType, srcObject, &object_name);
 
     callback_data.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CALLBACK_DATA_EXT;
@@ -508,6 +701,8 @@ VkBool32 util_DebugReportMessage(const struct loader_instance *inst, VkFlags msg
     callback_data.objectCount = 1;
     callback_data.pObjects = &object_name;
 
+    debug_utils_ReadLock(inst);
+    pTrav = inst->DbgFunctionHead;
     while (pTrav) {
         if (!pTrav->is_messenger && pTrav->report.msgFlags & msgFlags) {
             if (pTrav->report.pfnMsgCallback(msgFlags, objectType, srcObject, location, msgCode, pLayerPrefix, pMsg,
@@ -523,12 +718,14 @@ VkBool32 util_DebugReportMessage(const struct loader_instance *inst, VkFlags msg
 
         pTrav = pTrav->pNext;
     }
+    debug_utils_ReadUnlock(inst);
 
     return bail;
 }
 
 void util_DestroyDebugReportCallback(struct loader_instance *inst, VkDebugReportCallbackEXT callback,
                                      const VkAllocationCallbacks *pAllocator) {
+    loader_platform_thread_write_lock_rwlock(&inst->dbg_lock);
     VkLayerDbgFunctionNode *pTrav = inst->DbgFunctionHead;
     VkLayerDbgFunctionNode *pPrev = pTrav;
 
@@ -536,20 +733,26 @@ void util_DestroyDebugReportCallback(struct loader_instance *inst, VkDebugReport
         if (!pTrav->is_messenger && pTrav->report.msgCallback == callback) {
             pPrev->pNext = pTrav->pNext;
             if (inst->DbgFunctionHead == pTrav) inst->DbgFunctionHead = pTrav->pNext;
-#if (DEBUG_DISABLE_APP_ALLOCATORS == 1)
-            {
-#else
-            if (pAllocator != NULL) {
-                pAllocator->pfnFree(pAllocator->pUserData, pTrav);
-            } else {
-#endif
-                loader_instance_heap_free(inst, pTrav);
-            }
+            debug_utils_RebuildIndex(inst);
             break;
         }
         pPrev = pTrav;
         pTrav = pTrav->pNext;
     }
+    loader_platform_thread_write_unlock_rwlock(&inst->dbg_lock);
+
+    // No message can still be using the node once the lock is released
+    if (NULL != pTrav) {
+#if (DEBUG_DISABLE_APP_ALLOCATORS == 1)
+        {
+#else
+        if (pAllocator != NULL) {
+            pAllocator->pfnFree(pAllocator->pUserData, pTrav);
+        } else {
+#endif
+            loader_instance_heap_free(inst, pTrav);
+        }
+    }
 }
 
 // This utility (used by vkInstanceCreateInfo(), looks at a pNext chain.  It
@@ -666,11 +869,11 @@ void util_DestroyDebugReportCallbacks(struct loader_instance *inst, const VkAllo
 static VKAPI_ATTR void VKAPI_CALL debug_utils_DestroyDebugReportCallbackEXT(VkInstance instance, VkDebugReportCallbackEXT callback,
                                                                             const VkAllocationCallbacks *pAllocator) {
     struct loader_instance *inst = loader_get_instance(instance);
-    loader_platform_thread_lock_mutex(&loader_lock);
+    loader_platform_thread_lock_mutex(&inst->lock);
 
     inst->disp->layer_inst_disp.DestroyDebugReportCallbackEXT(instance, callback, pAllocator);
 
-    loader_platform_thread_unlock_mutex(&loader_lock);
+    loader_platform_thread_unlock_mutex(&inst->lock);
 }
 
 static VKAPI_ATTR void VKAPI_CALL debug_utils_DebugReportMessageEXT(VkInstance instance, VkDebugReportFlagsEXT flags,
@@ -752,11 +955,9 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateDebugReportCallbackEXT(VkInstanc
     pNewDbgFuncNode->report.pfnMsgCallback = pCreateInfo->pfnCallback;
     pNewDbgFuncNode->report.msgFlags = pCreateInfo->flags;
     pNewDbgFuncNode->pUserData = pCreateInfo->pUserData;
-    pNewDbgFuncNode->pNext = inst->DbgFunctionHead;
-    inst->DbgFunctionHead = pNewDbgFuncNode;
-
     *(VkDebugReportCallbackEXT **)pCallback = icd_info;
     pNewDbgFuncNode->report.msgCallback = *pCallback;
+    debug_utils_AddNode(inst, pNewDbgFuncNode);
 
 out:
 
@@ -840,7 +1041,7 @@ VKAPI_ATTR void VKAPI_CALL terminator_DebugReportMessageEXT(VkInstance instance,
 
     struct loader_instance *inst = (struct loader_instance *)instance;
 
-    loader_platform_thread_lock_mutex(&loader_lock);
+    loader_platform_thread_lock_mutex(&inst->lock);
     for (icd_term = inst->icd_terms; icd_term; icd_term = icd_term->next) {
         if (icd_term->dispatch.DebugReportMessageEXT != NULL) {
             icd_term->dispatch.DebugReportMessageEXT(icd_term->instance, flags, objType, object, location, msgCode, pLayerPrefix,
@@ -853,7 +1054,7 @@ VKAPI_ATTR void VKAPI_CALL terminator_DebugReportMessageEXT(VkInstance instance,
 
     util_DebugReportMessage(inst, flags, objType, object, location, msgCode, pLayerPrefix, pMsg);
 
-    loader_platform_thread_unlock_mutex(&loader_lock);
+    loader_platform_thread_unlock_mutex(&inst->lock);
 }
 
 // General utilities
@@ -39,6 +39,7 @@ bool debug_utils_ReportObjectToAnnotObject(VkDebugReportObjectTypeEXT dr_object_
                                            VkDebugUtilsObjectNameInfoEXT *da_object_name_info);
 bool debug_utils_AnnotObjectToDebugReportObject(const VkDebugUtilsObjectNameInfoEXT *da_object_name_info,
                                                 VkDebugReportObjectTypeEXT *dr_object_type, uint64_t *dr_object_handle);
+void util_DestroyDebugCallbackIndex(struct loader_instance *inst);
 
 // VK_EXT_debug_utils related items
 
@@ -60,6 +61,8 @@ VkResult util_CreateDebugUtilsMessengers(struct loader_instance *inst, const VkA
 VkBool32 util_SubmitDebugUtilsMessageEXT(const struct loader_instance *inst, VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
                                          VkDebugUtilsMessageTypeFlagsEXT messageTypes,
                                          const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData);
+bool util_DebugUtilsMessageWanted(const struct loader_instance *inst, VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+                                  VkDebugUtilsMessageTypeFlagsEXT messageTypes);
 VkResult util_CopyDebugUtilsMessengerCreateInfos(const void *pChain, const VkAllocationCallbacks *pAllocator,
                                                  uint32_t *num_messengers, VkDebugUtilsMessengerCreateInfoEXT **infos,
                                                  VkDebugUtilsMessengerEXT **messengers);
@@ -21,6 +21,10 @@
 
 #include "vk_loader_platform.h"
 #include "loader.h"
+
+// Where the trampolines are written at runtime these aren't used; see unknown_ext_jit.h
+#if !defined(LOADER_UNKNOWN_EXT_JIT)
+
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC optimize(3)  // force gcc to use tail-calls
 #endif
@@ -536,3 +540,5 @@ void *loader_get_dev_ext_trampoline(uint32_t index) {
 
     return NULL;
 }
+
+#endif  // !LOADER_UNKNOWN_EXT_JIT
@@ -54,8 +54,12 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceCapabilities2K
     struct loader_physical_device_term *phys_dev_term = (struct loader_physical_device_term *)physicalDevice;
     struct loader_icd_term *icd_term = phys_dev_term->this_icd_term;
 
-    VkIcdSurface *icd_surface = (VkIcdSurface *)(pSurfaceInfo->surface);
-    uint8_t icd_index = phys_dev_term->icd_index;
+    VkSurfaceKHR real_icd_surface;
+    VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)pSurfaceInfo->surface,
+                                       phys_dev_term->icd_index, &real_icd_surface);
+    if (VK_SUCCESS != res) {
+        return res;
+    }
 
     if (icd_term->dispatch.GetPhysicalDeviceSurfaceCapabilities2KHR != NULL) {
         VkBaseOutStructure *pNext = (VkBaseOutStructure *)pSurfaceCapabilities->pNext;
@@ -70,9 +74,9 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceCapabilities2K
         }
 
         // Pass the call to the driver, possibly unwrapping the ICD surface
-        if (icd_surface->real_icd_surfaces != NULL && (void *)icd_surface->real_icd_surfaces[icd_index] != NULL) {
+        if ((VkSurfaceKHR)NULL != real_icd_surface) {
             VkPhysicalDeviceSurfaceInfo2KHR info_copy = *pSurfaceInfo;
-            info_copy.surface = icd_surface->real_icd_surfaces[icd_index];
+            info_copy.surface = real_icd_surface;
             return icd_term->dispatch.GetPhysicalDeviceSurfaceCapabilities2KHR(phys_dev_term->phys_dev, &info_copy,
                                                                                pSurfaceCapabilities);
         } else {
@@ -94,11 +98,11 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceCapabilities2K
 
         // Write to the VkSurfaceCapabilities2KHR struct
         VkSurfaceKHR surface = pSurfaceInfo->surface;
-        if (icd_surface->real_icd_surfaces != NULL && (void *)icd_surface->real_icd_surfaces[icd_index] != NULL) {
-            surface = icd_surface->real_icd_surfaces[icd_index];
+        if ((VkSurfaceKHR)NULL != real_icd_surface) {
+            surface = real_icd_surface;
         }
-        VkResult res = icd_term->dispatch.GetPhysicalDeviceSurfaceCapabilitiesKHR(phys_dev_term->phys_dev, surface,
-                                                                                  &pSurfaceCapabilities->surfaceCapabilities);
+        res = icd_term->dispatch.GetPhysicalDeviceSurfaceCapabilitiesKHR(phys_dev_term->phys_dev, surface,
+                                                                         &pSurfaceCapabilities->surfaceCapabilities);
 
         if (pSurfaceCapabilities->pNext != NULL) {
             loader_log(icd_term->this_instance, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
@@ -176,14 +180,18 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceFormats2KHR(Vk
     struct loader_physical_device_term *phys_dev_term = (struct loader_physical_device_term *)physicalDevice;
     struct loader_icd_term *icd_term = phys_dev_term->this_icd_term;
 
-    VkIcdSurface *icd_surface = (VkIcdSurface *)(pSurfaceInfo->surface);
-    uint8_t icd_index = phys_dev_term->icd_index;
+    VkSurfaceKHR real_icd_surface;
+    VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)pSurfaceInfo->surface,
+                                       phys_dev_term->icd_index, &real_icd_surface);
+    if (VK_SUCCESS != res) {
+        return res;
+    }
 
     if (icd_term->dispatch.GetPhysicalDeviceSurfaceFormats2KHR != NULL) {
         // Pass the call to the driver, possibly unwrapping the ICD surface
-        if (icd_surface->real_icd_surfaces != NULL && (void *)icd_surface->real_icd_surfaces[icd_index] != NULL) {
+        if ((VkSurfaceKHR)NULL != real_icd_surface) {
             VkPhysicalDeviceSurfaceInfo2KHR info_copy = *pSurfaceInfo;
-            info_copy.surface = icd_surface->real_icd_surfaces[icd_index];
+            info_copy.surface = real_icd_surface;
             return icd_term->dispatch.GetPhysicalDeviceSurfaceFormats2KHR(phys_dev_term->phys_dev, &info_copy, pSurfaceFormatCount,
                                                                           pSurfaceFormats);
         } else {
@@ -203,8 +211,8 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceFormats2KHR(Vk
         }
 
         VkSurfaceKHR surface = pSurfaceInfo->surface;
-        if (icd_surface->real_icd_surfaces != NULL && (void *)icd_surface->real_icd_surfaces[icd_index] != NULL) {
-            surface = icd_surface->real_icd_surfaces[icd_index];
+        if ((VkSurfaceKHR)NULL != real_icd_surface) {
+            surface = real_icd_surface;
         }
 
         if (*pSurfaceFormatCount == 0 || pSurfaceFormats == NULL) {
@@ -218,8 +226,8 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceFormats2KHR(Vk
                 return VK_ERROR_OUT_OF_HOST_MEMORY;
             }
 
-            VkResult res = icd_term->dispatch.GetPhysicalDeviceSurfaceFormatsKHR(phys_dev_term->phys_dev, surface,
-                                                                                 pSurfaceFormatCount, formats);
+            res = icd_term->dispatch.GetPhysicalDeviceSurfaceFormatsKHR(phys_dev_term->phys_dev, surface, pSurfaceFormatCount,
+                                                                        formats);
             for (uint32_t i = 0; i < *pSurfaceFormatCount; ++i) {
                 pSurfaceFormats[i].surfaceFormat = formats[i];
                 if (pSurfaceFormats[i].pNext != NULL) {
@@ -249,13 +257,14 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceCapabilities2E
     struct loader_physical_device_term *phys_dev_term = (struct loader_physical_device_term *)physicalDevice;
     struct loader_icd_term *icd_term = phys_dev_term->this_icd_term;
 
-    VkIcdSurface *icd_surface = (VkIcdSurface *)(surface);
-    uint8_t icd_index = phys_dev_term->icd_index;
-
     // Unwrap the surface if needed
-    VkSurfaceKHR unwrapped_surface = surface;
-    if (icd_surface->real_icd_surfaces != NULL && (void *)icd_surface->real_icd_surfaces[icd_index] != NULL) {
-        unwrapped_surface = icd_surface->real_icd_surfaces[icd_index];
+    VkSurfaceKHR unwrapped_surface;
+    VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)surface, phys_dev_term->icd_index, &unwrapped_surface);
+    if (VK_SUCCESS != res) {
+        return res;
+    }
+    if ((VkSurfaceKHR)NULL == unwrapped_surface) {
+        unwrapped_surface = surface;
     }
 
     if (icd_term->dispatch.GetPhysicalDeviceSurfaceCapabilities2EXT != NULL) {
@@ -270,8 +279,7 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceCapabilities2E
                    icd_term->scanned_icd->lib_name);
 
         VkSurfaceCapabilitiesKHR surface_caps;
-        VkResult res =
-            icd_term->dispatch.GetPhysicalDeviceSurfaceCapabilitiesKHR(phys_dev_term->phys_dev, unwrapped_surface, &surface_caps);
+        res = icd_term->dispatch.GetPhysicalDeviceSurfaceCapabilitiesKHR(phys_dev_term->phys_dev, unwrapped_surface, &surface_caps);
         pSurfaceCapabilities->minImageCount = surface_caps.minImageCount;
         pSurfaceCapabilities->maxImageCount = surface_caps.maxImageCount;
         pSurfaceCapabilities->currentExtent = surface_caps.currentExtent;
@@ -397,13 +405,17 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfacePresentModes2E
         loader_log(icd_term->this_instance, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                    "ICD associated with VkPhysicalDevice does not support GetPhysicalDeviceSurfacePresentModes2EXT");
     }
-    VkIcdSurface *icd_surface = (VkIcdSurface *)(pSurfaceInfo->surface);
-    uint8_t icd_index = phys_dev_term->icd_index;
-    if (NULL != icd_surface->real_icd_surfaces && NULL != (void *)icd_surface->real_icd_surfaces[icd_index]) {
+    VkSurfaceKHR real_icd_surface;
+    VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)pSurfaceInfo->surface,
+                                       phys_dev_term->icd_index, &real_icd_surface);
+    if (VK_SUCCESS != res) {
+        return res;
+    }
+    if ((VkSurfaceKHR)NULL != real_icd_surface) {
         const VkPhysicalDeviceSurfaceInfo2KHR surface_info_copy = {
             .sType = pSurfaceInfo->sType,
             .pNext = pSurfaceInfo->pNext,
-            .surface = icd_surface->real_icd_surfaces[icd_index],
+            .surface = real_icd_surface,
         };
         return icd_term->dispatch.GetPhysicalDeviceSurfacePresentModes2EXT(phys_dev_term->phys_dev, &surface_info_copy, pPresentModeCount, pPresentModes);
     }
@@ -426,12 +438,17 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetDeviceGroupSurfacePresentModes2EXT(
     struct loader_device *dev;
     struct loader_icd_term *icd_term = loader_get_icd_and_device(device, &dev, &icd_index);
     if (NULL != icd_term && NULL != icd_term->dispatch.GetDeviceGroupSurfacePresentModes2EXT) {
-        VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)pSurfaceInfo->surface;
-        if (NULL != icd_surface->real_icd_surfaces && (VkSurfaceKHR)NULL != icd_surface->real_icd_surfaces[icd_index]) {
+        VkSurfaceKHR real_icd_surface;
+        VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)pSurfaceInfo->surface,
+                                           icd_index, &real_icd_surface);
+        if (VK_SUCCESS != res) {
+            return res;
+        }
+        if ((VkSurfaceKHR)NULL != real_icd_surface) {
             const VkPhysicalDeviceSurfaceInfo2KHR surface_info_copy = {
                 .sType = pSurfaceInfo->sType,
                 .pNext = pSurfaceInfo->pNext,
-                .surface = icd_surface->real_icd_surfaces[icd_index],
+                .surface = real_icd_surface,
             };
             return icd_term->dispatch.GetDeviceGroupSurfacePresentModes2EXT(device, &surface_info_copy, pModes);
         }
@@ -25,6 +25,7 @@
 #ifndef _GNU_SOURCE
 #define _GNU_SOURCE
 #endif
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -293,7 +294,6 @@ VKAPI_ATTR bool VKAPI_CALL loader_icd_init_entries(struct loader_icd_term *icd_t
 VKAPI_ATTR void VKAPI_CALL loader_init_device_dispatch_table(struct loader_dev_dispatch_table *dev_table, PFN_vkGetDeviceProcAddr gpa,
                                                              VkDevice dev) {
     VkLayerDispatchTable *table = &dev_table->core_dispatch;
-    for (uint32_t i = 0; i < MAX_NUM_UNKNOWN_EXTS; i++) dev_table->ext_dispatch.dev_ext[i] = (PFN_vkDevExt)vkDevExtError;
 
     // ---- Core 1_0 commands
     table->GetDeviceProcAddr = gpa;
@@ -953,450 +953,785 @@ VKAPI_ATTR void VKAPI_CALL loader_init_instance_extension_dispatch_table(VkLayer
     table->CreateHeadlessSurfaceEXT = (PFN_vkCreateHeadlessSurfaceEXT)gpa(inst, "vkCreateHeadlessSurfaceEXT");
 }
 
-// Device command lookup function
-VKAPI_ATTR void* VKAPI_CALL loader_lookup_device_dispatch_table(const VkLayerDispatchTable *table, const char *name) {
-    if (!name || name[0] != 'v' || name[1] != 'k') return NULL;
-
-    name += 2;
-
-    // ---- Core 1_0 commands
-    if (!strcmp(name, "GetDeviceProcAddr")) return (void *)table->GetDeviceProcAddr;
-    if (!strcmp(name, "DestroyDevice")) return (void *)table->DestroyDevice;
-    if (!strcmp(name, "GetDeviceQueue")) return (void *)table->GetDeviceQueue;
-    if (!strcmp(name, "QueueSubmit")) return (void *)table->QueueSubmit;
-    if (!strcmp(name, "QueueWaitIdle")) return (void *)table->QueueWaitIdle;
-    if (!strcmp(name, "DeviceWaitIdle")) return (void *)table->DeviceWaitIdle;
-    if (!strcmp(name, "AllocateMemory")) return (void *)table->AllocateMemory;
-    if (!strcmp(name, "FreeMemory")) return (void *)table->FreeMemory;
-    if (!strcmp(name, "MapMemory")) return (void *)table->MapMemory;
-    if (!strcmp(name, "UnmapMemory")) return (void *)table->UnmapMemory;
-    if (!strcmp(name, "FlushMappedMemoryRanges")) return (void *)table->FlushMappedMemoryRanges;
-    if (!strcmp(name, "InvalidateMappedMemoryRanges")) return (void *)table->InvalidateMappedMemoryRanges;
-    if (!strcmp(name, "GetDeviceMemoryCommitment")) return (void *)table->GetDeviceMemoryCommitment;
-    if (!strcmp(name, "BindBufferMemory")) return (void *)table->BindBufferMemory;
-    if (!strcmp(name, "BindImageMemory")) return (void *)table->BindImageMemory;
-    if (!strcmp(name, "GetBufferMemoryRequirements")) return (void *)table->GetBufferMemoryRequirements;
-    if (!strcmp(name, "GetImageMemoryRequirements")) return (void *)table->GetImageMemoryRequirements;
-    if (!strcmp(name, "GetImageSparseMemoryRequirements")) return (void *)table->GetImageSparseMemoryRequirements;
-    if (!strcmp(name, "QueueBindSparse")) return (void *)table->QueueBindSparse;
-    if (!strcmp(name, "CreateFence")) return (void *)table->CreateFence;
-    if (!strcmp(name, "DestroyFence")) return (void *)table->DestroyFence;
-    if (!strcmp(name, "ResetFences")) return (void *)table->ResetFences;
-    if (!strcmp(name, "GetFenceStatus")) return (void *)table->GetFenceStatus;
-    if (!strcmp(name, "WaitForFences")) return (void *)table->WaitForFences;
-    if (!strcmp(name, "CreateSemaphore")) return (void *)table->CreateSemaphore;
-    if (!strcmp(name, "DestroySemaphore")) return (void *)table->DestroySemaphore;
-    if (!strcmp(name, "CreateEvent")) return (void *)table->CreateEvent;
-    if (!strcmp(name, "DestroyEvent")) return (void *)table->DestroyEvent;
-    if (!strcmp(name, "GetEventStatus")) return (void *)table->GetEventStatus;
-    if (!strcmp(name, "SetEvent")) return (void *)table->SetEvent;
-    if (!strcmp(name, "ResetEvent")) return (void *)table->ResetEvent;
-    if (!strcmp(name, "CreateQueryPool")) return (void *)table->CreateQueryPool;
-    if (!strcmp(name, "DestroyQueryPool")) return (void *)table->DestroyQueryPool;
-    if (!strcmp(name, "GetQueryPoolResults")) return (void *)table->GetQueryPoolResults;
-    if (!strcmp(name, "CreateBuffer")) return (void *)table->CreateBuffer;
-    if (!strcmp(name, "DestroyBuffer")) return (void *)table->DestroyBuffer;
-    if (!strcmp(name, "CreateBufferView")) return (void *)table->CreateBufferView;
-    if (!strcmp(name, "DestroyBufferView")) return (void *)table->DestroyBufferView;
-    if (!strcmp(name, "CreateImage")) return (void *)table->CreateImage;
-    if (!strcmp(name, "DestroyImage")) return (void *)table->DestroyImage;
-    if (!strcmp(name, "GetImageSubresourceLayout")) return (void *)table->GetImageSubresourceLayout;
-    if (!strcmp(name, "CreateImageView")) return (void *)table->CreateImageView;
-    if (!strcmp(name, "DestroyImageView")) return (void *)table->DestroyImageView;
-    if (!strcmp(name, "CreateShaderModule")) return (void *)table->CreateShaderModule;
-    if (!strcmp(name, "DestroyShaderModule")) return (void *)table->DestroyShaderModule;
-    if (!strcmp(name, "CreatePipelineCache")) return (void *)table->CreatePipelineCache;
-    if (!strcmp(name, "DestroyPipelineCache")) return (void *)table->DestroyPipelineCache;
-    if (!strcmp(name, "GetPipelineCacheData")) return (void *)table->GetPipelineCacheData;
-    if (!strcmp(name, "MergePipelineCaches")) return (void *)table->MergePipelineCaches;
-    if (!strcmp(name, "CreateGraphicsPipelines")) return (void *)table->CreateGraphicsPipelines;
-    if (!strcmp(name, "CreateComputePipelines")) return (void *)table->CreateComputePipelines;
-    if (!strcmp(name, "DestroyPipeline")) return (void *)table->DestroyPipeline;
-    if (!strcmp(name, "CreatePipelineLayout")) return (void *)table->CreatePipelineLayout;
-    if (!strcmp(name, "DestroyPipelineLayout")) return (void *)table->DestroyPipelineLayout;
-    if (!strcmp(name, "CreateSampler")) return (void *)table->CreateSampler;
-    if (!strcmp(name, "DestroySampler")) return (void *)table->DestroySampler;
-    if (!strcmp(name, "CreateDescriptorSetLayout")) return (void *)table->CreateDescriptorSetLayout;
-    if (!strcmp(name, "DestroyDescriptorSetLayout")) return (void *)table->DestroyDescriptorSetLayout;
-    if (!strcmp(name, "CreateDescriptorPool")) return (void *)table->CreateDescriptorPool;
-    if (!strcmp(name, "DestroyDescriptorPool")) return (void *)table->DestroyDescriptorPool;
-    if (!strcmp(name, "ResetDescriptorPool")) return (void *)table->ResetDescriptorPool;
-    if (!strcmp(name, "AllocateDescriptorSets")) return (void *)table->AllocateDescriptorSets;
-    if (!strcmp(name, "FreeDescriptorSets")) return (void *)table->FreeDescriptorSets;
-    if (!strcmp(name, "UpdateDescriptorSets")) return (void *)table->UpdateDescriptorSets;
-    if (!strcmp(name, "CreateFramebuffer")) return (void *)table->CreateFramebuffer;
-    if (!strcmp(name, "DestroyFramebuffer")) return (void *)table->DestroyFramebuffer;
-    if (!strcmp(name, "CreateRenderPass")) return (void *)table->CreateRenderPass;
-    if (!strcmp(name, "DestroyRenderPass")) return (void *)table->DestroyRenderPass;
-    if (!strcmp(name, "GetRenderAreaGranularity")) return (void *)table->GetRenderAreaGranularity;
-    if (!strcmp(name, "CreateCommandPool")) return (void *)table->CreateCommandPool;
-    if (!strcmp(name, "DestroyCommandPool")) return (void *)table->DestroyCommandPool;
-    if (!strcmp(name, "ResetCommandPool")) return (void *)table->ResetCommandPool;
-    if (!strcmp(name, "AllocateCommandBuffers")) return (void *)table->AllocateCommandBuffers;
-    if (!strcmp(name, "FreeCommandBuffers")) return (void *)table->FreeCommandBuffers;
-    if (!strcmp(name, "BeginCommandBuffer")) return (void *)table->BeginCommandBuffer;
-    if (!strcmp(name, "EndCommandBuffer")) return (void *)table->EndCommandBuffer;
-    if (!strcmp(name, "ResetCommandBuffer")) return (void *)table->ResetCommandBuffer;
-    if (!strcmp(name, "CmdBindPipeline")) return (void *)table->CmdBindPipeline;
-    if (!strcmp(name, "CmdSetViewport")) return (void *)table->CmdSetViewport;
-    if (!strcmp(name, "CmdSetScissor")) return (void *)table->CmdSetScissor;
-    if (!strcmp(name, "CmdSetLineWidth")) return (void *)table->CmdSetLineWidth;
-    if (!strcmp(name, "CmdSetDepthBias")) return (void *)table->CmdSetDepthBias;
-    if (!strcmp(name, "CmdSetBlendConstants")) return (void *)table->CmdSetBlendConstants;
-    if (!strcmp(name, "CmdSetDepthBounds")) return (void *)table->CmdSetDepthBounds;
-    if (!strcmp(name, "CmdSetStencilCompareMask")) return (void *)table->CmdSetStencilCompareMask;
-    if (!strcmp(name, "CmdSetStencilWriteMask")) return (void *)table->CmdSetStencilWriteMask;
-    if (!strcmp(name, "CmdSetStencilReference")) return (void *)table->CmdSetStencilReference;
-    if (!strcmp(name, "CmdBindDescriptorSets")) return (void *)table->CmdBindDescriptorSets;
-    if (!strcmp(name, "CmdBindIndexBuffer")) return (void *)table->CmdBindIndexBuffer;
-    if (!strcmp(name, "CmdBindVertexBuffers")) return (void *)table->CmdBindVertexBuffers;
-    if (!strcmp(name, "CmdDraw")) return (void *)table->CmdDraw;
-    if (!strcmp(name, "CmdDrawIndexed")) return (void *)table->CmdDrawIndexed;
-    if (!strcmp(name, "CmdDrawIndirect")) return (void *)table->CmdDrawIndirect;
-    if (!strcmp(name, "CmdDrawIndexedIndirect")) return (void *)table->CmdDrawIndexedIndirect;
-    if (!strcmp(name, "CmdDispatch")) return (void *)table->CmdDispatch;
-    if (!strcmp(name, "CmdDispatchIndirect")) return (void *)table->CmdDispatchIndirect;
-    if (!strcmp(name, "CmdCopyBuffer")) return (void *)table->CmdCopyBuffer;
-    if (!strcmp(name, "CmdCopyImage")) return (void *)table->CmdCopyImage;
-    if (!strcmp(name, "CmdBlitImage")) return (void *)table->CmdBlitImage;
-    if (!strcmp(name, "CmdCopyBufferToImage")) return (void *)table->CmdCopyBufferToImage;
-    if (!strcmp(name, "CmdCopyImageToBuffer")) return (void *)table->CmdCopyImageToBuffer;
-    if (!strcmp(name, "CmdUpdateBuffer")) return (void *)table->CmdUpdateBuffer;
-    if (!strcmp(name, "CmdFillBuffer")) return (void *)table->CmdFillBuffer;
-    if (!strcmp(name, "CmdClearColorImage")) return (void *)table->CmdClearColorImage;
-    if (!strcmp(name, "CmdClearDepthStencilImage")) return (void *)table->CmdClearDepthStencilImage;
-    if (!strcmp(name, "CmdClearAttachments")) return (void *)table->CmdClearAttachments;
-    if (!strcmp(name, "CmdResolveImage")) return (void *)table->CmdResolveImage;
-    if (!strcmp(name, "CmdSetEvent")) return (void *)table->CmdSetEvent;
-    if (!strcmp(name, "CmdResetEvent")) return (void *)table->CmdResetEvent;
-    if (!strcmp(name, "CmdWaitEvents")) return (void *)table->CmdWaitEvents;
-    if (!strcmp(name, "CmdPipelineBarrier")) return (void *)table->CmdPipelineBarrier;
-    if (!strcmp(name, "CmdBeginQuery")) return (void *)table->CmdBeginQuery;
-    if (!strcmp(name, "CmdEndQuery")) return (void *)table->CmdEndQuery;
-    if (!strcmp(name, "CmdResetQueryPool")) return (void *)table->CmdResetQueryPool;
-    if (!strcmp(name, "CmdWriteTimestamp")) return (void *)table->CmdWriteTimestamp;
-    if (!strcmp(name, "CmdCopyQueryPoolResults")) return (void *)table->CmdCopyQueryPoolResults;
-    if (!strcmp(name, "CmdPushConstants")) return (void *)table->CmdPushConstants;
-    if (!strcmp(name, "CmdBeginRenderPass")) return (void *)table->CmdBeginRenderPass;
-    if (!strcmp(name, "CmdNextSubpass")) return (void *)table->CmdNextSubpass;
-    if (!strcmp(name, "CmdEndRenderPass")) return (void *)table->CmdEndRenderPass;
-    if (!strcmp(name, "CmdExecuteCommands")) return (void *)table->CmdExecuteCommands;
-
-    // ---- Core 1_1 commands
-    if (!strcmp(name, "BindBufferMemory2")) return (void *)table->BindBufferMemory2;
-    if (!strcmp(name, "BindImageMemory2")) return (void *)table->BindImageMemory2;
-    if (!strcmp(name, "GetDeviceGroupPeerMemoryFeatures")) return (void *)table->GetDeviceGroupPeerMemoryFeatures;
-    if (!strcmp(name, "CmdSetDeviceMask")) return (void *)table->CmdSetDeviceMask;
-    if (!strcmp(name, "CmdDispatchBase")) return (void *)table->CmdDispatchBase;
-    if (!strcmp(name, "GetImageMemoryRequirements2")) return (void *)table->GetImageMemoryRequirements2;
-    if (!strcmp(name, "GetBufferMemoryRequirements2")) return (void *)table->GetBufferMemoryRequirements2;
-    if (!strcmp(name, "GetImageSparseMemoryRequirements2")) return (void *)table->GetImageSparseMemoryRequirements2;
-    if (!strcmp(name, "TrimCommandPool")) return (void *)table->TrimCommandPool;
-    if (!strcmp(name, "GetDeviceQueue2")) return (void *)table->GetDeviceQueue2;
-    if (!strcmp(name, "CreateSamplerYcbcrConversion")) return (void *)table->CreateSamplerYcbcrConversion;
-    if (!strcmp(name, "DestroySamplerYcbcrConversion")) return (void *)table->DestroySamplerYcbcrConversion;
-    if (!strcmp(name, "CreateDescriptorUpdateTemplate")) return (void *)table->CreateDescriptorUpdateTemplate;
-    if (!strcmp(name, "DestroyDescriptorUpdateTemplate")) return (void *)table->DestroyDescriptorUpdateTemplate;
-    if (!strcmp(name, "UpdateDescriptorSetWithTemplate")) return (void *)table->UpdateDescriptorSetWithTemplate;
-    if (!strcmp(name, "GetDescriptorSetLayoutSupport")) return (void *)table->GetDescriptorSetLayoutSupport;
+// Dispatch lookups by name go through minimal perfect hashes built by the generator over every
+// command that could be in the table, so resolving a name costs one hash and one strcmp.
+static inline uint32_t loader_dispatch_name_hash(uint32_t seed, const char *name) {
+    uint32_t hash = seed != 0 ? seed : 0x811c9dc5;
+    for (; *name != '\0'; name++) {
+        hash = (hash ^ (uint8_t)*name) * 0x01000193;
+    }
+    return hash;
+}
 
-    // ---- Core 1_2 commands
-    if (!strcmp(name, "CmdDrawIndirectCount")) return (void *)table->CmdDrawIndirectCount;
-    if (!strcmp(name, "CmdDrawIndexedIndirectCount")) return (void *)table->CmdDrawIndexedIndirectCount;
-    if (!strcmp(name, "CreateRenderPass2")) return (void *)table->CreateRenderPass2;
-    if (!strcmp(name, "CmdBeginRenderPass2")) return (void *)table->CmdBeginRenderPass2;
-    if (!strcmp(name, "CmdNextSubpass2")) return (void *)table->CmdNextSubpass2;
-    if (!strcmp(name, "CmdEndRenderPass2")) return (void *)table->CmdEndRenderPass2;
-    if (!strcmp(name, "ResetQueryPool")) return (void *)table->ResetQueryPool;
-    if (!strcmp(name, "GetSemaphoreCounterValue")) return (void *)table->GetSemaphoreCounterValue;
-    if (!strcmp(name, "WaitSemaphores")) return (void *)table->WaitSemaphores;
-    if (!strcmp(name, "SignalSemaphore")) return (void *)table->SignalSemaphore;
-    if (!strcmp(name, "GetBufferDeviceAddress")) return (void *)table->GetBufferDeviceAddress;
-    if (!strcmp(name, "GetBufferOpaqueCaptureAddress")) return (void *)table->GetBufferOpaqueCaptureAddress;
-    if (!strcmp(name, "GetDeviceMemoryOpaqueCaptureAddress")) return (void *)table->GetDeviceMemoryOpaqueCaptureAddress;
+// Returns the only slot the name can be in.  The caller still has to compare the name.
+static inline uint32_t loader_dispatch_name_slot(const int32_t *displacements, uint32_t count, const char *name) {
+    int32_t displacement = displacements[loader_dispatch_name_hash(0, name) % count];
+    if (displacement < 0) return (uint32_t)(-displacement - 1);
+    return loader_dispatch_name_hash((uint32_t)displacement, name) % count;
+}
 
-    // ---- VK_KHR_swapchain extension commands
-    if (!strcmp(name, "CreateSwapchainKHR")) return (void *)table->CreateSwapchainKHR;
-    if (!strcmp(name, "DestroySwapchainKHR")) return (void *)table->DestroySwapchainKHR;
-    if (!strcmp(name, "GetSwapchainImagesKHR")) return (void *)table->GetSwapchainImagesKHR;
-    if (!strcmp(name, "AcquireNextImageKHR")) return (void *)table->AcquireNextImageKHR;
-    if (!strcmp(name, "QueuePresentKHR")) return (void *)table->QueuePresentKHR;
-    if (!strcmp(name, "GetDeviceGroupPresentCapabilitiesKHR")) return (void *)table->GetDeviceGroupPresentCapabilitiesKHR;
-    if (!strcmp(name, "GetDeviceGroupSurfacePresentModesKHR")) return (void *)table->GetDeviceGroupSurfacePresentModesKHR;
-    if (!strcmp(name, "AcquireNextImage2KHR")) return (void *)table->AcquireNextImage2KHR;
+// Offset used for commands that are not compiled into the dispatch table on this platform
+#define LOADER_DISPATCH_NO_OFFSET UINT32_MAX
 
-    // ---- VK_KHR_display_swapchain extension commands
-    if (!strcmp(name, "CreateSharedSwapchainsKHR")) return (void *)table->CreateSharedSwapchainsKHR;
+struct loader_dispatch_name_entry {
+    const char *name;  // without the "vk" prefix
+    uint32_t offset;   // into the dispatch table
+};
 
-    // ---- VK_KHR_device_group extension commands
-    if (!strcmp(name, "GetDeviceGroupPeerMemoryFeaturesKHR")) return (void *)table->GetDeviceGroupPeerMemoryFeaturesKHR;
-    if (!strcmp(name, "CmdSetDeviceMaskKHR")) return (void *)table->CmdSetDeviceMaskKHR;
-    if (!strcmp(name, "CmdDispatchBaseKHR")) return (void *)table->CmdDispatchBaseKHR;
+struct loader_trampoline_name_entry {
+    const char *name;  // without the "vk" prefix
+    void *addr;
+};
 
-    // ---- VK_KHR_maintenance1 extension commands
-    if (!strcmp(name, "TrimCommandPoolKHR")) return (void *)table->TrimCommandPoolKHR;
+#define LOADER_DEVICE_NAME_COUNT 297
+
+static const int32_t loader_device_name_displacements[LOADER_DEVICE_NAME_COUNT] = {
+    5, 1, 1, 0, -2, -3, -4, 6, -5, -6, -7, 0, -8, 1, 0, 0,
+    1, 1, 1, 1, 0, -9, 0, 1, -11, -13, 1, 0, 0, -19, 6, -21,
+    -22, -24, -25, 0, -28, 0, 0, 1, 0, 0, -30, -33, -36, -37, 4, 1,
+    -38, 1, -39, 1, 2, 0, 0, 2, 0, 3, 0, 0, -40, 0, -41, -42,
+    -48, 1, 2, -50, 1, 1, -51, 0, 2, 3, -54, -55, 2, 1, 0, -57,
+    -58, 4, -59, 2, -60, 0, 0, 0, 4, -63, -71, 3, 0, 1, -77, -78,
+    -79, -83, 0, -85, -86, -90, -92, -97, 0, -103, 3, -107, 1, 0, -109, 1,
+    1, 2, 0, 1, -113, 0, 0, 3, -118, -119, 0, -121, 0, -123, -128, -133,
+    -135, 0, 2, -141, 0, 0, 0, 0, -142, -146, 0, 0, 0, 0, -147, 1,
+    0, -150, 0, -151, 8, -152, 0, -154, 10, 0, 0, -156, 0, -157, 0, 0,
+    0, 0, 0, 0, 0, -160, 0, 1, 0, -162, -163, 0, -167, 0, -168, 4,
+    -176, -179, 4, -180, 2, 5, -182, 1, -188, 1, 0, -189, 2, -190, -195, -196,
+    1, 0, 0, -203, 0, 0, 1, 3, 0, -205, 1, -208, -210, -212, 0, 3,
+    0, -214, 4, 0, -215, 0, 0, 0, 0, 0, -217, 0, 0, 0, -220, 0,
+    -223, 3, -225, 0, 2, -228, -229, 0, 4, -231, -232, -235, 4, -239, -240, -241,
+    5, 0, -244, 0, 15, -247, -249, -251, -254, -255, 0, -258, -259, -262, -267, 0,
+    -270, 0, -273, 0, 4, -274, 0, 0, -277, 0, -279, -280, 6, 1, 1, 0,
+    12, 0, 0, -283, -284, 0, 14, 0, 0, 5, -285, -287, 0, 1, -289, -291,
+    -292, 3, 0, 0, 0, -297, 1, 0, 0,
+};
 
-    // ---- VK_KHR_external_memory_win32 extension commands
+static const struct loader_dispatch_name_entry loader_device_names[LOADER_DEVICE_NAME_COUNT] = {
+    {"CmdSetLineWidth", offsetof(VkLayerDispatchTable, CmdSetLineWidth)},
+    {"GetBufferDeviceAddress", offsetof(VkLayerDispatchTable, GetBufferDeviceAddress)},
+    {"CmdProcessCommandsNVX", offsetof(VkLayerDispatchTable, CmdProcessCommandsNVX)},
+    {"MapMemory", offsetof(VkLayerDispatchTable, MapMemory)},
+    {"SignalSemaphoreKHR", offsetof(VkLayerDispatchTable, SignalSemaphoreKHR)},
+    {"GetQueryPoolResults", offsetof(VkLayerDispatchTable, GetQueryPoolResults)},
+    {"GetImageMemoryRequirements2", offsetof(VkLayerDispatchTable, GetImageMemoryRequirements2)},
+    {"AcquireNextImageKHR", offsetof(VkLayerDispatchTable, AcquireNextImageKHR)},
+    {"GetAccelerationStructureHandleNV", offsetof(VkLayerDispatchTable, GetAccelerationStructureHandleNV)},
+    {"CmdNextSubpass2KHR", offsetof(VkLayerDispatchTable, CmdNextSubpass2KHR)},
+    {"WaitSemaphoresKHR", offsetof(VkLayerDispatchTable, WaitSemaphoresKHR)},
+    {"CmdSetDeviceMask", offsetof(VkLayerDispatchTable, CmdSetDeviceMask)},
+    {"CmdSetEvent", offsetof(VkLayerDispatchTable, CmdSetEvent)},
+    {"CmdEndConditionalRenderingEXT", offsetof(VkLayerDispatchTable, CmdEndConditionalRenderingEXT)},
+    {"GetImageDrmFormatModifierPropertiesEXT", offsetof(VkLayerDispatchTable, GetImageDrmFormatModifierPropertiesEXT)},
+    {"CreateSamplerYcbcrConversion", offsetof(VkLayerDispatchTable, CreateSamplerYcbcrConversion)},
+    {"DestroyDescriptorSetLayout", offsetof(VkLayerDispatchTable, DestroyDescriptorSetLayout)},
+    {"DestroyBuffer", offsetof(VkLayerDispatchTable, DestroyBuffer)},
+    {"DestroyFramebuffer", offsetof(VkLayerDispatchTable, DestroyFramebuffer)},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "GetMemoryWin32HandleKHR")) return (void *)table->GetMemoryWin32HandleKHR;
+    {"AcquireFullScreenExclusiveModeEXT", offsetof(VkLayerDispatchTable, AcquireFullScreenExclusiveModeEXT)},
+#else
+    {"AcquireFullScreenExclusiveModeEXT", LOADER_DISPATCH_NO_OFFSET},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"DestroyPipeline", offsetof(VkLayerDispatchTable, DestroyPipeline)},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "GetMemoryWin32HandlePropertiesKHR")) return (void *)table->GetMemoryWin32HandlePropertiesKHR;
+    {"ReleaseFullScreenExclusiveModeEXT", offsetof(VkLayerDispatchTable, ReleaseFullScreenExclusiveModeEXT)},
+#else
+    {"ReleaseFullScreenExclusiveModeEXT", LOADER_DISPATCH_NO_OFFSET},
 #endif // VK_USE_PLATFORM_WIN32_KHR
-
-    // ---- VK_KHR_external_memory_fd extension commands
-    if (!strcmp(name, "GetMemoryFdKHR")) return (void *)table->GetMemoryFdKHR;
-    if (!strcmp(name, "GetMemoryFdPropertiesKHR")) return (void *)table->GetMemoryFdPropertiesKHR;
-
-    // ---- VK_KHR_external_semaphore_win32 extension commands
+    {"CreateFence", offsetof(VkLayerDispatchTable, CreateFence)},
+    {"ResetDescriptorPool", offsetof(VkLayerDispatchTable, ResetDescriptorPool)},
+    {"AcquireNextImage2KHR", offsetof(VkLayerDispatchTable, AcquireNextImage2KHR)},
+    {"CreateIndirectCommandsLayoutNVX", offsetof(VkLayerDispatchTable, CreateIndirectCommandsLayoutNVX)},
+    {"RegisterDisplayEventEXT", offsetof(VkLayerDispatchTable, RegisterDisplayEventEXT)},
+    {"CmdCopyImage", offsetof(VkLayerDispatchTable, CmdCopyImage)},
+    {"CmdSetDiscardRectangleEXT", offsetof(VkLayerDispatchTable, CmdSetDiscardRectangleEXT)},
+    {"GetShaderInfoAMD", offsetof(VkLayerDispatchTable, GetShaderInfoAMD)},
+    {"GetDeviceQueue", offsetof(VkLayerDispatchTable, GetDeviceQueue)},
+    {"CmdWriteBufferMarkerAMD", offsetof(VkLayerDispatchTable, CmdWriteBufferMarkerAMD)},
+    {"CmdInsertDebugUtilsLabelEXT", offsetof(VkLayerDispatchTable, CmdInsertDebugUtilsLabelEXT)},
+    {"CmdResetEvent", offsetof(VkLayerDispatchTable, CmdResetEvent)},
+    {"QueueSetPerformanceConfigurationINTEL", offsetof(VkLayerDispatchTable, QueueSetPerformanceConfigurationINTEL)},
+    {"DestroyValidationCacheEXT", offsetof(VkLayerDispatchTable, DestroyValidationCacheEXT)},
+    {"CmdSetScissor", offsetof(VkLayerDispatchTable, CmdSetScissor)},
+    {"DestroySampler", offsetof(VkLayerDispatchTable, DestroySampler)},
+    {"DestroyCommandPool", offsetof(VkLayerDispatchTable, DestroyCommandPool)},
+    {"MergeValidationCachesEXT", offsetof(VkLayerDispatchTable, MergeValidationCachesEXT)},
+    {"DestroyBufferView", offsetof(VkLayerDispatchTable, DestroyBufferView)},
+    {"DeviceWaitIdle", offsetof(VkLayerDispatchTable, DeviceWaitIdle)},
+    {"CmdReserveSpaceForCommandsNVX", offsetof(VkLayerDispatchTable, CmdReserveSpaceForCommandsNVX)},
+    {"GetImageSparseMemoryRequirements2", offsetof(VkLayerDispatchTable, GetImageSparseMemoryRequirements2)},
+    {"CmdBindVertexBuffers", offsetof(VkLayerDispatchTable, CmdBindVertexBuffers)},
+    {"CmdDrawIndirectCount", offsetof(VkLayerDispatchTable, CmdDrawIndirectCount)},
+    {"BindBufferMemory2KHR", offsetof(VkLayerDispatchTable, BindBufferMemory2KHR)},
+    {"CreateDescriptorSetLayout", offsetof(VkLayerDispatchTable, CreateDescriptorSetLayout)},
+    {"FreeCommandBuffers", offsetof(VkLayerDispatchTable, FreeCommandBuffers)},
+    {"GetRayTracingShaderGroupHandlesNV", offsetof(VkLayerDispatchTable, GetRayTracingShaderGroupHandlesNV)},
+    {"BeginCommandBuffer", offsetof(VkLayerDispatchTable, BeginCommandBuffer)},
+    {"CmdNextSubpass2", offsetof(VkLayerDispatchTable, CmdNextSubpass2)},
+    {"CmdEndRenderPass", offsetof(VkLayerDispatchTable, CmdEndRenderPass)},
+    {"CreateAccelerationStructureNV", offsetof(VkLayerDispatchTable, CreateAccelerationStructureNV)},
+    {"CmdNextSubpass", offsetof(VkLayerDispatchTable, CmdNextSubpass)},
+    {"GetMemoryFdKHR", offsetof(VkLayerDispatchTable, GetMemoryFdKHR)},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "ImportSemaphoreWin32HandleKHR")) return (void *)table->ImportSemaphoreWin32HandleKHR;
+    {"GetMemoryWin32HandleNV", offsetof(VkLayerDispatchTable, GetMemoryWin32HandleNV)},
+#else
+    {"GetMemoryWin32HandleNV", LOADER_DISPATCH_NO_OFFSET},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"CreateShaderModule", offsetof(VkLayerDispatchTable, CreateShaderModule)},
+    {"CmdBindTransformFeedbackBuffersEXT", offsetof(VkLayerDispatchTable, CmdBindTransformFeedbackBuffersEXT)},
+    {"GetDeviceMemoryOpaqueCaptureAddressKHR", offsetof(VkLayerDispatchTable, GetDeviceMemoryOpaqueCaptureAddressKHR)},
+    {"GetPastPresentationTimingGOOGLE", offsetof(VkLayerDispatchTable, GetPastPresentationTimingGOOGLE)},
+    {"UpdateDescriptorSetWithTemplateKHR", offsetof(VkLayerDispatchTable, UpdateDescriptorSetWithTemplateKHR)},
+    {"DestroyAccelerationStructureNV", offsetof(VkLayerDispatchTable, DestroyAccelerationStructureNV)},
+    {"GetSemaphoreCounterValue", offsetof(VkLayerDispatchTable, GetSemaphoreCounterValue)},
+    {"GetSemaphoreCounterValueKHR", offsetof(VkLayerDispatchTable, GetSemaphoreCounterValueKHR)},
+    {"CmdDispatchBaseKHR", offsetof(VkLayerDispatchTable, CmdDispatchBaseKHR)},
+    {"CmdBeginDebugUtilsLabelEXT", offsetof(VkLayerDispatchTable, CmdBeginDebugUtilsLabelEXT)},
+    {"AllocateCommandBuffers", offsetof(VkLayerDispatchTable, AllocateCommandBuffers)},
+    {"CreateSampler", offsetof(VkLayerDispatchTable, CreateSampler)},
+    {"GetImageSparseMemoryRequirements", offsetof(VkLayerDispatchTable, GetImageSparseMemoryRequirements)},
+    {"CmdBindDescriptorSets", offsetof(VkLayerDispatchTable, CmdBindDescriptorSets)},
+    {"WaitForFences", offsetof(VkLayerDispatchTable, WaitForFences)},
+    {"GetImageMemoryRequirements", offsetof(VkLayerDispatchTable, GetImageMemoryRequirements)},
+    {"DestroyObjectTableNVX", offsetof(VkLayerDispatchTable, DestroyObjectTableNVX)},
+    {"BindImageMemory2KHR", offsetof(VkLayerDispatchTable, BindImageMemory2KHR)},
+    {"QueueSubmit", offsetof(VkLayerDispatchTable, QueueSubmit)},
+    {"BindImageMemory", offsetof(VkLayerDispatchTable, BindImageMemory)},
+    {"SetHdrMetadataEXT", offsetof(VkLayerDispatchTable, SetHdrMetadataEXT)},
+    {"GetImageSubresourceLayout", offsetof(VkLayerDispatchTable, GetImageSubresourceLayout)},
+    {"GetPipelineExecutableStatisticsKHR", offsetof(VkLayerDispatchTable, GetPipelineExecutableStatisticsKHR)},
+    {"UninitializePerformanceApiINTEL", offsetof(VkLayerDispatchTable, UninitializePerformanceApiINTEL)},
+    {"CmdEndQueryIndexedEXT", offsetof(VkLayerDispatchTable, CmdEndQueryIndexedEXT)},
+    {"CreateRenderPass2KHR", offsetof(VkLayerDispatchTable, CreateRenderPass2KHR)},
+    {"CmdSetLineStippleEXT", offsetof(VkLayerDispatchTable, CmdSetLineStippleEXT)},
+    {"QueueEndDebugUtilsLabelEXT", offsetof(VkLayerDispatchTable, QueueEndDebugUtilsLabelEXT)},
+    {"DestroyPipelineLayout", offsetof(VkLayerDispatchTable, DestroyPipelineLayout)},
+    {"GetAccelerationStructureMemoryRequirementsNV", offsetof(VkLayerDispatchTable, GetAccelerationStructureMemoryRequirementsNV)},
+    {"CmdSetDepthBias", offsetof(VkLayerDispatchTable, CmdSetDepthBias)},
+    {"CreateObjectTableNVX", offsetof(VkLayerDispatchTable, CreateObjectTableNVX)},
+    {"GetPipelineExecutablePropertiesKHR", offsetof(VkLayerDispatchTable, GetPipelineExecutablePropertiesKHR)},
+    {"CreateValidationCacheEXT", offsetof(VkLayerDispatchTable, CreateValidationCacheEXT)},
+    {"CompileDeferredNV", offsetof(VkLayerDispatchTable, CompileDeferredNV)},
+    {"DestroyRenderPass", offsetof(VkLayerDispatchTable, DestroyRenderPass)},
+    {"CmdBindIndexBuffer", offsetof(VkLayerDispatchTable, CmdBindIndexBuffer)},
+    {"ResetQueryPoolEXT", offsetof(VkLayerDispatchTable, ResetQueryPoolEXT)},
+    {"CmdEndRenderPass2KHR", offsetof(VkLayerDispatchTable, CmdEndRenderPass2KHR)},
+    {"AllocateDescriptorSets", offsetof(VkLayerDispatchTable, AllocateDescriptorSets)},
+    {"GetRefreshCycleDurationGOOGLE", offsetof(VkLayerDispatchTable, GetRefreshCycleDurationGOOGLE)},
+    {"CmdEndRenderPass2", offsetof(VkLayerDispatchTable, CmdEndRenderPass2)},
+    {"CmdDrawIndirect", offsetof(VkLayerDispatchTable, CmdDrawIndirect)},
+    {"GetImageViewHandleNVX", offsetof(VkLayerDispatchTable, GetImageViewHandleNVX)},
+    {"CmdEndTransformFeedbackEXT", offsetof(VkLayerDispatchTable, CmdEndTransformFeedbackEXT)},
+    {"DestroyFence", offsetof(VkLayerDispatchTable, DestroyFence)},
+    {"GetDeviceGroupPeerMemoryFeatures", offsetof(VkLayerDispatchTable, GetDeviceGroupPeerMemoryFeatures)},
+    {"CmdBindPipeline", offsetof(VkLayerDispatchTable, CmdBindPipeline)},
+    {"CreateRenderPass", offsetof(VkLayerDispatchTable, CreateRenderPass)},
+    {"MergePipelineCaches", offsetof(VkLayerDispatchTable, MergePipelineCaches)},
+    {"DestroyEvent", offsetof(VkLayerDispatchTable, DestroyEvent)},
+    {"CreateSemaphore", offsetof(VkLayerDispatchTable, CreateSemaphore)},
+    {"GetEventStatus", offsetof(VkLayerDispatchTable, GetEventStatus)},
+    {"GetSwapchainCounterEXT", offsetof(VkLayerDispatchTable, GetSwapchainCounterEXT)},
+    {"BindAccelerationStructureMemoryNV", offsetof(VkLayerDispatchTable, BindAccelerationStructureMemoryNV)},
+    {"CmdDrawIndexedIndirectCountAMD", offsetof(VkLayerDispatchTable, CmdDrawIndexedIndirectCountAMD)},
+    {"DestroyIndirectCommandsLayoutNVX", offsetof(VkLayerDispatchTable, DestroyIndirectCommandsLayoutNVX)},
+    {"DestroyShaderModule", offsetof(VkLayerDispatchTable, DestroyShaderModule)},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "GetSemaphoreWin32HandleKHR")) return (void *)table->GetSemaphoreWin32HandleKHR;
+    {"GetMemoryWin32HandleKHR", offsetof(VkLayerDispatchTable, GetMemoryWin32HandleKHR)},
+#else
+    {"GetMemoryWin32HandleKHR", LOADER_DISPATCH_NO_OFFSET},
 #endif // VK_USE_PLATFORM_WIN32_KHR
-
-    // ---- VK_KHR_external_semaphore_fd extension commands
-    if (!strcmp(name, "ImportSemaphoreFdKHR")) return (void *)table->ImportSemaphoreFdKHR;
-    if (!strcmp(name, "GetSemaphoreFdKHR")) return (void *)table->GetSemaphoreFdKHR;
-
-    // ---- VK_KHR_push_descriptor extension commands
-    if (!strcmp(name, "CmdPushDescriptorSetKHR")) return (void *)table->CmdPushDescriptorSetKHR;
-    if (!strcmp(name, "CmdPushDescriptorSetWithTemplateKHR")) return (void *)table->CmdPushDescriptorSetWithTemplateKHR;
-
-    // ---- VK_KHR_descriptor_update_template extension commands
-    if (!strcmp(name, "CreateDescriptorUpdateTemplateKHR")) return (void *)table->CreateDescriptorUpdateTemplateKHR;
-    if (!strcmp(name, "DestroyDescriptorUpdateTemplateKHR")) return (void *)table->DestroyDescriptorUpdateTemplateKHR;
-    if (!strcmp(name, "UpdateDescriptorSetWithTemplateKHR")) return (void *)table->UpdateDescriptorSetWithTemplateKHR;
-
-    // ---- VK_KHR_create_renderpass2 extension commands
-    if (!strcmp(name, "CreateRenderPass2KHR")) return (void *)table->CreateRenderPass2KHR;
-    if (!strcmp(name, "CmdBeginRenderPass2KHR")) return (void *)table->CmdBeginRenderPass2KHR;
-    if (!strcmp(name, "CmdNextSubpass2KHR")) return (void *)table->CmdNextSubpass2KHR;
-    if (!strcmp(name, "CmdEndRenderPass2KHR")) return (void *)table->CmdEndRenderPass2KHR;
-
-    // ---- VK_KHR_shared_presentable_image extension commands
-    if (!strcmp(name, "GetSwapchainStatusKHR")) return (void *)table->GetSwapchainStatusKHR;
-
-    // ---- VK_KHR_external_fence_win32 extension commands
+    {"CmdBeginQuery", offsetof(VkLayerDispatchTable, CmdBeginQuery)},
+    {"ReleaseProfilingLockKHR", offsetof(VkLayerDispatchTable, ReleaseProfilingLockKHR)},
+    {"CmdBuildAccelerationStructureNV", offsetof(VkLayerDispatchTable, CmdBuildAccelerationStructureNV)},
+    {"CreateSamplerYcbcrConversionKHR", offsetof(VkLayerDispatchTable, CreateSamplerYcbcrConversionKHR)},
+    {"CmdDrawIndexedIndirectCountKHR", offsetof(VkLayerDispatchTable, CmdDrawIndexedIndirectCountKHR)},
+    {"ResetFences", offsetof(VkLayerDispatchTable, ResetFences)},
+    {"InvalidateMappedMemoryRanges", offsetof(VkLayerDispatchTable, InvalidateMappedMemoryRanges)},
+    {"ImportSemaphoreFdKHR", offsetof(VkLayerDispatchTable, ImportSemaphoreFdKHR)},
+    {"GetBufferDeviceAddressEXT", offsetof(VkLayerDispatchTable, GetBufferDeviceAddressEXT)},
+    {"GetValidationCacheDataEXT", offsetof(VkLayerDispatchTable, GetValidationCacheDataEXT)},
+    {"CreateSharedSwapchainsKHR", offsetof(VkLayerDispatchTable, CreateSharedSwapchainsKHR)},
+    {"CmdClearDepthStencilImage", offsetof(VkLayerDispatchTable, CmdClearDepthStencilImage)},
+    {"FreeMemory", offsetof(VkLayerDispatchTable, FreeMemory)},
+    {"CmdSetPerformanceOverrideINTEL", offsetof(VkLayerDispatchTable, CmdSetPerformanceOverrideINTEL)},
+    {"UpdateDescriptorSets", offsetof(VkLayerDispatchTable, UpdateDescriptorSets)},
+    {"CmdCopyAccelerationStructureNV", offsetof(VkLayerDispatchTable, CmdCopyAccelerationStructureNV)},
+    {"UpdateDescriptorSetWithTemplate", offsetof(VkLayerDispatchTable, UpdateDescriptorSetWithTemplate)},
+#ifdef VK_USE_PLATFORM_ANDROID_KHR
+    {"GetMemoryAndroidHardwareBufferANDROID", offsetof(VkLayerDispatchTable, GetMemoryAndroidHardwareBufferANDROID)},
+#else
+    {"GetMemoryAndroidHardwareBufferANDROID", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_ANDROID_KHR
+    {"CmdDebugMarkerEndEXT", offsetof(VkLayerDispatchTable, CmdDebugMarkerEndEXT)},
+    {"EndCommandBuffer", offsetof(VkLayerDispatchTable, EndCommandBuffer)},
+    {"GetDeviceProcAddr", offsetof(VkLayerDispatchTable, GetDeviceProcAddr)},
+    {"GetSwapchainImagesKHR", offsetof(VkLayerDispatchTable, GetSwapchainImagesKHR)},
+    {"DestroyDescriptorUpdateTemplateKHR", offsetof(VkLayerDispatchTable, DestroyDescriptorUpdateTemplateKHR)},
+    {"RegisterObjectsNVX", offsetof(VkLayerDispatchTable, RegisterObjectsNVX)},
+    {"CmdPushDescriptorSetKHR", offsetof(VkLayerDispatchTable, CmdPushDescriptorSetKHR)},
+    {"CmdWaitEvents", offsetof(VkLayerDispatchTable, CmdWaitEvents)},
+    {"CreateGraphicsPipelines", offsetof(VkLayerDispatchTable, CreateGraphicsPipelines)},
+    {"CreateQueryPool", offsetof(VkLayerDispatchTable, CreateQueryPool)},
+    {"GetDeviceQueue2", offsetof(VkLayerDispatchTable, GetDeviceQueue2)},
+    {"GetDeviceGroupPeerMemoryFeaturesKHR", offsetof(VkLayerDispatchTable, GetDeviceGroupPeerMemoryFeaturesKHR)},
+    {"CmdDrawIndexedIndirect", offsetof(VkLayerDispatchTable, CmdDrawIndexedIndirect)},
+    {"CmdDispatch", offsetof(VkLayerDispatchTable, CmdDispatch)},
+    {"CmdEndDebugUtilsLabelEXT", offsetof(VkLayerDispatchTable, CmdEndDebugUtilsLabelEXT)},
+    {"QueueWaitIdle", offsetof(VkLayerDispatchTable, QueueWaitIdle)},
+    {"CreateComputePipelines", offsetof(VkLayerDispatchTable, CreateComputePipelines)},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "ImportFenceWin32HandleKHR")) return (void *)table->ImportFenceWin32HandleKHR;
+    {"GetFenceWin32HandleKHR", offsetof(VkLayerDispatchTable, GetFenceWin32HandleKHR)},
+#else
+    {"GetFenceWin32HandleKHR", LOADER_DISPATCH_NO_OFFSET},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"GetQueueCheckpointDataNV", offsetof(VkLayerDispatchTable, GetQueueCheckpointDataNV)},
+    {"FlushMappedMemoryRanges", offsetof(VkLayerDispatchTable, FlushMappedMemoryRanges)},
+    {"CreatePipelineCache", offsetof(VkLayerDispatchTable, CreatePipelineCache)},
+    {"GetDeviceMemoryCommitment", offsetof(VkLayerDispatchTable, GetDeviceMemoryCommitment)},
+    {"CmdSetViewportShadingRatePaletteNV", offsetof(VkLayerDispatchTable, CmdSetViewportShadingRatePaletteNV)},
+    {"BindBufferMemory2", offsetof(VkLayerDispatchTable, BindBufferMemory2)},
+    {"GetDeviceMemoryOpaqueCaptureAddress", offsetof(VkLayerDispatchTable, GetDeviceMemoryOpaqueCaptureAddress)},
+    {"WaitSemaphores", offsetof(VkLayerDispatchTable, WaitSemaphores)},
+    {"CmdDebugMarkerBeginEXT", offsetof(VkLayerDispatchTable, CmdDebugMarkerBeginEXT)},
+    {"CmdCopyImageToBuffer", offsetof(VkLayerDispatchTable, CmdCopyImageToBuffer)},
+    {"GetBufferOpaqueCaptureAddress", offsetof(VkLayerDispatchTable, GetBufferOpaqueCaptureAddress)},
+    {"GetSemaphoreFdKHR", offsetof(VkLayerDispatchTable, GetSemaphoreFdKHR)},
+    {"CreateDescriptorPool", offsetof(VkLayerDispatchTable, CreateDescriptorPool)},
+    {"CmdExecuteCommands", offsetof(VkLayerDispatchTable, CmdExecuteCommands)},
+    {"QueueInsertDebugUtilsLabelEXT", offsetof(VkLayerDispatchTable, QueueInsertDebugUtilsLabelEXT)},
+    {"CmdSetStencilReference", offsetof(VkLayerDispatchTable, CmdSetStencilReference)},
+    {"DestroyPipelineCache", offsetof(VkLayerDispatchTable, DestroyPipelineCache)},
+    {"CmdResetQueryPool", offsetof(VkLayerDispatchTable, CmdResetQueryPool)},
+    {"DestroySamplerYcbcrConversionKHR", offsetof(VkLayerDispatchTable, DestroySamplerYcbcrConversionKHR)},
+    {"CmdPushDescriptorSetWithTemplateKHR", offsetof(VkLayerDispatchTable, CmdPushDescriptorSetWithTemplateKHR)},
+    {"DestroyImageView", offsetof(VkLayerDispatchTable, DestroyImageView)},
+    {"FreeDescriptorSets", offsetof(VkLayerDispatchTable, FreeDescriptorSets)},
+    {"CmdSetStencilWriteMask", offsetof(VkLayerDispatchTable, CmdSetStencilWriteMask)},
+    {"GetBufferDeviceAddressKHR", offsetof(VkLayerDispatchTable, GetBufferDeviceAddressKHR)},
+    {"CmdDrawIndexedIndirectCount", offsetof(VkLayerDispatchTable, CmdDrawIndexedIndirectCount)},
+    {"ReleasePerformanceConfigurationINTEL", offsetof(VkLayerDispatchTable, ReleasePerformanceConfigurationINTEL)},
+    {"BindBufferMemory", offsetof(VkLayerDispatchTable, BindBufferMemory)},
+    {"CmdSetSampleLocationsEXT", offsetof(VkLayerDispatchTable, CmdSetSampleLocationsEXT)},
+    {"GetDescriptorSetLayoutSupport", offsetof(VkLayerDispatchTable, GetDescriptorSetLayoutSupport)},
+    {"CmdBeginConditionalRenderingEXT", offsetof(VkLayerDispatchTable, CmdBeginConditionalRenderingEXT)},
+    {"GetPipelineExecutableInternalRepresentationsKHR", offsetof(VkLayerDispatchTable, GetPipelineExecutableInternalRepresentationsKHR)},
+    {"CmdBeginRenderPass2KHR", offsetof(VkLayerDispatchTable, CmdBeginRenderPass2KHR)},
+    {"SetLocalDimmingAMD", offsetof(VkLayerDispatchTable, SetLocalDimmingAMD)},
+    {"CmdDispatchBase", offsetof(VkLayerDispatchTable, CmdDispatchBase)},
+    {"CmdDraw", offsetof(VkLayerDispatchTable, CmdDraw)},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "GetFenceWin32HandleKHR")) return (void *)table->GetFenceWin32HandleKHR;
+    {"GetMemoryWin32HandlePropertiesKHR", offsetof(VkLayerDispatchTable, GetMemoryWin32HandlePropertiesKHR)},
+#else
+    {"GetMemoryWin32HandlePropertiesKHR", LOADER_DISPATCH_NO_OFFSET},
 #endif // VK_USE_PLATFORM_WIN32_KHR
-
-    // ---- VK_KHR_external_fence_fd extension commands
-    if (!strcmp(name, "ImportFenceFdKHR")) return (void *)table->ImportFenceFdKHR;
-    if (!strcmp(name, "GetFenceFdKHR")) return (void *)table->GetFenceFdKHR;
-
-    // ---- VK_KHR_performance_query extension commands
-    if (!strcmp(name, "AcquireProfilingLockKHR")) return (void *)table->AcquireProfilingLockKHR;
-    if (!strcmp(name, "ReleaseProfilingLockKHR")) return (void *)table->ReleaseProfilingLockKHR;
-
-    // ---- VK_KHR_get_memory_requirements2 extension commands
-    if (!strcmp(name, "GetImageMemoryRequirements2KHR")) return (void *)table->GetImageMemoryRequirements2KHR;
-    if (!strcmp(name, "GetBufferMemoryRequirements2KHR")) return (void *)table->GetBufferMemoryRequirements2KHR;
-    if (!strcmp(name, "GetImageSparseMemoryRequirements2KHR")) return (void *)table->GetImageSparseMemoryRequirements2KHR;
-
-    // ---- VK_KHR_sampler_ycbcr_conversion extension commands
-    if (!strcmp(name, "CreateSamplerYcbcrConversionKHR")) return (void *)table->CreateSamplerYcbcrConversionKHR;
-    if (!strcmp(name, "DestroySamplerYcbcrConversionKHR")) return (void *)table->DestroySamplerYcbcrConversionKHR;
-
-    // ---- VK_KHR_bind_memory2 extension commands
-    if (!strcmp(name, "BindBufferMemory2KHR")) return (void *)table->BindBufferMemory2KHR;
-    if (!strcmp(name, "BindImageMemory2KHR")) return (void *)table->BindImageMemory2KHR;
-
-    // ---- VK_KHR_maintenance3 extension commands
-    if (!strcmp(name, "GetDescriptorSetLayoutSupportKHR")) return (void *)table->GetDescriptorSetLayoutSupportKHR;
-
-    // ---- VK_KHR_draw_indirect_count extension commands
-    if (!strcmp(name, "CmdDrawIndirectCountKHR")) return (void *)table->CmdDrawIndirectCountKHR;
-    if (!strcmp(name, "CmdDrawIndexedIndirectCountKHR")) return (void *)table->CmdDrawIndexedIndirectCountKHR;
-
-    // ---- VK_KHR_timeline_semaphore extension commands
-    if (!strcmp(name, "GetSemaphoreCounterValueKHR")) return (void *)table->GetSemaphoreCounterValueKHR;
-    if (!strcmp(name, "WaitSemaphoresKHR")) return (void *)table->WaitSemaphoresKHR;
-    if (!strcmp(name, "SignalSemaphoreKHR")) return (void *)table->SignalSemaphoreKHR;
-
-    // ---- VK_KHR_buffer_device_address extension commands
-    if (!strcmp(name, "GetBufferDeviceAddressKHR")) return (void *)table->GetBufferDeviceAddressKHR;
-    if (!strcmp(name, "GetBufferOpaqueCaptureAddressKHR")) return (void *)table->GetBufferOpaqueCaptureAddressKHR;
-    if (!strcmp(name, "GetDeviceMemoryOpaqueCaptureAddressKHR")) return (void *)table->GetDeviceMemoryOpaqueCaptureAddressKHR;
-
-    // ---- VK_KHR_pipeline_executable_properties extension commands
-    if (!strcmp(name, "GetPipelineExecutablePropertiesKHR")) return (void *)table->GetPipelineExecutablePropertiesKHR;
-    if (!strcmp(name, "GetPipelineExecutableStatisticsKHR")) return (void *)table->GetPipelineExecutableStatisticsKHR;
-    if (!strcmp(name, "GetPipelineExecutableInternalRepresentationsKHR")) return (void *)table->GetPipelineExecutableInternalRepresentationsKHR;
-
-    // ---- VK_EXT_debug_marker extension commands
-    if (!strcmp(name, "DebugMarkerSetObjectTagEXT")) return (void *)table->DebugMarkerSetObjectTagEXT;
-    if (!strcmp(name, "DebugMarkerSetObjectNameEXT")) return (void *)table->DebugMarkerSetObjectNameEXT;
-    if (!strcmp(name, "CmdDebugMarkerBeginEXT")) return (void *)table->CmdDebugMarkerBeginEXT;
-    if (!strcmp(name, "CmdDebugMarkerEndEXT")) return (void *)table->CmdDebugMarkerEndEXT;
-    if (!strcmp(name, "CmdDebugMarkerInsertEXT")) return (void *)table->CmdDebugMarkerInsertEXT;
-
-    // ---- VK_EXT_transform_feedback extension commands
-    if (!strcmp(name, "CmdBindTransformFeedbackBuffersEXT")) return (void *)table->CmdBindTransformFeedbackBuffersEXT;
-    if (!strcmp(name, "CmdBeginTransformFeedbackEXT")) return (void *)table->CmdBeginTransformFeedbackEXT;
-    if (!strcmp(name, "CmdEndTransformFeedbackEXT")) return (void *)table->CmdEndTransformFeedbackEXT;
-    if (!strcmp(name, "CmdBeginQueryIndexedEXT")) return (void *)table->CmdBeginQueryIndexedEXT;
-    if (!strcmp(name, "CmdEndQueryIndexedEXT")) return (void *)table->CmdEndQueryIndexedEXT;
-    if (!strcmp(name, "CmdDrawIndirectByteCountEXT")) return (void *)table->CmdDrawIndirectByteCountEXT;
-
-    // ---- VK_NVX_image_view_handle extension commands
-    if (!strcmp(name, "GetImageViewHandleNVX")) return (void *)table->GetImageViewHandleNVX;
-
-    // ---- VK_AMD_draw_indirect_count extension commands
-    if (!strcmp(name, "CmdDrawIndirectCountAMD")) return (void *)table->CmdDrawIndirectCountAMD;
-    if (!strcmp(name, "CmdDrawIndexedIndirectCountAMD")) return (void *)table->CmdDrawIndexedIndirectCountAMD;
-
-    // ---- VK_AMD_shader_info extension commands
-    if (!strcmp(name, "GetShaderInfoAMD")) return (void *)table->GetShaderInfoAMD;
-
-    // ---- VK_NV_external_memory_win32 extension commands
+    {"CreatePipelineLayout", offsetof(VkLayerDispatchTable, CreatePipelineLayout)},
+    {"GetFenceStatus", offsetof(VkLayerDispatchTable, GetFenceStatus)},
+    {"GetMemoryHostPointerPropertiesEXT", offsetof(VkLayerDispatchTable, GetMemoryHostPointerPropertiesEXT)},
+    {"CreateImageView", offsetof(VkLayerDispatchTable, CreateImageView)},
+    {"GetDeviceGroupSurfacePresentModesKHR", offsetof(VkLayerDispatchTable, GetDeviceGroupSurfacePresentModesKHR)},
+    {"GetDescriptorSetLayoutSupportKHR", offsetof(VkLayerDispatchTable, GetDescriptorSetLayoutSupportKHR)},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "GetMemoryWin32HandleNV")) return (void *)table->GetMemoryWin32HandleNV;
+    {"GetSemaphoreWin32HandleKHR", offsetof(VkLayerDispatchTable, GetSemaphoreWin32HandleKHR)},
+#else
+    {"GetSemaphoreWin32HandleKHR", LOADER_DISPATCH_NO_OFFSET},
 #endif // VK_USE_PLATFORM_WIN32_KHR
-
-    // ---- VK_EXT_conditional_rendering extension commands
-    if (!strcmp(name, "CmdBeginConditionalRenderingEXT")) return (void *)table->CmdBeginConditionalRenderingEXT;
-    if (!strcmp(name, "CmdEndConditionalRenderingEXT")) return (void *)table->CmdEndConditionalRenderingEXT;
-
-    // ---- VK_NVX_device_generated_commands extension commands
-    if (!strcmp(name, "CmdProcessCommandsNVX")) return (void *)table->CmdProcessCommandsNVX;
-    if (!strcmp(name, "CmdReserveSpaceForCommandsNVX")) return (void *)table->CmdReserveSpaceForCommandsNVX;
-    if (!strcmp(name, "CreateIndirectCommandsLayoutNVX")) return (void *)table->CreateIndirectCommandsLayoutNVX;
-    if (!strcmp(name, "DestroyIndirectCommandsLayoutNVX")) return (void *)table->DestroyIndirectCommandsLayoutNVX;
-    if (!strcmp(name, "CreateObjectTableNVX")) return (void *)table->CreateObjectTableNVX;
-    if (!strcmp(name, "DestroyObjectTableNVX")) return (void *)table->DestroyObjectTableNVX;
-    if (!strcmp(name, "RegisterObjectsNVX")) return (void *)table->RegisterObjectsNVX;
-    if (!strcmp(name, "UnregisterObjectsNVX")) return (void *)table->UnregisterObjectsNVX;
-
-    // ---- VK_NV_clip_space_w_scaling extension commands
-    if (!strcmp(name, "CmdSetViewportWScalingNV")) return (void *)table->CmdSetViewportWScalingNV;
-
-    // ---- VK_EXT_display_control extension commands
-    if (!strcmp(name, "DisplayPowerControlEXT")) return (void *)table->DisplayPowerControlEXT;
-    if (!strcmp(name, "RegisterDeviceEventEXT")) return (void *)table->RegisterDeviceEventEXT;
-    if (!strcmp(name, "RegisterDisplayEventEXT")) return (void *)table->RegisterDisplayEventEXT;
-    if (!strcmp(name, "GetSwapchainCounterEXT")) return (void *)table->GetSwapchainCounterEXT;
-
-    // ---- VK_GOOGLE_display_timing extension commands
-    if (!strcmp(name, "GetRefreshCycleDurationGOOGLE")) return (void *)table->GetRefreshCycleDurationGOOGLE;
-    if (!strcmp(name, "GetPastPresentationTimingGOOGLE")) return (void *)table->GetPastPresentationTimingGOOGLE;
-
-    // ---- VK_EXT_discard_rectangles extension commands
-    if (!strcmp(name, "CmdSetDiscardRectangleEXT")) return (void *)table->CmdSetDiscardRectangleEXT;
-
-    // ---- VK_EXT_hdr_metadata extension commands
-    if (!strcmp(name, "SetHdrMetadataEXT")) return (void *)table->SetHdrMetadataEXT;
-
-    // ---- VK_EXT_debug_utils extension commands
-    if (!strcmp(name, "SetDebugUtilsObjectNameEXT")) return (void *)table->SetDebugUtilsObjectNameEXT;
-    if (!strcmp(name, "SetDebugUtilsObjectTagEXT")) return (void *)table->SetDebugUtilsObjectTagEXT;
-    if (!strcmp(name, "QueueBeginDebugUtilsLabelEXT")) return (void *)table->QueueBeginDebugUtilsLabelEXT;
-    if (!strcmp(name, "QueueEndDebugUtilsLabelEXT")) return (void *)table->QueueEndDebugUtilsLabelEXT;
-    if (!strcmp(name, "QueueInsertDebugUtilsLabelEXT")) return (void *)table->QueueInsertDebugUtilsLabelEXT;
-    if (!strcmp(name, "CmdBeginDebugUtilsLabelEXT")) return (void *)table->CmdBeginDebugUtilsLabelEXT;
-    if (!strcmp(name, "CmdEndDebugUtilsLabelEXT")) return (void *)table->CmdEndDebugUtilsLabelEXT;
-    if (!strcmp(name, "CmdInsertDebugUtilsLabelEXT")) return (void *)table->CmdInsertDebugUtilsLabelEXT;
-
-    // ---- VK_ANDROID_external_memory_android_hardware_buffer extension commands
-#ifdef VK_USE_PLATFORM_ANDROID_KHR
-    if (!strcmp(name, "GetAndroidHardwareBufferPropertiesANDROID")) return (void *)table->GetAndroidHardwareBufferPropertiesANDROID;
-#endif // VK_USE_PLATFORM_ANDROID_KHR
+    {"CmdClearColorImage", offsetof(VkLayerDispatchTable, CmdClearColorImage)},
+    {"CmdCopyQueryPoolResults", offsetof(VkLayerDispatchTable, CmdCopyQueryPoolResults)},
+    {"CreateRenderPass2", offsetof(VkLayerDispatchTable, CreateRenderPass2)},
+    {"DestroyDescriptorPool", offsetof(VkLayerDispatchTable, DestroyDescriptorPool)},
+    {"DestroySamplerYcbcrConversion", offsetof(VkLayerDispatchTable, DestroySamplerYcbcrConversion)},
+    {"CreateImage", offsetof(VkLayerDispatchTable, CreateImage)},
+    {"CmdDrawIndirectCountKHR", offsetof(VkLayerDispatchTable, CmdDrawIndirectCountKHR)},
+    {"GetDeviceGroupPresentCapabilitiesKHR", offsetof(VkLayerDispatchTable, GetDeviceGroupPresentCapabilitiesKHR)},
+    {"CmdDrawIndexed", offsetof(VkLayerDispatchTable, CmdDrawIndexed)},
+    {"GetBufferMemoryRequirements2KHR", offsetof(VkLayerDispatchTable, GetBufferMemoryRequirements2KHR)},
+    {"AcquirePerformanceConfigurationINTEL", offsetof(VkLayerDispatchTable, AcquirePerformanceConfigurationINTEL)},
+    {"CmdDrawMeshTasksIndirectNV", offsetof(VkLayerDispatchTable, CmdDrawMeshTasksIndirectNV)},
+    {"GetBufferMemoryRequirements2", offsetof(VkLayerDispatchTable, GetBufferMemoryRequirements2)},
+    {"AcquireProfilingLockKHR", offsetof(VkLayerDispatchTable, AcquireProfilingLockKHR)},
+    {"QueuePresentKHR", offsetof(VkLayerDispatchTable, QueuePresentKHR)},
+    {"CmdCopyBuffer", offsetof(VkLayerDispatchTable, CmdCopyBuffer)},
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"GetDeviceGroupSurfacePresentModes2EXT", offsetof(VkLayerDispatchTable, GetDeviceGroupSurfacePresentModes2EXT)},
+#else
+    {"GetDeviceGroupSurfacePresentModes2EXT", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_WIN32_KHR
+    {"DestroySwapchainKHR", offsetof(VkLayerDispatchTable, DestroySwapchainKHR)},
+    {"GetBufferOpaqueCaptureAddressKHR", offsetof(VkLayerDispatchTable, GetBufferOpaqueCaptureAddressKHR)},
+    {"GetImageMemoryRequirements2KHR", offsetof(VkLayerDispatchTable, GetImageMemoryRequirements2KHR)},
+    {"ResetCommandPool", offsetof(VkLayerDispatchTable, ResetCommandPool)},
+    {"SignalSemaphore", offsetof(VkLayerDispatchTable, SignalSemaphore)},
+    {"CmdSetBlendConstants", offsetof(VkLayerDispatchTable, CmdSetBlendConstants)},
+    {"DisplayPowerControlEXT", offsetof(VkLayerDispatchTable, DisplayPowerControlEXT)},
+    {"DebugMarkerSetObjectTagEXT", offsetof(VkLayerDispatchTable, DebugMarkerSetObjectTagEXT)},
+    {"GetImageSparseMemoryRequirements2KHR", offsetof(VkLayerDispatchTable, GetImageSparseMemoryRequirements2KHR)},
+    {"CmdSetCheckpointNV", offsetof(VkLayerDispatchTable, CmdSetCheckpointNV)},
+    {"CmdBeginRenderPass", offsetof(VkLayerDispatchTable, CmdBeginRenderPass)},
+    {"CmdDebugMarkerInsertEXT", offsetof(VkLayerDispatchTable, CmdDebugMarkerInsertEXT)},
+    {"CmdCopyBufferToImage", offsetof(VkLayerDispatchTable, CmdCopyBufferToImage)},
+    {"CmdPushConstants", offsetof(VkLayerDispatchTable, CmdPushConstants)},
+    {"CreateCommandPool", offsetof(VkLayerDispatchTable, CreateCommandPool)},
+    {"CmdUpdateBuffer", offsetof(VkLayerDispatchTable, CmdUpdateBuffer)},
+    {"CmdPipelineBarrier", offsetof(VkLayerDispatchTable, CmdPipelineBarrier)},
+    {"CreateDescriptorUpdateTemplate", offsetof(VkLayerDispatchTable, CreateDescriptorUpdateTemplate)},
+    {"CmdClearAttachments", offsetof(VkLayerDispatchTable, CmdClearAttachments)},
+    {"GetSwapchainStatusKHR", offsetof(VkLayerDispatchTable, GetSwapchainStatusKHR)},
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
-    if (!strcmp(name, "GetMemoryAndroidHardwareBufferANDROID")) return (void *)table->GetMemoryAndroidHardwareBufferANDROID;
+    {"GetAndroidHardwareBufferPropertiesANDROID", offsetof(VkLayerDispatchTable, GetAndroidHardwareBufferPropertiesANDROID)},
+#else
+    {"GetAndroidHardwareBufferPropertiesANDROID", LOADER_DISPATCH_NO_OFFSET},
 #endif // VK_USE_PLATFORM_ANDROID_KHR
+    {"CmdSetViewport", offsetof(VkLayerDispatchTable, CmdSetViewport)},
+    {"InitializePerformanceApiINTEL", offsetof(VkLayerDispatchTable, InitializePerformanceApiINTEL)},
+    {"DestroyDevice", offsetof(VkLayerDispatchTable, DestroyDevice)},
+    {"GetBufferMemoryRequirements", offsetof(VkLayerDispatchTable, GetBufferMemoryRequirements)},
+    {"CmdBindShadingRateImageNV", offsetof(VkLayerDispatchTable, CmdBindShadingRateImageNV)},
+    {"CreateBufferView", offsetof(VkLayerDispatchTable, CreateBufferView)},
+    {"GetPipelineCacheData", offsetof(VkLayerDispatchTable, GetPipelineCacheData)},
+    {"BindImageMemory2", offsetof(VkLayerDispatchTable, BindImageMemory2)},
+    {"CmdSetDeviceMaskKHR", offsetof(VkLayerDispatchTable, CmdSetDeviceMaskKHR)},
+    {"CmdDrawMeshTasksIndirectCountNV", offsetof(VkLayerDispatchTable, CmdDrawMeshTasksIndirectCountNV)},
+    {"AllocateMemory", offsetof(VkLayerDispatchTable, AllocateMemory)},
+    {"CreateRayTracingPipelinesNV", offsetof(VkLayerDispatchTable, CreateRayTracingPipelinesNV)},
+    {"CmdSetPerformanceMarkerINTEL", offsetof(VkLayerDispatchTable, CmdSetPerformanceMarkerINTEL)},
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"ImportSemaphoreWin32HandleKHR", offsetof(VkLayerDispatchTable, ImportSemaphoreWin32HandleKHR)},
+#else
+    {"ImportSemaphoreWin32HandleKHR", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_WIN32_KHR
+    {"CmdBeginQueryIndexedEXT", offsetof(VkLayerDispatchTable, CmdBeginQueryIndexedEXT)},
+    {"CmdBlitImage", offsetof(VkLayerDispatchTable, CmdBlitImage)},
+    {"TrimCommandPoolKHR", offsetof(VkLayerDispatchTable, TrimCommandPoolKHR)},
+    {"GetRenderAreaGranularity", offsetof(VkLayerDispatchTable, GetRenderAreaGranularity)},
+    {"RegisterDeviceEventEXT", offsetof(VkLayerDispatchTable, RegisterDeviceEventEXT)},
+    {"SetDebugUtilsObjectTagEXT", offsetof(VkLayerDispatchTable, SetDebugUtilsObjectTagEXT)},
+    {"CmdWriteAccelerationStructuresPropertiesNV", offsetof(VkLayerDispatchTable, CmdWriteAccelerationStructuresPropertiesNV)},
+    {"UnregisterObjectsNVX", offsetof(VkLayerDispatchTable, UnregisterObjectsNVX)},
+    {"CmdDispatchIndirect", offsetof(VkLayerDispatchTable, CmdDispatchIndirect)},
+    {"GetCalibratedTimestampsEXT", offsetof(VkLayerDispatchTable, GetCalibratedTimestampsEXT)},
+    {"QueueBeginDebugUtilsLabelEXT", offsetof(VkLayerDispatchTable, QueueBeginDebugUtilsLabelEXT)},
+    {"GetMemoryFdPropertiesKHR", offsetof(VkLayerDispatchTable, GetMemoryFdPropertiesKHR)},
+    {"GetPerformanceParameterINTEL", offsetof(VkLayerDispatchTable, GetPerformanceParameterINTEL)},
+    {"CmdSetViewportWScalingNV", offsetof(VkLayerDispatchTable, CmdSetViewportWScalingNV)},
+    {"QueueBindSparse", offsetof(VkLayerDispatchTable, QueueBindSparse)},
+    {"UnmapMemory", offsetof(VkLayerDispatchTable, UnmapMemory)},
+    {"SetEvent", offsetof(VkLayerDispatchTable, SetEvent)},
+    {"CreateSwapchainKHR", offsetof(VkLayerDispatchTable, CreateSwapchainKHR)},
+    {"CmdTraceRaysNV", offsetof(VkLayerDispatchTable, CmdTraceRaysNV)},
+    {"CmdSetStencilCompareMask", offsetof(VkLayerDispatchTable, CmdSetStencilCompareMask)},
+    {"CmdSetCoarseSampleOrderNV", offsetof(VkLayerDispatchTable, CmdSetCoarseSampleOrderNV)},
+    {"ResetEvent", offsetof(VkLayerDispatchTable, ResetEvent)},
+    {"CmdSetDepthBounds", offsetof(VkLayerDispatchTable, CmdSetDepthBounds)},
+    {"TrimCommandPool", offsetof(VkLayerDispatchTable, TrimCommandPool)},
+    {"ImportFenceFdKHR", offsetof(VkLayerDispatchTable, ImportFenceFdKHR)},
+    {"CreateBuffer", offsetof(VkLayerDispatchTable, CreateBuffer)},
+    {"CreateEvent", offsetof(VkLayerDispatchTable, CreateEvent)},
+    {"CmdDrawIndirectCountAMD", offsetof(VkLayerDispatchTable, CmdDrawIndirectCountAMD)},
+    {"CmdWriteTimestamp", offsetof(VkLayerDispatchTable, CmdWriteTimestamp)},
+    {"DestroySemaphore", offsetof(VkLayerDispatchTable, DestroySemaphore)},
+    {"CmdFillBuffer", offsetof(VkLayerDispatchTable, CmdFillBuffer)},
+    {"CreateDescriptorUpdateTemplateKHR", offsetof(VkLayerDispatchTable, CreateDescriptorUpdateTemplateKHR)},
+    {"SetDebugUtilsObjectNameEXT", offsetof(VkLayerDispatchTable, SetDebugUtilsObjectNameEXT)},
+    {"CmdDrawIndirectByteCountEXT", offsetof(VkLayerDispatchTable, CmdDrawIndirectByteCountEXT)},
+    {"ResetCommandBuffer", offsetof(VkLayerDispatchTable, ResetCommandBuffer)},
+    {"DestroyQueryPool", offsetof(VkLayerDispatchTable, DestroyQueryPool)},
+    {"CmdSetPerformanceStreamMarkerINTEL", offsetof(VkLayerDispatchTable, CmdSetPerformanceStreamMarkerINTEL)},
+    {"DestroyDescriptorUpdateTemplate", offsetof(VkLayerDispatchTable, DestroyDescriptorUpdateTemplate)},
+    {"GetFenceFdKHR", offsetof(VkLayerDispatchTable, GetFenceFdKHR)},
+    {"DebugMarkerSetObjectNameEXT", offsetof(VkLayerDispatchTable, DebugMarkerSetObjectNameEXT)},
+    {"ResetQueryPool", offsetof(VkLayerDispatchTable, ResetQueryPool)},
+    {"CmdBeginTransformFeedbackEXT", offsetof(VkLayerDispatchTable, CmdBeginTransformFeedbackEXT)},
+    {"CmdSetExclusiveScissorNV", offsetof(VkLayerDispatchTable, CmdSetExclusiveScissorNV)},
+    {"CmdDrawMeshTasksNV", offsetof(VkLayerDispatchTable, CmdDrawMeshTasksNV)},
+    {"CreateFramebuffer", offsetof(VkLayerDispatchTable, CreateFramebuffer)},
+    {"DestroyImage", offsetof(VkLayerDispatchTable, DestroyImage)},
+    {"CmdResolveImage", offsetof(VkLayerDispatchTable, CmdResolveImage)},
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    {"ImportFenceWin32HandleKHR", offsetof(VkLayerDispatchTable, ImportFenceWin32HandleKHR)},
+#else
+    {"ImportFenceWin32HandleKHR", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_WIN32_KHR
+    {"CmdBeginRenderPass2", offsetof(VkLayerDispatchTable, CmdBeginRenderPass2)},
+    {"CmdEndQuery", offsetof(VkLayerDispatchTable, CmdEndQuery)},
+};
 
-    // ---- VK_EXT_sample_locations extension commands
-    if (!strcmp(name, "CmdSetSampleLocationsEXT")) return (void *)table->CmdSetSampleLocationsEXT;
-
-    // ---- VK_EXT_image_drm_format_modifier extension commands
-    if (!strcmp(name, "GetImageDrmFormatModifierPropertiesEXT")) return (void *)table->GetImageDrmFormatModifierPropertiesEXT;
-
-    // ---- VK_EXT_validation_cache extension commands
-    if (!strcmp(name, "CreateValidationCacheEXT")) return (void *)table->CreateValidationCacheEXT;
-    if (!strcmp(name, "DestroyValidationCacheEXT")) return (void *)table->DestroyValidationCacheEXT;
-    if (!strcmp(name, "MergeValidationCachesEXT")) return (void *)table->MergeValidationCachesEXT;
-    if (!strcmp(name, "GetValidationCacheDataEXT")) return (void *)table->GetValidationCacheDataEXT;
-
-    // ---- VK_NV_shading_rate_image extension commands
-    if (!strcmp(name, "CmdBindShadingRateImageNV")) return (void *)table->CmdBindShadingRateImageNV;
-    if (!strcmp(name, "CmdSetViewportShadingRatePaletteNV")) return (void *)table->CmdSetViewportShadingRatePaletteNV;
-    if (!strcmp(name, "CmdSetCoarseSampleOrderNV")) return (void *)table->CmdSetCoarseSampleOrderNV;
-
-    // ---- VK_NV_ray_tracing extension commands
-    if (!strcmp(name, "CreateAccelerationStructureNV")) return (void *)table->CreateAccelerationStructureNV;
-    if (!strcmp(name, "DestroyAccelerationStructureNV")) return (void *)table->DestroyAccelerationStructureNV;
-    if (!strcmp(name, "GetAccelerationStructureMemoryRequirementsNV")) return (void *)table->GetAccelerationStructureMemoryRequirementsNV;
-    if (!strcmp(name, "BindAccelerationStructureMemoryNV")) return (void *)table->BindAccelerationStructureMemoryNV;
-    if (!strcmp(name, "CmdBuildAccelerationStructureNV")) return (void *)table->CmdBuildAccelerationStructureNV;
-    if (!strcmp(name, "CmdCopyAccelerationStructureNV")) return (void *)table->CmdCopyAccelerationStructureNV;
-    if (!strcmp(name, "CmdTraceRaysNV")) return (void *)table->CmdTraceRaysNV;
-    if (!strcmp(name, "CreateRayTracingPipelinesNV")) return (void *)table->CreateRayTracingPipelinesNV;
-    if (!strcmp(name, "GetRayTracingShaderGroupHandlesNV")) return (void *)table->GetRayTracingShaderGroupHandlesNV;
-    if (!strcmp(name, "GetAccelerationStructureHandleNV")) return (void *)table->GetAccelerationStructureHandleNV;
-    if (!strcmp(name, "CmdWriteAccelerationStructuresPropertiesNV")) return (void *)table->CmdWriteAccelerationStructuresPropertiesNV;
-    if (!strcmp(name, "CompileDeferredNV")) return (void *)table->CompileDeferredNV;
-
-    // ---- VK_EXT_external_memory_host extension commands
-    if (!strcmp(name, "GetMemoryHostPointerPropertiesEXT")) return (void *)table->GetMemoryHostPointerPropertiesEXT;
-
-    // ---- VK_AMD_buffer_marker extension commands
-    if (!strcmp(name, "CmdWriteBufferMarkerAMD")) return (void *)table->CmdWriteBufferMarkerAMD;
-
-    // ---- VK_EXT_calibrated_timestamps extension commands
-    if (!strcmp(name, "GetCalibratedTimestampsEXT")) return (void *)table->GetCalibratedTimestampsEXT;
-
-    // ---- VK_NV_mesh_shader extension commands
-    if (!strcmp(name, "CmdDrawMeshTasksNV")) return (void *)table->CmdDrawMeshTasksNV;
-    if (!strcmp(name, "CmdDrawMeshTasksIndirectNV")) return (void *)table->CmdDrawMeshTasksIndirectNV;
-    if (!strcmp(name, "CmdDrawMeshTasksIndirectCountNV")) return (void *)table->CmdDrawMeshTasksIndirectCountNV;
-
-    // ---- VK_NV_scissor_exclusive extension commands
-    if (!strcmp(name, "CmdSetExclusiveScissorNV")) return (void *)table->CmdSetExclusiveScissorNV;
-
-    // ---- VK_NV_device_diagnostic_checkpoints extension commands
-    if (!strcmp(name, "CmdSetCheckpointNV")) return (void *)table->CmdSetCheckpointNV;
-    if (!strcmp(name, "GetQueueCheckpointDataNV")) return (void *)table->GetQueueCheckpointDataNV;
-
-    // ---- VK_INTEL_performance_query extension commands
-    if (!strcmp(name, "InitializePerformanceApiINTEL")) return (void *)table->InitializePerformanceApiINTEL;
-    if (!strcmp(name, "UninitializePerformanceApiINTEL")) return (void *)table->UninitializePerformanceApiINTEL;
-    if (!strcmp(name, "CmdSetPerformanceMarkerINTEL")) return (void *)table->CmdSetPerformanceMarkerINTEL;
-    if (!strcmp(name, "CmdSetPerformanceStreamMarkerINTEL")) return (void *)table->CmdSetPerformanceStreamMarkerINTEL;
-    if (!strcmp(name, "CmdSetPerformanceOverrideINTEL")) return (void *)table->CmdSetPerformanceOverrideINTEL;
-    if (!strcmp(name, "AcquirePerformanceConfigurationINTEL")) return (void *)table->AcquirePerformanceConfigurationINTEL;
-    if (!strcmp(name, "ReleasePerformanceConfigurationINTEL")) return (void *)table->ReleasePerformanceConfigurationINTEL;
-    if (!strcmp(name, "QueueSetPerformanceConfigurationINTEL")) return (void *)table->QueueSetPerformanceConfigurationINTEL;
-    if (!strcmp(name, "GetPerformanceParameterINTEL")) return (void *)table->GetPerformanceParameterINTEL;
-
-    // ---- VK_AMD_display_native_hdr extension commands
-    if (!strcmp(name, "SetLocalDimmingAMD")) return (void *)table->SetLocalDimmingAMD;
+#define LOADER_INSTANCE_NAME_COUNT 89
 
-    // ---- VK_EXT_buffer_device_address extension commands
-    if (!strcmp(name, "GetBufferDeviceAddressEXT")) return (void *)table->GetBufferDeviceAddressEXT;
+static const int32_t loader_instance_name_displacements[LOADER_INSTANCE_NAME_COUNT] = {
+    -2, -4, 1, -5, 0, 0, 0, -7, 0, 2, -8, -16, 0, -17, 0, 0,
+    1, 2, 1, 0, -19, -29, -32, -38, 0, 0, 0, 1, 0, 0, -42, -45,
+    0, 0, 1, -46, 3, 0, -49, 0, 1, -51, 1, -52, -53, 0, 2, -57,
+    -59, -61, 0, -63, 0, 0, 3, 1, 0, 1, 3, 6, -64, 0, -65, -67,
+    -68, 6, -70, -73, -75, -76, 2, 0, 2, 7, 0, -77, 0, 0, 0, -78,
+    -79, 1, 0, 0, 7, -80, 12, -82, 0,
+};
 
-    // ---- VK_EXT_full_screen_exclusive extension commands
+static const struct loader_dispatch_name_entry loader_instance_names[LOADER_INSTANCE_NAME_COUNT] = {
+    {"GetPhysicalDeviceExternalFenceProperties", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceExternalFenceProperties)},
+    {"GetPhysicalDeviceExternalSemaphorePropertiesKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceExternalSemaphorePropertiesKHR)},
+    {"GetPhysicalDeviceExternalBufferProperties", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceExternalBufferProperties)},
+    {"EnumerateDeviceLayerProperties", offsetof(VkLayerInstanceDispatchTable, EnumerateDeviceLayerProperties)},
+    {"GetPhysicalDeviceMemoryProperties2KHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceMemoryProperties2KHR)},
+#ifdef VK_USE_PLATFORM_WAYLAND_KHR
+    {"CreateWaylandSurfaceKHR", offsetof(VkLayerInstanceDispatchTable, CreateWaylandSurfaceKHR)},
+#else
+    {"CreateWaylandSurfaceKHR", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_WAYLAND_KHR
+    {"EnumeratePhysicalDeviceGroups", offsetof(VkLayerInstanceDispatchTable, EnumeratePhysicalDeviceGroups)},
+    {"GetPhysicalDeviceExternalBufferPropertiesKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceExternalBufferPropertiesKHR)},
+    {"GetPhysicalDeviceFormatProperties2", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceFormatProperties2)},
+    {"GetPhysicalDeviceSurfaceCapabilities2KHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSurfaceCapabilities2KHR)},
+    {"GetPhysicalDeviceDisplayPropertiesKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceDisplayPropertiesKHR)},
+    {"CreateDebugReportCallbackEXT", offsetof(VkLayerInstanceDispatchTable, CreateDebugReportCallbackEXT)},
+    {"GetInstanceProcAddr", offsetof(VkLayerInstanceDispatchTable, GetInstanceProcAddr)},
+#ifdef VK_USE_PLATFORM_XCB_KHR
+    {"CreateXcbSurfaceKHR", offsetof(VkLayerInstanceDispatchTable, CreateXcbSurfaceKHR)},
+#else
+    {"CreateXcbSurfaceKHR", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_XCB_KHR
+    {"GetPhysicalDeviceMemoryProperties", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceMemoryProperties)},
+    {"GetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR)},
+#ifdef VK_USE_PLATFORM_XCB_KHR
+    {"GetPhysicalDeviceXcbPresentationSupportKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceXcbPresentationSupportKHR)},
+#else
+    {"GetPhysicalDeviceXcbPresentationSupportKHR", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_XCB_KHR
+    {"GetPhysicalDeviceFeatures2KHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceFeatures2KHR)},
+    {"CreateHeadlessSurfaceEXT", offsetof(VkLayerInstanceDispatchTable, CreateHeadlessSurfaceEXT)},
+    {"DestroyDebugUtilsMessengerEXT", offsetof(VkLayerInstanceDispatchTable, DestroyDebugUtilsMessengerEXT)},
+    {"GetPhysicalDeviceProperties2KHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceProperties2KHR)},
+    {"ReleaseDisplayEXT", offsetof(VkLayerInstanceDispatchTable, ReleaseDisplayEXT)},
+    {"GetPhysicalDeviceSparseImageFormatProperties", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSparseImageFormatProperties)},
+    {"GetPhysicalDeviceSurfacePresentModesKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSurfacePresentModesKHR)},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "AcquireFullScreenExclusiveModeEXT")) return (void *)table->AcquireFullScreenExclusiveModeEXT;
+    {"GetPhysicalDeviceSurfacePresentModes2EXT", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSurfacePresentModes2EXT)},
+#else
+    {"GetPhysicalDeviceSurfacePresentModes2EXT", LOADER_DISPATCH_NO_OFFSET},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"GetPhysicalDeviceMultisamplePropertiesEXT", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceMultisamplePropertiesEXT)},
+    {"GetPhysicalDeviceQueueFamilyProperties", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceQueueFamilyProperties)},
+#ifdef VK_USE_PLATFORM_GGP
+    {"CreateStreamDescriptorSurfaceGGP", offsetof(VkLayerInstanceDispatchTable, CreateStreamDescriptorSurfaceGGP)},
+#else
+    {"CreateStreamDescriptorSurfaceGGP", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_GGP
+    {"GetPhysicalDeviceDisplayProperties2KHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceDisplayProperties2KHR)},
+    {"GetPhysicalDeviceImageFormatProperties2KHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceImageFormatProperties2KHR)},
+    {"EnumeratePhysicalDevices", offsetof(VkLayerInstanceDispatchTable, EnumeratePhysicalDevices)},
+    {"GetPhysicalDeviceImageFormatProperties", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceImageFormatProperties)},
+    {"GetPhysicalDeviceFeatures", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceFeatures)},
+    {"GetPhysicalDeviceExternalFencePropertiesKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceExternalFencePropertiesKHR)},
+    {"CreateDisplayPlaneSurfaceKHR", offsetof(VkLayerInstanceDispatchTable, CreateDisplayPlaneSurfaceKHR)},
+    {"GetDisplayPlaneCapabilities2KHR", offsetof(VkLayerInstanceDispatchTable, GetDisplayPlaneCapabilities2KHR)},
+    {"GetPhysicalDeviceQueueFamilyProperties2KHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceQueueFamilyProperties2KHR)},
+    {"DebugReportMessageEXT", offsetof(VkLayerInstanceDispatchTable, DebugReportMessageEXT)},
+    {"GetPhysicalDeviceFeatures2", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceFeatures2)},
+    {"GetPhysicalDeviceProperties", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceProperties)},
+    {"GetPhysicalDeviceCalibrateableTimeDomainsEXT", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceCalibrateableTimeDomainsEXT)},
+    {"GetPhysicalDeviceFormatProperties", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceFormatProperties)},
+#ifdef VK_USE_PLATFORM_IOS_MVK
+    {"CreateIOSSurfaceMVK", offsetof(VkLayerInstanceDispatchTable, CreateIOSSurfaceMVK)},
+#else
+    {"CreateIOSSurfaceMVK", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_IOS_MVK
+#ifdef VK_USE_PLATFORM_XLIB_KHR
+    {"CreateXlibSurfaceKHR", offsetof(VkLayerInstanceDispatchTable, CreateXlibSurfaceKHR)},
+#else
+    {"CreateXlibSurfaceKHR", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_XLIB_KHR
+#ifdef VK_USE_PLATFORM_MACOS_MVK
+    {"CreateMacOSSurfaceMVK", offsetof(VkLayerInstanceDispatchTable, CreateMacOSSurfaceMVK)},
+#else
+    {"CreateMacOSSurfaceMVK", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_MACOS_MVK
+    {"GetPhysicalDeviceDisplayPlaneProperties2KHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceDisplayPlaneProperties2KHR)},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "ReleaseFullScreenExclusiveModeEXT")) return (void *)table->ReleaseFullScreenExclusiveModeEXT;
+    {"CreateWin32SurfaceKHR", offsetof(VkLayerInstanceDispatchTable, CreateWin32SurfaceKHR)},
+#else
+    {"CreateWin32SurfaceKHR", LOADER_DISPATCH_NO_OFFSET},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"GetPhysicalDeviceImageFormatProperties2", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceImageFormatProperties2)},
+    {"GetDisplayModePropertiesKHR", offsetof(VkLayerInstanceDispatchTable, GetDisplayModePropertiesKHR)},
+    {"GetDisplayModeProperties2KHR", offsetof(VkLayerInstanceDispatchTable, GetDisplayModeProperties2KHR)},
+    {"GetPhysicalDeviceSurfaceCapabilities2EXT", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSurfaceCapabilities2EXT)},
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"CreateImagePipeSurfaceFUCHSIA", offsetof(VkLayerInstanceDispatchTable, CreateImagePipeSurfaceFUCHSIA)},
+#else
+    {"CreateImagePipeSurfaceFUCHSIA", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_FUCHSIA
+    {"EnumerateDeviceExtensionProperties", offsetof(VkLayerInstanceDispatchTable, EnumerateDeviceExtensionProperties)},
+#ifdef VK_USE_PLATFORM_WAYLAND_KHR
+    {"GetPhysicalDeviceWaylandPresentationSupportKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceWaylandPresentationSupportKHR)},
+#else
+    {"GetPhysicalDeviceWaylandPresentationSupportKHR", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_WAYLAND_KHR
+#ifdef VK_USE_PLATFORM_METAL_EXT
+    {"CreateMetalSurfaceEXT", offsetof(VkLayerInstanceDispatchTable, CreateMetalSurfaceEXT)},
+#else
+    {"CreateMetalSurfaceEXT", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_METAL_EXT
+    {"GetPhysicalDeviceExternalImageFormatPropertiesNV", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceExternalImageFormatPropertiesNV)},
+    {"CreateDebugUtilsMessengerEXT", offsetof(VkLayerInstanceDispatchTable, CreateDebugUtilsMessengerEXT)},
+    {"DestroyDebugReportCallbackEXT", offsetof(VkLayerInstanceDispatchTable, DestroyDebugReportCallbackEXT)},
+    {"GetPhysicalDeviceSurfaceFormatsKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSurfaceFormatsKHR)},
+    {"EnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR", offsetof(VkLayerInstanceDispatchTable, EnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR)},
+#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
+    {"AcquireXlibDisplayEXT", offsetof(VkLayerInstanceDispatchTable, AcquireXlibDisplayEXT)},
+#else
+    {"AcquireXlibDisplayEXT", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_XLIB_XRANDR_EXT
+#ifdef VK_USE_PLATFORM_XLIB_KHR
+    {"GetPhysicalDeviceXlibPresentationSupportKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceXlibPresentationSupportKHR)},
+#else
+    {"GetPhysicalDeviceXlibPresentationSupportKHR", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_XLIB_KHR
+    {"GetPhysicalDeviceExternalSemaphoreProperties", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceExternalSemaphoreProperties)},
+    {"GetDisplayPlaneSupportedDisplaysKHR", offsetof(VkLayerInstanceDispatchTable, GetDisplayPlaneSupportedDisplaysKHR)},
+    {"GetPhysicalDeviceProperties2", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceProperties2)},
+#ifdef VK_USE_PLATFORM_ANDROID_KHR
+    {"CreateAndroidSurfaceKHR", offsetof(VkLayerInstanceDispatchTable, CreateAndroidSurfaceKHR)},
+#else
+    {"CreateAndroidSurfaceKHR", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_ANDROID_KHR
+    {"GetPhysicalDeviceCooperativeMatrixPropertiesNV", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceCooperativeMatrixPropertiesNV)},
+    {"GetPhysicalDeviceSparseImageFormatProperties2KHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSparseImageFormatProperties2KHR)},
+    {"EnumeratePhysicalDeviceGroupsKHR", offsetof(VkLayerInstanceDispatchTable, EnumeratePhysicalDeviceGroupsKHR)},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "GetDeviceGroupSurfacePresentModes2EXT")) return (void *)table->GetDeviceGroupSurfacePresentModes2EXT;
+    {"GetPhysicalDeviceWin32PresentationSupportKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceWin32PresentationSupportKHR)},
+#else
+    {"GetPhysicalDeviceWin32PresentationSupportKHR", LOADER_DISPATCH_NO_OFFSET},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"DestroyInstance", offsetof(VkLayerInstanceDispatchTable, DestroyInstance)},
+    {"GetPhysicalDeviceSurfaceFormats2KHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSurfaceFormats2KHR)},
+    {"SubmitDebugUtilsMessageEXT", offsetof(VkLayerInstanceDispatchTable, SubmitDebugUtilsMessageEXT)},
+#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
+    {"GetRandROutputDisplayEXT", offsetof(VkLayerInstanceDispatchTable, GetRandROutputDisplayEXT)},
+#else
+    {"GetRandROutputDisplayEXT", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_XLIB_XRANDR_EXT
+    {"GetPhysicalDeviceSparseImageFormatProperties2", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSparseImageFormatProperties2)},
+    {"CreateDisplayModeKHR", offsetof(VkLayerInstanceDispatchTable, CreateDisplayModeKHR)},
+    {"GetPhysicalDeviceSurfaceCapabilitiesKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSurfaceCapabilitiesKHR)},
+    {"DestroySurfaceKHR", offsetof(VkLayerInstanceDispatchTable, DestroySurfaceKHR)},
+#ifdef VK_USE_PLATFORM_VI_NN
+    {"CreateViSurfaceNN", offsetof(VkLayerInstanceDispatchTable, CreateViSurfaceNN)},
+#else
+    {"CreateViSurfaceNN", LOADER_DISPATCH_NO_OFFSET},
+#endif // VK_USE_PLATFORM_VI_NN
+    {"GetPhysicalDeviceDisplayPlanePropertiesKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceDisplayPlanePropertiesKHR)},
+    {"GetPhysicalDeviceToolPropertiesEXT", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceToolPropertiesEXT)},
+    {"GetPhysicalDeviceGeneratedCommandsPropertiesNVX", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceGeneratedCommandsPropertiesNVX)},
+    {"GetPhysicalDeviceQueueFamilyProperties2", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceQueueFamilyProperties2)},
+    {"GetPhysicalDeviceSurfaceSupportKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSurfaceSupportKHR)},
+    {"GetPhysicalDevicePresentRectanglesKHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDevicePresentRectanglesKHR)},
+    {"GetPhysicalDeviceFormatProperties2KHR", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceFormatProperties2KHR)},
+    {"GetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV)},
+    {"GetDisplayPlaneCapabilitiesKHR", offsetof(VkLayerInstanceDispatchTable, GetDisplayPlaneCapabilitiesKHR)},
+    {"GetPhysicalDeviceMemoryProperties2", offsetof(VkLayerInstanceDispatchTable, GetPhysicalDeviceMemoryProperties2)},
+};
 
-    // ---- VK_EXT_line_rasterization extension commands
-    if (!strcmp(name, "CmdSetLineStippleEXT")) return (void *)table->CmdSetLineStippleEXT;
+#define LOADER_CORE_TRAMPOLINE_NAME_COUNT 174
+
+static const int32_t loader_core_trampoline_name_displacements[LOADER_CORE_TRAMPOLINE_NAME_COUNT] = {
+    0, 1, -8, -9, 0, 2, -10, 3, -18, 2, 0, 2, 0, -21, 2, -23,
+    -26, 0, 1, 2, -28, 0, 0, -29, -30, -31, -33, 0, -34, -35, -36, 0,
+    0, -39, -40, -41, 1, 1, 1, 0, -42, 0, -43, 0, 1, 1, -44, 2,
+    0, 0, 2, 0, 0, 0, 0, -45, 0, -48, 0, 0, 1, 1, -56, -63,
+    -64, -66, 2, 9, -68, -70, -74, -75, -77, 1, 0, -80, 0, -84, 0, -85,
+    -86, 3, 6, -87, 0, 4, 1, 0, 0, 0, 0, -92, 0, -96, 0, 0,
+    -97, -98, 0, 0, 6, 0, -100, 6, -102, 7, 2, 0, -105, 0, -110, -112,
+    1, -114, -115, -120, -121, 0, 3, -122, 1, -124, 0, 1, -125, 0, 2, -127,
+    -129, 0, 0, 0, -131, 0, 0, 2, 1, 0, 0, -133, 4, -136, -137, -138,
+    0, 0, -140, 3, -141, 0, 0, -142, -146, -147, -148, 6, -151, 0, 0, -152,
+    0, -154, -155, -159, 1, -160, -161, 2, 1, 6, 0, -163, -166, -170,
+};
 
-    // ---- VK_EXT_host_query_reset extension commands
-    if (!strcmp(name, "ResetQueryPoolEXT")) return (void *)table->ResetQueryPoolEXT;
+static const struct loader_trampoline_name_entry loader_core_trampoline_names[LOADER_CORE_TRAMPOLINE_NAME_COUNT] = {
+    {"ResetCommandBuffer", (void *)vkResetCommandBuffer},
+    {"DestroyPipelineLayout", (void *)vkDestroyPipelineLayout},
+    {"CreateImageView", (void *)vkCreateImageView},
+    {"BindBufferMemory2", (void *)vkBindBufferMemory2},
+    {"EnumeratePhysicalDeviceGroups", (void *)vkEnumeratePhysicalDeviceGroups},
+    {"InvalidateMappedMemoryRanges", (void *)vkInvalidateMappedMemoryRanges},
+    {"GetPipelineCacheData", (void *)vkGetPipelineCacheData},
+    {"ResetEvent", (void *)vkResetEvent},
+    {"GetPhysicalDeviceProperties2", (void *)vkGetPhysicalDeviceProperties2},
+    {"GetPhysicalDeviceMemoryProperties", (void *)vkGetPhysicalDeviceMemoryProperties},
+    {"CmdBeginRenderPass", (void *)vkCmdBeginRenderPass},
+    {"FreeMemory", (void *)vkFreeMemory},
+    {"DestroyEvent", (void *)vkDestroyEvent},
+    {"CreateFence", (void *)vkCreateFence},
+    {"CmdFillBuffer", (void *)vkCmdFillBuffer},
+    {"BindImageMemory", (void *)vkBindImageMemory},
+    {"BindImageMemory2", (void *)vkBindImageMemory2},
+    {"GetPhysicalDeviceMemoryProperties2", (void *)vkGetPhysicalDeviceMemoryProperties2},
+    {"GetDeviceGroupPeerMemoryFeatures", (void *)vkGetDeviceGroupPeerMemoryFeatures},
+    {"BindBufferMemory", (void *)vkBindBufferMemory},
+    {"GetPhysicalDeviceExternalFenceProperties", (void *)vkGetPhysicalDeviceExternalFenceProperties},
+    {"GetPhysicalDeviceFeatures", (void *)vkGetPhysicalDeviceFeatures},
+    {"DestroyDescriptorUpdateTemplate", (void *)vkDestroyDescriptorUpdateTemplate},
+    {"CreateBufferView", (void *)vkCreateBufferView},
+    {"AllocateMemory", (void *)vkAllocateMemory},
+    {"CmdPushConstants", (void *)vkCmdPushConstants},
+    {"CmdSetStencilReference", (void *)vkCmdSetStencilReference},
+    {"ResetFences", (void *)vkResetFences},
+    {"GetPhysicalDeviceFeatures2", (void *)vkGetPhysicalDeviceFeatures2},
+    {"CreateRenderPass2", (void *)vkCreateRenderPass2},
+    {"CmdSetViewport", (void *)vkCmdSetViewport},
+    {"CreateDevice", (void *)vkCreateDevice},
+    {"DestroyInstance", (void *)vkDestroyInstance},
+    {"GetDeviceQueue2", (void *)vkGetDeviceQueue2},
+    {"UnmapMemory", (void *)vkUnmapMemory},
+    {"CmdBeginQuery", (void *)vkCmdBeginQuery},
+    {"CmdNextSubpass", (void *)vkCmdNextSubpass},
+    {"BeginCommandBuffer", (void *)vkBeginCommandBuffer},
+    {"FreeCommandBuffers", (void *)vkFreeCommandBuffers},
+    {"CmdCopyBufferToImage", (void *)vkCmdCopyBufferToImage},
+    {"DestroyDevice", (void *)vkDestroyDevice},
+    {"GetBufferMemoryRequirements", (void *)vkGetBufferMemoryRequirements},
+    {"CmdExecuteCommands", (void *)vkCmdExecuteCommands},
+    {"CmdUpdateBuffer", (void *)vkCmdUpdateBuffer},
+    {"GetImageSparseMemoryRequirements", (void *)vkGetImageSparseMemoryRequirements},
+    {"CmdCopyImage", (void *)vkCmdCopyImage},
+    {"ResetDescriptorPool", (void *)vkResetDescriptorPool},
+    {"CreateGraphicsPipelines", (void *)vkCreateGraphicsPipelines},
+    {"DestroyImageView", (void *)vkDestroyImageView},
+    {"UpdateDescriptorSetWithTemplate", (void *)vkUpdateDescriptorSetWithTemplate},
+    {"QueueWaitIdle", (void *)vkQueueWaitIdle},
+    {"DestroyCommandPool", (void *)vkDestroyCommandPool},
+    {"GetPhysicalDeviceFormatProperties", (void *)vkGetPhysicalDeviceFormatProperties},
+    {"CmdSetDepthBias", (void *)vkCmdSetDepthBias},
+    {"CmdDrawIndexedIndirect", (void *)vkCmdDrawIndexedIndirect},
+    {"MergePipelineCaches", (void *)vkMergePipelineCaches},
+    {"CmdClearColorImage", (void *)vkCmdClearColorImage},
+    {"DestroyPipelineCache", (void *)vkDestroyPipelineCache},
+    {"AllocateCommandBuffers", (void *)vkAllocateCommandBuffers},
+    {"CmdNextSubpass2", (void *)vkCmdNextSubpass2},
+    {"QueueBindSparse", (void *)vkQueueBindSparse},
+    {"DestroySamplerYcbcrConversion", (void *)vkDestroySamplerYcbcrConversion},
+    {"EnumerateDeviceExtensionProperties", (void *)vkEnumerateDeviceExtensionProperties},
+    {"CreateRenderPass", (void *)vkCreateRenderPass},
+    {"EnumeratePhysicalDevices", (void *)vkEnumeratePhysicalDevices},
+    {"DestroyQueryPool", (void *)vkDestroyQueryPool},
+    {"CreateQueryPool", (void *)vkCreateQueryPool},
+    {"DestroyBufferView", (void *)vkDestroyBufferView},
+    {"CmdDrawIndexedIndirectCount", (void *)vkCmdDrawIndexedIndirectCount},
+    {"CreatePipelineCache", (void *)vkCreatePipelineCache},
+    {"DestroyDescriptorSetLayout", (void *)vkDestroyDescriptorSetLayout},
+    {"CmdClearAttachments", (void *)vkCmdClearAttachments},
+    {"CmdCopyBuffer", (void *)vkCmdCopyBuffer},
+    {"TrimCommandPool", (void *)vkTrimCommandPool},
+    {"DestroyBuffer", (void *)vkDestroyBuffer},
+    {"CmdBeginRenderPass2", (void *)vkCmdBeginRenderPass2},
+    {"DestroyFence", (void *)vkDestroyFence},
+    {"GetPhysicalDeviceQueueFamilyProperties2", (void *)vkGetPhysicalDeviceQueueFamilyProperties2},
+    {"DestroyDescriptorPool", (void *)vkDestroyDescriptorPool},
+    {"GetPhysicalDeviceSparseImageFormatProperties", (void *)vkGetPhysicalDeviceSparseImageFormatProperties},
+    {"GetPhysicalDeviceExternalSemaphoreProperties", (void *)vkGetPhysicalDeviceExternalSemaphoreProperties},
+    {"CmdSetEvent", (void *)vkCmdSetEvent},
+    {"CmdEndRenderPass2", (void *)vkCmdEndRenderPass2},
+    {"SetEvent", (void *)vkSetEvent},
+    {"CmdDispatchIndirect", (void *)vkCmdDispatchIndirect},
+    {"CmdResolveImage", (void *)vkCmdResolveImage},
+    {"GetPhysicalDeviceProperties", (void *)vkGetPhysicalDeviceProperties},
+    {"DestroySemaphore", (void *)vkDestroySemaphore},
+    {"CmdBlitImage", (void *)vkCmdBlitImage},
+    {"FlushMappedMemoryRanges", (void *)vkFlushMappedMemoryRanges},
+    {"GetDeviceQueue", (void *)vkGetDeviceQueue},
+    {"CreateDescriptorUpdateTemplate", (void *)vkCreateDescriptorUpdateTemplate},
+    {"MapMemory", (void *)vkMapMemory},
+    {"CmdCopyQueryPoolResults", (void *)vkCmdCopyQueryPoolResults},
+    {"GetDeviceProcAddr", (void *)vkGetDeviceProcAddr},
+    {"CmdDrawIndirect", (void *)vkCmdDrawIndirect},
+    {"CmdResetEvent", (void *)vkCmdResetEvent},
+    {"GetDescriptorSetLayoutSupport", (void *)vkGetDescriptorSetLayoutSupport},
+    {"CmdEndQuery", (void *)vkCmdEndQuery},
+    {"CmdDispatchBase", (void *)vkCmdDispatchBase},
+    {"CmdPipelineBarrier", (void *)vkCmdPipelineBarrier},
+    {"DestroyFramebuffer", (void *)vkDestroyFramebuffer},
+    {"CmdSetDeviceMask", (void *)vkCmdSetDeviceMask},
+    {"DeviceWaitIdle", (void *)vkDeviceWaitIdle},
+    {"CmdResetQueryPool", (void *)vkCmdResetQueryPool},
+    {"CreateCommandPool", (void *)vkCreateCommandPool},
+    {"CmdSetStencilCompareMask", (void *)vkCmdSetStencilCompareMask},
+    {"DestroyShaderModule", (void *)vkDestroyShaderModule},
+    {"GetPhysicalDeviceQueueFamilyProperties", (void *)vkGetPhysicalDeviceQueueFamilyProperties},
+    {"CmdDrawIndexed", (void *)vkCmdDrawIndexed},
+    {"GetImageSparseMemoryRequirements2", (void *)vkGetImageSparseMemoryRequirements2},
+    {"CreateEvent", (void *)vkCreateEvent},
+    {"CmdDispatch", (void *)vkCmdDispatch},
+    {"CreateSampler", (void *)vkCreateSampler},
+    {"GetFenceStatus", (void *)vkGetFenceStatus},
+    {"CmdBindDescriptorSets", (void *)vkCmdBindDescriptorSets},
+    {"CmdEndRenderPass", (void *)vkCmdEndRenderPass},
+    {"GetImageMemoryRequirements", (void *)vkGetImageMemoryRequirements},
+    {"GetImageSubresourceLayout", (void *)vkGetImageSubresourceLayout},
+    {"CmdWaitEvents", (void *)vkCmdWaitEvents},
+    {"CreateImage", (void *)vkCreateImage},
+    {"ResetCommandPool", (void *)vkResetCommandPool},
+    {"CmdBindVertexBuffers", (void *)vkCmdBindVertexBuffers},
+    {"CmdSetBlendConstants", (void *)vkCmdSetBlendConstants},
+    {"CmdSetStencilWriteMask", (void *)vkCmdSetStencilWriteMask},
+    {"GetPhysicalDeviceSparseImageFormatProperties2", (void *)vkGetPhysicalDeviceSparseImageFormatProperties2},
+    {"FreeDescriptorSets", (void *)vkFreeDescriptorSets},
+    {"GetBufferDeviceAddress", (void *)vkGetBufferDeviceAddress},
+    {"ResetQueryPool", (void *)vkResetQueryPool},
+    {"CmdBindIndexBuffer", (void *)vkCmdBindIndexBuffer},
+    {"QueueSubmit", (void *)vkQueueSubmit},
+    {"CmdSetScissor", (void *)vkCmdSetScissor},
+    {"CmdSetDepthBounds", (void *)vkCmdSetDepthBounds},
+    {"GetEventStatus", (void *)vkGetEventStatus},
+    {"CreateSemaphore", (void *)vkCreateSemaphore},
+    {"GetDeviceMemoryOpaqueCaptureAddress", (void *)vkGetDeviceMemoryOpaqueCaptureAddress},
+    {"GetRenderAreaGranularity", (void *)vkGetRenderAreaGranularity},
+    {"SignalSemaphore", (void *)vkSignalSemaphore},
+    {"CmdClearDepthStencilImage", (void *)vkCmdClearDepthStencilImage},
+    {"CreateShaderModule", (void *)vkCreateShaderModule},
+    {"CmdBindPipeline", (void *)vkCmdBindPipeline},
+    {"DestroyPipeline", (void *)vkDestroyPipeline},
+    {"UpdateDescriptorSets", (void *)vkUpdateDescriptorSets},
+    {"GetImageMemoryRequirements2", (void *)vkGetImageMemoryRequirements2},
+    {"CreateDescriptorPool", (void *)vkCreateDescriptorPool},
+    {"GetPhysicalDeviceExternalBufferProperties", (void *)vkGetPhysicalDeviceExternalBufferProperties},
+    {"CreateBuffer", (void *)vkCreateBuffer},
+    {"CreateSamplerYcbcrConversion", (void *)vkCreateSamplerYcbcrConversion},
+    {"WaitForFences", (void *)vkWaitForFences},
+    {"GetBufferMemoryRequirements2", (void *)vkGetBufferMemoryRequirements2},
+    {"CreateFramebuffer", (void *)vkCreateFramebuffer},
+    {"WaitSemaphores", (void *)vkWaitSemaphores},
+    {"DestroyImage", (void *)vkDestroyImage},
+    {"GetDeviceMemoryCommitment", (void *)vkGetDeviceMemoryCommitment},
+    {"DestroyRenderPass", (void *)vkDestroyRenderPass},
+    {"GetQueryPoolResults", (void *)vkGetQueryPoolResults},
+    {"CmdDraw", (void *)vkCmdDraw},
+    {"GetPhysicalDeviceFormatProperties2", (void *)vkGetPhysicalDeviceFormatProperties2},
+    {"EnumerateDeviceLayerProperties", (void *)vkEnumerateDeviceLayerProperties},
+    {"EndCommandBuffer", (void *)vkEndCommandBuffer},
+    {"CmdCopyImageToBuffer", (void *)vkCmdCopyImageToBuffer},
+    {"CreateComputePipelines", (void *)vkCreateComputePipelines},
+    {"DestroySampler", (void *)vkDestroySampler},
+    {"CmdSetLineWidth", (void *)vkCmdSetLineWidth},
+    {"CmdWriteTimestamp", (void *)vkCmdWriteTimestamp},
+    {"AllocateDescriptorSets", (void *)vkAllocateDescriptorSets},
+    {"GetPhysicalDeviceImageFormatProperties2", (void *)vkGetPhysicalDeviceImageFormatProperties2},
+    {"CreateDescriptorSetLayout", (void *)vkCreateDescriptorSetLayout},
+    {"GetSemaphoreCounterValue", (void *)vkGetSemaphoreCounterValue},
+    {"GetInstanceProcAddr", (void *)vkGetInstanceProcAddr},
+    {"GetBufferOpaqueCaptureAddress", (void *)vkGetBufferOpaqueCaptureAddress},
+    {"CmdDrawIndirectCount", (void *)vkCmdDrawIndirectCount},
+    {"CreatePipelineLayout", (void *)vkCreatePipelineLayout},
+    {"GetPhysicalDeviceImageFormatProperties", (void *)vkGetPhysicalDeviceImageFormatProperties},
+};
+
+// Device command lookup function
+VKAPI_ATTR void* VKAPI_CALL loader_lookup_device_dispatch_table(const VkLayerDispatchTable *table, const char *name) {
+    if (!name || name[0] != 'v' || name[1] != 'k') return NULL;
 
-    return NULL;
+    name += 2;
+    const struct loader_dispatch_name_entry *entry = &loader_device_names[loader_dispatch_name_slot(
+        loader_device_name_displacements, LOADER_DEVICE_NAME_COUNT, name)];
+    if (strcmp(name, entry->name) || entry->offset == LOADER_DISPATCH_NO_OFFSET) return NULL;
+    return *(void *const *)((const char *)table + entry->offset);
 }
 
 // Instance command lookup function
@@ -1407,283 +1742,98 @@ VKAPI_ATTR void* VKAPI_CALL loader_lookup_instance_dispatch_table(const VkLayerI
         return NULL;
     }
 
+    name += 2;
+    const struct loader_dispatch_name_entry *entry = &loader_instance_names[loader_dispatch_name_slot(
+        loader_instance_name_displacements, LOADER_INSTANCE_NAME_COUNT, name)];
+    if (strcmp(name, entry->name) || entry->offset == LOADER_DISPATCH_NO_OFFSET) {
+        *found_name = false;
+        return NULL;
+    }
+
     *found_name = true;
+    return *(void *const *)((const char *)table + entry->offset);
+}
+
+// Core command trampoline lookup function
+void *loader_lookup_core_trampoline(const char *name) {
+    if (!name || name[0] != 'v' || name[1] != 'k') return NULL;
+
     name += 2;
+    const struct loader_trampoline_name_entry *entry = &loader_core_trampoline_names[loader_dispatch_name_slot(
+        loader_core_trampoline_name_displacements, LOADER_CORE_TRAMPOLINE_NAME_COUNT, name)];
+    if (strcmp(name, entry->name)) return NULL;
+    return entry->addr;
+}
 
-    // ---- Core 1_0 commands
-    if (!strcmp(name, "DestroyInstance")) return (void *)table->DestroyInstance;
-    if (!strcmp(name, "EnumeratePhysicalDevices")) return (void *)table->EnumeratePhysicalDevices;
-    if (!strcmp(name, "GetPhysicalDeviceFeatures")) return (void *)table->GetPhysicalDeviceFeatures;
-    if (!strcmp(name, "GetPhysicalDeviceFormatProperties")) return (void *)table->GetPhysicalDeviceFormatProperties;
-    if (!strcmp(name, "GetPhysicalDeviceImageFormatProperties")) return (void *)table->GetPhysicalDeviceImageFormatProperties;
-    if (!strcmp(name, "GetPhysicalDeviceProperties")) return (void *)table->GetPhysicalDeviceProperties;
-    if (!strcmp(name, "GetPhysicalDeviceQueueFamilyProperties")) return (void *)table->GetPhysicalDeviceQueueFamilyProperties;
-    if (!strcmp(name, "GetPhysicalDeviceMemoryProperties")) return (void *)table->GetPhysicalDeviceMemoryProperties;
-    if (!strcmp(name, "GetInstanceProcAddr")) return (void *)table->GetInstanceProcAddr;
-    if (!strcmp(name, "EnumerateDeviceExtensionProperties")) return (void *)table->EnumerateDeviceExtensionProperties;
-    if (!strcmp(name, "EnumerateDeviceLayerProperties")) return (void *)table->EnumerateDeviceLayerProperties;
-    if (!strcmp(name, "GetPhysicalDeviceSparseImageFormatProperties")) return (void *)table->GetPhysicalDeviceSparseImageFormatProperties;
 
-    // ---- Core 1_1 commands
-    if (!strcmp(name, "EnumeratePhysicalDeviceGroups")) return (void *)table->EnumeratePhysicalDeviceGroups;
-    if (!strcmp(name, "GetPhysicalDeviceFeatures2")) return (void *)table->GetPhysicalDeviceFeatures2;
-    if (!strcmp(name, "GetPhysicalDeviceProperties2")) return (void *)table->GetPhysicalDeviceProperties2;
-    if (!strcmp(name, "GetPhysicalDeviceFormatProperties2")) return (void *)table->GetPhysicalDeviceFormatProperties2;
-    if (!strcmp(name, "GetPhysicalDeviceImageFormatProperties2")) return (void *)table->GetPhysicalDeviceImageFormatProperties2;
-    if (!strcmp(name, "GetPhysicalDeviceQueueFamilyProperties2")) return (void *)table->GetPhysicalDeviceQueueFamilyProperties2;
-    if (!strcmp(name, "GetPhysicalDeviceMemoryProperties2")) return (void *)table->GetPhysicalDeviceMemoryProperties2;
-    if (!strcmp(name, "GetPhysicalDeviceSparseImageFormatProperties2")) return (void *)table->GetPhysicalDeviceSparseImageFormatProperties2;
-    if (!strcmp(name, "GetPhysicalDeviceExternalBufferProperties")) return (void *)table->GetPhysicalDeviceExternalBufferProperties;
-    if (!strcmp(name, "GetPhysicalDeviceExternalFenceProperties")) return (void *)table->GetPhysicalDeviceExternalFenceProperties;
-    if (!strcmp(name, "GetPhysicalDeviceExternalSemaphoreProperties")) return (void *)table->GetPhysicalDeviceExternalSemaphoreProperties;
+// ---- VK_KHR_device_group extension trampoline/terminators
 
-    // ---- VK_KHR_surface extension commands
-    if (!strcmp(name, "DestroySurfaceKHR")) return (void *)table->DestroySurfaceKHR;
-    if (!strcmp(name, "GetPhysicalDeviceSurfaceSupportKHR")) return (void *)table->GetPhysicalDeviceSurfaceSupportKHR;
-    if (!strcmp(name, "GetPhysicalDeviceSurfaceCapabilitiesKHR")) return (void *)table->GetPhysicalDeviceSurfaceCapabilitiesKHR;
-    if (!strcmp(name, "GetPhysicalDeviceSurfaceFormatsKHR")) return (void *)table->GetPhysicalDeviceSurfaceFormatsKHR;
-    if (!strcmp(name, "GetPhysicalDeviceSurfacePresentModesKHR")) return (void *)table->GetPhysicalDeviceSurfacePresentModesKHR;
+VKAPI_ATTR void VKAPI_CALL GetDeviceGroupPeerMemoryFeaturesKHR(
+    VkDevice                                    device,
+    uint32_t                                    heapIndex,
+    uint32_t                                    localDeviceIndex,
+    uint32_t                                    remoteDeviceIndex,
+    VkPeerMemoryFeatureFlags*                   pPeerMemoryFeatures) {
+    const VkLayerDispatchTable *disp = loader_get_dispatch(device);
+    disp->GetDeviceGroupPeerMemoryFeaturesKHR(device, heapIndex, localDeviceIndex, remoteDeviceIndex, pPeerMemoryFeatures);
+}
 
-    // ---- VK_KHR_swapchain extension commands
-    if (!strcmp(name, "GetPhysicalDevicePresentRectanglesKHR")) return (void *)table->GetPhysicalDevicePresentRectanglesKHR;
+VKAPI_ATTR void VKAPI_CALL CmdSetDeviceMaskKHR(
+    VkCommandBuffer                             commandBuffer,
+    uint32_t                                    deviceMask) {
+    const VkLayerDispatchTable *disp = loader_get_dispatch(commandBuffer);
+    disp->CmdSetDeviceMaskKHR(commandBuffer, deviceMask);
+}
 
-    // ---- VK_KHR_display extension commands
-    if (!strcmp(name, "GetPhysicalDeviceDisplayPropertiesKHR")) return (void *)table->GetPhysicalDeviceDisplayPropertiesKHR;
-    if (!strcmp(name, "GetPhysicalDeviceDisplayPlanePropertiesKHR")) return (void *)table->GetPhysicalDeviceDisplayPlanePropertiesKHR;
-    if (!strcmp(name, "GetDisplayPlaneSupportedDisplaysKHR")) return (void *)table->GetDisplayPlaneSupportedDisplaysKHR;
-    if (!strcmp(name, "GetDisplayModePropertiesKHR")) return (void *)table->GetDisplayModePropertiesKHR;
-    if (!strcmp(name, "CreateDisplayModeKHR")) return (void *)table->CreateDisplayModeKHR;
-    if (!strcmp(name, "GetDisplayPlaneCapabilitiesKHR")) return (void *)table->GetDisplayPlaneCapabilitiesKHR;
-    if (!strcmp(name, "CreateDisplayPlaneSurfaceKHR")) return (void *)table->CreateDisplayPlaneSurfaceKHR;
+VKAPI_ATTR void VKAPI_CALL CmdDispatchBaseKHR(
+    VkCommandBuffer                             commandBuffer,
+    uint32_t                                    baseGroupX,
+    uint32_t                                    baseGroupY,
+    uint32_t                                    baseGroupZ,
+    uint32_t                                    groupCountX,
+    uint32_t                                    groupCountY,
+    uint32_t                                    groupCountZ) {
+    const VkLayerDispatchTable *disp = loader_get_dispatch(commandBuffer);
+    disp->CmdDispatchBaseKHR(commandBuffer, baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ);
+}
 
-    // ---- VK_KHR_xlib_surface extension commands
-#ifdef VK_USE_PLATFORM_XLIB_KHR
-    if (!strcmp(name, "CreateXlibSurfaceKHR")) return (void *)table->CreateXlibSurfaceKHR;
-#endif // VK_USE_PLATFORM_XLIB_KHR
-#ifdef VK_USE_PLATFORM_XLIB_KHR
-    if (!strcmp(name, "GetPhysicalDeviceXlibPresentationSupportKHR")) return (void *)table->GetPhysicalDeviceXlibPresentationSupportKHR;
-#endif // VK_USE_PLATFORM_XLIB_KHR
 
-    // ---- VK_KHR_xcb_surface extension commands
-#ifdef VK_USE_PLATFORM_XCB_KHR
-    if (!strcmp(name, "CreateXcbSurfaceKHR")) return (void *)table->CreateXcbSurfaceKHR;
-#endif // VK_USE_PLATFORM_XCB_KHR
-#ifdef VK_USE_PLATFORM_XCB_KHR
-    if (!strcmp(name, "GetPhysicalDeviceXcbPresentationSupportKHR")) return (void *)table->GetPhysicalDeviceXcbPresentationSupportKHR;
-#endif // VK_USE_PLATFORM_XCB_KHR
+// ---- VK_KHR_maintenance1 extension trampoline/terminators
 
-    // ---- VK_KHR_wayland_surface extension commands
-#ifdef VK_USE_PLATFORM_WAYLAND_KHR
-    if (!strcmp(name, "CreateWaylandSurfaceKHR")) return (void *)table->CreateWaylandSurfaceKHR;
-#endif // VK_USE_PLATFORM_WAYLAND_KHR
-#ifdef VK_USE_PLATFORM_WAYLAND_KHR
-    if (!strcmp(name, "GetPhysicalDeviceWaylandPresentationSupportKHR")) return (void *)table->GetPhysicalDeviceWaylandPresentationSupportKHR;
-#endif // VK_USE_PLATFORM_WAYLAND_KHR
+VKAPI_ATTR void VKAPI_CALL TrimCommandPoolKHR(
+    VkDevice                                    device,
+    VkCommandPool                               commandPool,
+    VkCommandPoolTrimFlags                      flags) {
+    const VkLayerDispatchTable *disp = loader_get_dispatch(device);
+    disp->TrimCommandPoolKHR(device, commandPool, flags);
+}
 
-    // ---- VK_KHR_android_surface extension commands
-#ifdef VK_USE_PLATFORM_ANDROID_KHR
-    if (!strcmp(name, "CreateAndroidSurfaceKHR")) return (void *)table->CreateAndroidSurfaceKHR;
-#endif // VK_USE_PLATFORM_ANDROID_KHR
 
-    // ---- VK_KHR_win32_surface extension commands
+// ---- VK_KHR_external_memory_win32 extension trampoline/terminators
+
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "CreateWin32SurfaceKHR")) return (void *)table->CreateWin32SurfaceKHR;
+VKAPI_ATTR VkResult VKAPI_CALL GetMemoryWin32HandleKHR(
+    VkDevice                                    device,
+    const VkMemoryGetWin32HandleInfoKHR*        pGetWin32HandleInfo,
+    HANDLE*                                     pHandle) {
+    const VkLayerDispatchTable *disp = loader_get_dispatch(device);
+    return disp->GetMemoryWin32HandleKHR(device, pGetWin32HandleInfo, pHandle);
+}
+
 #endif // VK_USE_PLATFORM_WIN32_KHR
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "GetPhysicalDeviceWin32PresentationSupportKHR")) return (void *)table->GetPhysicalDeviceWin32PresentationSupportKHR;
+VKAPI_ATTR VkResult VKAPI_CALL GetMemoryWin32HandlePropertiesKHR(
+    VkDevice                                    device,
+    VkExternalMemoryHandleTypeFlagBits          handleType,
+    HANDLE                                      handle,
+    VkMemoryWin32HandlePropertiesKHR*           pMemoryWin32HandleProperties) {
+    const VkLayerDispatchTable *disp = loader_get_dispatch(device);
+    return disp->GetMemoryWin32HandlePropertiesKHR(device, handleType, handle, pMemoryWin32HandleProperties);
+}
+
 #endif // VK_USE_PLATFORM_WIN32_KHR
 
-    // ---- VK_KHR_get_physical_device_properties2 extension commands
-    if (!strcmp(name, "GetPhysicalDeviceFeatures2KHR")) return (void *)table->GetPhysicalDeviceFeatures2KHR;
-    if (!strcmp(name, "GetPhysicalDeviceProperties2KHR")) return (void *)table->GetPhysicalDeviceProperties2KHR;
-    if (!strcmp(name, "GetPhysicalDeviceFormatProperties2KHR")) return (void *)table->GetPhysicalDeviceFormatProperties2KHR;
-    if (!strcmp(name, "GetPhysicalDeviceImageFormatProperties2KHR")) return (void *)table->GetPhysicalDeviceImageFormatProperties2KHR;
-    if (!strcmp(name, "GetPhysicalDeviceQueueFamilyProperties2KHR")) return (void *)table->GetPhysicalDeviceQueueFamilyProperties2KHR;
-    if (!strcmp(name, "GetPhysicalDeviceMemoryProperties2KHR")) return (void *)table->GetPhysicalDeviceMemoryProperties2KHR;
-    if (!strcmp(name, "GetPhysicalDeviceSparseImageFormatProperties2KHR")) return (void *)table->GetPhysicalDeviceSparseImageFormatProperties2KHR;
-
-    // ---- VK_KHR_device_group_creation extension commands
-    if (!strcmp(name, "EnumeratePhysicalDeviceGroupsKHR")) return (void *)table->EnumeratePhysicalDeviceGroupsKHR;
-
-    // ---- VK_KHR_external_memory_capabilities extension commands
-    if (!strcmp(name, "GetPhysicalDeviceExternalBufferPropertiesKHR")) return (void *)table->GetPhysicalDeviceExternalBufferPropertiesKHR;
-
-    // ---- VK_KHR_external_semaphore_capabilities extension commands
-    if (!strcmp(name, "GetPhysicalDeviceExternalSemaphorePropertiesKHR")) return (void *)table->GetPhysicalDeviceExternalSemaphorePropertiesKHR;
-
-    // ---- VK_KHR_external_fence_capabilities extension commands
-    if (!strcmp(name, "GetPhysicalDeviceExternalFencePropertiesKHR")) return (void *)table->GetPhysicalDeviceExternalFencePropertiesKHR;
-
-    // ---- VK_KHR_performance_query extension commands
-    if (!strcmp(name, "EnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR")) return (void *)table->EnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR;
-    if (!strcmp(name, "GetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR")) return (void *)table->GetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR;
-
-    // ---- VK_KHR_get_surface_capabilities2 extension commands
-    if (!strcmp(name, "GetPhysicalDeviceSurfaceCapabilities2KHR")) return (void *)table->GetPhysicalDeviceSurfaceCapabilities2KHR;
-    if (!strcmp(name, "GetPhysicalDeviceSurfaceFormats2KHR")) return (void *)table->GetPhysicalDeviceSurfaceFormats2KHR;
-
-    // ---- VK_KHR_get_display_properties2 extension commands
-    if (!strcmp(name, "GetPhysicalDeviceDisplayProperties2KHR")) return (void *)table->GetPhysicalDeviceDisplayProperties2KHR;
-    if (!strcmp(name, "GetPhysicalDeviceDisplayPlaneProperties2KHR")) return (void *)table->GetPhysicalDeviceDisplayPlaneProperties2KHR;
-    if (!strcmp(name, "GetDisplayModeProperties2KHR")) return (void *)table->GetDisplayModeProperties2KHR;
-    if (!strcmp(name, "GetDisplayPlaneCapabilities2KHR")) return (void *)table->GetDisplayPlaneCapabilities2KHR;
-
-    // ---- VK_EXT_debug_report extension commands
-    if (!strcmp(name, "CreateDebugReportCallbackEXT")) return (void *)table->CreateDebugReportCallbackEXT;
-    if (!strcmp(name, "DestroyDebugReportCallbackEXT")) return (void *)table->DestroyDebugReportCallbackEXT;
-    if (!strcmp(name, "DebugReportMessageEXT")) return (void *)table->DebugReportMessageEXT;
-
-    // ---- VK_GGP_stream_descriptor_surface extension commands
-#ifdef VK_USE_PLATFORM_GGP
-    if (!strcmp(name, "CreateStreamDescriptorSurfaceGGP")) return (void *)table->CreateStreamDescriptorSurfaceGGP;
-#endif // VK_USE_PLATFORM_GGP
-
-    // ---- VK_NV_external_memory_capabilities extension commands
-    if (!strcmp(name, "GetPhysicalDeviceExternalImageFormatPropertiesNV")) return (void *)table->GetPhysicalDeviceExternalImageFormatPropertiesNV;
-
-    // ---- VK_NN_vi_surface extension commands
-#ifdef VK_USE_PLATFORM_VI_NN
-    if (!strcmp(name, "CreateViSurfaceNN")) return (void *)table->CreateViSurfaceNN;
-#endif // VK_USE_PLATFORM_VI_NN
-
-    // ---- VK_NVX_device_generated_commands extension commands
-    if (!strcmp(name, "GetPhysicalDeviceGeneratedCommandsPropertiesNVX")) return (void *)table->GetPhysicalDeviceGeneratedCommandsPropertiesNVX;
-
-    // ---- VK_EXT_direct_mode_display extension commands
-    if (!strcmp(name, "ReleaseDisplayEXT")) return (void *)table->ReleaseDisplayEXT;
-
-    // ---- VK_EXT_acquire_xlib_display extension commands
-#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
-    if (!strcmp(name, "AcquireXlibDisplayEXT")) return (void *)table->AcquireXlibDisplayEXT;
-#endif // VK_USE_PLATFORM_XLIB_XRANDR_EXT
-#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
-    if (!strcmp(name, "GetRandROutputDisplayEXT")) return (void *)table->GetRandROutputDisplayEXT;
-#endif // VK_USE_PLATFORM_XLIB_XRANDR_EXT
-
-    // ---- VK_EXT_display_surface_counter extension commands
-    if (!strcmp(name, "GetPhysicalDeviceSurfaceCapabilities2EXT")) return (void *)table->GetPhysicalDeviceSurfaceCapabilities2EXT;
-
-    // ---- VK_MVK_ios_surface extension commands
-#ifdef VK_USE_PLATFORM_IOS_MVK
-    if (!strcmp(name, "CreateIOSSurfaceMVK")) return (void *)table->CreateIOSSurfaceMVK;
-#endif // VK_USE_PLATFORM_IOS_MVK
-
-    // ---- VK_MVK_macos_surface extension commands
-#ifdef VK_USE_PLATFORM_MACOS_MVK
-    if (!strcmp(name, "CreateMacOSSurfaceMVK")) return (void *)table->CreateMacOSSurfaceMVK;
-#endif // VK_USE_PLATFORM_MACOS_MVK
-
-    // ---- VK_EXT_debug_utils extension commands
-    if (!strcmp(name, "CreateDebugUtilsMessengerEXT")) return (void *)table->CreateDebugUtilsMessengerEXT;
-    if (!strcmp(name, "DestroyDebugUtilsMessengerEXT")) return (void *)table->DestroyDebugUtilsMessengerEXT;
-    if (!strcmp(name, "SubmitDebugUtilsMessageEXT")) return (void *)table->SubmitDebugUtilsMessageEXT;
-
-    // ---- VK_EXT_sample_locations extension commands
-    if (!strcmp(name, "GetPhysicalDeviceMultisamplePropertiesEXT")) return (void *)table->GetPhysicalDeviceMultisamplePropertiesEXT;
-
-    // ---- VK_EXT_calibrated_timestamps extension commands
-    if (!strcmp(name, "GetPhysicalDeviceCalibrateableTimeDomainsEXT")) return (void *)table->GetPhysicalDeviceCalibrateableTimeDomainsEXT;
-
-    // ---- VK_FUCHSIA_imagepipe_surface extension commands
-#ifdef VK_USE_PLATFORM_FUCHSIA
-    if (!strcmp(name, "CreateImagePipeSurfaceFUCHSIA")) return (void *)table->CreateImagePipeSurfaceFUCHSIA;
-#endif // VK_USE_PLATFORM_FUCHSIA
-
-    // ---- VK_EXT_metal_surface extension commands
-#ifdef VK_USE_PLATFORM_METAL_EXT
-    if (!strcmp(name, "CreateMetalSurfaceEXT")) return (void *)table->CreateMetalSurfaceEXT;
-#endif // VK_USE_PLATFORM_METAL_EXT
-
-    // ---- VK_EXT_tooling_info extension commands
-    if (!strcmp(name, "GetPhysicalDeviceToolPropertiesEXT")) return (void *)table->GetPhysicalDeviceToolPropertiesEXT;
-
-    // ---- VK_NV_cooperative_matrix extension commands
-    if (!strcmp(name, "GetPhysicalDeviceCooperativeMatrixPropertiesNV")) return (void *)table->GetPhysicalDeviceCooperativeMatrixPropertiesNV;
-
-    // ---- VK_NV_coverage_reduction_mode extension commands
-    if (!strcmp(name, "GetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV")) return (void *)table->GetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV;
-
-    // ---- VK_EXT_full_screen_exclusive extension commands
-#ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp(name, "GetPhysicalDeviceSurfacePresentModes2EXT")) return (void *)table->GetPhysicalDeviceSurfacePresentModes2EXT;
-#endif // VK_USE_PLATFORM_WIN32_KHR
-
-    // ---- VK_EXT_headless_surface extension commands
-    if (!strcmp(name, "CreateHeadlessSurfaceEXT")) return (void *)table->CreateHeadlessSurfaceEXT;
-
-    *found_name = false;
-    return NULL;
-}
-
-
-// ---- VK_KHR_device_group extension trampoline/terminators
-
-VKAPI_ATTR void VKAPI_CALL GetDeviceGroupPeerMemoryFeaturesKHR(
-    VkDevice                                    device,
-    uint32_t                                    heapIndex,
-    uint32_t                                    localDeviceIndex,
-    uint32_t                                    remoteDeviceIndex,
-    VkPeerMemoryFeatureFlags*                   pPeerMemoryFeatures) {
-    const VkLayerDispatchTable *disp = loader_get_dispatch(device);
-    disp->GetDeviceGroupPeerMemoryFeaturesKHR(device, heapIndex, localDeviceIndex, remoteDeviceIndex, pPeerMemoryFeatures);
-}
-
-VKAPI_ATTR void VKAPI_CALL CmdSetDeviceMaskKHR(
-    VkCommandBuffer                             commandBuffer,
-    uint32_t                                    deviceMask) {
-    const VkLayerDispatchTable *disp = loader_get_dispatch(commandBuffer);
-    disp->CmdSetDeviceMaskKHR(commandBuffer, deviceMask);
-}
-
-VKAPI_ATTR void VKAPI_CALL CmdDispatchBaseKHR(
-    VkCommandBuffer                             commandBuffer,
-    uint32_t                                    baseGroupX,
-    uint32_t                                    baseGroupY,
-    uint32_t                                    baseGroupZ,
-    uint32_t                                    groupCountX,
-    uint32_t                                    groupCountY,
-    uint32_t                                    groupCountZ) {
-    const VkLayerDispatchTable *disp = loader_get_dispatch(commandBuffer);
-    disp->CmdDispatchBaseKHR(commandBuffer, baseGroupX, baseGroupY, baseGroupZ, groupCountX, groupCountY, groupCountZ);
-}
-
-
-// ---- VK_KHR_maintenance1 extension trampoline/terminators
-
-VKAPI_ATTR void VKAPI_CALL TrimCommandPoolKHR(
-    VkDevice                                    device,
-    VkCommandPool                               commandPool,
-    VkCommandPoolTrimFlags                      flags) {
-    const VkLayerDispatchTable *disp = loader_get_dispatch(device);
-    disp->TrimCommandPoolKHR(device, commandPool, flags);
-}
-
-
-// ---- VK_KHR_external_memory_win32 extension trampoline/terminators
-
-#ifdef VK_USE_PLATFORM_WIN32_KHR
-VKAPI_ATTR VkResult VKAPI_CALL GetMemoryWin32HandleKHR(
-    VkDevice                                    device,
-    const VkMemoryGetWin32HandleInfoKHR*        pGetWin32HandleInfo,
-    HANDLE*                                     pHandle) {
-    const VkLayerDispatchTable *disp = loader_get_dispatch(device);
-    return disp->GetMemoryWin32HandleKHR(device, pGetWin32HandleInfo, pHandle);
-}
-
-#endif // VK_USE_PLATFORM_WIN32_KHR
-#ifdef VK_USE_PLATFORM_WIN32_KHR
-VKAPI_ATTR VkResult VKAPI_CALL GetMemoryWin32HandlePropertiesKHR(
-    VkDevice                                    device,
-    VkExternalMemoryHandleTypeFlagBits          handleType,
-    HANDLE                                      handle,
-    VkMemoryWin32HandlePropertiesKHR*           pMemoryWin32HandleProperties) {
-    const VkLayerDispatchTable *disp = loader_get_dispatch(device);
-    return disp->GetMemoryWin32HandlePropertiesKHR(device, handleType, handle, pMemoryWin32HandleProperties);
-}
-
-#endif // VK_USE_PLATFORM_WIN32_KHR
-
-// ---- VK_KHR_external_memory_fd extension trampoline/terminators
+// ---- VK_KHR_external_memory_fd extension trampoline/terminators
 
 VKAPI_ATTR VkResult VKAPI_CALL GetMemoryFdKHR(
     VkDevice                                    device,
@@ -2166,7 +2316,12 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_DebugMarkerSetObjectTagEXT(
             if (NULL != icd_term && NULL != icd_term->dispatch.CreateSwapchainKHR) {
                 VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)pTagInfo->object;
                 if (NULL != icd_surface->real_icd_surfaces) {
-                    local_tag_info.object = (uint64_t)icd_surface->real_icd_surfaces[icd_index];
+                    VkSurfaceKHR real_icd_surface;
+                    VkResult res = wsi_get_icd_surface(icd_term, icd_surface, icd_index, &real_icd_surface);
+                    if (VK_SUCCESS != res) {
+                        return res;
+                    }
+                    local_tag_info.object = (uint64_t)real_icd_surface;
                 }
             }
         }
@@ -2208,7 +2363,12 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_DebugMarkerSetObjectNameEXT(
             if (NULL != icd_term && NULL != icd_term->dispatch.CreateSwapchainKHR) {
                 VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)pNameInfo->object;
                 if (NULL != icd_surface->real_icd_surfaces) {
-                    local_name_info.object = (uint64_t)icd_surface->real_icd_surfaces[icd_index];
+                    VkSurfaceKHR real_icd_surface;
+                    VkResult res = wsi_get_icd_surface(icd_term, icd_surface, icd_index, &real_icd_surface);
+                    if (VK_SUCCESS != res) {
+                        return res;
+                    }
+                    local_name_info.object = (uint64_t)real_icd_surface;
                 }
             }
         }
@@ -2656,7 +2816,12 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_SetDebugUtilsObjectNameEXT(
             if (NULL != icd_term && NULL != icd_term->dispatch.CreateSwapchainKHR) {
                 VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)pNameInfo->objectHandle;
                 if (NULL != icd_surface->real_icd_surfaces) {
-                    local_name_info.objectHandle = (uint64_t)icd_surface->real_icd_surfaces[icd_index];
+                    VkSurfaceKHR real_icd_surface;
+                    VkResult res = wsi_get_icd_surface(icd_term, icd_surface, icd_index, &real_icd_surface);
+                    if (VK_SUCCESS != res) {
+                        return res;
+                    }
+                    local_name_info.objectHandle = (uint64_t)real_icd_surface;
                 }
             }
         }
@@ -2702,7 +2867,12 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_SetDebugUtilsObjectTagEXT(
             if (NULL != icd_term && NULL != icd_term->dispatch.CreateSwapchainKHR) {
                 VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)pTagInfo->objectHandle;
                 if (NULL != icd_surface->real_icd_surfaces) {
-                    local_tag_info.objectHandle = (uint64_t)icd_surface->real_icd_surfaces[icd_index];
+                    VkSurfaceKHR real_icd_surface;
+                    VkResult res = wsi_get_icd_surface(icd_term, icd_surface, icd_index, &real_icd_surface);
+                    if (VK_SUCCESS != res) {
+                        return res;
+                    }
+                    local_tag_info.objectHandle = (uint64_t)real_icd_surface;
                 }
             }
         }
@@ -3421,915 +3591,340 @@ VKAPI_ATTR void VKAPI_CALL ResetQueryPoolEXT(
     disp->ResetQueryPoolEXT(device, queryPool, firstQuery, queryCount);
 }
 
-// GPA helpers for extensions
-bool extension_instance_gpa(struct loader_instance *ptr_instance, const char *name, void **addr) {
-    *addr = NULL;
-
-
-    // ---- VK_KHR_get_physical_device_properties2 extension commands
-    if (!strcmp("vkGetPhysicalDeviceFeatures2KHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_get_physical_device_properties2 == 1)
-                     ? (void *)vkGetPhysicalDeviceFeatures2
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkGetPhysicalDeviceProperties2KHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_get_physical_device_properties2 == 1)
-                     ? (void *)vkGetPhysicalDeviceProperties2
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkGetPhysicalDeviceFormatProperties2KHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_get_physical_device_properties2 == 1)
-                     ? (void *)vkGetPhysicalDeviceFormatProperties2
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkGetPhysicalDeviceImageFormatProperties2KHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_get_physical_device_properties2 == 1)
-                     ? (void *)vkGetPhysicalDeviceImageFormatProperties2
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkGetPhysicalDeviceQueueFamilyProperties2KHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_get_physical_device_properties2 == 1)
-                     ? (void *)vkGetPhysicalDeviceQueueFamilyProperties2
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkGetPhysicalDeviceMemoryProperties2KHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_get_physical_device_properties2 == 1)
-                     ? (void *)vkGetPhysicalDeviceMemoryProperties2
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkGetPhysicalDeviceSparseImageFormatProperties2KHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_get_physical_device_properties2 == 1)
-                     ? (void *)vkGetPhysicalDeviceSparseImageFormatProperties2
-                     : NULL;
-        return true;
-    }
-
-    // ---- VK_KHR_device_group extension commands
-    if (!strcmp("vkGetDeviceGroupPeerMemoryFeaturesKHR", name)) {
-        *addr = (void *)GetDeviceGroupPeerMemoryFeaturesKHR;
-        return true;
-    }
-    if (!strcmp("vkCmdSetDeviceMaskKHR", name)) {
-        *addr = (void *)CmdSetDeviceMaskKHR;
-        return true;
-    }
-    if (!strcmp("vkCmdDispatchBaseKHR", name)) {
-        *addr = (void *)CmdDispatchBaseKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_maintenance1 extension commands
-    if (!strcmp("vkTrimCommandPoolKHR", name)) {
-        *addr = (void *)TrimCommandPoolKHR;
-        return true;
-    }
+// Extension entry points vkGetInstanceProcAddr hands out, looked up the same way as the dispatch
+// tables.  Commands of instance extensions are only handed out once their extension is enabled.
+enum loader_extension_trampoline_check {
+    LOADER_EXTENSION_TRAMPOLINE_ALWAYS,
+    LOADER_EXTENSION_TRAMPOLINE_KHR_GET_PHYSICAL_DEVICE_PROPERTIES2,
+    LOADER_EXTENSION_TRAMPOLINE_KHR_DEVICE_GROUP_CREATION,
+    LOADER_EXTENSION_TRAMPOLINE_KHR_EXTERNAL_MEMORY_CAPABILITIES,
+    LOADER_EXTENSION_TRAMPOLINE_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES,
+    LOADER_EXTENSION_TRAMPOLINE_KHR_EXTERNAL_FENCE_CAPABILITIES,
+    LOADER_EXTENSION_TRAMPOLINE_KHR_GET_SURFACE_CAPABILITIES2,
+    LOADER_EXTENSION_TRAMPOLINE_GGP_STREAM_DESCRIPTOR_SURFACE,
+    LOADER_EXTENSION_TRAMPOLINE_NV_EXTERNAL_MEMORY_CAPABILITIES,
+    LOADER_EXTENSION_TRAMPOLINE_NN_VI_SURFACE,
+    LOADER_EXTENSION_TRAMPOLINE_EXT_DIRECT_MODE_DISPLAY,
+    LOADER_EXTENSION_TRAMPOLINE_EXT_ACQUIRE_XLIB_DISPLAY,
+    LOADER_EXTENSION_TRAMPOLINE_EXT_DISPLAY_SURFACE_COUNTER,
+    LOADER_EXTENSION_TRAMPOLINE_EXT_DEBUG_UTILS,
+    LOADER_EXTENSION_TRAMPOLINE_FUCHSIA_IMAGEPIPE_SURFACE,
+};
 
-    // ---- VK_KHR_device_group_creation extension commands
-    if (!strcmp("vkEnumeratePhysicalDeviceGroupsKHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_device_group_creation == 1)
-                     ? (void *)vkEnumeratePhysicalDeviceGroups
-                     : NULL;
-        return true;
-    }
+struct loader_extension_trampoline_name_entry {
+    const char *name;  // without the "vk" prefix
+    void *addr;        // NULL if the command isn't compiled in on this platform
+    uint32_t check;
+};
 
-    // ---- VK_KHR_external_memory_capabilities extension commands
-    if (!strcmp("vkGetPhysicalDeviceExternalBufferPropertiesKHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_external_memory_capabilities == 1)
-                     ? (void *)vkGetPhysicalDeviceExternalBufferProperties
-                     : NULL;
-        return true;
-    }
+#define LOADER_EXTENSION_TRAMPOLINE_NAME_COUNT 168
+
+static const int32_t loader_extension_trampoline_name_displacements[LOADER_EXTENSION_TRAMPOLINE_NAME_COUNT] = {
+    -6, 1, 0, 1, 0, -7, -11, -19, 2, 9, 1, 0, 0, 7, 0, 1,
+    0, -22, 1, -26, -29, 0, -33, -36, 0, 0, -38, 1, -43, -44, -48, 1,
+    -49, 0, 0, -54, 0, -56, 0, 0, -57, 0, -58, 0, 0, 0, -61, 2,
+    -62, -67, 0, -70, 2, 0, 2, -71, 1, -79, -83, -84, -85, 2, -87, 0,
+    0, -88, 2, 0, 1, -89, 2, 0, -91, 1, 0, 0, 0, -94, 0, 0,
+    2, 0, -96, 8, 0, 0, 1, 0, 5, -98, 0, 0, 0, 2, -99, 0,
+    0, -101, 5, 0, 0, 0, 0, 0, 1, -107, 0, -108, 1, 0, 0, 0,
+    1, -109, -111, -113, 2, -115, -121, 3, -125, -133, 6, 0, 0, 1, 1, -135,
+    0, 0, 0, 1, -138, -145, 2, -147, 0, -148, 0, -149, 1, -150, -151, 1,
+    0, 4, 1, 21, 0, 0, 6, 2, -152, 2, 6, -154, 3, -157, -160, 0,
+    0, 0, -164, -167, 0, 1, 0, -168,
+};
 
-    // ---- VK_KHR_external_memory_win32 extension commands
+static const struct loader_extension_trampoline_name_entry loader_extension_trampoline_names[LOADER_EXTENSION_TRAMPOLINE_NAME_COUNT] = {
+    {"ResetQueryPoolEXT", (void *)ResetQueryPoolEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdDrawMeshTasksNV", (void *)CmdDrawMeshTasksNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetSwapchainStatusKHR", (void *)GetSwapchainStatusKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#ifdef VK_USE_PLATFORM_VI_NN
+    {"CreateViSurfaceNN", (void *)CreateViSurfaceNN, LOADER_EXTENSION_TRAMPOLINE_NN_VI_SURFACE},
+#else
+    {"CreateViSurfaceNN", NULL, LOADER_EXTENSION_TRAMPOLINE_NN_VI_SURFACE},
+#endif // VK_USE_PLATFORM_VI_NN
+    {"GetCalibratedTimestampsEXT", (void *)GetCalibratedTimestampsEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdEndRenderPass2KHR", (void *)CmdEndRenderPass2KHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"SetLocalDimmingAMD", (void *)SetLocalDimmingAMD, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdDebugMarkerEndEXT", (void *)CmdDebugMarkerEndEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetSemaphoreFdKHR", (void *)GetSemaphoreFdKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdSetViewportWScalingNV", (void *)CmdSetViewportWScalingNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"ReleaseProfilingLockKHR", (void *)ReleaseProfilingLockKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPastPresentationTimingGOOGLE", (void *)GetPastPresentationTimingGOOGLE, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdWriteBufferMarkerAMD", (void *)CmdWriteBufferMarkerAMD, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetImageViewHandleNVX", (void *)GetImageViewHandleNVX, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"BindImageMemory2KHR", (void *)BindImageMemory2KHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CreateValidationCacheEXT", (void *)CreateValidationCacheEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#ifdef VK_USE_PLATFORM_ANDROID_KHR
+    {"GetMemoryAndroidHardwareBufferANDROID", (void *)GetMemoryAndroidHardwareBufferANDROID, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"GetMemoryAndroidHardwareBufferANDROID", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#endif // VK_USE_PLATFORM_ANDROID_KHR
+    {"QueueSetPerformanceConfigurationINTEL", (void *)QueueSetPerformanceConfigurationINTEL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetAccelerationStructureMemoryRequirementsNV", (void *)GetAccelerationStructureMemoryRequirementsNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"UpdateDescriptorSetWithTemplateKHR", (void *)UpdateDescriptorSetWithTemplateKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetRefreshCycleDurationGOOGLE", (void *)GetRefreshCycleDurationGOOGLE, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp("vkGetMemoryWin32HandleKHR", name)) {
-        *addr = (void *)GetMemoryWin32HandleKHR;
-        return true;
-    }
+    {"ImportFenceWin32HandleKHR", (void *)ImportFenceWin32HandleKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"ImportFenceWin32HandleKHR", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"CmdDrawIndexedIndirectCountAMD", (void *)CmdDrawIndexedIndirectCountAMD, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdSetCoarseSampleOrderNV", (void *)CmdSetCoarseSampleOrderNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdDispatchBaseKHR", (void *)CmdDispatchBaseKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp("vkGetMemoryWin32HandlePropertiesKHR", name)) {
-        *addr = (void *)GetMemoryWin32HandlePropertiesKHR;
-        return true;
-    }
+    {"GetMemoryWin32HandlePropertiesKHR", (void *)GetMemoryWin32HandlePropertiesKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"GetMemoryWin32HandlePropertiesKHR", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #endif // VK_USE_PLATFORM_WIN32_KHR
-
-    // ---- VK_KHR_external_memory_fd extension commands
-    if (!strcmp("vkGetMemoryFdKHR", name)) {
-        *addr = (void *)GetMemoryFdKHR;
-        return true;
-    }
-    if (!strcmp("vkGetMemoryFdPropertiesKHR", name)) {
-        *addr = (void *)GetMemoryFdPropertiesKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_external_semaphore_capabilities extension commands
-    if (!strcmp("vkGetPhysicalDeviceExternalSemaphorePropertiesKHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_external_semaphore_capabilities == 1)
-                     ? (void *)vkGetPhysicalDeviceExternalSemaphoreProperties
-                     : NULL;
-        return true;
-    }
-
-    // ---- VK_KHR_external_semaphore_win32 extension commands
+    {"UninitializePerformanceApiINTEL", (void *)UninitializePerformanceApiINTEL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetDeviceGroupPeerMemoryFeaturesKHR", (void *)GetDeviceGroupPeerMemoryFeaturesKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdSetSampleLocationsEXT", (void *)CmdSetSampleLocationsEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdEndTransformFeedbackEXT", (void *)CmdEndTransformFeedbackEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"ReleasePerformanceConfigurationINTEL", (void *)ReleasePerformanceConfigurationINTEL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdDrawIndirectByteCountEXT", (void *)CmdDrawIndirectByteCountEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceSparseImageFormatProperties2KHR", (void *)vkGetPhysicalDeviceSparseImageFormatProperties2, LOADER_EXTENSION_TRAMPOLINE_KHR_GET_PHYSICAL_DEVICE_PROPERTIES2},
+    {"CmdPushDescriptorSetKHR", (void *)CmdPushDescriptorSetKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetImageSparseMemoryRequirements2KHR", (void *)GetImageSparseMemoryRequirements2KHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdBeginConditionalRenderingEXT", (void *)CmdBeginConditionalRenderingEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetMemoryHostPointerPropertiesEXT", (void *)GetMemoryHostPointerPropertiesEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CreateAccelerationStructureNV", (void *)CreateAccelerationStructureNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#ifdef VK_USE_PLATFORM_FUCHSIA
+    {"CreateImagePipeSurfaceFUCHSIA", (void *)CreateImagePipeSurfaceFUCHSIA, LOADER_EXTENSION_TRAMPOLINE_FUCHSIA_IMAGEPIPE_SURFACE},
+#else
+    {"CreateImagePipeSurfaceFUCHSIA", NULL, LOADER_EXTENSION_TRAMPOLINE_FUCHSIA_IMAGEPIPE_SURFACE},
+#endif // VK_USE_PLATFORM_FUCHSIA
+    {"GetRayTracingShaderGroupHandlesNV", (void *)GetRayTracingShaderGroupHandlesNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetBufferOpaqueCaptureAddressKHR", (void *)GetBufferOpaqueCaptureAddressKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"DisplayPowerControlEXT", (void *)DisplayPowerControlEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"QueueInsertDebugUtilsLabelEXT", (void *)QueueInsertDebugUtilsLabelEXT, LOADER_EXTENSION_TRAMPOLINE_EXT_DEBUG_UTILS},
+    {"CmdEndDebugUtilsLabelEXT", (void *)CmdEndDebugUtilsLabelEXT, LOADER_EXTENSION_TRAMPOLINE_EXT_DEBUG_UTILS},
+    {"RegisterObjectsNVX", (void *)RegisterObjectsNVX, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceMultisamplePropertiesEXT", (void *)GetPhysicalDeviceMultisamplePropertiesEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"RegisterDeviceEventEXT", (void *)RegisterDeviceEventEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"WaitSemaphoresKHR", (void *)WaitSemaphoresKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetBufferDeviceAddressKHR", (void *)GetBufferDeviceAddressKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"DestroyIndirectCommandsLayoutNVX", (void *)DestroyIndirectCommandsLayoutNVX, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetImageMemoryRequirements2KHR", (void *)GetImageMemoryRequirements2KHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp("vkImportSemaphoreWin32HandleKHR", name)) {
-        *addr = (void *)ImportSemaphoreWin32HandleKHR;
-        return true;
-    }
+    {"ImportSemaphoreWin32HandleKHR", (void *)ImportSemaphoreWin32HandleKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"ImportSemaphoreWin32HandleKHR", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"CmdBindTransformFeedbackBuffersEXT", (void *)CmdBindTransformFeedbackBuffersEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceExternalBufferPropertiesKHR", (void *)vkGetPhysicalDeviceExternalBufferProperties, LOADER_EXTENSION_TRAMPOLINE_KHR_EXTERNAL_MEMORY_CAPABILITIES},
+    {"CreateDescriptorUpdateTemplateKHR", (void *)CreateDescriptorUpdateTemplateKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
+    {"AcquireXlibDisplayEXT", (void *)AcquireXlibDisplayEXT, LOADER_EXTENSION_TRAMPOLINE_EXT_ACQUIRE_XLIB_DISPLAY},
+#else
+    {"AcquireXlibDisplayEXT", NULL, LOADER_EXTENSION_TRAMPOLINE_EXT_ACQUIRE_XLIB_DISPLAY},
+#endif // VK_USE_PLATFORM_XLIB_XRANDR_EXT
+#ifdef VK_USE_PLATFORM_ANDROID_KHR
+    {"GetAndroidHardwareBufferPropertiesANDROID", (void *)GetAndroidHardwareBufferPropertiesANDROID, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"GetAndroidHardwareBufferPropertiesANDROID", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#endif // VK_USE_PLATFORM_ANDROID_KHR
+    {"GetAccelerationStructureHandleNV", (void *)GetAccelerationStructureHandleNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdProcessCommandsNVX", (void *)CmdProcessCommandsNVX, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdPushDescriptorSetWithTemplateKHR", (void *)CmdPushDescriptorSetWithTemplateKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceFeatures2KHR", (void *)vkGetPhysicalDeviceFeatures2, LOADER_EXTENSION_TRAMPOLINE_KHR_GET_PHYSICAL_DEVICE_PROPERTIES2},
+    {"GetShaderInfoAMD", (void *)GetShaderInfoAMD, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceSurfaceCapabilities2KHR", (void *)GetPhysicalDeviceSurfaceCapabilities2KHR, LOADER_EXTENSION_TRAMPOLINE_KHR_GET_SURFACE_CAPABILITIES2},
+    {"SignalSemaphoreKHR", (void *)SignalSemaphoreKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdSetDiscardRectangleEXT", (void *)CmdSetDiscardRectangleEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdSetExclusiveScissorNV", (void *)CmdSetExclusiveScissorNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"DebugMarkerSetObjectNameEXT", (void *)DebugMarkerSetObjectNameEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CreateSamplerYcbcrConversionKHR", (void *)CreateSamplerYcbcrConversionKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdEndQueryIndexedEXT", (void *)CmdEndQueryIndexedEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdSetPerformanceOverrideINTEL", (void *)CmdSetPerformanceOverrideINTEL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"SetDebugUtilsObjectTagEXT", (void *)SetDebugUtilsObjectTagEXT, LOADER_EXTENSION_TRAMPOLINE_EXT_DEBUG_UTILS},
+    {"CreateRenderPass2KHR", (void *)CreateRenderPass2KHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"BindAccelerationStructureMemoryNV", (void *)BindAccelerationStructureMemoryNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdSetPerformanceStreamMarkerINTEL", (void *)CmdSetPerformanceStreamMarkerINTEL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdBeginRenderPass2KHR", (void *)CmdBeginRenderPass2KHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"ImportSemaphoreFdKHR", (void *)ImportSemaphoreFdKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp("vkGetSemaphoreWin32HandleKHR", name)) {
-        *addr = (void *)GetSemaphoreWin32HandleKHR;
-        return true;
-    }
+    {"AcquireFullScreenExclusiveModeEXT", (void *)AcquireFullScreenExclusiveModeEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"AcquireFullScreenExclusiveModeEXT", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #endif // VK_USE_PLATFORM_WIN32_KHR
-
-    // ---- VK_KHR_external_semaphore_fd extension commands
-    if (!strcmp("vkImportSemaphoreFdKHR", name)) {
-        *addr = (void *)ImportSemaphoreFdKHR;
-        return true;
-    }
-    if (!strcmp("vkGetSemaphoreFdKHR", name)) {
-        *addr = (void *)GetSemaphoreFdKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_push_descriptor extension commands
-    if (!strcmp("vkCmdPushDescriptorSetKHR", name)) {
-        *addr = (void *)CmdPushDescriptorSetKHR;
-        return true;
-    }
-    if (!strcmp("vkCmdPushDescriptorSetWithTemplateKHR", name)) {
-        *addr = (void *)CmdPushDescriptorSetWithTemplateKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_descriptor_update_template extension commands
-    if (!strcmp("vkCreateDescriptorUpdateTemplateKHR", name)) {
-        *addr = (void *)CreateDescriptorUpdateTemplateKHR;
-        return true;
-    }
-    if (!strcmp("vkDestroyDescriptorUpdateTemplateKHR", name)) {
-        *addr = (void *)DestroyDescriptorUpdateTemplateKHR;
-        return true;
-    }
-    if (!strcmp("vkUpdateDescriptorSetWithTemplateKHR", name)) {
-        *addr = (void *)UpdateDescriptorSetWithTemplateKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_create_renderpass2 extension commands
-    if (!strcmp("vkCreateRenderPass2KHR", name)) {
-        *addr = (void *)CreateRenderPass2KHR;
-        return true;
-    }
-    if (!strcmp("vkCmdBeginRenderPass2KHR", name)) {
-        *addr = (void *)CmdBeginRenderPass2KHR;
-        return true;
-    }
-    if (!strcmp("vkCmdNextSubpass2KHR", name)) {
-        *addr = (void *)CmdNextSubpass2KHR;
-        return true;
-    }
-    if (!strcmp("vkCmdEndRenderPass2KHR", name)) {
-        *addr = (void *)CmdEndRenderPass2KHR;
-        return true;
-    }
-
-    // ---- VK_KHR_shared_presentable_image extension commands
-    if (!strcmp("vkGetSwapchainStatusKHR", name)) {
-        *addr = (void *)GetSwapchainStatusKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_external_fence_capabilities extension commands
-    if (!strcmp("vkGetPhysicalDeviceExternalFencePropertiesKHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_external_fence_capabilities == 1)
-                     ? (void *)vkGetPhysicalDeviceExternalFenceProperties
-                     : NULL;
-        return true;
-    }
-
-    // ---- VK_KHR_external_fence_win32 extension commands
+    {"GetPhysicalDeviceFormatProperties2KHR", (void *)vkGetPhysicalDeviceFormatProperties2, LOADER_EXTENSION_TRAMPOLINE_KHR_GET_PHYSICAL_DEVICE_PROPERTIES2},
+    {"CmdDrawIndirectCountKHR", (void *)CmdDrawIndirectCountKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceCooperativeMatrixPropertiesNV", (void *)GetPhysicalDeviceCooperativeMatrixPropertiesNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"QueueBeginDebugUtilsLabelEXT", (void *)QueueBeginDebugUtilsLabelEXT, LOADER_EXTENSION_TRAMPOLINE_EXT_DEBUG_UTILS},
+    {"MergeValidationCachesEXT", (void *)MergeValidationCachesEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdBeginTransformFeedbackEXT", (void *)CmdBeginTransformFeedbackEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"DestroyValidationCacheEXT", (void *)DestroyValidationCacheEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdDebugMarkerBeginEXT", (void *)CmdDebugMarkerBeginEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetFenceFdKHR", (void *)GetFenceFdKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceToolPropertiesEXT", (void *)GetPhysicalDeviceToolPropertiesEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdBindShadingRateImageNV", (void *)CmdBindShadingRateImageNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPipelineExecutableInternalRepresentationsKHR", (void *)GetPipelineExecutableInternalRepresentationsKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdDrawIndirectCountAMD", (void *)CmdDrawIndirectCountAMD, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceExternalFencePropertiesKHR", (void *)vkGetPhysicalDeviceExternalFenceProperties, LOADER_EXTENSION_TRAMPOLINE_KHR_EXTERNAL_FENCE_CAPABILITIES},
+    {"UnregisterObjectsNVX", (void *)UnregisterObjectsNVX, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdSetLineStippleEXT", (void *)CmdSetLineStippleEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp("vkImportFenceWin32HandleKHR", name)) {
-        *addr = (void *)ImportFenceWin32HandleKHR;
-        return true;
-    }
+    {"ReleaseFullScreenExclusiveModeEXT", (void *)ReleaseFullScreenExclusiveModeEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"ReleaseFullScreenExclusiveModeEXT", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"CmdSetPerformanceMarkerINTEL", (void *)CmdSetPerformanceMarkerINTEL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPerformanceParameterINTEL", (void *)GetPerformanceParameterINTEL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceSurfaceFormats2KHR", (void *)GetPhysicalDeviceSurfaceFormats2KHR, LOADER_EXTENSION_TRAMPOLINE_KHR_GET_SURFACE_CAPABILITIES2},
+    {"SetHdrMetadataEXT", (void *)SetHdrMetadataEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdSetDeviceMaskKHR", (void *)CmdSetDeviceMaskKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdSetViewportShadingRatePaletteNV", (void *)CmdSetViewportShadingRatePaletteNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"EnumeratePhysicalDeviceGroupsKHR", (void *)vkEnumeratePhysicalDeviceGroups, LOADER_EXTENSION_TRAMPOLINE_KHR_DEVICE_GROUP_CREATION},
+    {"SetDebugUtilsObjectNameEXT", (void *)SetDebugUtilsObjectNameEXT, LOADER_EXTENSION_TRAMPOLINE_EXT_DEBUG_UTILS},
+    {"DestroySamplerYcbcrConversionKHR", (void *)DestroySamplerYcbcrConversionKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp("vkGetFenceWin32HandleKHR", name)) {
-        *addr = (void *)GetFenceWin32HandleKHR;
-        return true;
-    }
+    {"GetPhysicalDeviceSurfacePresentModes2EXT", (void *)GetPhysicalDeviceSurfacePresentModes2EXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"GetPhysicalDeviceSurfacePresentModes2EXT", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #endif // VK_USE_PLATFORM_WIN32_KHR
-
-    // ---- VK_KHR_external_fence_fd extension commands
-    if (!strcmp("vkImportFenceFdKHR", name)) {
-        *addr = (void *)ImportFenceFdKHR;
-        return true;
-    }
-    if (!strcmp("vkGetFenceFdKHR", name)) {
-        *addr = (void *)GetFenceFdKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_performance_query extension commands
-    if (!strcmp("vkEnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR", name)) {
-        *addr = (void *)EnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR;
-        return true;
-    }
-    if (!strcmp("vkGetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR", name)) {
-        *addr = (void *)GetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR;
-        return true;
-    }
-    if (!strcmp("vkAcquireProfilingLockKHR", name)) {
-        *addr = (void *)AcquireProfilingLockKHR;
-        return true;
-    }
-    if (!strcmp("vkReleaseProfilingLockKHR", name)) {
-        *addr = (void *)ReleaseProfilingLockKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_get_surface_capabilities2 extension commands
-    if (!strcmp("vkGetPhysicalDeviceSurfaceCapabilities2KHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_get_surface_capabilities2 == 1)
-                     ? (void *)GetPhysicalDeviceSurfaceCapabilities2KHR
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkGetPhysicalDeviceSurfaceFormats2KHR", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.khr_get_surface_capabilities2 == 1)
-                     ? (void *)GetPhysicalDeviceSurfaceFormats2KHR
-                     : NULL;
-        return true;
-    }
-
-    // ---- VK_KHR_get_memory_requirements2 extension commands
-    if (!strcmp("vkGetImageMemoryRequirements2KHR", name)) {
-        *addr = (void *)GetImageMemoryRequirements2KHR;
-        return true;
-    }
-    if (!strcmp("vkGetBufferMemoryRequirements2KHR", name)) {
-        *addr = (void *)GetBufferMemoryRequirements2KHR;
-        return true;
-    }
-    if (!strcmp("vkGetImageSparseMemoryRequirements2KHR", name)) {
-        *addr = (void *)GetImageSparseMemoryRequirements2KHR;
-        return true;
-    }
-
-    // ---- VK_KHR_sampler_ycbcr_conversion extension commands
-    if (!strcmp("vkCreateSamplerYcbcrConversionKHR", name)) {
-        *addr = (void *)CreateSamplerYcbcrConversionKHR;
-        return true;
-    }
-    if (!strcmp("vkDestroySamplerYcbcrConversionKHR", name)) {
-        *addr = (void *)DestroySamplerYcbcrConversionKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_bind_memory2 extension commands
-    if (!strcmp("vkBindBufferMemory2KHR", name)) {
-        *addr = (void *)BindBufferMemory2KHR;
-        return true;
-    }
-    if (!strcmp("vkBindImageMemory2KHR", name)) {
-        *addr = (void *)BindImageMemory2KHR;
-        return true;
-    }
-
-    // ---- VK_KHR_maintenance3 extension commands
-    if (!strcmp("vkGetDescriptorSetLayoutSupportKHR", name)) {
-        *addr = (void *)GetDescriptorSetLayoutSupportKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_draw_indirect_count extension commands
-    if (!strcmp("vkCmdDrawIndirectCountKHR", name)) {
-        *addr = (void *)CmdDrawIndirectCountKHR;
-        return true;
-    }
-    if (!strcmp("vkCmdDrawIndexedIndirectCountKHR", name)) {
-        *addr = (void *)CmdDrawIndexedIndirectCountKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_timeline_semaphore extension commands
-    if (!strcmp("vkGetSemaphoreCounterValueKHR", name)) {
-        *addr = (void *)GetSemaphoreCounterValueKHR;
-        return true;
-    }
-    if (!strcmp("vkWaitSemaphoresKHR", name)) {
-        *addr = (void *)WaitSemaphoresKHR;
-        return true;
-    }
-    if (!strcmp("vkSignalSemaphoreKHR", name)) {
-        *addr = (void *)SignalSemaphoreKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_buffer_device_address extension commands
-    if (!strcmp("vkGetBufferDeviceAddressKHR", name)) {
-        *addr = (void *)GetBufferDeviceAddressKHR;
-        return true;
-    }
-    if (!strcmp("vkGetBufferOpaqueCaptureAddressKHR", name)) {
-        *addr = (void *)GetBufferOpaqueCaptureAddressKHR;
-        return true;
-    }
-    if (!strcmp("vkGetDeviceMemoryOpaqueCaptureAddressKHR", name)) {
-        *addr = (void *)GetDeviceMemoryOpaqueCaptureAddressKHR;
-        return true;
-    }
-
-    // ---- VK_KHR_pipeline_executable_properties extension commands
-    if (!strcmp("vkGetPipelineExecutablePropertiesKHR", name)) {
-        *addr = (void *)GetPipelineExecutablePropertiesKHR;
-        return true;
-    }
-    if (!strcmp("vkGetPipelineExecutableStatisticsKHR", name)) {
-        *addr = (void *)GetPipelineExecutableStatisticsKHR;
-        return true;
-    }
-    if (!strcmp("vkGetPipelineExecutableInternalRepresentationsKHR", name)) {
-        *addr = (void *)GetPipelineExecutableInternalRepresentationsKHR;
-        return true;
-    }
-
-    // ---- VK_EXT_debug_marker extension commands
-    if (!strcmp("vkDebugMarkerSetObjectTagEXT", name)) {
-        *addr = (void *)DebugMarkerSetObjectTagEXT;
-        return true;
-    }
-    if (!strcmp("vkDebugMarkerSetObjectNameEXT", name)) {
-        *addr = (void *)DebugMarkerSetObjectNameEXT;
-        return true;
-    }
-    if (!strcmp("vkCmdDebugMarkerBeginEXT", name)) {
-        *addr = (void *)CmdDebugMarkerBeginEXT;
-        return true;
-    }
-    if (!strcmp("vkCmdDebugMarkerEndEXT", name)) {
-        *addr = (void *)CmdDebugMarkerEndEXT;
-        return true;
-    }
-    if (!strcmp("vkCmdDebugMarkerInsertEXT", name)) {
-        *addr = (void *)CmdDebugMarkerInsertEXT;
-        return true;
-    }
-
-    // ---- VK_EXT_transform_feedback extension commands
-    if (!strcmp("vkCmdBindTransformFeedbackBuffersEXT", name)) {
-        *addr = (void *)CmdBindTransformFeedbackBuffersEXT;
-        return true;
-    }
-    if (!strcmp("vkCmdBeginTransformFeedbackEXT", name)) {
-        *addr = (void *)CmdBeginTransformFeedbackEXT;
-        return true;
-    }
-    if (!strcmp("vkCmdEndTransformFeedbackEXT", name)) {
-        *addr = (void *)CmdEndTransformFeedbackEXT;
-        return true;
-    }
-    if (!strcmp("vkCmdBeginQueryIndexedEXT", name)) {
-        *addr = (void *)CmdBeginQueryIndexedEXT;
-        return true;
-    }
-    if (!strcmp("vkCmdEndQueryIndexedEXT", name)) {
-        *addr = (void *)CmdEndQueryIndexedEXT;
-        return true;
-    }
-    if (!strcmp("vkCmdDrawIndirectByteCountEXT", name)) {
-        *addr = (void *)CmdDrawIndirectByteCountEXT;
-        return true;
-    }
-
-    // ---- VK_NVX_image_view_handle extension commands
-    if (!strcmp("vkGetImageViewHandleNVX", name)) {
-        *addr = (void *)GetImageViewHandleNVX;
-        return true;
-    }
-
-    // ---- VK_AMD_draw_indirect_count extension commands
-    if (!strcmp("vkCmdDrawIndirectCountAMD", name)) {
-        *addr = (void *)CmdDrawIndirectCountAMD;
-        return true;
-    }
-    if (!strcmp("vkCmdDrawIndexedIndirectCountAMD", name)) {
-        *addr = (void *)CmdDrawIndexedIndirectCountAMD;
-        return true;
-    }
-
-    // ---- VK_AMD_shader_info extension commands
-    if (!strcmp("vkGetShaderInfoAMD", name)) {
-        *addr = (void *)GetShaderInfoAMD;
-        return true;
-    }
-
-    // ---- VK_GGP_stream_descriptor_surface extension commands
-#ifdef VK_USE_PLATFORM_GGP
-    if (!strcmp("vkCreateStreamDescriptorSurfaceGGP", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ggp_stream_descriptor_surface == 1)
-                     ? (void *)CreateStreamDescriptorSurfaceGGP
-                     : NULL;
-        return true;
-    }
-#endif // VK_USE_PLATFORM_GGP
-
-    // ---- VK_NV_external_memory_capabilities extension commands
-    if (!strcmp("vkGetPhysicalDeviceExternalImageFormatPropertiesNV", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.nv_external_memory_capabilities == 1)
-                     ? (void *)GetPhysicalDeviceExternalImageFormatPropertiesNV
-                     : NULL;
-        return true;
-    }
-
-    // ---- VK_NV_external_memory_win32 extension commands
+    {"TrimCommandPoolKHR", (void *)TrimCommandPoolKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"DestroyDescriptorUpdateTemplateKHR", (void *)DestroyDescriptorUpdateTemplateKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetMemoryFdKHR", (void *)GetMemoryFdKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdDrawMeshTasksIndirectCountNV", (void *)CmdDrawMeshTasksIndirectCountNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdWriteAccelerationStructuresPropertiesNV", (void *)CmdWriteAccelerationStructuresPropertiesNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"BindBufferMemory2KHR", (void *)BindBufferMemory2KHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"DebugMarkerSetObjectTagEXT", (void *)DebugMarkerSetObjectTagEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdCopyAccelerationStructureNV", (void *)CmdCopyAccelerationStructureNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdSetCheckpointNV", (void *)CmdSetCheckpointNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetDeviceMemoryOpaqueCaptureAddressKHR", (void *)GetDeviceMemoryOpaqueCaptureAddressKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPipelineExecutableStatisticsKHR", (void *)GetPipelineExecutableStatisticsKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp("vkGetMemoryWin32HandleNV", name)) {
-        *addr = (void *)GetMemoryWin32HandleNV;
-        return true;
-    }
+    {"GetSemaphoreWin32HandleKHR", (void *)GetSemaphoreWin32HandleKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"GetSemaphoreWin32HandleKHR", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #endif // VK_USE_PLATFORM_WIN32_KHR
-
-    // ---- VK_NN_vi_surface extension commands
-#ifdef VK_USE_PLATFORM_VI_NN
-    if (!strcmp("vkCreateViSurfaceNN", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.nn_vi_surface == 1)
-                     ? (void *)CreateViSurfaceNN
-                     : NULL;
-        return true;
-    }
-#endif // VK_USE_PLATFORM_VI_NN
-
-    // ---- VK_EXT_conditional_rendering extension commands
-    if (!strcmp("vkCmdBeginConditionalRenderingEXT", name)) {
-        *addr = (void *)CmdBeginConditionalRenderingEXT;
-        return true;
-    }
-    if (!strcmp("vkCmdEndConditionalRenderingEXT", name)) {
-        *addr = (void *)CmdEndConditionalRenderingEXT;
-        return true;
-    }
-
-    // ---- VK_NVX_device_generated_commands extension commands
-    if (!strcmp("vkCmdProcessCommandsNVX", name)) {
-        *addr = (void *)CmdProcessCommandsNVX;
-        return true;
-    }
-    if (!strcmp("vkCmdReserveSpaceForCommandsNVX", name)) {
-        *addr = (void *)CmdReserveSpaceForCommandsNVX;
-        return true;
-    }
-    if (!strcmp("vkCreateIndirectCommandsLayoutNVX", name)) {
-        *addr = (void *)CreateIndirectCommandsLayoutNVX;
-        return true;
-    }
-    if (!strcmp("vkDestroyIndirectCommandsLayoutNVX", name)) {
-        *addr = (void *)DestroyIndirectCommandsLayoutNVX;
-        return true;
-    }
-    if (!strcmp("vkCreateObjectTableNVX", name)) {
-        *addr = (void *)CreateObjectTableNVX;
-        return true;
-    }
-    if (!strcmp("vkDestroyObjectTableNVX", name)) {
-        *addr = (void *)DestroyObjectTableNVX;
-        return true;
-    }
-    if (!strcmp("vkRegisterObjectsNVX", name)) {
-        *addr = (void *)RegisterObjectsNVX;
-        return true;
-    }
-    if (!strcmp("vkUnregisterObjectsNVX", name)) {
-        *addr = (void *)UnregisterObjectsNVX;
-        return true;
-    }
-    if (!strcmp("vkGetPhysicalDeviceGeneratedCommandsPropertiesNVX", name)) {
-        *addr = (void *)GetPhysicalDeviceGeneratedCommandsPropertiesNVX;
-        return true;
-    }
-
-    // ---- VK_NV_clip_space_w_scaling extension commands
-    if (!strcmp("vkCmdSetViewportWScalingNV", name)) {
-        *addr = (void *)CmdSetViewportWScalingNV;
-        return true;
-    }
-
-    // ---- VK_EXT_direct_mode_display extension commands
-    if (!strcmp("vkReleaseDisplayEXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_direct_mode_display == 1)
-                     ? (void *)ReleaseDisplayEXT
-                     : NULL;
-        return true;
-    }
-
-    // ---- VK_EXT_acquire_xlib_display extension commands
-#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
-    if (!strcmp("vkAcquireXlibDisplayEXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_acquire_xlib_display == 1)
-                     ? (void *)AcquireXlibDisplayEXT
-                     : NULL;
-        return true;
-    }
-#endif // VK_USE_PLATFORM_XLIB_XRANDR_EXT
-#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
-    if (!strcmp("vkGetRandROutputDisplayEXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_acquire_xlib_display == 1)
-                     ? (void *)GetRandROutputDisplayEXT
-                     : NULL;
-        return true;
-    }
-#endif // VK_USE_PLATFORM_XLIB_XRANDR_EXT
-
-    // ---- VK_EXT_display_surface_counter extension commands
-    if (!strcmp("vkGetPhysicalDeviceSurfaceCapabilities2EXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_display_surface_counter == 1)
-                     ? (void *)GetPhysicalDeviceSurfaceCapabilities2EXT
-                     : NULL;
-        return true;
-    }
-
-    // ---- VK_EXT_display_control extension commands
-    if (!strcmp("vkDisplayPowerControlEXT", name)) {
-        *addr = (void *)DisplayPowerControlEXT;
-        return true;
-    }
-    if (!strcmp("vkRegisterDeviceEventEXT", name)) {
-        *addr = (void *)RegisterDeviceEventEXT;
-        return true;
-    }
-    if (!strcmp("vkRegisterDisplayEventEXT", name)) {
-        *addr = (void *)RegisterDisplayEventEXT;
-        return true;
-    }
-    if (!strcmp("vkGetSwapchainCounterEXT", name)) {
-        *addr = (void *)GetSwapchainCounterEXT;
-        return true;
-    }
-
-    // ---- VK_GOOGLE_display_timing extension commands
-    if (!strcmp("vkGetRefreshCycleDurationGOOGLE", name)) {
-        *addr = (void *)GetRefreshCycleDurationGOOGLE;
-        return true;
-    }
-    if (!strcmp("vkGetPastPresentationTimingGOOGLE", name)) {
-        *addr = (void *)GetPastPresentationTimingGOOGLE;
-        return true;
-    }
-
-    // ---- VK_EXT_discard_rectangles extension commands
-    if (!strcmp("vkCmdSetDiscardRectangleEXT", name)) {
-        *addr = (void *)CmdSetDiscardRectangleEXT;
-        return true;
-    }
-
-    // ---- VK_EXT_hdr_metadata extension commands
-    if (!strcmp("vkSetHdrMetadataEXT", name)) {
-        *addr = (void *)SetHdrMetadataEXT;
-        return true;
-    }
-
-    // ---- VK_EXT_debug_utils extension commands
-    if (!strcmp("vkSetDebugUtilsObjectNameEXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_debug_utils == 1)
-                     ? (void *)SetDebugUtilsObjectNameEXT
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkSetDebugUtilsObjectTagEXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_debug_utils == 1)
-                     ? (void *)SetDebugUtilsObjectTagEXT
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkQueueBeginDebugUtilsLabelEXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_debug_utils == 1)
-                     ? (void *)QueueBeginDebugUtilsLabelEXT
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkQueueEndDebugUtilsLabelEXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_debug_utils == 1)
-                     ? (void *)QueueEndDebugUtilsLabelEXT
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkQueueInsertDebugUtilsLabelEXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_debug_utils == 1)
-                     ? (void *)QueueInsertDebugUtilsLabelEXT
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkCmdBeginDebugUtilsLabelEXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_debug_utils == 1)
-                     ? (void *)CmdBeginDebugUtilsLabelEXT
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkCmdEndDebugUtilsLabelEXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_debug_utils == 1)
-                     ? (void *)CmdEndDebugUtilsLabelEXT
-                     : NULL;
-        return true;
-    }
-    if (!strcmp("vkCmdInsertDebugUtilsLabelEXT", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.ext_debug_utils == 1)
-                     ? (void *)CmdInsertDebugUtilsLabelEXT
-                     : NULL;
-        return true;
-    }
-
-    // ---- VK_ANDROID_external_memory_android_hardware_buffer extension commands
-#ifdef VK_USE_PLATFORM_ANDROID_KHR
-    if (!strcmp("vkGetAndroidHardwareBufferPropertiesANDROID", name)) {
-        *addr = (void *)GetAndroidHardwareBufferPropertiesANDROID;
-        return true;
-    }
-#endif // VK_USE_PLATFORM_ANDROID_KHR
-#ifdef VK_USE_PLATFORM_ANDROID_KHR
-    if (!strcmp("vkGetMemoryAndroidHardwareBufferANDROID", name)) {
-        *addr = (void *)GetMemoryAndroidHardwareBufferANDROID;
-        return true;
-    }
-#endif // VK_USE_PLATFORM_ANDROID_KHR
-
-    // ---- VK_EXT_sample_locations extension commands
-    if (!strcmp("vkCmdSetSampleLocationsEXT", name)) {
-        *addr = (void *)CmdSetSampleLocationsEXT;
-        return true;
-    }
-    if (!strcmp("vkGetPhysicalDeviceMultisamplePropertiesEXT", name)) {
-        *addr = (void *)GetPhysicalDeviceMultisamplePropertiesEXT;
-        return true;
-    }
-
-    // ---- VK_EXT_image_drm_format_modifier extension commands
-    if (!strcmp("vkGetImageDrmFormatModifierPropertiesEXT", name)) {
-        *addr = (void *)GetImageDrmFormatModifierPropertiesEXT;
-        return true;
-    }
-
-    // ---- VK_EXT_validation_cache extension commands
-    if (!strcmp("vkCreateValidationCacheEXT", name)) {
-        *addr = (void *)CreateValidationCacheEXT;
-        return true;
-    }
-    if (!strcmp("vkDestroyValidationCacheEXT", name)) {
-        *addr = (void *)DestroyValidationCacheEXT;
-        return true;
-    }
-    if (!strcmp("vkMergeValidationCachesEXT", name)) {
-        *addr = (void *)MergeValidationCachesEXT;
-        return true;
-    }
-    if (!strcmp("vkGetValidationCacheDataEXT", name)) {
-        *addr = (void *)GetValidationCacheDataEXT;
-        return true;
-    }
-
-    // ---- VK_NV_shading_rate_image extension commands
-    if (!strcmp("vkCmdBindShadingRateImageNV", name)) {
-        *addr = (void *)CmdBindShadingRateImageNV;
-        return true;
-    }
-    if (!strcmp("vkCmdSetViewportShadingRatePaletteNV", name)) {
-        *addr = (void *)CmdSetViewportShadingRatePaletteNV;
-        return true;
-    }
-    if (!strcmp("vkCmdSetCoarseSampleOrderNV", name)) {
-        *addr = (void *)CmdSetCoarseSampleOrderNV;
-        return true;
-    }
-
-    // ---- VK_NV_ray_tracing extension commands
-    if (!strcmp("vkCreateAccelerationStructureNV", name)) {
-        *addr = (void *)CreateAccelerationStructureNV;
-        return true;
-    }
-    if (!strcmp("vkDestroyAccelerationStructureNV", name)) {
-        *addr = (void *)DestroyAccelerationStructureNV;
-        return true;
-    }
-    if (!strcmp("vkGetAccelerationStructureMemoryRequirementsNV", name)) {
-        *addr = (void *)GetAccelerationStructureMemoryRequirementsNV;
-        return true;
-    }
-    if (!strcmp("vkBindAccelerationStructureMemoryNV", name)) {
-        *addr = (void *)BindAccelerationStructureMemoryNV;
-        return true;
-    }
-    if (!strcmp("vkCmdBuildAccelerationStructureNV", name)) {
-        *addr = (void *)CmdBuildAccelerationStructureNV;
-        return true;
-    }
-    if (!strcmp("vkCmdCopyAccelerationStructureNV", name)) {
-        *addr = (void *)CmdCopyAccelerationStructureNV;
-        return true;
-    }
-    if (!strcmp("vkCmdTraceRaysNV", name)) {
-        *addr = (void *)CmdTraceRaysNV;
-        return true;
-    }
-    if (!strcmp("vkCreateRayTracingPipelinesNV", name)) {
-        *addr = (void *)CreateRayTracingPipelinesNV;
-        return true;
-    }
-    if (!strcmp("vkGetRayTracingShaderGroupHandlesNV", name)) {
-        *addr = (void *)GetRayTracingShaderGroupHandlesNV;
-        return true;
-    }
-    if (!strcmp("vkGetAccelerationStructureHandleNV", name)) {
-        *addr = (void *)GetAccelerationStructureHandleNV;
-        return true;
-    }
-    if (!strcmp("vkCmdWriteAccelerationStructuresPropertiesNV", name)) {
-        *addr = (void *)CmdWriteAccelerationStructuresPropertiesNV;
-        return true;
-    }
-    if (!strcmp("vkCompileDeferredNV", name)) {
-        *addr = (void *)CompileDeferredNV;
-        return true;
-    }
-
-    // ---- VK_EXT_external_memory_host extension commands
-    if (!strcmp("vkGetMemoryHostPointerPropertiesEXT", name)) {
-        *addr = (void *)GetMemoryHostPointerPropertiesEXT;
-        return true;
-    }
-
-    // ---- VK_AMD_buffer_marker extension commands
-    if (!strcmp("vkCmdWriteBufferMarkerAMD", name)) {
-        *addr = (void *)CmdWriteBufferMarkerAMD;
-        return true;
-    }
-
-    // ---- VK_EXT_calibrated_timestamps extension commands
-    if (!strcmp("vkGetPhysicalDeviceCalibrateableTimeDomainsEXT", name)) {
-        *addr = (void *)GetPhysicalDeviceCalibrateableTimeDomainsEXT;
-        return true;
-    }
-    if (!strcmp("vkGetCalibratedTimestampsEXT", name)) {
-        *addr = (void *)GetCalibratedTimestampsEXT;
-        return true;
-    }
-
-    // ---- VK_NV_mesh_shader extension commands
-    if (!strcmp("vkCmdDrawMeshTasksNV", name)) {
-        *addr = (void *)CmdDrawMeshTasksNV;
-        return true;
-    }
-    if (!strcmp("vkCmdDrawMeshTasksIndirectNV", name)) {
-        *addr = (void *)CmdDrawMeshTasksIndirectNV;
-        return true;
-    }
-    if (!strcmp("vkCmdDrawMeshTasksIndirectCountNV", name)) {
-        *addr = (void *)CmdDrawMeshTasksIndirectCountNV;
-        return true;
-    }
-
-    // ---- VK_NV_scissor_exclusive extension commands
-    if (!strcmp("vkCmdSetExclusiveScissorNV", name)) {
-        *addr = (void *)CmdSetExclusiveScissorNV;
-        return true;
-    }
-
-    // ---- VK_NV_device_diagnostic_checkpoints extension commands
-    if (!strcmp("vkCmdSetCheckpointNV", name)) {
-        *addr = (void *)CmdSetCheckpointNV;
-        return true;
-    }
-    if (!strcmp("vkGetQueueCheckpointDataNV", name)) {
-        *addr = (void *)GetQueueCheckpointDataNV;
-        return true;
-    }
-
-    // ---- VK_INTEL_performance_query extension commands
-    if (!strcmp("vkInitializePerformanceApiINTEL", name)) {
-        *addr = (void *)InitializePerformanceApiINTEL;
-        return true;
-    }
-    if (!strcmp("vkUninitializePerformanceApiINTEL", name)) {
-        *addr = (void *)UninitializePerformanceApiINTEL;
-        return true;
-    }
-    if (!strcmp("vkCmdSetPerformanceMarkerINTEL", name)) {
-        *addr = (void *)CmdSetPerformanceMarkerINTEL;
-        return true;
-    }
-    if (!strcmp("vkCmdSetPerformanceStreamMarkerINTEL", name)) {
-        *addr = (void *)CmdSetPerformanceStreamMarkerINTEL;
-        return true;
-    }
-    if (!strcmp("vkCmdSetPerformanceOverrideINTEL", name)) {
-        *addr = (void *)CmdSetPerformanceOverrideINTEL;
-        return true;
-    }
-    if (!strcmp("vkAcquirePerformanceConfigurationINTEL", name)) {
-        *addr = (void *)AcquirePerformanceConfigurationINTEL;
-        return true;
-    }
-    if (!strcmp("vkReleasePerformanceConfigurationINTEL", name)) {
-        *addr = (void *)ReleasePerformanceConfigurationINTEL;
-        return true;
-    }
-    if (!strcmp("vkQueueSetPerformanceConfigurationINTEL", name)) {
-        *addr = (void *)QueueSetPerformanceConfigurationINTEL;
-        return true;
-    }
-    if (!strcmp("vkGetPerformanceParameterINTEL", name)) {
-        *addr = (void *)GetPerformanceParameterINTEL;
-        return true;
-    }
-
-    // ---- VK_AMD_display_native_hdr extension commands
-    if (!strcmp("vkSetLocalDimmingAMD", name)) {
-        *addr = (void *)SetLocalDimmingAMD;
-        return true;
-    }
-
-    // ---- VK_FUCHSIA_imagepipe_surface extension commands
-#ifdef VK_USE_PLATFORM_FUCHSIA
-    if (!strcmp("vkCreateImagePipeSurfaceFUCHSIA", name)) {
-        *addr = (ptr_instance->enabled_known_extensions.fuchsia_imagepipe_surface == 1)
-                     ? (void *)CreateImagePipeSurfaceFUCHSIA
-                     : NULL;
-        return true;
-    }
-#endif // VK_USE_PLATFORM_FUCHSIA
-
-    // ---- VK_EXT_buffer_device_address extension commands
-    if (!strcmp("vkGetBufferDeviceAddressEXT", name)) {
-        *addr = (void *)GetBufferDeviceAddressEXT;
-        return true;
-    }
-
-    // ---- VK_EXT_tooling_info extension commands
-    if (!strcmp("vkGetPhysicalDeviceToolPropertiesEXT", name)) {
-        *addr = (void *)GetPhysicalDeviceToolPropertiesEXT;
-        return true;
-    }
-
-    // ---- VK_NV_cooperative_matrix extension commands
-    if (!strcmp("vkGetPhysicalDeviceCooperativeMatrixPropertiesNV", name)) {
-        *addr = (void *)GetPhysicalDeviceCooperativeMatrixPropertiesNV;
-        return true;
-    }
-
-    // ---- VK_NV_coverage_reduction_mode extension commands
-    if (!strcmp("vkGetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV", name)) {
-        *addr = (void *)GetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV;
-        return true;
-    }
-
-    // ---- VK_EXT_full_screen_exclusive extension commands
+    {"GetBufferDeviceAddressEXT", (void *)GetBufferDeviceAddressEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"RegisterDisplayEventEXT", (void *)RegisterDisplayEventEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CreateRayTracingPipelinesNV", (void *)CreateRayTracingPipelinesNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdEndConditionalRenderingEXT", (void *)CmdEndConditionalRenderingEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdBuildAccelerationStructureNV", (void *)CmdBuildAccelerationStructureNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdTraceRaysNV", (void *)CmdTraceRaysNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"DestroyAccelerationStructureNV", (void *)DestroyAccelerationStructureNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR", (void *)GetPhysicalDeviceQueueFamilyPerformanceQueryPassesKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdNextSubpass2KHR", (void *)CmdNextSubpass2KHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetValidationCacheDataEXT", (void *)GetValidationCacheDataEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetSwapchainCounterEXT", (void *)GetSwapchainCounterEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp("vkGetPhysicalDeviceSurfacePresentModes2EXT", name)) {
-        *addr = (void *)GetPhysicalDeviceSurfacePresentModes2EXT;
-        return true;
-    }
+    {"GetFenceWin32HandleKHR", (void *)GetFenceWin32HandleKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"GetFenceWin32HandleKHR", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"GetQueueCheckpointDataNV", (void *)GetQueueCheckpointDataNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetDescriptorSetLayoutSupportKHR", (void *)GetDescriptorSetLayoutSupportKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceCalibrateableTimeDomainsEXT", (void *)GetPhysicalDeviceCalibrateableTimeDomainsEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdInsertDebugUtilsLabelEXT", (void *)CmdInsertDebugUtilsLabelEXT, LOADER_EXTENSION_TRAMPOLINE_EXT_DEBUG_UTILS},
+    {"GetPhysicalDeviceExternalSemaphorePropertiesKHR", (void *)vkGetPhysicalDeviceExternalSemaphoreProperties, LOADER_EXTENSION_TRAMPOLINE_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES},
+#ifdef VK_USE_PLATFORM_XLIB_XRANDR_EXT
+    {"GetRandROutputDisplayEXT", (void *)GetRandROutputDisplayEXT, LOADER_EXTENSION_TRAMPOLINE_EXT_ACQUIRE_XLIB_DISPLAY},
+#else
+    {"GetRandROutputDisplayEXT", NULL, LOADER_EXTENSION_TRAMPOLINE_EXT_ACQUIRE_XLIB_DISPLAY},
+#endif // VK_USE_PLATFORM_XLIB_XRANDR_EXT
+    {"InitializePerformanceApiINTEL", (void *)InitializePerformanceApiINTEL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#ifdef VK_USE_PLATFORM_GGP
+    {"CreateStreamDescriptorSurfaceGGP", (void *)CreateStreamDescriptorSurfaceGGP, LOADER_EXTENSION_TRAMPOLINE_GGP_STREAM_DESCRIPTOR_SURFACE},
+#else
+    {"CreateStreamDescriptorSurfaceGGP", NULL, LOADER_EXTENSION_TRAMPOLINE_GGP_STREAM_DESCRIPTOR_SURFACE},
+#endif // VK_USE_PLATFORM_GGP
+    {"CmdDebugMarkerInsertEXT", (void *)CmdDebugMarkerInsertEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"QueueEndDebugUtilsLabelEXT", (void *)QueueEndDebugUtilsLabelEXT, LOADER_EXTENSION_TRAMPOLINE_EXT_DEBUG_UTILS},
+    {"GetPhysicalDeviceImageFormatProperties2KHR", (void *)vkGetPhysicalDeviceImageFormatProperties2, LOADER_EXTENSION_TRAMPOLINE_KHR_GET_PHYSICAL_DEVICE_PROPERTIES2},
+    {"GetPhysicalDeviceGeneratedCommandsPropertiesNVX", (void *)GetPhysicalDeviceGeneratedCommandsPropertiesNVX, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp("vkAcquireFullScreenExclusiveModeEXT", name)) {
-        *addr = (void *)AcquireFullScreenExclusiveModeEXT;
-        return true;
-    }
+    {"GetMemoryWin32HandleNV", (void *)GetMemoryWin32HandleNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"GetMemoryWin32HandleNV", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"CreateObjectTableNVX", (void *)CreateObjectTableNVX, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"ImportFenceFdKHR", (void *)ImportFenceFdKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPipelineExecutablePropertiesKHR", (void *)GetPipelineExecutablePropertiesKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"EnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR", (void *)EnumeratePhysicalDeviceQueueFamilyPerformanceQueryCountersKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CreateIndirectCommandsLayoutNVX", (void *)CreateIndirectCommandsLayoutNVX, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetBufferMemoryRequirements2KHR", (void *)GetBufferMemoryRequirements2KHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetImageDrmFormatModifierPropertiesEXT", (void *)GetImageDrmFormatModifierPropertiesEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp("vkReleaseFullScreenExclusiveModeEXT", name)) {
-        *addr = (void *)ReleaseFullScreenExclusiveModeEXT;
-        return true;
-    }
+    {"GetDeviceGroupSurfacePresentModes2EXT", (void *)GetDeviceGroupSurfacePresentModes2EXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"GetDeviceGroupSurfacePresentModes2EXT", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"CompileDeferredNV", (void *)CompileDeferredNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceExternalImageFormatPropertiesNV", (void *)GetPhysicalDeviceExternalImageFormatPropertiesNV, LOADER_EXTENSION_TRAMPOLINE_NV_EXTERNAL_MEMORY_CAPABILITIES},
+    {"CmdDrawMeshTasksIndirectNV", (void *)CmdDrawMeshTasksIndirectNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceSurfaceCapabilities2EXT", (void *)GetPhysicalDeviceSurfaceCapabilities2EXT, LOADER_EXTENSION_TRAMPOLINE_EXT_DISPLAY_SURFACE_COUNTER},
+    {"AcquireProfilingLockKHR", (void *)AcquireProfilingLockKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"DestroyObjectTableNVX", (void *)DestroyObjectTableNVX, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"ReleaseDisplayEXT", (void *)ReleaseDisplayEXT, LOADER_EXTENSION_TRAMPOLINE_EXT_DIRECT_MODE_DISPLAY},
+    {"GetSemaphoreCounterValueKHR", (void *)GetSemaphoreCounterValueKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdBeginDebugUtilsLabelEXT", (void *)CmdBeginDebugUtilsLabelEXT, LOADER_EXTENSION_TRAMPOLINE_EXT_DEBUG_UTILS},
+    {"CmdDrawIndexedIndirectCountKHR", (void *)CmdDrawIndexedIndirectCountKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"CmdReserveSpaceForCommandsNVX", (void *)CmdReserveSpaceForCommandsNVX, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-    if (!strcmp("vkGetDeviceGroupSurfacePresentModes2EXT", name)) {
-        *addr = (void *)GetDeviceGroupSurfacePresentModes2EXT;
-        return true;
-    }
+    {"GetMemoryWin32HandleKHR", (void *)GetMemoryWin32HandleKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+#else
+    {"GetMemoryWin32HandleKHR", NULL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
 #endif // VK_USE_PLATFORM_WIN32_KHR
+    {"CmdBeginQueryIndexedEXT", (void *)CmdBeginQueryIndexedEXT, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceMemoryProperties2KHR", (void *)vkGetPhysicalDeviceMemoryProperties2, LOADER_EXTENSION_TRAMPOLINE_KHR_GET_PHYSICAL_DEVICE_PROPERTIES2},
+    {"GetMemoryFdPropertiesKHR", (void *)GetMemoryFdPropertiesKHR, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceProperties2KHR", (void *)vkGetPhysicalDeviceProperties2, LOADER_EXTENSION_TRAMPOLINE_KHR_GET_PHYSICAL_DEVICE_PROPERTIES2},
+    {"AcquirePerformanceConfigurationINTEL", (void *)AcquirePerformanceConfigurationINTEL, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+    {"GetPhysicalDeviceQueueFamilyProperties2KHR", (void *)vkGetPhysicalDeviceQueueFamilyProperties2, LOADER_EXTENSION_TRAMPOLINE_KHR_GET_PHYSICAL_DEVICE_PROPERTIES2},
+    {"GetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV", (void *)GetPhysicalDeviceSupportedFramebufferMixedSamplesCombinationsNV, LOADER_EXTENSION_TRAMPOLINE_ALWAYS},
+};
 
-    // ---- VK_EXT_line_rasterization extension commands
-    if (!strcmp("vkCmdSetLineStippleEXT", name)) {
-        *addr = (void *)CmdSetLineStippleEXT;
-        return true;
+static bool loader_extension_trampoline_enabled(const struct loader_instance *ptr_instance, uint32_t check) {
+    switch (check) {
+        case LOADER_EXTENSION_TRAMPOLINE_KHR_GET_PHYSICAL_DEVICE_PROPERTIES2:
+            return ptr_instance->enabled_known_extensions.khr_get_physical_device_properties2 == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_KHR_DEVICE_GROUP_CREATION:
+            return ptr_instance->enabled_known_extensions.khr_device_group_creation == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_KHR_EXTERNAL_MEMORY_CAPABILITIES:
+            return ptr_instance->enabled_known_extensions.khr_external_memory_capabilities == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES:
+            return ptr_instance->enabled_known_extensions.khr_external_semaphore_capabilities == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_KHR_EXTERNAL_FENCE_CAPABILITIES:
+            return ptr_instance->enabled_known_extensions.khr_external_fence_capabilities == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_KHR_GET_SURFACE_CAPABILITIES2:
+            return ptr_instance->enabled_known_extensions.khr_get_surface_capabilities2 == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_GGP_STREAM_DESCRIPTOR_SURFACE:
+            return ptr_instance->enabled_known_extensions.ggp_stream_descriptor_surface == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_NV_EXTERNAL_MEMORY_CAPABILITIES:
+            return ptr_instance->enabled_known_extensions.nv_external_memory_capabilities == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_NN_VI_SURFACE:
+            return ptr_instance->enabled_known_extensions.nn_vi_surface == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_EXT_DIRECT_MODE_DISPLAY:
+            return ptr_instance->enabled_known_extensions.ext_direct_mode_display == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_EXT_ACQUIRE_XLIB_DISPLAY:
+            return ptr_instance->enabled_known_extensions.ext_acquire_xlib_display == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_EXT_DISPLAY_SURFACE_COUNTER:
+            return ptr_instance->enabled_known_extensions.ext_display_surface_counter == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_EXT_DEBUG_UTILS:
+            return ptr_instance->enabled_known_extensions.ext_debug_utils == 1;
+        case LOADER_EXTENSION_TRAMPOLINE_FUCHSIA_IMAGEPIPE_SURFACE:
+            return ptr_instance->enabled_known_extensions.fuchsia_imagepipe_surface == 1;
+        default:
+            return true;
     }
+}
 
-    // ---- VK_EXT_host_query_reset extension commands
-    if (!strcmp("vkResetQueryPoolEXT", name)) {
-        *addr = (void *)ResetQueryPoolEXT;
-        return true;
+// GPA helpers for extensions
+bool extension_instance_gpa(struct loader_instance *ptr_instance, const char *name, void **addr) {
+    *addr = NULL;
+    if (!name || name[0] != 'v' || name[1] != 'k') return false;
+
+    name += 2;
+    const struct loader_extension_trampoline_name_entry *entry = &loader_extension_trampoline_names[loader_dispatch_name_slot(
+        loader_extension_trampoline_name_displacements, LOADER_EXTENSION_TRAMPOLINE_NAME_COUNT, name)];
+    if (strcmp(name, entry->name) || NULL == entry->addr) return false;
+
+    if (loader_extension_trampoline_enabled(ptr_instance, entry->check)) {
+        *addr = entry->addr;
     }
-    return false;
+    return true;
 }
 
 // A function that can be used to query enabled extensions during a vkCreateInstance call
@@ -83,6 +83,9 @@ VKAPI_ATTR void* VKAPI_CALL loader_lookup_device_dispatch_table(const VkLayerDis
 VKAPI_ATTR void* VKAPI_CALL loader_lookup_instance_dispatch_table(const VkLayerInstanceDispatchTable *table, const char *name,
                                                                   bool *found_name);
 
+// Core command trampoline lookup function, global commands are not included
+void *loader_lookup_core_trampoline(const char *name);
+
 VKAPI_ATTR bool VKAPI_CALL loader_icd_init_entries(struct loader_icd_term *icd_term, VkInstance inst,
                                                    const PFN_vkGetInstanceProcAddr fp_gipa);
 
@@ -0,0 +1,125 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string.h>
+
+#include "vk_loader_platform.h"
+#include "loader.h"
+#include "handle_index.h"
+
+static uint32_t loaderHandleIndexBucket(const void *key, uint32_t bucket_count) {
+    // Keys are heap addresses, so the low bits carry no information.  Fibonacci hashing spreads the
+    // rest over the power of two bucket count.
+    uint64_t hash = ((uint64_t)(uintptr_t)key >> 4) * 0x9E3779B97F4A7C15ULL;
+    return (uint32_t)(hash >> 32) & (bucket_count - 1);
+}
+
+void loaderHandleIndexInit(struct loader_handle_index *index) {
+    memset(index, 0, sizeof(*index));
+    index->buckets = index->initial_buckets;
+    index->bucket_count = LOADER_HANDLE_INDEX_INITIAL_BUCKETS;
+}
+
+// Moves every entry into a bucket array of new_count buckets
+static void loaderHandleIndexRehash(struct loader_handle_index *index, struct loader_handle_index_node **new_buckets,
+                                    uint32_t new_count) {
+    memset(new_buckets, 0, new_count * sizeof(struct loader_handle_index_node *));
+    for (uint32_t i = 0; i < index->bucket_count; i++) {
+        struct loader_handle_index_node *node = index->buckets[i];
+        while (NULL != node) {
+            struct loader_handle_index_node *next = node->next;
+            uint32_t bucket = loaderHandleIndexBucket(node->key, new_count);
+            node->next = new_buckets[bucket];
+            new_buckets[bucket] = node;
+            node = next;
+        }
+    }
+}
+
+void loaderHandleIndexDestroy(struct loader_handle_index *index) {
+    if (index->buckets != index->initial_buckets) {
+        loader_instance_heap_free(NULL, index->buckets);
+    }
+    loaderHandleIndexInit(index);
+}
+
+// Doubles past the entry count, so one step catches up however many inserts were made while an
+// earlier allocation failed
+static void loaderHandleIndexGrow(struct loader_handle_index *index) {
+    uint32_t new_count = index->bucket_count * 2;
+    while (new_count <= index->count) {
+        new_count *= 2;
+    }
+    size_t size = new_count * sizeof(struct loader_handle_index_node *);
+    struct loader_handle_index_node **new_buckets = loader_instance_heap_alloc(NULL, size, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (NULL == new_buckets) {
+        return;
+    }
+
+    loaderHandleIndexRehash(index, new_buckets, new_count);
+    if (index->buckets != index->initial_buckets) {
+        loader_instance_heap_free(NULL, index->buckets);
+    }
+    index->buckets = new_buckets;
+    index->bucket_count = new_count;
+}
+
+void loaderHandleIndexInsert(struct loader_handle_index *index, struct loader_handle_index_node *node, const void *key,
+                             void *object) {
+    if (index->count >= index->bucket_count) {
+        loaderHandleIndexGrow(index);
+    }
+
+    uint32_t bucket = loaderHandleIndexBucket(key, index->bucket_count);
+    node->key = key;
+    node->object = object;
+    node->next = index->buckets[bucket];
+    index->buckets[bucket] = node;
+    index->count++;
+}
+
+void loaderHandleIndexRemove(struct loader_handle_index *index, struct loader_handle_index_node *node) {
+    if (NULL == node->key) {
+        return;
+    }
+
+    struct loader_handle_index_node **link = &index->buckets[loaderHandleIndexBucket(node->key, index->bucket_count)];
+    while (NULL != *link) {
+        if (*link == node) {
+            *link = node->next;
+            index->count--;
+            break;
+        }
+        link = &(*link)->next;
+    }
+    node->key = NULL;
+    node->object = NULL;
+    node->next = NULL;
+}
+
+void *loaderHandleIndexFind(const struct loader_handle_index *index, const void *key) {
+    for (struct loader_handle_index_node *node = index->buckets[loaderHandleIndexBucket(key, index->bucket_count)]; NULL != node;
+         node = node->next) {
+        if (node->key == key) {
+            return node->object;
+        }
+    }
+    return NULL;
+}
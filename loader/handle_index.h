@@ -0,0 +1,49 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LOADER_HANDLE_INDEX_H
+#define LOADER_HANDLE_INDEX_H
+
+#include "loader.h"
+
+// Hash indexes used to map a dispatchable handle back to its loader object.
+//
+// Layers may wrap instances and devices, so the loader can't use a handle as a pointer to its own
+// object.  Every handle it is given does start with the dispatch table pointer the loader installed
+// though, and that pointer is unique to the loader_instance or loader_device.  The index is keyed on
+// that pointer so lookups stay constant time regardless of how many instances and devices are alive.
+//
+// Nodes are embedded in the objects.  The bucket array grows as the index fills; if that allocation
+// fails the index keeps working with longer chains.  The index outlives every instance, so the
+// array doesn't come from instance allocation callbacks and is only freed by
+// loaderHandleIndexDestroy.
+//
+// Lookups must be made with loader_instance_list_lock held for reading and changes with it held for
+// writing.
+
+void loaderHandleIndexInit(struct loader_handle_index *index);
+void loaderHandleIndexDestroy(struct loader_handle_index *index);
+void loaderHandleIndexInsert(struct loader_handle_index *index, struct loader_handle_index_node *node, const void *key,
+                             void *object);
+// Does nothing if the node is not in the index
+void loaderHandleIndexRemove(struct loader_handle_index *index, struct loader_handle_index_node *node);
+void *loaderHandleIndexFind(const struct loader_handle_index *index, const void *key);
+
+#endif  // LOADER_HANDLE_INDEX_H
@@ -0,0 +1,133 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string.h>
+
+#include "vk_loader_platform.h"
+#include "loader.h"
+#include "icd_ext_cache.h"
+#include "manifest_cache.h"
+
+struct loader_icd_ext_cache_entry {
+    struct loader_icd_ext_cache_entry *next;
+    struct loader_manifest_cache_stat lib_stat;
+    uint32_t ext_count;
+    VkExtensionProperties *exts;
+    // The library path follows the extensions
+    char *lib_name;
+};
+
+static struct loader_icd_ext_cache_entry *g_icd_ext_cache;
+static loader_platform_thread_mutex g_icd_ext_cache_lock;
+
+// Returns false if lib_name can't be cached
+static bool loaderIcdExtCacheStatLibrary(const char *lib_name, struct loader_manifest_cache_stat *lib_stat) {
+    if (!loader_platform_is_path(lib_name)) {
+        return false;
+    }
+    loaderManifestCacheStatPath(lib_name, lib_stat);
+    return 0 != lib_stat->exists;
+}
+
+// Must be called with g_icd_ext_cache_lock held
+static struct loader_icd_ext_cache_entry *loaderIcdExtCacheFind(const char *lib_name) {
+    struct loader_manifest_cache_stat lib_stat;
+    if (!loaderIcdExtCacheStatLibrary(lib_name, &lib_stat)) {
+        return NULL;
+    }
+    for (struct loader_icd_ext_cache_entry *entry = g_icd_ext_cache; NULL != entry; entry = entry->next) {
+        if (!strcmp(entry->lib_name, lib_name)) {
+            return loaderManifestCacheStatEqual(&entry->lib_stat, &lib_stat) ? entry : NULL;
+        }
+    }
+    return NULL;
+}
+
+bool loaderIcdExtCacheContains(const char *lib_name) {
+    loader_platform_thread_lock_mutex(&g_icd_ext_cache_lock);
+    bool found = NULL != loaderIcdExtCacheFind(lib_name);
+    loader_platform_thread_unlock_mutex(&g_icd_ext_cache_lock);
+    return found;
+}
+
+VkResult loaderIcdExtCacheCopy(const struct loader_instance *inst, const char *lib_name, struct loader_extension_list *exts,
+                               bool *found) {
+    VkResult res = VK_SUCCESS;
+
+    loader_platform_thread_lock_mutex(&g_icd_ext_cache_lock);
+    const struct loader_icd_ext_cache_entry *entry = loaderIcdExtCacheFind(lib_name);
+    *found = NULL != entry;
+    if (NULL != entry && 0 != entry->ext_count) {
+        res = loader_add_to_ext_list(inst, exts, entry->ext_count, entry->exts);
+    }
+    loader_platform_thread_unlock_mutex(&g_icd_ext_cache_lock);
+    return res;
+}
+
+// Must be called with g_icd_ext_cache_lock held
+static void loaderIcdExtCacheRemove(const char *lib_name) {
+    for (struct loader_icd_ext_cache_entry **link = &g_icd_ext_cache; NULL != *link; link = &(*link)->next) {
+        if (!strcmp((*link)->lib_name, lib_name)) {
+            struct loader_icd_ext_cache_entry *entry = *link;
+            *link = entry->next;
+            loader_instance_heap_free(NULL, entry);
+            return;
+        }
+    }
+}
+
+void loaderIcdExtCacheStore(const char *lib_name, const struct loader_extension_list *exts) {
+    struct loader_manifest_cache_stat lib_stat;
+    if (!loaderIcdExtCacheStatLibrary(lib_name, &lib_stat)) {
+        return;
+    }
+
+    size_t exts_size = exts->count * sizeof(VkExtensionProperties);
+    struct loader_icd_ext_cache_entry *entry = loader_instance_heap_alloc(
+        NULL, sizeof(struct loader_icd_ext_cache_entry) + exts_size + strlen(lib_name) + 1, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (NULL == entry) {
+        return;
+    }
+    entry->lib_stat = lib_stat;
+    entry->ext_count = exts->count;
+    entry->exts = (VkExtensionProperties *)(entry + 1);
+    if (0 != exts_size) {
+        memcpy(entry->exts, exts->list, exts_size);
+    }
+    entry->lib_name = (char *)entry->exts + exts_size;
+    strcpy(entry->lib_name, lib_name);
+
+    loader_platform_thread_lock_mutex(&g_icd_ext_cache_lock);
+    loaderIcdExtCacheRemove(lib_name);
+    entry->next = g_icd_ext_cache;
+    g_icd_ext_cache = entry;
+    loader_platform_thread_unlock_mutex(&g_icd_ext_cache_lock);
+}
+
+void loaderIcdExtCacheInit(void) { loader_platform_thread_create_mutex(&g_icd_ext_cache_lock); }
+
+void loaderIcdExtCacheRelease(void) {
+    while (NULL != g_icd_ext_cache) {
+        struct loader_icd_ext_cache_entry *entry = g_icd_ext_cache;
+        g_icd_ext_cache = entry->next;
+        loader_instance_heap_free(NULL, entry);
+    }
+    loader_platform_thread_delete_mutex(&g_icd_ext_cache_lock);
+}
@@ -0,0 +1,54 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LOADER_ICD_EXT_CACHE_H
+#define LOADER_ICD_EXT_CACHE_H
+
+#include "loader.h"
+
+// Process-wide cache of the instance extensions each ICD library reports.
+//
+// vkEnumerateInstanceExtensionProperties used to open every installed driver, ask it for its
+// instance extensions and close it again on every call.  Opening a driver maps it and runs its
+// constructors, and applications often call the function several times before creating an
+// instance.  The lists are kept here, keyed by the library path and the library file's identity,
+// so later calls only open drivers that are new or whose library has changed.  Libraries named
+// without a path are found through the dynamic linker's search path and can't be stat'ed, so
+// they are never cached.
+//
+// The lists are the ones the ICD returned, before the loader's filtering, so changing
+// VK_LOADER_DISABLE_INST_EXT_FILTER still takes effect.  Like the other process-wide tables the
+// cache outlives instances and doesn't use instance allocation callbacks.  It has its own lock,
+// since ICD scans look it up both with and without loader_json_lock held.
+
+bool loaderIcdExtCacheContains(const char *lib_name);
+
+// Appends the cached extensions for lib_name to exts.  *found is false if there are none.
+VkResult loaderIcdExtCacheCopy(const struct loader_instance *inst, const char *lib_name, struct loader_extension_list *exts,
+                               bool *found);
+
+// Replaces the extensions cached for lib_name.  Failing to allocate just leaves it uncached.
+void loaderIcdExtCacheStore(const char *lib_name, const struct loader_extension_list *exts);
+
+// Called from loader_initialize and loader_release
+void loaderIcdExtCacheInit(void);
+void loaderIcdExtCacheRelease(void);
+
+#endif  // LOADER_ICD_EXT_CACHE_H
@@ -0,0 +1,112 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string.h>
+
+#include "vk_loader_platform.h"
+#include "loader.h"
+#include "instance_arena.h"
+
+// The first block holds an instance's ICD terminators on a typical system, and each new block
+// doubles in size up to the maximum.  Anything bigger than the maximum gets a block of its own.
+#define LOADER_INSTANCE_ARENA_FIRST_BLOCK_SIZE (16 * 1024)
+#define LOADER_INSTANCE_ARENA_MAX_BLOCK_SIZE (128 * 1024)
+
+// Same alignment as the loader's other internal allocations
+#define LOADER_INSTANCE_ARENA_ALIGN sizeof(uint64_t)
+
+// The block's memory follows the header
+struct loader_instance_arena_block {
+    struct loader_instance_arena_block *next;
+    size_t size;
+};
+
+void loaderInstanceArenaInit(struct loader_instance_arena *arena) {
+    memset(arena, 0, sizeof(*arena));
+    loader_platform_thread_create_mutex(&arena->lock);
+}
+
+void loaderInstanceArenaDestroy(const struct loader_instance *inst, struct loader_instance_arena *arena) {
+    while (NULL != arena->blocks) {
+        struct loader_instance_arena_block *next = arena->blocks->next;
+        loader_instance_heap_free(inst, arena->blocks);
+        arena->blocks = next;
+    }
+    loader_platform_thread_delete_mutex(&arena->lock);
+    memset(arena, 0, sizeof(*arena));
+}
+
+// Must be called with the arena's lock held
+static bool loaderInstanceArenaAddBlock(const struct loader_instance *inst, struct loader_instance_arena *arena, size_t min_size) {
+    size_t size = LOADER_INSTANCE_ARENA_FIRST_BLOCK_SIZE;
+    if (NULL != arena->blocks) {
+        size = arena->blocks->size * 2 > LOADER_INSTANCE_ARENA_MAX_BLOCK_SIZE ? LOADER_INSTANCE_ARENA_MAX_BLOCK_SIZE
+                                                                             : arena->blocks->size * 2;
+    }
+    if (size < min_size) {
+        size = min_size;
+    }
+
+    struct loader_instance_arena_block *block =
+        loader_instance_heap_alloc(inst, sizeof(struct loader_instance_arena_block) + size, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (NULL == block) {
+        return false;
+    }
+    block->size = size;
+    block->next = arena->blocks;
+    arena->blocks = block;
+    arena->next = (char *)(block + 1);
+    arena->end = arena->next + size;
+    return true;
+}
+
+// Returns the padding needed to align the arena's next allocation.  Must be called with the
+// arena's lock held.
+static size_t loaderInstanceArenaPadding(const struct loader_instance_arena *arena, size_t alignment) {
+    return (alignment - ((uintptr_t)arena->next & (alignment - 1))) & (alignment - 1);
+}
+
+void *loaderInstanceArenaAllocAligned(const struct loader_instance *inst, size_t size, size_t alignment) {
+    // The arena is synchronized on its own, so like the heap functions it can be used through a
+    // const instance.
+    struct loader_instance_arena *arena = (struct loader_instance_arena *)&inst->arena;
+    void *pMemory = NULL;
+
+    if (alignment < LOADER_INSTANCE_ARENA_ALIGN) {
+        alignment = LOADER_INSTANCE_ARENA_ALIGN;
+    }
+    size = (size + LOADER_INSTANCE_ARENA_ALIGN - 1) & ~(LOADER_INSTANCE_ARENA_ALIGN - 1);
+
+    loader_platform_thread_lock_mutex(&arena->lock);
+    // Blocks are only aligned like loader_instance_heap_alloc, so a new one may need padding too
+    if ((size_t)(arena->end - arena->next) >= loaderInstanceArenaPadding(arena, alignment) + size ||
+        loaderInstanceArenaAddBlock(inst, arena, size + alignment - LOADER_INSTANCE_ARENA_ALIGN)) {
+        arena->next += loaderInstanceArenaPadding(arena, alignment);
+        pMemory = arena->next;
+        arena->next += size;
+    }
+    loader_platform_thread_unlock_mutex(&arena->lock);
+
+    return pMemory;
+}
+
+void *loaderInstanceArenaAlloc(const struct loader_instance *inst, size_t size) {
+    return loaderInstanceArenaAllocAligned(inst, size, LOADER_INSTANCE_ARENA_ALIGN);
+}
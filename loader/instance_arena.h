@@ -0,0 +1,55 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LOADER_INSTANCE_ARENA_H
+#define LOADER_INSTANCE_ARENA_H
+
+#include "loader.h"
+
+// Per-instance arena for the loader's bookkeeping objects that are never freed before the
+// instance is destroyed.
+//
+// ICD terminators, the physical device objects of the trampoline and terminator, the tables and
+// entries of the unknown function maps, the records in the instance's device pool, and the
+// instance's dispatch table are carved out of a few blocks rather than each taking a call to the
+// application's allocator.  The arena gets its blocks from loader_instance_heap_alloc, so the
+// application's VkAllocationCallbacks still provide all of the memory, and the blocks are freed
+// together when the instance is destroyed.
+//
+// Memory from the arena is never freed on its own.  An object that is dropped early, such as a
+// physical device that disappeared or an ICD that failed to create its instance, stays in the
+// arena until the instance is destroyed.  Only use the arena for objects where that is rare.
+//
+// The arena has its own lock, so it can be used from any thread that can use the instance.
+
+void loaderInstanceArenaInit(struct loader_instance_arena *arena);
+
+// Frees every block with the instance's current allocation callbacks.  Called from
+// vkDestroyInstance, and from vkCreateInstance when it fails, once nothing uses the arena.
+void loaderInstanceArenaDestroy(const struct loader_instance *inst, struct loader_instance_arena *arena);
+
+// Returns uninitialized memory aligned like loader_instance_heap_alloc, or NULL when a new block
+// can't be allocated.
+void *loaderInstanceArenaAlloc(const struct loader_instance *inst, size_t size);
+
+// Like loaderInstanceArenaAlloc, with a power of two alignment such as LOADER_CACHE_LINE_SIZE
+void *loaderInstanceArenaAllocAligned(const struct loader_instance *inst, size_t size, size_t alignment);
+
+#endif  // LOADER_INSTANCE_ARENA_H
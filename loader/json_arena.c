@@ -0,0 +1,128 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string.h>
+
+#include "vk_loader_platform.h"
+#include "loader.h"
+#include "json_arena.h"
+
+// The first chunk is big enough for a typical layer manifest, and each new chunk doubles in size
+// up to the maximum so a scan over many manifests only needs a handful.
+#define LOADER_JSON_ARENA_FIRST_CHUNK_SIZE (16 * 1024)
+#define LOADER_JSON_ARENA_MAX_CHUNK_SIZE (1024 * 1024)
+
+// Everything handed out is aligned to the largest unit, like the loader's other internal
+// allocations
+#define LOADER_JSON_ARENA_ALIGN sizeof(uint64_t)
+
+// The chunk's memory follows the header
+struct loader_json_arena_chunk {
+    struct loader_json_arena_chunk *next;
+    size_t size;
+};
+
+static THREAD_LOCAL_DECL struct loader_json_arena *tls_json_arena;
+
+void loaderJsonArenaBegin(const struct loader_instance *inst, struct loader_json_arena *arena) {
+    memset(arena, 0, sizeof(*arena));
+    if (NULL != tls_json_arena) {
+        return;
+    }
+    arena->inst = inst;
+    arena->active = true;
+    tls_json_arena = arena;
+}
+
+void loaderJsonArenaEnd(struct loader_json_arena *arena) {
+    if (!arena->active) {
+        return;
+    }
+    tls_json_arena = NULL;
+    while (NULL != arena->chunks) {
+        struct loader_json_arena_chunk *next = arena->chunks->next;
+        loader_instance_heap_free(arena->inst, arena->chunks);
+        arena->chunks = next;
+    }
+    memset(arena, 0, sizeof(*arena));
+}
+
+static bool loaderJsonArenaAddChunk(struct loader_json_arena *arena, size_t min_size) {
+    size_t size = NULL == arena->chunks ? LOADER_JSON_ARENA_FIRST_CHUNK_SIZE : arena->chunks->size * 2;
+    if (size > LOADER_JSON_ARENA_MAX_CHUNK_SIZE) {
+        size = LOADER_JSON_ARENA_MAX_CHUNK_SIZE;
+    }
+    if (size < min_size) {
+        size = min_size;
+    }
+
+    struct loader_json_arena_chunk *chunk = loader_instance_heap_alloc(
+        arena->inst, sizeof(struct loader_json_arena_chunk) + size, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == chunk) {
+        return false;
+    }
+    chunk->size = size;
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    arena->next = (char *)(chunk + 1);
+    arena->end = arena->next + size;
+    arena->last = NULL;
+    return true;
+}
+
+static bool loaderJsonArenaOwns(const struct loader_json_arena *arena, const void *pMemory) {
+    for (const struct loader_json_arena_chunk *chunk = arena->chunks; NULL != chunk; chunk = chunk->next) {
+        const char *data = (const char *)(chunk + 1);
+        if ((const char *)pMemory >= data && (const char *)pMemory < data + chunk->size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void *loaderJsonArenaAlloc(size_t size) {
+    struct loader_json_arena *arena = tls_json_arena;
+    if (NULL == arena) {
+        return loader_instance_tls_heap_alloc(size);
+    }
+
+    size = (size + LOADER_JSON_ARENA_ALIGN - 1) & ~(LOADER_JSON_ARENA_ALIGN - 1);
+    if ((size_t)(arena->end - arena->next) < size && !loaderJsonArenaAddChunk(arena, size)) {
+        return NULL;
+    }
+    arena->last = arena->next;
+    arena->next += size;
+    return arena->last;
+}
+
+void loaderJsonArenaFree(void *pMemory) {
+    struct loader_json_arena *arena = tls_json_arena;
+    if (NULL == pMemory) {
+        return;
+    }
+    if (NULL == arena || !loaderJsonArenaOwns(arena, pMemory)) {
+        loader_instance_tls_heap_free(pMemory);
+        return;
+    }
+    if (pMemory == arena->last) {
+        arena->next = arena->last;
+        arena->last = NULL;
+    }
+}
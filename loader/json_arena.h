@@ -0,0 +1,58 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LOADER_JSON_ARENA_H
+#define LOADER_JSON_ARENA_H
+
+#include "loader.h"
+
+// Arena for the cJSON trees built while scanning manifests.
+//
+// cJSON allocates a node for every value and a copy of every key and string, and frees each of
+// them again when the tree is deleted.  A scan over a few large manifests turns into thousands of
+// calls to the application's allocator.  While an arena is active on a thread, the cJSON hooks
+// carve those allocations out of a few large chunks instead.  Freeing arena memory does nothing
+// unless it was the latest allocation, which covers cJSON_Print's scratch buffers.  The chunks are
+// released all at once when the arena ends.
+//
+// An arena covers a whole scan, so nothing cJSON allocated during the scan may be kept after it.
+// Beginning an arena while one is already active on the thread just uses the outer one.
+
+struct loader_json_arena_chunk;
+
+struct loader_json_arena {
+    const struct loader_instance *inst;
+    struct loader_json_arena_chunk *chunks;
+    char *next;
+    char *end;
+    // Most recent allocation, which can be given back by freeing it
+    char *last;
+    bool active;
+};
+
+void loaderJsonArenaBegin(const struct loader_instance *inst, struct loader_json_arena *arena);
+void loaderJsonArenaEnd(struct loader_json_arena *arena);
+
+// cJSON allocation hooks.  Without an active arena they use loader_instance_tls_heap_alloc and
+// loader_instance_tls_heap_free.
+void *loaderJsonArenaAlloc(size_t size);
+void loaderJsonArenaFree(void *pMemory);
+
+#endif  // LOADER_JSON_ARENA_H
@@ -63,7 +63,16 @@
 #include "wsi.h"
 #include "vulkan/vk_icd.h"
 #include "cJSON.h"
-#include "murmurhash.h"
+#include "json_arena.h"
+#include "manifest_cache.h"
+#include "scan_snapshot.h"
+#include "handle_index.h"
+#include "icd_ext_cache.h"
+#include "instance_arena.h"
+#include "log_sink.h"
+#include "string_table.h"
+#include "unknown_ext_jit.h"
+#include "unknown_ext_map.h"
 
 #if defined(_WIN32)
 #include <cfgmgr32.h>
@@ -119,7 +128,7 @@ enum loader_data_files_type {
 // thread safety lock for accessing global data structures such as "loader"
 // all entrypoints on the instance chain need to be locked except GPA
 // additionally CreateDevice and DestroyDevice needs to be locked
-loader_platform_thread_mutex loader_lock;
+loader_platform_thread_rwlock loader_instance_list_lock;
 loader_platform_thread_mutex loader_json_lock;
 
 LOADER_PLATFORM_THREAD_ONCE_DECLARATION(once_init);
@@ -373,48 +382,100 @@ static inline void loader_free_getenv(char *val, const struct loader_instance *i
 
 #endif
 
+// Writes the "INFO | WARNING: " style prefix used for messages written to stderr and returns its length.
+// The prefix buffer must hold at least 64 characters.
+static size_t loader_log_prefix(VkFlags msg_type, char *prefix) {
+    static const struct {
+        VkFlags bit;
+        const char *name;
+    } names[] = {
+        {LOADER_INFO_BIT, "INFO"}, {LOADER_WARN_BIT, "WARNING"}, {LOADER_PERF_BIT, "PERF"},
+        {LOADER_ERROR_BIT, "ERROR"}, {LOADER_DEBUG_BIT, "DEBUG"},
+    };
+
+    prefix[0] = '\0';
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if ((msg_type & names[i].bit) != 0) {
+            if (prefix[0] != '\0') {
+                strcat(prefix, " | ");
+            }
+            strcat(prefix, names[i].name);
+        }
+    }
+    if (prefix[0] != '\0') {
+        strcat(prefix, ": ");
+    }
+    return strlen(prefix);
+}
+
 void loader_log(const struct loader_instance *inst, VkFlags msg_type, int32_t msg_code, const char *format, ...) {
-    char msg[512];
-    char cmd_line_msg[512];
-    size_t cmd_line_size = sizeof(cmd_line_msg);
+    char stack_buffer[512];
+    char *buffer = stack_buffer;
+    char *heap_buffer = NULL;
+    size_t prefix_len = 0;
+    VkDebugUtilsMessageSeverityFlagBitsEXT severity = 0;
+    VkDebugUtilsMessageTypeFlagsEXT type;
     va_list ap;
     int ret;
 
-    va_start(ap, format);
-    ret = vsnprintf(msg, sizeof(msg), format, ap);
-    if ((ret >= (int)sizeof(msg)) || ret < 0) {
-        msg[sizeof(msg) - 1] = '\0';
+    if ((msg_type & LOADER_INFO_BIT) != 0) {
+        severity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+    } else if ((msg_type & LOADER_WARN_BIT) != 0) {
+        severity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT;
+    } else if ((msg_type & LOADER_ERROR_BIT) != 0) {
+        severity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    } else if ((msg_type & LOADER_DEBUG_BIT) != 0) {
+        severity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
     }
-    va_end(ap);
 
-    if (inst) {
-        VkDebugUtilsMessageSeverityFlagBitsEXT severity = 0;
-        VkDebugUtilsMessageTypeFlagsEXT type;
-        VkDebugUtilsMessengerCallbackDataEXT callback_data;
-        VkDebugUtilsObjectNameInfoEXT object_name;
+    if ((msg_type & LOADER_PERF_BIT) != 0) {
+        type = VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    } else {
+        type = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT;
+    }
 
-        if ((msg_type & LOADER_INFO_BIT) != 0) {
-            severity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
-        } else if ((msg_type & LOADER_WARN_BIT) != 0) {
-            severity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT;
-        } else if ((msg_type & LOADER_ERROR_BIT) != 0) {
-            severity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
-        } else if ((msg_type & LOADER_DEBUG_BIT) != 0) {
-            severity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
-        }
+    // Discovery logs many INFO and DEBUG messages that are normally filtered out, so don't format
+    // a message unless a callback or VK_LOADER_DEBUG is going to see it.
+    bool to_callbacks = NULL != inst && util_DebugUtilsMessageWanted(inst, severity, type);
+    bool to_stderr = (msg_type & g_loader_log_msgs) != 0;
+    if (!to_callbacks && !to_stderr) {
+        return;
+    }
 
-        if ((msg_type & LOADER_PERF_BIT) != 0) {
-            type = VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
-        } else {
-            type = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT;
-        }
+    // The stderr prefix goes in front of the message so the line can be written in one call
+    if (to_stderr) {
+        prefix_len = loader_log_prefix(msg_type, stack_buffer);
+    }
+
+    va_start(ap, format);
+    ret = vsnprintf(buffer + prefix_len, sizeof(stack_buffer) - prefix_len, format, ap);
+    va_end(ap);
+    if (ret < 0) {
+        buffer[prefix_len] = '\0';
+    } else if ((size_t)ret >= sizeof(stack_buffer) - prefix_len) {
+        // Too long for the stack buffer, so format it again into one that fits.  If that can't be
+        // allocated the truncated message is still better than none.
+        size_t size = prefix_len + (size_t)ret + 1;
+        heap_buffer = loader_instance_heap_alloc(inst, size, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+        if (NULL != heap_buffer) {
+            memcpy(heap_buffer, stack_buffer, prefix_len);
+            va_start(ap, format);
+            vsnprintf(heap_buffer + prefix_len, size - prefix_len, format, ap);
+            va_end(ap);
+            buffer = heap_buffer;
+        }
+    }
+
+    if (to_callbacks) {
+        VkDebugUtilsMessengerCallbackDataEXT callback_data;
+        VkDebugUtilsObjectNameInfoEXT object_name;
 
         callback_data.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CALLBACK_DATA_EXT;
         callback_data.pNext = NULL;
         callback_data.flags = 0;
         callback_data.pMessageIdName = "Loader Message";
         callback_data.messageIdNumber = 0;
-        callback_data.pMessage = msg;
+        callback_data.pMessage = buffer + prefix_len;
         callback_data.queueLabelCount = 0;
         callback_data.pQueueLabels = NULL;
         callback_data.cmdBufLabelCount = 0;
@@ -430,74 +491,21 @@ void loader_log(const struct loader_instance *inst, VkFlags msg_type, int32_t ms
         util_SubmitDebugUtilsMessageEXT(inst, severity, type, &callback_data);
     }
 
-    if (!(msg_type & g_loader_log_msgs)) {
-        return;
-    }
-
-    cmd_line_msg[0] = '\0';
-    cmd_line_size -= 1;
-    size_t original_size = cmd_line_size;
-
-    if ((msg_type & LOADER_INFO_BIT) != 0) {
-        strncat(cmd_line_msg, "INFO", cmd_line_size);
-        cmd_line_size -= 4;
-    }
-    if ((msg_type & LOADER_WARN_BIT) != 0) {
-        if (cmd_line_size != original_size) {
-            strncat(cmd_line_msg, " | ", cmd_line_size);
-            cmd_line_size -= 3;
-        }
-        strncat(cmd_line_msg, "WARNING", cmd_line_size);
-        cmd_line_size -= 7;
-    }
-    if ((msg_type & LOADER_PERF_BIT) != 0) {
-        if (cmd_line_size != original_size) {
-            strncat(cmd_line_msg, " | ", cmd_line_size);
-            cmd_line_size -= 3;
-        }
-        strncat(cmd_line_msg, "PERF", cmd_line_size);
-        cmd_line_size -= 4;
-    }
-    if ((msg_type & LOADER_ERROR_BIT) != 0) {
-        if (cmd_line_size != original_size) {
-            strncat(cmd_line_msg, " | ", cmd_line_size);
-            cmd_line_size -= 3;
-        }
-        strncat(cmd_line_msg, "ERROR", cmd_line_size);
-        cmd_line_size -= 5;
-    }
-    if ((msg_type & LOADER_DEBUG_BIT) != 0) {
-        if (cmd_line_size != original_size) {
-            strncat(cmd_line_msg, " | ", cmd_line_size);
-            cmd_line_size -= 3;
-        }
-        strncat(cmd_line_msg, "DEBUG", cmd_line_size);
-        cmd_line_size -= 5;
-    }
-    if (cmd_line_size != original_size) {
-        strncat(cmd_line_msg, ": ", cmd_line_size);
-        cmd_line_size -= 2;
-    }
+    if (to_stderr) {
+        if (loaderLogSinkEnabled()) {
+            loaderLogSinkWrite(buffer, strlen(buffer));
+        } else {
+#if defined(WIN32)
+            OutputDebugString(buffer);
+            OutputDebugString("\n");
+#endif
 
-    if (0 < cmd_line_size) {
-        // If the message is too long, trim it down
-        if (strlen(msg) > cmd_line_size) {
-            msg[cmd_line_size - 1] = '\0';
+            fputs(buffer, stderr);
+            fputc('\n', stderr);
         }
-        strncat(cmd_line_msg, msg, cmd_line_size);
-    } else {
-        // Shouldn't get here, but check to make sure if we've already overrun
-        // the string boundary
-        assert(false);
     }
 
-#if defined(WIN32)
-    OutputDebugString(cmd_line_msg);
-    OutputDebugString("\n");
-#endif
-
-    fputs(cmd_line_msg, stderr);
-    fputc('\n', stderr);
+    loader_instance_heap_free(inst, heap_buffer);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL vkSetInstanceDispatch(VkInstance instance, void *object) {
@@ -1131,8 +1139,8 @@ bool has_vk_dev_ext_property(const VkExtensionProperties *ext_prop, const struct
 }
 
 // Get the next unused layer property in the list. Init the property to zero.
-static struct loader_layer_properties *loaderGetNextLayerPropertySlot(const struct loader_instance *inst,
-                                                                      struct loader_layer_list *layer_list) {
+struct loader_layer_properties *loaderGetNextLayerPropertySlot(const struct loader_instance *inst,
+                                                               struct loader_layer_list *layer_list) {
     if (layer_list->capacity == 0) {
         layer_list->list =
             loader_instance_heap_alloc(inst, sizeof(struct loader_layer_properties) * 64, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
@@ -1210,40 +1218,117 @@ static bool loaderFindLayerNameInBlacklist(const struct loader_instance *inst, c
     return false;
 }
 
-// Remove all layer properties entries from the list
-void loaderDeleteLayerListAndProperties(const struct loader_instance *inst, struct loader_layer_list *layer_list) {
-    uint32_t i, j, k;
+// Free everything a single layer property owns, but not the property itself
+void loaderFreeLayerProperties(const struct loader_instance *inst, struct loader_layer_properties *layer_properties) {
+    uint32_t j, k;
     struct loader_device_extension_list *dev_ext_list;
     struct loader_dev_ext_props *ext_props;
-    if (!layer_list) return;
 
-    for (i = 0; i < layer_list->count; i++) {
-        if (NULL != layer_list->list[i].blacklist_layer_names) {
-            loader_instance_heap_free(inst, layer_list->list[i].blacklist_layer_names);
-            layer_list->list[i].blacklist_layer_names = NULL;
-        }
-        if (NULL != layer_list->list[i].component_layer_names) {
-            loader_instance_heap_free(inst, layer_list->list[i].component_layer_names);
-            layer_list->list[i].component_layer_names = NULL;
-        }
-        if (NULL != layer_list->list[i].override_paths) {
-            loader_instance_heap_free(inst, layer_list->list[i].override_paths);
-            layer_list->list[i].override_paths = NULL;
-        }
-        loader_destroy_generic_list(inst, (struct loader_generic_list *)&layer_list->list[i].instance_extension_list);
-        dev_ext_list = &layer_list->list[i].device_extension_list;
-        if (dev_ext_list->capacity > 0 && NULL != dev_ext_list->list) {
-            for (j = 0; j < dev_ext_list->count; j++) {
-                ext_props = &dev_ext_list->list[j];
-                if (ext_props->entrypoint_count > 0) {
-                    for (k = 0; k < ext_props->entrypoint_count; k++) {
-                        loader_instance_heap_free(inst, ext_props->entrypoints[k]);
-                    }
-                    loader_instance_heap_free(inst, ext_props->entrypoints);
+    if (NULL != layer_properties->blacklist_layer_names) {
+        loader_instance_heap_free(inst, layer_properties->blacklist_layer_names);
+        layer_properties->blacklist_layer_names = NULL;
+    }
+    if (NULL != layer_properties->component_layer_names) {
+        loader_instance_heap_free(inst, layer_properties->component_layer_names);
+        layer_properties->component_layer_names = NULL;
+    }
+    if (NULL != layer_properties->override_paths) {
+        loader_instance_heap_free(inst, layer_properties->override_paths);
+        layer_properties->override_paths = NULL;
+    }
+    loader_destroy_generic_list(inst, (struct loader_generic_list *)&layer_properties->instance_extension_list);
+    dev_ext_list = &layer_properties->device_extension_list;
+    if (dev_ext_list->capacity > 0 && NULL != dev_ext_list->list) {
+        for (j = 0; j < dev_ext_list->count; j++) {
+            ext_props = &dev_ext_list->list[j];
+            if (ext_props->entrypoint_count > 0) {
+                for (k = 0; k < ext_props->entrypoint_count; k++) {
+                    loader_instance_heap_free(inst, ext_props->entrypoints[k]);
                 }
+                loader_instance_heap_free(inst, ext_props->entrypoints);
             }
         }
-        loader_destroy_generic_list(inst, (struct loader_generic_list *)dev_ext_list);
+    }
+    loader_destroy_generic_list(inst, (struct loader_generic_list *)dev_ext_list);
+    loaderStringTableReleaseGeneration(layer_properties->strings);
+    layer_properties->strings = NULL;
+}
+
+// Deep copy a layer property, so the copy shares no memory with the source.  The library handle
+// is not copied since every list opens its own.
+VkResult loaderCopyLayerProperties(const struct loader_instance *inst, struct loader_layer_properties *dst,
+                                   const struct loader_layer_properties *src) {
+    VkResult res = VK_SUCCESS;
+
+    memcpy(dst, src, sizeof(struct loader_layer_properties));
+    dst->lib_handle = NULL;
+    dst->component_layer_names = NULL;
+    dst->override_paths = NULL;
+    dst->blacklist_layer_names = NULL;
+    memset(&dst->instance_extension_list, 0, sizeof(struct loader_extension_list));
+    memset(&dst->device_extension_list, 0, sizeof(struct loader_device_extension_list));
+
+    // The strings are interned, so only the arrays pointing at them need copying, and the copy
+    // keeps them alive too
+    dst->strings = loaderStringTableRetainGeneration(src->strings);
+    if (src->num_component_layers > 0) {
+        dst->component_layer_names =
+            loader_instance_heap_alloc(inst, sizeof(const char *) * src->num_component_layers, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+        if (NULL == dst->component_layer_names) {
+            res = VK_ERROR_OUT_OF_HOST_MEMORY;
+            goto out;
+        }
+        memcpy(dst->component_layer_names, src->component_layer_names, sizeof(const char *) * src->num_component_layers);
+    }
+    if (src->num_override_paths > 0) {
+        dst->override_paths =
+            loader_instance_heap_alloc(inst, sizeof(const char *) * src->num_override_paths, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+        if (NULL == dst->override_paths) {
+            res = VK_ERROR_OUT_OF_HOST_MEMORY;
+            goto out;
+        }
+        memcpy(dst->override_paths, src->override_paths, sizeof(const char *) * src->num_override_paths);
+    }
+    if (src->num_blacklist_layers > 0) {
+        dst->blacklist_layer_names =
+            loader_instance_heap_alloc(inst, sizeof(const char *) * src->num_blacklist_layers, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+        if (NULL == dst->blacklist_layer_names) {
+            res = VK_ERROR_OUT_OF_HOST_MEMORY;
+            goto out;
+        }
+        memcpy(dst->blacklist_layer_names, src->blacklist_layer_names, sizeof(const char *) * src->num_blacklist_layers);
+    }
+
+    if (src->instance_extension_list.count > 0) {
+        res = loader_add_to_ext_list(inst, &dst->instance_extension_list, src->instance_extension_list.count,
+                                     src->instance_extension_list.list);
+        if (VK_SUCCESS != res) {
+            goto out;
+        }
+    }
+    for (uint32_t i = 0; i < src->device_extension_list.count; i++) {
+        const struct loader_dev_ext_props *ext_props = &src->device_extension_list.list[i];
+        res = loader_add_to_dev_ext_list(inst, &dst->device_extension_list, &ext_props->props, ext_props->entrypoint_count,
+                                         ext_props->entrypoints);
+        if (VK_SUCCESS != res) {
+            goto out;
+        }
+    }
+
+out:
+    if (VK_SUCCESS != res) {
+        loaderFreeLayerProperties(inst, dst);
+    }
+    return res;
+}
+
+// Remove all layer properties entries from the list
+void loaderDeleteLayerListAndProperties(const struct loader_instance *inst, struct loader_layer_list *layer_list) {
+    uint32_t i;
+    if (!layer_list) return;
+
+    for (i = 0; i < layer_list->count; i++) {
+        loaderFreeLayerProperties(inst, &layer_list->list[i]);
     }
     layer_list->count = 0;
 
@@ -1283,6 +1368,7 @@ void loaderRemoveLayersInBlacklist(const struct loader_instance *inst, struct lo
                 loader_instance_heap_free(inst, cur_layer_prop.override_paths);
                 // Never need to free the blacklist, since it can only exist in the override layer
             }
+            loaderStringTableReleaseGeneration(cur_layer_prop.strings);
 
             // Remove the current invalid meta-layer from the layer list.  Use memmove since we are
             // overlapping the source and destination addresses.
@@ -1350,6 +1436,7 @@ void loaderRemoveLayersNotInImplicitMetaLayers(const struct loader_instance *ins
                 loader_instance_heap_free(inst, cur_layer_prop.component_layer_names);
                 loader_instance_heap_free(inst, cur_layer_prop.override_paths);
             }
+            loaderStringTableReleaseGeneration(cur_layer_prop.strings);
 
             // Remove the current invalid meta-layer from the layer list.  Use memmove since we are
             // overlapping the source and destination addresses.
@@ -1782,12 +1869,12 @@ bool loaderImplicitLayerIsEnabled(const struct loader_instance *inst, const stru
     char *env_value = NULL;
 
     // If no enable_environment variable is specified, this implicit layer is always be enabled by default.
-    if (prop->enable_env_var.name[0] == 0) {
+    if (NULL == prop->enable_env_var.name) {
         enable = true;
     } else {
         // Otherwise, only enable this layer if the enable environment variable is defined
         env_value = loader_getenv(prop->enable_env_var.name, inst);
-        if (env_value && !strcmp(prop->enable_env_var.value, env_value)) {
+        if (env_value && !strcmp(NULL != prop->enable_env_var.value ? prop->enable_env_var.value : "", env_value)) {
             enable = true;
         }
         loader_free_getenv(env_value, inst);
@@ -1795,11 +1882,13 @@ bool loaderImplicitLayerIsEnabled(const struct loader_instance *inst, const stru
 
     // The disable_environment has priority over everything else.  If it is defined, the layer is always
     // disabled.
-    env_value = loader_getenv(prop->disable_env_var.name, inst);
-    if (env_value) {
-        enable = false;
+    if (NULL != prop->disable_env_var.name) {
+        env_value = loader_getenv(prop->disable_env_var.name, inst);
+        if (env_value) {
+            enable = false;
+        }
+        loader_free_getenv(env_value, inst);
     }
-    loader_free_getenv(env_value, inst);
 
     // If this layer has an expiration, check it to determine if this layer has expired.
     if (prop->has_expiration) {
@@ -1986,6 +2075,8 @@ static VkExtensionProperties *get_dev_extension_property(const char *name, const
 //                                    to this array.
 // The extension itself should be in a separate file that will be linked directly
 // with the loader.
+static bool loader_scanned_icd_open(const struct loader_instance *inst, struct loader_scanned_icd *scanned_icd);
+
 VkResult loader_get_icd_loader_instance_extensions(const struct loader_instance *inst, struct loader_icd_tramp_list *icd_tramp_list,
                                                    struct loader_extension_list *inst_exts) {
     struct loader_extension_list icd_exts;
@@ -2008,8 +2099,23 @@ VkResult loader_get_icd_loader_instance_extensions(const struct loader_instance
         if (VK_SUCCESS != res) {
             goto out;
         }
-        res = loader_add_instance_extensions(inst, icd_tramp_list->scanned_list[i].EnumerateInstanceExtensionProperties,
-                                             icd_tramp_list->scanned_list[i].lib_name, &icd_exts);
+        struct loader_scanned_icd *scanned_icd = &icd_tramp_list->scanned_list[i];
+        bool cached = false;
+        if (NULL == scanned_icd->handle) {
+            res = loaderIcdExtCacheCopy(inst, scanned_icd->lib_name, &icd_exts, &cached);
+            // If the library changed since the scan looked at the cache, it has to be asked after all
+            if (VK_SUCCESS == res && !cached && !loader_scanned_icd_open(inst, scanned_icd)) {
+                loader_destroy_generic_list(inst, (struct loader_generic_list *)&icd_exts);
+                continue;
+            }
+        }
+        if (VK_SUCCESS == res && !cached) {
+            res = loader_add_instance_extensions(inst, scanned_icd->EnumerateInstanceExtensionProperties, scanned_icd->lib_name,
+                                                 &icd_exts);
+            if (VK_SUCCESS == res) {
+                loaderIcdExtCacheStore(scanned_icd->lib_name, &icd_exts);
+            }
+        }
         if (VK_SUCCESS == res) {
             if (filter_extensions) {
                 // Remove any extensions not recognized by the loader
@@ -2050,25 +2156,77 @@ out:
 }
 
 struct loader_icd_term *loader_get_icd_and_device(const void *device, struct loader_device **found_dev, uint32_t *icd_index) {
-    *found_dev = NULL;
-    for (struct loader_instance *inst = loader.instances; inst; inst = inst->next) {
-        uint32_t index = 0;
-        for (struct loader_icd_term *icd_term = inst->icd_terms; icd_term; icd_term = icd_term->next) {
-            for (struct loader_device *dev = icd_term->logical_device_list; dev; dev = dev->next)
-                // Value comparison of device prevents object wrapping by layers
-                if (loader_get_dispatch(dev->icd_device) == loader_get_dispatch(device) ||
-                    (dev->chain_device != VK_NULL_HANDLE &&
-                     loader_get_dispatch(dev->chain_device) == loader_get_dispatch(device))) {
-                    *found_dev = dev;
-                    if (NULL != icd_index) {
-                        *icd_index = index;
-                    }
-                    return icd_term;
-                }
-            index++;
+    struct loader_icd_term *found_icd_term = NULL;
+
+    // Value comparison of the dispatch pointer prevents object wrapping by layers
+    loader_platform_thread_read_lock_rwlock(&loader_instance_list_lock);
+    *found_dev = loaderHandleIndexFind(&loader.device_index, loader_get_dispatch(device));
+    if (NULL != *found_dev) {
+        found_icd_term = (*found_dev)->icd_term;
+        if (NULL != icd_index) {
+            *icd_index = (*found_dev)->icd_index;
         }
     }
-    return NULL;
+    loader_platform_thread_read_unlock_rwlock(&loader_instance_list_lock);
+    return found_icd_term;
+}
+
+// Number of loader_device records the pool takes from the instance's arena at a time
+#define LOADER_DEVICE_POOL_SLAB_SIZE 4
+
+void loaderDevicePoolInit(struct loader_device_pool *pool) {
+    memset(pool, 0, sizeof(*pool));
+    loader_platform_thread_create_mutex(&pool->lock);
+}
+
+// The records themselves are in the instance's arena
+void loaderDevicePoolDestroy(struct loader_device_pool *pool) {
+    loader_platform_thread_delete_mutex(&pool->lock);
+    memset(pool, 0, sizeof(*pool));
+}
+
+#if !defined(LOADER_UNKNOWN_EXT_JIT)
+// Every device's unknown function table starts out as this one, with every entry set to
+// vkDevExtError by loader_initialize, so a trampoline called for a function the device's
+// layers and ICD didn't return has somewhere to go.  Devices get a table of their own the first
+// time an entry is set.
+static struct loader_dev_ext_dispatch_table loader_dev_ext_dispatch_error;
+#endif
+
+// Devices created without an allocator take their record from the instance's pool.  Records are
+// carved out of the instance's arena a slab at a time, returned to the pool when the device is
+// destroyed and only freed with the instance.  A device with its own allocator can't keep memory
+// from it past vkDestroyDevice, so its record is allocated and freed every time.
+static struct loader_device *loader_device_pool_take(const struct loader_instance *inst) {
+    // Like the arena, the pool is synchronized on its own
+    struct loader_device_pool *pool = (struct loader_device_pool *)&inst->device_pool;
+    struct loader_device *dev;
+
+    loader_platform_thread_lock_mutex(&pool->lock);
+    if (NULL == pool->free_list) {
+        struct loader_device *slab = loaderInstanceArenaAlloc(inst, LOADER_DEVICE_POOL_SLAB_SIZE * sizeof(struct loader_device));
+        if (NULL != slab) {
+            for (uint32_t i = 0; i < LOADER_DEVICE_POOL_SLAB_SIZE; i++) {
+                slab[i].next = pool->free_list;
+                pool->free_list = &slab[i];
+            }
+        }
+    }
+    dev = pool->free_list;
+    if (NULL != dev) {
+        pool->free_list = dev->next;
+    }
+    loader_platform_thread_unlock_mutex(&pool->lock);
+    return dev;
+}
+
+static void loader_device_pool_return(const struct loader_instance *inst, struct loader_device *dev) {
+    struct loader_device_pool *pool = (struct loader_device_pool *)&inst->device_pool;
+
+    loader_platform_thread_lock_mutex(&pool->lock);
+    dev->next = pool->free_list;
+    pool->free_list = dev;
+    loader_platform_thread_unlock_mutex(&pool->lock);
 }
 
 void loader_destroy_logical_device(const struct loader_instance *inst, struct loader_device *dev,
@@ -2082,20 +2240,34 @@ void loader_destroy_logical_device(const struct loader_instance *inst, struct lo
     if (NULL != dev->app_activated_layer_list.list) {
         loaderDestroyLayerList(inst, dev, &dev->app_activated_layer_list);
     }
-    loader_device_heap_free(dev, dev);
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+    loaderUnknownExtArrayFree(dev, dev->loader_dispatch.ext_dispatch);
+#else
+    if (&loader_dev_ext_dispatch_error != dev->loader_dispatch.ext_dispatch) {
+        loader_device_heap_free(dev, dev->loader_dispatch.ext_dispatch);
+    }
+#endif
+    if (dev->pooled) {
+        loader_device_pool_return(inst, dev);
+    } else {
+        loader_device_heap_free(dev, dev);
+    }
 }
 
 struct loader_device *loader_create_logical_device(const struct loader_instance *inst, const VkAllocationCallbacks *pAllocator) {
     struct loader_device *new_dev;
+    bool pooled = false;
 #if (DEBUG_DISABLE_APP_ALLOCATORS == 1)
     {
+        new_dev = (struct loader_device *)malloc(sizeof(struct loader_device));
 #else
     if (pAllocator) {
         new_dev = (struct loader_device *)pAllocator->pfnAllocation(pAllocator->pUserData, sizeof(struct loader_device),
                                                                     sizeof(int *), VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
     } else {
+        new_dev = loader_device_pool_take(inst);
+        pooled = true;
 #endif
-        new_dev = (struct loader_device *)malloc(sizeof(struct loader_device));
     }
 
     if (!new_dev) {
@@ -2105,7 +2277,15 @@ struct loader_device *loader_create_logical_device(const struct loader_instance
         return NULL;
     }
 
-    memset(new_dev, 0, sizeof(struct loader_device));
+    // The core dispatch table is filled in completely by loader_init_device_dispatch_table before
+    // the device is handed out, so only the rest of the record is cleared.
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+    new_dev->loader_dispatch.ext_dispatch = (struct loader_unknown_ext_array *)&loader_unknown_ext_array_empty;
+#else
+    new_dev->loader_dispatch.ext_dispatch = &loader_dev_ext_dispatch_error;
+#endif
+    memset(&new_dev->chain_device, 0, sizeof(struct loader_device) - offsetof(struct loader_device, chain_device));
+    new_dev->pooled = pooled;
     if (pAllocator) {
         new_dev->alloc_callbacks = *pAllocator;
     }
@@ -2114,8 +2294,17 @@ struct loader_device *loader_create_logical_device(const struct loader_instance
 }
 
 void loader_add_logical_device(const struct loader_instance *inst, struct loader_icd_term *icd_term, struct loader_device *dev) {
+    dev->icd_term = icd_term;
+    dev->icd_index = 0;
+    for (struct loader_icd_term *cur = inst->icd_terms; cur && cur != icd_term; cur = cur->next) {
+        dev->icd_index++;
+    }
+
+    loader_platform_thread_write_lock_rwlock(&loader_instance_list_lock);
     dev->next = icd_term->logical_device_list;
     icd_term->logical_device_list = dev;
+    loaderHandleIndexInsert(&loader.device_index, &dev->index_node, &dev->loader_dispatch, dev);
+    loader_platform_thread_write_unlock_rwlock(&loader_instance_list_lock);
 }
 
 void loader_remove_logical_device(const struct loader_instance *inst, struct loader_icd_term *icd_term,
@@ -2124,6 +2313,7 @@ void loader_remove_logical_device(const struct loader_instance *inst, struct loa
 
     if (!icd_term || !found_dev) return;
 
+    loader_platform_thread_write_lock_rwlock(&loader_instance_list_lock);
     prev_dev = NULL;
     dev = icd_term->logical_device_list;
     while (dev && dev != found_dev) {
@@ -2135,30 +2325,45 @@ void loader_remove_logical_device(const struct loader_instance *inst, struct loa
         prev_dev->next = found_dev->next;
     else
         icd_term->logical_device_list = found_dev->next;
+    loaderHandleIndexRemove(&loader.device_index, &found_dev->index_node);
+    loader_platform_thread_write_unlock_rwlock(&loader_instance_list_lock);
     loader_destroy_logical_device(inst, found_dev, pAllocator);
 }
 
 static void loader_icd_destroy(struct loader_instance *ptr_inst, struct loader_icd_term *icd_term,
                                const VkAllocationCallbacks *pAllocator) {
     ptr_inst->total_icd_count--;
-    for (struct loader_device *dev = icd_term->logical_device_list; dev;) {
+
+    // Devices the application leaked still have to leave the index before they are freed
+    loader_platform_thread_write_lock_rwlock(&loader_instance_list_lock);
+    struct loader_device *dev = icd_term->logical_device_list;
+    icd_term->logical_device_list = NULL;
+    for (struct loader_device *cur = dev; cur; cur = cur->next) {
+        loaderHandleIndexRemove(&loader.device_index, &cur->index_node);
+    }
+    loader_platform_thread_write_unlock_rwlock(&loader_instance_list_lock);
+
+    while (dev) {
         struct loader_device *next_dev = dev->next;
         loader_destroy_logical_device(ptr_inst, dev, pAllocator);
         dev = next_dev;
     }
 
-    loader_instance_heap_free(ptr_inst, icd_term);
+    // The terminator itself is in the instance's arena
 }
 
 static struct loader_icd_term *loader_icd_create(const struct loader_instance *inst) {
     struct loader_icd_term *icd_term;
 
-    icd_term = loader_instance_heap_alloc(inst, sizeof(struct loader_icd_term), VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    icd_term = loaderInstanceArenaAlloc(inst, sizeof(struct loader_icd_term));
     if (!icd_term) {
         return NULL;
     }
 
     memset(icd_term, 0, sizeof(struct loader_icd_term));
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+    icd_term->phys_dev_ext = (struct loader_unknown_ext_array *)&loader_unknown_ext_array_empty;
+#endif
 
     return icd_term;
 }
@@ -2219,7 +2424,9 @@ bool loader_get_icd_interface_version(PFN_vkNegotiateLoaderICDInterfaceVersion f
 void loader_scanned_icd_clear(const struct loader_instance *inst, struct loader_icd_tramp_list *icd_tramp_list) {
     if (0 != icd_tramp_list->capacity) {
         for (uint32_t i = 0; i < icd_tramp_list->count; i++) {
-            loader_platform_close_library(icd_tramp_list->scanned_list[i].handle);
+            if (NULL != icd_tramp_list->scanned_list[i].handle) {
+                loader_platform_close_library(icd_tramp_list->scanned_list[i].handle);
+            }
             loader_instance_heap_free(inst, icd_tramp_list->scanned_list[i].lib_name);
         }
         loader_instance_heap_free(inst, icd_tramp_list->scanned_list);
@@ -2243,25 +2450,16 @@ static VkResult loader_scanned_icd_init(const struct loader_instance *inst, stru
     return err;
 }
 
-static VkResult loader_scanned_icd_add(const struct loader_instance *inst, struct loader_icd_tramp_list *icd_tramp_list,
-                                       const char *filename, uint32_t api_version) {
-    loader_platform_dl_handle handle;
+// Looks up the ICD's entry points in an opened library and settles on an interface version.  Only
+// fills in the fields that come from the library.
+static bool loader_scanned_icd_get_entry_points(const struct loader_instance *inst, const char *filename,
+                                                loader_platform_dl_handle handle, struct loader_scanned_icd *scanned_icd) {
     PFN_vkCreateInstance fp_create_inst;
     PFN_vkEnumerateInstanceExtensionProperties fp_get_inst_ext_props;
     PFN_vkGetInstanceProcAddr fp_get_proc_addr;
     PFN_GetPhysicalDeviceProcAddr fp_get_phys_dev_proc_addr = NULL;
     PFN_vkNegotiateLoaderICDInterfaceVersion fp_negotiate_icd_version;
-    struct loader_scanned_icd *new_scanned_icd;
     uint32_t interface_vers;
-    VkResult res = VK_SUCCESS;
-
-    // TODO implement smarter opening/closing of libraries. For now this
-    // function leaves libraries open and the scanned_icd_clear closes them
-    handle = loader_platform_open_library(filename);
-    if (NULL == handle) {
-        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, loader_platform_open_library_error(filename));
-        goto out;
-    }
 
     // Get and settle on an ICD interface version
     fp_negotiate_icd_version = loader_platform_get_proc_address(handle, "vk_icdNegotiateLoaderICDInterfaceVersion");
@@ -2271,7 +2469,7 @@ static VkResult loader_scanned_icd_add(const struct loader_instance *inst, struc
                    "loader_scanned_icd_add: ICD %s doesn't support interface"
                    " version compatible with loader, skip this ICD.",
                    filename);
-        goto out;
+        return false;
     }
 
     fp_get_proc_addr = loader_platform_get_proc_address(handle, "vk_icdGetInstanceProcAddr");
@@ -2285,7 +2483,7 @@ static VkResult loader_scanned_icd_add(const struct loader_instance *inst, struc
                        "\'vkGetInstanceProcAddr\' or "
                        "\'vk_icdGetInstanceProcAddr\' from ICD %s failed.",
                        filename);
-            goto out;
+            return false;
         } else {
             loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
                        "loader_scanned_icd_add: Using deprecated ICD "
@@ -2300,7 +2498,7 @@ static VkResult loader_scanned_icd_add(const struct loader_instance *inst, struc
                        "\'vkCreateInstance\' via dlsym/loadlibrary for "
                        "ICD %s",
                        filename);
-            goto out;
+            return false;
         }
         fp_get_inst_ext_props = loader_platform_get_proc_address(handle, "vkEnumerateInstanceExtensionProperties");
         if (NULL == fp_get_inst_ext_props) {
@@ -2309,7 +2507,7 @@ static VkResult loader_scanned_icd_add(const struct loader_instance *inst, struc
                        "InstanceExtensionProperties\' via dlsym/loadlibrary "
                        "for ICD %s",
                        filename);
-            goto out;
+            return false;
         }
     } else {
         // Use newer interface version 1 or later
@@ -2324,7 +2522,7 @@ static VkResult loader_scanned_icd_add(const struct loader_instance *inst, struc
                        "\'vkCreateInstance\' via \'vk_icdGetInstanceProcAddr\'"
                        " for ICD %s",
                        filename);
-            goto out;
+            return false;
         }
         fp_get_inst_ext_props =
             (PFN_vkEnumerateInstanceExtensionProperties)fp_get_proc_addr(NULL, "vkEnumerateInstanceExtensionProperties");
@@ -2334,11 +2532,58 @@ static VkResult loader_scanned_icd_add(const struct loader_instance *inst, struc
                        "InstanceExtensionProperties\' via "
                        "\'vk_icdGetInstanceProcAddr\' for ICD %s",
                        filename);
-            goto out;
+            return false;
         }
         fp_get_phys_dev_proc_addr = loader_platform_get_proc_address(handle, "vk_icdGetPhysicalDeviceProcAddr");
     }
 
+    scanned_icd->GetInstanceProcAddr = fp_get_proc_addr;
+    scanned_icd->GetPhysicalDeviceProcAddr = fp_get_phys_dev_proc_addr;
+    scanned_icd->EnumerateInstanceExtensionProperties = fp_get_inst_ext_props;
+    scanned_icd->CreateInstance = fp_create_inst;
+    scanned_icd->interface_version = interface_vers;
+    return true;
+}
+
+// Opens the library of an ICD that was added without one.  On failure the ICD keeps a NULL handle.
+static bool loader_scanned_icd_open(const struct loader_instance *inst, struct loader_scanned_icd *scanned_icd) {
+    loader_platform_dl_handle handle = loader_platform_open_library(scanned_icd->lib_name);
+    if (NULL == handle) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "%s", loader_platform_open_library_error(scanned_icd->lib_name));
+        return false;
+    }
+    if (!loader_scanned_icd_get_entry_points(inst, scanned_icd->lib_name, handle, scanned_icd)) {
+        loader_platform_close_library(handle);
+        return false;
+    }
+    scanned_icd->handle = handle;
+    return true;
+}
+
+// Opens the library and adds it to the scanned list.  If only the ICD's instance extensions are
+// needed and they are cached, the ICD is added without a library or entry points.
+static VkResult loader_scanned_icd_add(const struct loader_instance *inst, struct loader_icd_tramp_list *icd_tramp_list,
+                                       const char *filename, uint32_t api_version) {
+    loader_platform_dl_handle handle = NULL;
+    struct loader_scanned_icd scanned_icd;
+    struct loader_scanned_icd *new_scanned_icd;
+    bool added = false;
+    VkResult res = VK_SUCCESS;
+
+    // TODO implement smarter opening/closing of libraries. For now this
+    // function leaves libraries open and the scanned_icd_clear closes them
+    memset(&scanned_icd, 0, sizeof(scanned_icd));
+    if (!icd_tramp_list->open_on_demand || !loaderIcdExtCacheContains(filename)) {
+        handle = loader_platform_open_library(filename);
+        if (NULL == handle) {
+            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "%s", loader_platform_open_library_error(filename));
+            goto out;
+        }
+        if (!loader_scanned_icd_get_entry_points(inst, filename, handle, &scanned_icd)) {
+            goto out;
+        }
+    }
+
     // check for enough capacity
     if ((icd_tramp_list->count * sizeof(struct loader_scanned_icd)) >= icd_tramp_list->capacity) {
         void *new_ptr = loader_instance_heap_realloc(inst, icd_tramp_list->scanned_list, icd_tramp_list->capacity,
@@ -2356,13 +2601,9 @@ static VkResult loader_scanned_icd_add(const struct loader_instance *inst, struc
     }
 
     new_scanned_icd = &(icd_tramp_list->scanned_list[icd_tramp_list->count]);
+    *new_scanned_icd = scanned_icd;
     new_scanned_icd->handle = handle;
     new_scanned_icd->api_version = api_version;
-    new_scanned_icd->GetInstanceProcAddr = fp_get_proc_addr;
-    new_scanned_icd->GetPhysicalDeviceProcAddr = fp_get_phys_dev_proc_addr;
-    new_scanned_icd->EnumerateInstanceExtensionProperties = fp_get_inst_ext_props;
-    new_scanned_icd->CreateInstance = fp_create_inst;
-    new_scanned_icd->interface_version = interface_vers;
 
     new_scanned_icd->lib_name = (char *)loader_instance_heap_alloc(inst, strlen(filename) + 1, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
     if (NULL == new_scanned_icd->lib_name) {
@@ -2372,9 +2613,13 @@ static VkResult loader_scanned_icd_add(const struct loader_instance *inst, struc
     }
     strcpy(new_scanned_icd->lib_name, filename);
     icd_tramp_list->count++;
+    added = true;
 
 out:
 
+    if (!added && NULL != handle) {
+        loader_platform_close_library(handle);
+    }
     return res;
 }
 
@@ -2424,19 +2669,36 @@ static void loader_debug_init(void) {
     }
 
     loader_free_getenv(orig, NULL);
+
+    // Only worth setting up a sink if there's something to write
+    if (0 != g_loader_log_msgs) {
+        char *sink_name = loader_getenv("VK_LOADER_DEBUG_SINK", NULL);
+        loaderLogSinkInit(sink_name);
+        loader_free_getenv(sink_name, NULL);
+    }
 }
 
 void loader_initialize(void) {
     // initialize mutexes
-    loader_platform_thread_create_mutex(&loader_lock);
+    loader_platform_thread_create_rwlock(&loader_instance_list_lock);
     loader_platform_thread_create_mutex(&loader_json_lock);
+    loaderIcdExtCacheInit();
+    loaderUnknownExtJitInit();
+#if !defined(LOADER_UNKNOWN_EXT_JIT)
+    for (uint32_t i = 0; i < MAX_NUM_UNKNOWN_EXTS; i++) {
+        loader_dev_ext_dispatch_error.dev_ext[i] = (PFN_vkDevExt)vkDevExtError;
+    }
+#endif
+
+    loaderHandleIndexInit(&loader.instance_index);
+    loaderHandleIndexInit(&loader.device_index);
 
     // initialize logging
     loader_debug_init();
 
-    // initial cJSON to use alloc callbacks
+    // initial cJSON to use alloc callbacks, or the manifest scan's arena while one is active
     cJSON_Hooks alloc_fns = {
-        .malloc_fn = loader_instance_tls_heap_alloc, .free_fn = loader_instance_tls_heap_free,
+        .malloc_fn = loaderJsonArenaAlloc, .free_fn = loaderJsonArenaFree,
     };
     cJSON_InitHooks(&alloc_fns);
 
@@ -2447,16 +2709,21 @@ void loader_initialize(void) {
 #endif
 }
 
-struct loader_data_files {
-    uint32_t count;
-    uint32_t alloc_count;
-    char **filename_list;
-};
-
 void loader_release() {
+    loaderScanSnapshotReleaseAll();
+    loaderManifestCacheRelease();
+    loaderStringTableRelease();
+    loaderIcdExtCacheRelease();
+    loaderUnknownExtJitRelease();
+
+    loaderHandleIndexDestroy(&loader.instance_index);
+    loaderHandleIndexDestroy(&loader.device_index);
+
     // release mutexes
-    loader_platform_thread_delete_mutex(&loader_lock);
+    loader_platform_thread_delete_rwlock(&loader_instance_list_lock);
     loader_platform_thread_delete_mutex(&loader_json_lock);
+
+    loaderLogSinkShutdown();
 }
 
 // Get next file or dirname given a string list or registry key path
@@ -2519,23 +2786,16 @@ static void loader_get_fullpath(const char *file, const char *dirs, size_t out_s
     (void)snprintf(out_fullpath, out_size, "%s", file);
 }
 
-// Read a JSON file into a buffer.
-//
-// @return -  A pointer to a cJSON object representing the JSON parse tree.
-//            This returned buffer should be freed by caller.
-static VkResult loader_get_json(const struct loader_instance *inst, const char *filename, cJSON **json) {
+// Read a whole file into a NUL terminated heap buffer.  Files that can't report their size, like
+// pipes, are read until they end.
+static VkResult loader_read_text_file(const struct loader_instance *inst, const char *filename, char **out_buf) {
     FILE *file = NULL;
-    char *json_buf;
-    size_t len;
+    char *buf = NULL;
+    size_t capacity = 4096;
+    size_t len = 0;
     VkResult res = VK_SUCCESS;
 
-    if (NULL == json) {
-        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "loader_get_json: Received invalid JSON file");
-        res = VK_ERROR_INITIALIZATION_FAILED;
-        goto out;
-    }
-
-    *json = NULL;
+    *out_buf = NULL;
 
     file = fopen(filename, "rb");
     if (!file) {
@@ -2543,24 +2803,86 @@ static VkResult loader_get_json(const struct loader_instance *inst, const char *
         res = VK_ERROR_INITIALIZATION_FAILED;
         goto out;
     }
-    fseek(file, 0, SEEK_END);
-    len = ftell(file);
-    fseek(file, 0, SEEK_SET);
-    json_buf = (char *)loader_stack_alloc(len + 1);
-    if (json_buf == NULL) {
+    if (0 == fseek(file, 0, SEEK_END)) {
+        long file_len = ftell(file);
+        if (file_len >= 0) {
+            capacity = (size_t)file_len + 1;
+        }
+        fseek(file, 0, SEEK_SET);
+    }
+
+    buf = loader_instance_heap_alloc(inst, capacity, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == buf) {
         loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                    "loader_get_json: Failed to allocate space for "
-                   "JSON file %s buffer of length %d",
-                   filename, len);
+                   "JSON file %s buffer of length " PRINTF_SIZE_T_SPECIFIER,
+                   filename, capacity);
         res = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto out;
     }
-    if (fread(json_buf, sizeof(char), len, file) != len) {
+    for (;;) {
+        len += fread(buf + len, sizeof(char), capacity - 1 - len, file);
+        if (len < capacity - 1) {
+            break;
+        }
+        // The buffer is full, so check whether there is more to read
+        int c = fgetc(file);
+        if (EOF == c) {
+            break;
+        }
+        char *new_buf = loader_instance_heap_realloc(inst, buf, capacity, capacity * 2, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+        if (NULL == new_buf) {
+            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                       "loader_get_json: Failed to allocate space for "
+                       "JSON file %s buffer of length " PRINTF_SIZE_T_SPECIFIER,
+                       filename, capacity * 2);
+            res = VK_ERROR_OUT_OF_HOST_MEMORY;
+            goto out;
+        }
+        buf = new_buf;
+        capacity *= 2;
+        buf[len++] = (char)c;
+    }
+    if (ferror(file)) {
         loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "loader_get_json: Failed to read JSON file %s.", filename);
         res = VK_ERROR_INITIALIZATION_FAILED;
         goto out;
     }
-    json_buf[len] = '\0';
+    buf[len] = '\0';
+
+    *out_buf = buf;
+    buf = NULL;
+
+out:
+    loader_instance_heap_free(inst, buf);
+    if (NULL != file) {
+        fclose(file);
+    }
+
+    return res;
+}
+
+// Read a JSON file and parse it.  The file is read into a heap buffer first, since cJSON needs the
+// whole text NUL terminated and nothing else may change it while it is parsed.
+//
+// @return -  A pointer to a cJSON object representing the JSON parse tree.
+//            This returned buffer should be freed by caller.
+static VkResult loader_get_json(const struct loader_instance *inst, const char *filename, cJSON **json) {
+    char *json_buf = NULL;
+    VkResult res = VK_SUCCESS;
+
+    if (NULL == json) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "loader_get_json: Received invalid JSON file");
+        res = VK_ERROR_INITIALIZATION_FAILED;
+        goto out;
+    }
+
+    *json = NULL;
+
+    res = loader_read_text_file(inst, filename, &json_buf);
+    if (VK_SUCCESS != res) {
+        goto out;
+    }
 
     // Parse text from file
     *json = cJSON_Parse(json_buf);
@@ -2575,13 +2897,32 @@ static VkResult loader_get_json(const struct loader_instance *inst, const char *
     }
 
 out:
-    if (NULL != file) {
-        fclose(file);
-    }
+    loader_instance_heap_free(inst, json_buf);
 
     return res;
 }
 
+// Get the persistent manifest cache named by VK_LOADER_MANIFEST_CACHE, or NULL if caching
+// isn't enabled.  Must be called with loader_json_lock held.
+static struct loader_manifest_cache *loaderGetManifestCache(const struct loader_instance *inst) {
+    struct loader_manifest_cache *cache = NULL;
+    char *cache_file;
+
+#ifndef _WIN32
+    // Don't allow setuid apps to read or write a file chosen by the environment
+    if (IsHighIntegrity()) {
+        return NULL;
+    }
+#endif
+
+    cache_file = loader_getenv("VK_LOADER_MANIFEST_CACHE", inst);
+    if (NULL != cache_file) {
+        cache = loaderManifestCacheOpen(inst, cache_file);
+        loader_free_getenv(cache_file, inst);
+    }
+    return cache;
+}
+
 // Verify that all component layers in a meta-layer are valid.
 static bool verifyMetaLayerComponentLayers(const struct loader_instance *inst, struct loader_layer_properties *prop,
                                            struct loader_layer_list *instance_layers) {
@@ -2711,6 +3052,7 @@ static void VerifyAllMetaLayers(struct loader_instance *inst, struct loader_laye
             if (prop->blacklist_layer_names != NULL) {
                 loader_instance_heap_free(inst, prop->blacklist_layer_names);
             }
+            loaderStringTableReleaseGeneration(prop->strings);
 
             // Remove the current invalid meta-layer from the layer list.  Use memmove since we are
             // overlapping the source and destination addresses.
@@ -2828,6 +3170,12 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
             result = VK_ERROR_OUT_OF_HOST_MEMORY;
             goto out;
         }
+        props->strings = loaderStringTableAcquireGeneration();
+        if (NULL == props->strings) {
+            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "loaderReadLayerJson: Out of memory for layer strings");
+            result = VK_ERROR_OUT_OF_HOST_MEMORY;
+            goto out;
+        }
         props->type_flags = VK_LAYER_TYPE_FLAG_INSTANCE_LAYER;
         if (!is_implicit) {
             props->type_flags |= VK_LAYER_TYPE_FLAG_EXPLICIT_LAYER;
@@ -2933,7 +3281,7 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
         strcpy(library_path_str, &temp[1]);
         cJSON_Free(temp);
 
-        char *fullpath = props->lib_name;
+        char fullpath[MAX_STRING_SIZE];
         char *rel_base;
         if (NULL != library_path_str) {
             if (loader_platform_is_path(library_path_str)) {
@@ -2950,6 +3298,10 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
                 loader_get_fullpath(library_path_str, "", MAX_STRING_SIZE, fullpath);
 #endif
             }
+            result = loaderStringTableIntern(fullpath, &props->lib_name);
+            if (VK_SUCCESS != result) {
+                goto out;
+            }
         }
     } else if (NULL != component_layers) {
         if (version.major == 1 && (version.minor < 1 || version.patch < 1)) {
@@ -2962,11 +3314,12 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
 
         // Allocate buffer for layer names
         props->component_layer_names =
-            loader_instance_heap_alloc(inst, sizeof(char[MAX_STRING_SIZE]) * count, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+            loader_instance_heap_alloc(inst, sizeof(const char *) * count, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
         if (NULL == props->component_layer_names) {
             result = VK_ERROR_OUT_OF_HOST_MEMORY;
             goto out;
         }
+        memset(props->component_layer_names, 0, sizeof(const char *) * count);
 
         // Copy the component layers into the array
         for (i = 0; i < count; i++) {
@@ -2978,9 +3331,11 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
                     goto out;
                 }
                 temp[strlen(temp) - 1] = '\0';
-                strncpy(props->component_layer_names[i], temp + 1, MAX_STRING_SIZE - 1);
-                props->component_layer_names[i][MAX_STRING_SIZE - 1] = '\0';
+                result = loaderStringTableInternName(temp + 1, &props->component_layer_names[i]);
                 cJSON_Free(temp);
+                if (VK_SUCCESS != result) {
+                    goto out;
+                }
             }
         }
 
@@ -3010,12 +3365,13 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
             props->num_blacklist_layers = cJSON_GetArraySize(blacklisted_layers);
 
             // Allocate the blacklist array
-            props->blacklist_layer_names = loader_instance_heap_alloc(
-                inst, sizeof(char[MAX_STRING_SIZE]) * props->num_blacklist_layers, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+            props->blacklist_layer_names = loader_instance_heap_alloc(inst, sizeof(const char *) * props->num_blacklist_layers,
+                                                                     VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
             if (props->blacklist_layer_names == NULL) {
                 result = VK_ERROR_OUT_OF_HOST_MEMORY;
                 goto out;
             }
+            memset(props->blacklist_layer_names, 0, sizeof(const char *) * props->num_blacklist_layers);
 
             // Copy the blacklisted layers into the array
             for (i = 0; i < (int)props->num_blacklist_layers; ++i) {
@@ -3029,9 +3385,11 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
                     goto out;
                 }
                 temp[strlen(temp) - 1] = '\0';
-                strncpy(props->blacklist_layer_names[i], temp + 1, MAX_STRING_SIZE - 1);
-                props->blacklist_layer_names[i][MAX_STRING_SIZE - 1] = '\0';
+                result = loaderStringTableInternName(temp + 1, &props->blacklist_layer_names[i]);
                 cJSON_Free(temp);
+                if (VK_SUCCESS != result) {
+                    goto out;
+                }
             }
         }
     }
@@ -3047,12 +3405,12 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
         props->num_override_paths = count;
 
         // Allocate buffer for override paths
-        props->override_paths =
-            loader_instance_heap_alloc(inst, sizeof(char[MAX_STRING_SIZE]) * count, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+        props->override_paths = loader_instance_heap_alloc(inst, sizeof(const char *) * count, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
         if (NULL == props->override_paths) {
             result = VK_ERROR_OUT_OF_HOST_MEMORY;
             goto out;
         }
+        memset(props->override_paths, 0, sizeof(const char *) * count);
 
         // Copy the override paths into the array
         for (i = 0; i < count; i++) {
@@ -3064,9 +3422,11 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
                     goto out;
                 }
                 temp[strlen(temp) - 1] = '\0';
-                strncpy(props->override_paths[i], temp + 1, MAX_STRING_SIZE - 1);
-                props->override_paths[i][MAX_STRING_SIZE - 1] = '\0';
+                result = loaderStringTableInternName(temp + 1, &props->override_paths[i]);
                 cJSON_Free(temp);
+                if (VK_SUCCESS != result) {
+                    goto out;
+                }
             }
         }
     }
@@ -3091,10 +3451,13 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
             layer_node = layer_node->next;
             goto out;
         }
-        strncpy(props->disable_env_var.name, disable_environment->child->string, sizeof(props->disable_env_var.name));
-        props->disable_env_var.name[sizeof(props->disable_env_var.name) - 1] = '\0';
-        strncpy(props->disable_env_var.value, disable_environment->child->valuestring, sizeof(props->disable_env_var.value));
-        props->disable_env_var.value[sizeof(props->disable_env_var.value) - 1] = '\0';
+        result = loaderStringTableIntern(disable_environment->child->string, &props->disable_env_var.name);
+        if (VK_SUCCESS == result) {
+            result = loaderStringTableIntern(disable_environment->child->valuestring, &props->disable_env_var.value);
+        }
+        if (VK_SUCCESS != result) {
+            goto out;
+        }
     }
 
 // Now get all optional items and objects and put in list:
@@ -3137,17 +3500,23 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
     if (functions != NULL) {
         if (version.major > 1 || version.minor >= 1) {
             GET_JSON_ITEM(functions, vkNegotiateLoaderLayerInterfaceVersion)
-            if (vkNegotiateLoaderLayerInterfaceVersion != NULL)
-                strncpy(props->functions.str_negotiate_interface, vkNegotiateLoaderLayerInterfaceVersion,
-                        sizeof(props->functions.str_negotiate_interface));
-            props->functions.str_negotiate_interface[sizeof(props->functions.str_negotiate_interface) - 1] = '\0';
+            result = loaderStringTableIntern(vkNegotiateLoaderLayerInterfaceVersion, &props->functions.str_negotiate_interface);
+            if (VK_SUCCESS != result) {
+                goto out;
+            }
         } else {
-            props->functions.str_negotiate_interface[0] = '\0';
+            props->functions.str_negotiate_interface = NULL;
         }
         GET_JSON_ITEM(functions, vkGetInstanceProcAddr)
         GET_JSON_ITEM(functions, vkGetDeviceProcAddr)
+        result = loaderStringTableIntern(vkGetInstanceProcAddr, &props->functions.str_gipa);
+        if (VK_SUCCESS == result) {
+            result = loaderStringTableIntern(vkGetDeviceProcAddr, &props->functions.str_gdpa);
+        }
+        if (VK_SUCCESS != result) {
+            goto out;
+        }
         if (vkGetInstanceProcAddr != NULL) {
-            strncpy(props->functions.str_gipa, vkGetInstanceProcAddr, sizeof(props->functions.str_gipa));
             if (version.major > 1 || version.minor >= 1) {
                 loader_log(inst, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, 0,
                            "Layer \"%s\" using deprecated \'vkGetInstanceProcAddr\' tag which was deprecated starting with JSON "
@@ -3156,9 +3525,7 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
                            name);
             }
         }
-        props->functions.str_gipa[sizeof(props->functions.str_gipa) - 1] = '\0';
         if (vkGetDeviceProcAddr != NULL) {
-            strncpy(props->functions.str_gdpa, vkGetDeviceProcAddr, sizeof(props->functions.str_gdpa));
             if (version.major > 1 || version.minor >= 1) {
                 loader_log(inst, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, 0,
                            "Layer \"%s\" using deprecated \'vkGetDeviceProcAddr\' tag which was deprecated starting with JSON "
@@ -3167,7 +3534,6 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
                            name);
             }
         }
-        props->functions.str_gdpa[sizeof(props->functions.str_gdpa) - 1] = '\0';
     }
 
     // instance_extensions
@@ -3254,10 +3620,13 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
 
         // enable_environment is optional
         if (enable_environment) {
-            strncpy(props->enable_env_var.name, enable_environment->child->string, sizeof(props->enable_env_var.name));
-            props->enable_env_var.name[sizeof(props->enable_env_var.name) - 1] = '\0';
-            strncpy(props->enable_env_var.value, enable_environment->child->valuestring, sizeof(props->enable_env_var.value));
-            props->enable_env_var.value[sizeof(props->enable_env_var.value) - 1] = '\0';
+            result = loaderStringTableIntern(enable_environment->child->string, &props->enable_env_var.name);
+            if (VK_SUCCESS == result) {
+                result = loaderStringTableIntern(enable_environment->child->valuestring, &props->enable_env_var.value);
+            }
+            if (VK_SUCCESS != result) {
+                goto out;
+            }
         }
     }
 
@@ -3282,10 +3651,13 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
                     result = VK_ERROR_OUT_OF_HOST_MEMORY;
                     goto out;
                 }
-                size_t len = strlen(inst_ext_name) >= MAX_STRING_SIZE ? MAX_STRING_SIZE - 3 : strlen(inst_ext_name) - 2;
-                strncpy(props->pre_instance_functions.enumerate_instance_extension_properties, inst_ext_name + 1, len);
-                props->pre_instance_functions.enumerate_instance_extension_properties[len] = '\0';
+                inst_ext_name[strlen(inst_ext_name) - 1] = '\0';
+                result = loaderStringTableIntern(inst_ext_name + 1,
+                                                 &props->pre_instance_functions.enumerate_instance_extension_properties);
                 cJSON_Free(inst_ext_name);
+                if (VK_SUCCESS != result) {
+                    goto out;
+                }
             }
 
             cJSON *inst_layer_json = cJSON_GetObjectItem(pre_instance, "vkEnumerateInstanceLayerProperties");
@@ -3295,10 +3667,13 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
                     result = VK_ERROR_OUT_OF_HOST_MEMORY;
                     goto out;
                 }
-                size_t len = strlen(inst_layer_name) >= MAX_STRING_SIZE ? MAX_STRING_SIZE - 3 : strlen(inst_layer_name) - 2;
-                strncpy(props->pre_instance_functions.enumerate_instance_layer_properties, inst_layer_name + 1, len);
-                props->pre_instance_functions.enumerate_instance_layer_properties[len] = '\0';
+                inst_layer_name[strlen(inst_layer_name) - 1] = '\0';
+                result = loaderStringTableIntern(inst_layer_name + 1,
+                                                 &props->pre_instance_functions.enumerate_instance_layer_properties);
                 cJSON_Free(inst_layer_name);
+                if (VK_SUCCESS != result) {
+                    goto out;
+                }
             }
 
             cJSON *inst_version_json = cJSON_GetObjectItem(pre_instance, "vkEnumerateInstanceVersion");
@@ -3308,10 +3683,13 @@ static VkResult loaderReadLayerJson(const struct loader_instance *inst, struct l
                     result = VK_ERROR_OUT_OF_HOST_MEMORY;
                     goto out;
                 }
-                size_t len = strlen(inst_version_name) >= MAX_STRING_SIZE ? MAX_STRING_SIZE - 3 : strlen(inst_version_name) - 2;
-                strncpy(props->pre_instance_functions.enumerate_instance_version, inst_version_name + 1, len);
-                props->pre_instance_functions.enumerate_instance_version[len] = '\0';
+                inst_version_name[strlen(inst_version_name) - 1] = '\0';
+                result = loaderStringTableIntern(inst_version_name + 1,
+                                                 &props->pre_instance_functions.enumerate_instance_version);
                 cJSON_Free(inst_version_name);
+                if (VK_SUCCESS != result) {
+                    goto out;
+                }
             }
         }
     }
@@ -3859,8 +4237,30 @@ static VkResult ReadDataFilesInSearchPaths(const struct loader_instance *inst, e
                    "ReadDataFilesInSearchPaths: Searching the following paths for manifest files: %s\n", search_path);
     }
 
-    // Now, parse the paths and add any manifest files found in them.
-    vk_result = AddDataFilesInPath(inst, search_path, is_directory_list, out_files);
+    // Now, parse the paths and add any manifest files found in them, unless none of the paths changed
+    // since the manifest cache last saw them.
+    uint32_t first_file = out_files->count;
+    loaderScanSnapshotRecordPaths(search_path);
+    struct loader_manifest_cache *manifest_cache = loaderGetManifestCache(inst);
+    if (!loaderManifestCacheFindDataFiles(inst, manifest_cache, search_path, is_directory_list, out_files)) {
+        char *search_path_key = NULL;
+
+        // AddDataFilesInPath() splits the search path in place, so keep a copy to use as the cache key
+        if (NULL != manifest_cache) {
+            search_path_key = loader_stack_alloc(strlen(search_path) + 1);
+            if (NULL != search_path_key) {
+                strcpy(search_path_key, search_path);
+            }
+        }
+
+        vk_result = AddDataFilesInPath(inst, search_path, is_directory_list, out_files);
+        if (VK_SUCCESS == vk_result && NULL != search_path_key) {
+            loaderManifestCacheStoreDataFiles(inst, manifest_cache, search_path_key, is_directory_list, out_files, first_file);
+        }
+    }
+    for (uint32_t i = first_file; i < out_files->count; i++) {
+        loaderScanSnapshotRecordPath(out_files->filename_list[i]);
+    }
 
     if (NULL != override_path) {
         *override_active = true;
@@ -4209,29 +4609,74 @@ VkResult loader_icd_scan(const struct loader_instance *inst, struct loader_icd_t
     bool lockedMutex = false;
     cJSON *json = NULL;
     uint32_t num_good_icds = 0;
+    struct loader_manifest_cache *manifest_cache = NULL;
+    struct loader_scan_snapshot *snapshot = NULL;
+    bool scan_complete = false;
+    struct loader_json_arena json_arena;
 
     memset(&manifest_files, 0, sizeof(struct loader_data_files));
+    loaderJsonArenaBegin(inst, &json_arena);
 
     res = loader_scanned_icd_init(inst, icd_tramp_list);
     if (VK_SUCCESS != res) {
         goto out;
     }
 
+    loader_platform_thread_lock_mutex(&loader_json_lock);
+    lockedMutex = true;
+
+    // If an earlier scan is still current, only the libraries need to be loaded
+    snapshot = loaderScanSnapshotAcquire(inst, LOADER_SCAN_SNAPSHOT_ICDS);
+    if (NULL != snapshot) {
+        loader_platform_thread_unlock_mutex(&loader_json_lock);
+        lockedMutex = false;
+        for (uint32_t i = 0; i < snapshot->icd_count; i++) {
+            res = loader_scanned_icd_add(inst, icd_tramp_list, snapshot->icds[i].lib_name, snapshot->icds[i].api_version);
+            if (VK_SUCCESS != res) {
+                loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                           "loader_icd_scan: Failed to add ICD JSON %s. "
+                           " Skipping ICD JSON.",
+                           snapshot->icds[i].lib_name);
+            }
+        }
+        loaderScanSnapshotRelease(snapshot);
+        goto out;
+    }
+    loaderScanSnapshotBeginRecording(inst, LOADER_SCAN_SNAPSHOT_ICDS);
+    manifest_cache = loaderGetManifestCache(inst);
+
     // Get a list of manifest files for ICDs
     res = loaderGetDataFiles(inst, LOADER_DATA_FILE_MANIFEST_ICD, true, "VK_ICD_FILENAMES", NULL, VK_DRIVERS_INFO_REGISTRY_LOC,
                              VK_DRIVERS_INFO_RELATIVE_DIR, &manifest_files);
     if (VK_SUCCESS != res || manifest_files.count == 0) {
+        scan_complete = (VK_SUCCESS == res);
         goto out;
     }
 
-    loader_platform_thread_lock_mutex(&loader_json_lock);
-    lockedMutex = true;
     for (uint32_t i = 0; i < manifest_files.count; i++) {
         file_str = manifest_files.filename_list[i];
         if (file_str == NULL) {
             continue;
         }
 
+        // Skip the parse if the manifest hasn't changed since it was cached
+        char cached_lib_name[MAX_STRING_SIZE];
+        uint32_t cached_api_version = 0;
+        if (loaderManifestCacheFindIcd(inst, manifest_cache, file_str, cached_lib_name, sizeof(cached_lib_name),
+                                       &cached_api_version)) {
+            loaderScanSnapshotRecordIcd(cached_lib_name, cached_api_version);
+            res = loader_scanned_icd_add(inst, icd_tramp_list, cached_lib_name, cached_api_version);
+            if (VK_SUCCESS != res) {
+                loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                           "loader_icd_scan: Failed to add ICD JSON %s. "
+                           " Skipping ICD JSON.",
+                           cached_lib_name);
+                continue;
+            }
+            num_good_icds++;
+            continue;
+        }
+
         VkResult temp_res = loader_get_json(inst, file_str, &json);
         if (NULL == json || temp_res != VK_SUCCESS) {
             if (NULL != json) {
@@ -4396,6 +4841,9 @@ VkResult loader_icd_scan(const struct loader_instance *inst, struct loader_icd_t
                                file_str);
                 }
 
+                loaderManifestCacheStoreIcd(inst, manifest_cache, file_str, fullpath, vers);
+                loaderScanSnapshotRecordIcd(fullpath, vers);
+
                 res = loader_scanned_icd_add(inst, icd_tramp_list, fullpath, vers);
                 if (VK_SUCCESS != res) {
                     loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
@@ -4423,12 +4871,14 @@ VkResult loader_icd_scan(const struct loader_instance *inst, struct loader_icd_t
         cJSON_Delete(json);
         json = NULL;
     }
+    scan_complete = true;
 
 out:
 
     if (NULL != json) {
         cJSON_Delete(json);
     }
+    loaderJsonArenaEnd(&json_arena);
 
     if (NULL != manifest_files.filename_list) {
         for (uint32_t i = 0; i < manifest_files.count; i++) {
@@ -4439,6 +4889,11 @@ out:
         loader_instance_heap_free(inst, manifest_files.filename_list);
     }
     if (lockedMutex) {
+        if (scan_complete && VK_SUCCESS == res) {
+            loaderScanSnapshotCommit(inst, NULL);
+        }
+        loaderScanSnapshotEndRecording();
+        loaderManifestCacheFlush(inst, manifest_cache);
         loader_platform_thread_unlock_mutex(&loader_json_lock);
     }
 
@@ -4452,6 +4907,11 @@ void loaderScanForLayers(struct loader_instance *inst, struct loader_layer_list
     bool override_layer_valid = false;
     char *override_paths = NULL;
     uint32_t total_count = 0;
+    struct loader_manifest_cache *manifest_cache = NULL;
+    struct loader_scan_snapshot *snapshot = NULL;
+    bool override_layer_found = false;
+    bool scan_complete = false;
+    struct loader_json_arena json_arena;
 
     memset(&manifest_files, 0, sizeof(struct loader_data_files));
 
@@ -4460,6 +4920,18 @@ void loaderScanForLayers(struct loader_instance *inst, struct loader_layer_list
 
     loader_platform_thread_lock_mutex(&loader_json_lock);
 
+    // Reuse an earlier scan if none of the paths it read changed since
+    snapshot = loaderScanSnapshotAcquire(inst, LOADER_SCAN_SNAPSHOT_LAYERS);
+    if (NULL != snapshot) {
+        loader_platform_thread_unlock_mutex(&loader_json_lock);
+        loaderScanSnapshotCopyLayers(inst, snapshot, instance_layers);
+        loaderScanSnapshotRelease(snapshot);
+        return;
+    }
+    loaderScanSnapshotBeginRecording(inst, LOADER_SCAN_SNAPSHOT_LAYERS);
+    loaderJsonArenaBegin(inst, &json_arena);
+    manifest_cache = loaderGetManifestCache(inst);
+
     // Get a list of manifest files for any implicit layers
     // Pass NULL for environment variable override - implicit layers are not overridden by LAYERS_PATH_ENV
     if (VK_SUCCESS != loaderGetDataFiles(inst, LOADER_DATA_FILE_MANIFEST_LAYER, false, NULL, NULL, VK_ILAYERS_INFO_REGISTRY_LOC,
@@ -4475,6 +4947,11 @@ void loaderScanForLayers(struct loader_instance *inst, struct loader_layer_list
                 continue;
             }
 
+            // Use the cached layers if the manifest hasn't changed
+            if (loaderManifestCacheFindLayers(inst, manifest_cache, file_str, true, instance_layers)) {
+                continue;
+            }
+
             // Parse file into JSON struct
             VkResult res = loader_get_json(inst, file_str, &json);
             if (VK_ERROR_OUT_OF_HOST_MEMORY == res) {
@@ -4483,18 +4960,21 @@ void loaderScanForLayers(struct loader_instance *inst, struct loader_layer_list
                 continue;
             }
 
+            uint32_t first_layer = instance_layers->count;
             VkResult local_res = loaderAddLayerProperties(inst, instance_layers, json, true, file_str);
             cJSON_Delete(json);
 
             if (VK_SUCCESS != local_res) {
                 goto out;
             }
+            loaderManifestCacheStoreLayers(inst, manifest_cache, file_str, true, instance_layers, first_layer);
         }
     }
 
     // Check to see if the override layer is present, and use it's override paths.
     for (int32_t i = 0; i < (int32_t)instance_layers->count; i++) {
         struct loader_layer_properties *prop = &instance_layers->list[i];
+        override_layer_found |= prop->is_override;
         if (prop->is_override && loaderImplicitLayerIsEnabled(inst, prop) && prop->num_override_paths > 0) {
             char *cur_write_ptr = NULL;
             size_t override_path_size = 0;
@@ -4526,6 +5006,7 @@ void loaderScanForLayers(struct loader_instance *inst, struct loader_layer_list
 
     // Make sure we have at least one layer, if not, go ahead and return
     if (manifest_files.count == 0 && total_count == 0) {
+        scan_complete = true;
         goto out;
     } else {
         total_count += manifest_files.count;
@@ -4535,6 +5016,11 @@ void loaderScanForLayers(struct loader_instance *inst, struct loader_layer_list
                 continue;
             }
 
+            // Use the cached layers if the manifest hasn't changed
+            if (loaderManifestCacheFindLayers(inst, manifest_cache, file_str, false, instance_layers)) {
+                continue;
+            }
+
             // Parse file into JSON struct
             VkResult res = loader_get_json(inst, file_str, &json);
             if (VK_ERROR_OUT_OF_HOST_MEMORY == res) {
@@ -4543,12 +5029,15 @@ void loaderScanForLayers(struct loader_instance *inst, struct loader_layer_list
                 continue;
             }
 
+            uint32_t first_layer = instance_layers->count;
             VkResult local_res = loaderAddLayerProperties(inst, instance_layers, json, false, file_str);
             cJSON_Delete(json);
 
             // If the error is anything other than out of memory we still want to try to load the other layers
             if (VK_ERROR_OUT_OF_HOST_MEMORY == local_res) {
                 goto out;
+            } else if (VK_SUCCESS == local_res) {
+                loaderManifestCacheStoreLayers(inst, manifest_cache, file_str, false, instance_layers, first_layer);
             }
         }
     }
@@ -4563,6 +5052,7 @@ void loaderScanForLayers(struct loader_instance *inst, struct loader_layer_list
             inst->override_layer_present = true;
         }
     }
+    scan_complete = true;
 
 out:
 
@@ -4577,6 +5067,13 @@ out:
         }
         loader_instance_heap_free(inst, manifest_files.filename_list);
     }
+    // Whether the override layer is enabled can change without any manifest changing
+    if (scan_complete && !override_layer_found) {
+        loaderScanSnapshotCommit(inst, instance_layers);
+    }
+    loaderScanSnapshotEndRecording();
+    loaderManifestCacheFlush(inst, manifest_cache);
+    loaderJsonArenaEnd(&json_arena);
     loader_platform_thread_unlock_mutex(&loader_json_lock);
 }
 
@@ -4587,31 +5084,55 @@ void loaderScanForImplicitLayers(struct loader_instance *inst, struct loader_lay
     bool override_layer_valid = false;
     char *override_paths = NULL;
     bool implicit_metalayer_present = false;
-    bool have_json_lock = false;
+    struct loader_manifest_cache *manifest_cache = NULL;
+    struct loader_scan_snapshot *snapshot = NULL;
+    bool override_layer_found = false;
+    bool scan_complete = false;
+    struct loader_json_arena json_arena;
 
     // Before we begin anything, init manifest_files to avoid a delete of garbage memory if
     // a failure occurs before allocating the manifest filename_list.
     memset(&manifest_files, 0, sizeof(struct loader_data_files));
 
+    loader_platform_thread_lock_mutex(&loader_json_lock);
+
+    // Reuse an earlier scan if none of the paths it read changed since
+    snapshot = loaderScanSnapshotAcquire(inst, LOADER_SCAN_SNAPSHOT_IMPLICIT_LAYERS);
+    if (NULL != snapshot) {
+        loader_platform_thread_unlock_mutex(&loader_json_lock);
+        loaderDeleteLayerListAndProperties(inst, instance_layers);
+        loaderScanSnapshotCopyLayers(inst, snapshot, instance_layers);
+        loaderScanSnapshotRelease(snapshot);
+        return;
+    }
+    loaderScanSnapshotBeginRecording(inst, LOADER_SCAN_SNAPSHOT_IMPLICIT_LAYERS);
+    loaderJsonArenaBegin(inst, &json_arena);
+    manifest_cache = loaderGetManifestCache(inst);
+
     // Pass NULL for environment variable override - implicit layers are not overridden by LAYERS_PATH_ENV
     VkResult res = loaderGetDataFiles(inst, LOADER_DATA_FILE_MANIFEST_LAYER, false, NULL, NULL, VK_ILAYERS_INFO_REGISTRY_LOC,
                                       VK_ILAYERS_INFO_RELATIVE_DIR, &manifest_files);
     if (VK_SUCCESS != res || manifest_files.count == 0) {
+        scan_complete = (VK_SUCCESS == res);
         goto out;
     }
 
     // Cleanup any previously scanned libraries
     loaderDeleteLayerListAndProperties(inst, instance_layers);
 
-    loader_platform_thread_lock_mutex(&loader_json_lock);
-    have_json_lock = true;
-
     for (uint32_t i = 0; i < manifest_files.count; i++) {
         file_str = manifest_files.filename_list[i];
         if (file_str == NULL) {
             continue;
         }
 
+        // Use the cached layers if the manifest hasn't changed
+        if (loaderManifestCacheFindLayers(inst, manifest_cache, file_str, true, instance_layers)) {
+            loader_instance_heap_free(inst, file_str);
+            manifest_files.filename_list[i] = NULL;
+            continue;
+        }
+
         // parse file into JSON struct
         res = loader_get_json(inst, file_str, &json);
         if (VK_ERROR_OUT_OF_HOST_MEMORY == res) {
@@ -4620,7 +5141,11 @@ void loaderScanForImplicitLayers(struct loader_instance *inst, struct loader_lay
             continue;
         }
 
+        uint32_t first_layer = instance_layers->count;
         res = loaderAddLayerProperties(inst, instance_layers, json, true, file_str);
+        if (VK_SUCCESS == res) {
+            loaderManifestCacheStoreLayers(inst, manifest_cache, file_str, true, instance_layers, first_layer);
+        }
 
         loader_instance_heap_free(inst, file_str);
         manifest_files.filename_list[i] = NULL;
@@ -4635,6 +5160,7 @@ void loaderScanForImplicitLayers(struct loader_instance *inst, struct loader_lay
     // Each of these may require explicit layers to be enabled at this time.
     for (int32_t i = 0; i < (int32_t)instance_layers->count; i++) {
         struct loader_layer_properties *prop = &instance_layers->list[i];
+        override_layer_found |= prop->is_override;
         if (prop->is_override && loaderImplicitLayerIsEnabled(inst, prop)) {
             override_layer_valid = true;
             if (prop->num_override_paths > 0) {
@@ -4678,6 +5204,12 @@ void loaderScanForImplicitLayers(struct loader_instance *inst, struct loader_lay
                 continue;
             }
 
+            // Use the cached layers if the manifest hasn't changed
+            if (loaderManifestCacheFindLayers(inst, manifest_cache, file_str, true, instance_layers)) {
+                loader_instance_heap_free(inst, file_str);
+                continue;
+            }
+
             // parse file into JSON struct
             res = loader_get_json(inst, file_str, &json);
             if (VK_ERROR_OUT_OF_HOST_MEMORY == res) {
@@ -4686,7 +5218,11 @@ void loaderScanForImplicitLayers(struct loader_instance *inst, struct loader_lay
                 continue;
             }
 
+            uint32_t first_layer = instance_layers->count;
             res = loaderAddLayerProperties(inst, instance_layers, json, true, file_str);
+            if (VK_SUCCESS == res) {
+                loaderManifestCacheStoreLayers(inst, manifest_cache, file_str, true, instance_layers, first_layer);
+            }
 
             loader_instance_heap_free(inst, file_str);
             cJSON_Delete(json);
@@ -4707,6 +5243,7 @@ void loaderScanForImplicitLayers(struct loader_instance *inst, struct loader_lay
             inst->override_layer_present = true;
         }
     }
+    scan_complete = true;
 
 out:
 
@@ -4717,9 +5254,14 @@ out:
         loader_instance_heap_free(inst, manifest_files.filename_list);
     }
 
-    if (have_json_lock) {
-        loader_platform_thread_unlock_mutex(&loader_json_lock);
+    // Whether the override layer is enabled can change without any manifest changing
+    if (scan_complete && !override_layer_found) {
+        loaderScanSnapshotCommit(inst, instance_layers);
     }
+    loaderScanSnapshotEndRecording();
+    loaderManifestCacheFlush(inst, manifest_cache);
+    loaderJsonArenaEnd(&json_arena);
+    loader_platform_thread_unlock_mutex(&loader_json_lock);
 }
 
 static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL loader_gpdpa_instance_internal(VkInstance inst, const char *pName) {
@@ -4832,6 +5374,47 @@ static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL loader_gpa_instance_internal(VkI
     return NULL;
 }
 
+// Device terminators that unwrap nothing and only guard against an ICD without the command.  The
+// VK_EXT_debug_utils label commands are device commands of an instance extension, so the loader
+// offers them whether or not the ICD has them.
+static const struct {
+    PFN_vkVoidFunction terminator;
+    size_t icd_dispatch_offset;
+} loader_guard_device_terminators[] = {
+    {(PFN_vkVoidFunction)terminator_QueueBeginDebugUtilsLabelEXT,
+     offsetof(struct loader_icd_term_dispatch, QueueBeginDebugUtilsLabelEXT)},
+    {(PFN_vkVoidFunction)terminator_QueueEndDebugUtilsLabelEXT,
+     offsetof(struct loader_icd_term_dispatch, QueueEndDebugUtilsLabelEXT)},
+    {(PFN_vkVoidFunction)terminator_QueueInsertDebugUtilsLabelEXT,
+     offsetof(struct loader_icd_term_dispatch, QueueInsertDebugUtilsLabelEXT)},
+    {(PFN_vkVoidFunction)terminator_CmdBeginDebugUtilsLabelEXT,
+     offsetof(struct loader_icd_term_dispatch, CmdBeginDebugUtilsLabelEXT)},
+    {(PFN_vkVoidFunction)terminator_CmdEndDebugUtilsLabelEXT,
+     offsetof(struct loader_icd_term_dispatch, CmdEndDebugUtilsLabelEXT)},
+    {(PFN_vkVoidFunction)terminator_CmdInsertDebugUtilsLabelEXT,
+     offsetof(struct loader_icd_term_dispatch, CmdInsertDebugUtilsLabelEXT)},
+};
+
+// Returns the ICD's own entry point in place of a guard terminator when the ICD has the command.
+// Each call through the terminator looks the device up again, which recording label commands in
+// a loop pays for every time.  Any other terminator is returned as it is.
+static PFN_vkVoidFunction loader_skip_guard_device_terminator(struct loader_icd_term *icd_term, VkDevice device,
+                                                              const char *pName, PFN_vkVoidFunction terminator) {
+    for (uint32_t i = 0; i < sizeof(loader_guard_device_terminators) / sizeof(loader_guard_device_terminators[0]); i++) {
+        if (loader_guard_device_terminators[i].terminator != terminator) {
+            continue;
+        }
+        PFN_vkVoidFunction icd_entry =
+            *(PFN_vkVoidFunction *)((char *)&icd_term->dispatch + loader_guard_device_terminators[i].icd_dispatch_offset);
+        if (NULL == icd_entry) {
+            return terminator;
+        }
+        PFN_vkVoidFunction addr = icd_term->dispatch.GetDeviceProcAddr(device, pName);
+        return NULL != addr ? addr : terminator;
+    }
+    return terminator;
+}
+
 VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL loader_gpa_device_internal(VkDevice device, const char *pName) {
     struct loader_device *dev;
     struct loader_icd_term *icd_term = loader_get_icd_and_device(device, &dev, NULL);
@@ -4852,12 +5435,96 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL loader_gpa_device_internal(VkDevice dev
     // vkGetDeviceProcAddr to intercept those calls.
     PFN_vkVoidFunction addr = get_extension_device_proc_terminator(dev, pName);
     if (NULL != addr) {
-        return addr;
+        return loader_skip_guard_device_terminator(icd_term, device, pName, addr);
     }
 
     return icd_term->dispatch.GetDeviceProcAddr(device, pName);
 }
 
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+
+// Sets entry idx of an array of unknown function entry points, growing it if needed.  The map's
+// lock is what serializes changes to the arrays indexed by it.
+static bool loader_set_unknown_ext_entry(const struct loader_instance *inst, struct loader_unknown_ext_map *map,
+                                         const struct loader_device *dev, struct loader_unknown_ext_array **array, uint32_t idx,
+                                         void *value, void *fill) {
+    bool set = false;
+
+    loader_platform_thread_lock_mutex(&map->lock);
+    if (VK_SUCCESS == loaderUnknownExtArrayReserve(inst, dev, array, idx, fill)) {
+        loader_platform_atomic_store_ptr(&(*array)->entries[idx], value);
+        set = true;
+    }
+    loader_platform_thread_unlock_mutex(&map->lock);
+
+    if (!set) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                   "loader_set_unknown_ext_entry: Failed to grow the dispatch array for %s", loaderUnknownExtMapName(map, idx));
+    }
+    return set;
+}
+
+static void loader_set_dev_ext_entry(struct loader_instance *inst, struct loader_device *dev, uint32_t idx, const char *funcName) {
+    void *gdpa_value = dev->loader_dispatch.core_dispatch.GetDeviceProcAddr(dev->chain_device, funcName);
+    if (gdpa_value != NULL) {
+        // Entries past the end of the array go to vkDevExtError in the trampolines, so the gaps
+        // are filled with it too
+        loader_set_unknown_ext_entry(inst, &inst->dev_ext_map, dev, &dev->loader_dispatch.ext_dispatch, idx, gdpa_value,
+                                     (void *)vkDevExtError);
+    }
+}
+
+static void loader_set_phys_dev_ext_entry(struct loader_instance *inst, struct loader_unknown_ext_array **array, uint32_t idx,
+                                          void *value) {
+    loader_set_unknown_ext_entry(inst, &inst->phys_dev_ext_map, NULL, array, idx, value, NULL);
+}
+
+#else  // !LOADER_UNKNOWN_EXT_JIT
+
+// Returns dev's own table of unknown device functions, replacing loader_dev_ext_dispatch_error
+// with a copy of it the first time.  Threads adding different functions can get here for the
+// same device at once, so the table is published with a compare and exchange.
+static struct loader_dev_ext_dispatch_table *loader_get_dev_ext_dispatch(const struct loader_instance *inst,
+                                                                         struct loader_device *dev) {
+    struct loader_dev_ext_dispatch_table *ext_dispatch =
+        loader_platform_atomic_load_ptr((void *const *)&dev->loader_dispatch.ext_dispatch);
+    if (&loader_dev_ext_dispatch_error != ext_dispatch) {
+        return ext_dispatch;
+    }
+
+    ext_dispatch = loader_device_heap_alloc(dev, sizeof(struct loader_dev_ext_dispatch_table), VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+    if (NULL == ext_dispatch) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                   "loader_get_dev_ext_dispatch: Failed to allocate the dispatch table for unknown device functions");
+        return NULL;
+    }
+    memcpy(ext_dispatch, &loader_dev_ext_dispatch_error, sizeof(struct loader_dev_ext_dispatch_table));
+    if (!loader_platform_atomic_compare_exchange_ptr((void **)&dev->loader_dispatch.ext_dispatch, &loader_dev_ext_dispatch_error,
+                                                     ext_dispatch)) {
+        loader_device_heap_free(dev, ext_dispatch);
+        ext_dispatch = loader_platform_atomic_load_ptr((void *const *)&dev->loader_dispatch.ext_dispatch);
+    }
+    return ext_dispatch;
+}
+
+static void loader_set_dev_ext_entry(struct loader_instance *inst, struct loader_device *dev, uint32_t idx, const char *funcName) {
+    void *gdpa_value = dev->loader_dispatch.core_dispatch.GetDeviceProcAddr(dev->chain_device, funcName);
+    if (gdpa_value != NULL) {
+        struct loader_dev_ext_dispatch_table *ext_dispatch = loader_get_dev_ext_dispatch(inst, dev);
+        if (NULL != ext_dispatch) {
+            ext_dispatch->dev_ext[idx] = (PFN_vkDevExt)gdpa_value;
+        }
+    }
+}
+
+static void loader_set_phys_dev_ext_entry(struct loader_instance *inst, PFN_PhysDevExt (*array)[MAX_NUM_UNKNOWN_EXTS], uint32_t idx,
+                                          void *value) {
+    (void)inst;
+    (*array)[idx] = (PFN_PhysDevExt)value;
+}
+
+#endif  // LOADER_UNKNOWN_EXT_JIT
+
 // Initialize device_ext dispatch table entry as follows:
 // If dev == NULL find all logical devices created within this instance and
 //  init the entry (given by idx) in the ext dispatch table.
@@ -4869,28 +5536,28 @@ static void loader_init_dispatch_dev_ext_entry(struct loader_instance *inst, str
                                                const char *funcName)
 
 {
-    void *gdpa_value;
     if (dev != NULL) {
-        gdpa_value = dev->loader_dispatch.core_dispatch.GetDeviceProcAddr(dev->chain_device, funcName);
-        if (gdpa_value != NULL) dev->loader_dispatch.ext_dispatch.dev_ext[idx] = (PFN_vkDevExt)gdpa_value;
+        loader_set_dev_ext_entry(inst, dev, idx, funcName);
     } else {
+        // The logical device lists can change under other threads' vkCreateDevice and vkDestroyDevice
+        loader_platform_thread_read_lock_rwlock(&loader_instance_list_lock);
         for (struct loader_icd_term *icd_term = inst->icd_terms; icd_term != NULL; icd_term = icd_term->next) {
             struct loader_device *ldev = icd_term->logical_device_list;
             while (ldev) {
-                gdpa_value = ldev->loader_dispatch.core_dispatch.GetDeviceProcAddr(ldev->chain_device, funcName);
-                if (gdpa_value != NULL) ldev->loader_dispatch.ext_dispatch.dev_ext[idx] = (PFN_vkDevExt)gdpa_value;
+                loader_set_dev_ext_entry(inst, ldev, idx, funcName);
                 ldev = ldev->next;
             }
         }
+        loader_platform_thread_read_unlock_rwlock(&loader_instance_list_lock);
     }
 }
 
-// Find all dev extension in the hash table  and initialize the dispatch table
-// for dev  for each of those extension entrypoints found in hash table.
+// Find all dev extension in the unknown extension map and initialize the
+// dispatch table for dev for each of those extension entrypoints.
 void loader_init_dispatch_dev_ext(struct loader_instance *inst, struct loader_device *dev) {
-    for (uint32_t i = 0; i < MAX_NUM_UNKNOWN_EXTS; i++) {
-        if (inst->dev_ext_disp_hash[i].func_name != NULL)
-            loader_init_dispatch_dev_ext_entry(inst, dev, i, inst->dev_ext_disp_hash[i].func_name);
+    const char *func_name;
+    for (uint32_t i = 0; NULL != (func_name = loaderUnknownExtMapName(&inst->dev_ext_map, i)); i++) {
+        loader_init_dispatch_dev_ext_entry(inst, dev, i, func_name);
     }
 }
 
@@ -4926,128 +5593,26 @@ static bool loader_check_layer_list_for_dev_ext_address(const struct loader_laye
     return false;
 }
 
-static void loader_free_dev_ext_table(struct loader_instance *inst) {
-    for (uint32_t i = 0; i < MAX_NUM_UNKNOWN_EXTS; i++) {
-        loader_instance_heap_free(inst, inst->dev_ext_disp_hash[i].func_name);
-        loader_instance_heap_free(inst, inst->dev_ext_disp_hash[i].list.index);
-    }
-    memset(inst->dev_ext_disp_hash, 0, sizeof(inst->dev_ext_disp_hash));
-}
-
-static bool loader_add_dev_ext_table(struct loader_instance *inst, uint32_t *ptr_idx, const char *funcName) {
-    uint32_t i;
-    uint32_t idx = *ptr_idx;
-    struct loader_dispatch_hash_list *list = &inst->dev_ext_disp_hash[idx].list;
-
-    if (!inst->dev_ext_disp_hash[idx].func_name) {
-        // no entry here at this idx, so use it
-        assert(list->capacity == 0);
-        inst->dev_ext_disp_hash[idx].func_name =
-            (char *)loader_instance_heap_alloc(inst, strlen(funcName) + 1, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-        if (inst->dev_ext_disp_hash[idx].func_name == NULL) {
-            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                       "loader_add_dev_ext_table: Failed to allocate memory "
-                       "for func_name %s",
-                       funcName);
-            return false;
-        }
-        strncpy(inst->dev_ext_disp_hash[idx].func_name, funcName, strlen(funcName) + 1);
-        return true;
-    }
-
-    // check for enough capacity
-    if (list->capacity == 0) {
-        list->index = loader_instance_heap_alloc(inst, 8 * sizeof(*(list->index)), VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-        if (list->index == NULL) {
-            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                       "loader_add_dev_ext_table: Failed to allocate memory for list index of function %s", funcName);
-            return false;
-        }
-        list->capacity = 8 * sizeof(*(list->index));
-    } else if (list->capacity < (list->count + 1) * sizeof(*(list->index))) {
-        void *new_ptr = loader_instance_heap_realloc(inst, list->index, list->capacity, list->capacity * 2,
-                                                     VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-        if (NULL == new_ptr) {
-            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                       "loader_add_dev_ext_table: Failed to reallocate memory for list index of function %s", funcName);
-            return false;
-        }
-        list->index = new_ptr;
-        list->capacity *= 2;
-    }
-
-    // find an unused index in the hash table and use it
-    i = (idx + 1) % MAX_NUM_UNKNOWN_EXTS;
-    do {
-        if (!inst->dev_ext_disp_hash[i].func_name) {
-            assert(inst->dev_ext_disp_hash[i].list.capacity == 0);
-            inst->dev_ext_disp_hash[i].func_name =
-                (char *)loader_instance_heap_alloc(inst, strlen(funcName) + 1, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-            if (inst->dev_ext_disp_hash[i].func_name == NULL) {
-                loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                           "loader_add_dev_ext_table: Failed to allocate memory "
-                           "for func_name %s",
-                           funcName);
-                return false;
-            }
-            strncpy(inst->dev_ext_disp_hash[i].func_name, funcName, strlen(funcName) + 1);
-            list->index[list->count] = i;
-            list->count++;
-            *ptr_idx = i;
-            return true;
-        }
-        i = (i + 1) % MAX_NUM_UNKNOWN_EXTS;
-    } while (i != idx);
-
-    loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-               "loader_add_dev_ext_table:  Could not insert into hash table; is "
-               "it full?");
-
-    return false;
-}
-
-static bool loader_name_in_dev_ext_table(struct loader_instance *inst, uint32_t *idx, const char *funcName) {
-    uint32_t alt_idx;
-    if (inst->dev_ext_disp_hash[*idx].func_name && !strcmp(inst->dev_ext_disp_hash[*idx].func_name, funcName)) return true;
-
-    // funcName wasn't at the primary spot in the hash table
-    // search the list of secondary locations (shallow search, not deep search)
-    for (uint32_t i = 0; i < inst->dev_ext_disp_hash[*idx].list.count; i++) {
-        alt_idx = inst->dev_ext_disp_hash[*idx].list.index[i];
-        if (!strcmp(inst->dev_ext_disp_hash[*idx].func_name, funcName)) {
-            *idx = alt_idx;
-            return true;
-        }
-    }
-
-    return false;
-}
-
 // This function returns generic trampoline code address for unknown entry
 // points.
 // Presumably, these unknown entry points (as given by funcName) are device
-// extension entrypoints.  A hash table is used to keep a list of unknown entry
-// points and their mapping to the device extension dispatch table
+// extension entrypoints.  The instance's dev_ext_map keeps a list of unknown
+// entry points and their mapping to the device extension dispatch table
 // (struct loader_dev_ext_dispatch_table).
 // \returns
 // For a given entry point string (funcName), if an existing mapping is found
-// the
-// trampoline address for that mapping is returned. Otherwise, this unknown
-// entry point
-// has not been seen yet. Next check if a layer or ICD supports it.  If so then
-// a
-// new entry in the hash table is initialized and that trampoline address for
-// the new entry is returned. Null is returned if the hash table is full or
-// if no discovered layer or ICD returns a non-NULL GetProcAddr for it.
+// the trampoline address for that mapping is returned. Otherwise, this unknown
+// entry point has not been seen yet. Next check if a layer or ICD supports it.
+// If so then a new entry in the map is initialized and that trampoline address
+// for the new entry is returned. Null is returned if there is no trampoline for
+// it, or if no discovered layer or ICD returns a non-NULL GetProcAddr for it.
 void *loader_dev_ext_gpa(struct loader_instance *inst, const char *funcName) {
     uint32_t idx;
-    uint32_t seed = 0;
-
-    idx = murmurhash(funcName, strlen(funcName), seed) % MAX_NUM_UNKNOWN_EXTS;
+    bool added;
 
-    if (loader_name_in_dev_ext_table(inst, &idx, funcName))
-        // found funcName already in hash
-        return loader_get_dev_ext_trampoline(idx);
+    if (loaderUnknownExtMapFind(&inst->dev_ext_map, funcName, &idx))
+        // found funcName already in the map
+        return loaderUnknownExtDevTramp(idx);
 
     // Check if funcName is supported in either ICDs or a layer library
     if (!loader_check_icds_for_dev_ext_address(inst, funcName) &&
@@ -5056,14 +5621,14 @@ void *loader_dev_ext_gpa(struct loader_instance *inst, const char *funcName) {
         return NULL;
     }
 
-    if (loader_add_dev_ext_table(inst, &idx, funcName)) {
-        // successfully added new table entry
-        // init any dev dispatch table entries as needed
-        loader_init_dispatch_dev_ext_entry(inst, NULL, idx, funcName);
-        return loader_get_dev_ext_trampoline(idx);
+    if (VK_SUCCESS != loaderUnknownExtMapAdd(inst, &inst->dev_ext_map, funcName, &idx, &added)) {
+        return NULL;
     }
 
-    return NULL;
+    // Init any dev dispatch table entries as needed.  This is also done when
+    // another thread added the name first, since it may not have finished yet.
+    loader_init_dispatch_dev_ext_entry(inst, NULL, idx, funcName);
+    return loaderUnknownExtDevTramp(idx);
 }
 
 static bool loader_check_icds_for_phys_dev_ext_address(struct loader_instance *inst, const char *funcName) {
@@ -5097,103 +5662,10 @@ static bool loader_check_layer_list_for_phys_dev_ext_address(struct loader_insta
     return false;
 }
 
-static void loader_free_phys_dev_ext_table(struct loader_instance *inst) {
-    for (uint32_t i = 0; i < MAX_NUM_UNKNOWN_EXTS; i++) {
-        loader_instance_heap_free(inst, inst->phys_dev_ext_disp_hash[i].func_name);
-        loader_instance_heap_free(inst, inst->phys_dev_ext_disp_hash[i].list.index);
-    }
-    memset(inst->phys_dev_ext_disp_hash, 0, sizeof(inst->phys_dev_ext_disp_hash));
-}
-
-static bool loader_add_phys_dev_ext_table(struct loader_instance *inst, uint32_t *ptr_idx, const char *funcName) {
-    uint32_t i;
-    uint32_t idx = *ptr_idx;
-    struct loader_dispatch_hash_list *list = &inst->phys_dev_ext_disp_hash[idx].list;
-
-    if (!inst->phys_dev_ext_disp_hash[idx].func_name) {
-        // no entry here at this idx, so use it
-        assert(list->capacity == 0);
-        inst->phys_dev_ext_disp_hash[idx].func_name =
-            (char *)loader_instance_heap_alloc(inst, strlen(funcName) + 1, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-        if (inst->phys_dev_ext_disp_hash[idx].func_name == NULL) {
-            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                       "loader_add_phys_dev_ext_table() can't allocate memory for "
-                       "func_name");
-            return false;
-        }
-        strncpy(inst->phys_dev_ext_disp_hash[idx].func_name, funcName, strlen(funcName) + 1);
-        return true;
-    }
-
-    // check for enough capacity
-    if (list->capacity == 0) {
-        list->index = loader_instance_heap_alloc(inst, 8 * sizeof(*(list->index)), VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-        if (list->index == NULL) {
-            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "loader_add_phys_dev_ext_table() can't allocate list memory");
-            return false;
-        }
-        list->capacity = 8 * sizeof(*(list->index));
-    } else if (list->capacity < (list->count + 1) * sizeof(*(list->index))) {
-        void *new_ptr = loader_instance_heap_realloc(inst, list->index, list->capacity, list->capacity * 2,
-                                                     VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-        if (NULL == new_ptr) {
-            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "loader_add_phys_dev_ext_table() can't reallocate list memory");
-            return false;
-        }
-        list->index = new_ptr;
-        list->capacity *= 2;
-    }
-
-    // find an unused index in the hash table and use it
-    i = (idx + 1) % MAX_NUM_UNKNOWN_EXTS;
-    do {
-        if (!inst->phys_dev_ext_disp_hash[i].func_name) {
-            assert(inst->phys_dev_ext_disp_hash[i].list.capacity == 0);
-            inst->phys_dev_ext_disp_hash[i].func_name =
-                (char *)loader_instance_heap_alloc(inst, strlen(funcName) + 1, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-            if (inst->phys_dev_ext_disp_hash[i].func_name == NULL) {
-                loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                           "loader_add_dev_ext_table() can't reallocate "
-                           "func_name memory");
-                return false;
-            }
-            strncpy(inst->phys_dev_ext_disp_hash[i].func_name, funcName, strlen(funcName) + 1);
-            list->index[list->count] = i;
-            list->count++;
-            *ptr_idx = i;
-            return true;
-        }
-        i = (i + 1) % MAX_NUM_UNKNOWN_EXTS;
-    } while (i != idx);
-
-    loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-               "loader_add_phys_dev_ext_table() couldn't insert into hash table; is "
-               "it full?");
-    return false;
-}
-
-static bool loader_name_in_phys_dev_ext_table(struct loader_instance *inst, uint32_t *idx, const char *funcName) {
-    uint32_t alt_idx;
-    if (inst->phys_dev_ext_disp_hash[*idx].func_name && !strcmp(inst->phys_dev_ext_disp_hash[*idx].func_name, funcName))
-        return true;
-
-    // funcName wasn't at the primary spot in the hash table
-    // search the list of secondary locations (shallow search, not deep search)
-    for (uint32_t i = 0; i < inst->phys_dev_ext_disp_hash[*idx].list.count; i++) {
-        alt_idx = inst->phys_dev_ext_disp_hash[*idx].list.index[i];
-        if (!strcmp(inst->phys_dev_ext_disp_hash[*idx].func_name, funcName)) {
-            *idx = alt_idx;
-            return true;
-        }
-    }
-
-    return false;
-}
-
 // This function returns a generic trampoline and/or terminator function
-// address for any unknown physical device extension commands.  A hash
-// table is used to keep a list of unknown entry points and their
-// mapping to the physical device extension dispatch table (struct
+// address for any unknown physical device extension commands.  The instance's
+// phys_dev_ext_map keeps a list of unknown entry points and their mapping to
+// the physical device extension dispatch table (struct
 // loader_phys_dev_ext_dispatch_table).
 // For a given entry point string (funcName), if an existing mapping is
 // found, then the trampoline address for that mapping is returned in
@@ -5202,14 +5674,14 @@ static bool loader_name_in_phys_dev_ext_table(struct loader_instance *inst, uint
 // this unknown entry point has not been seen yet.
 // If it has not been seen before, and perform_checking is 'true',
 // check if a layer or and ICD supports it.  If so then a new entry in
-// the hash table is initialized and the trampoline and/or terminator
+// the map is initialized and the trampoline and/or terminator
 // addresses are returned.
-// Null is returned if the hash table is full or if no discovered layer or
-// ICD returns a non-NULL GetProcAddr for it.
+// False is returned if there is no trampoline for it, or if no discovered layer
+// or ICD returns a non-NULL GetProcAddr for it.
 bool loader_phys_dev_ext_gpa(struct loader_instance *inst, const char *funcName, bool perform_checking, void **tramp_addr,
                              void **term_addr) {
     uint32_t idx;
-    uint32_t seed = 0;
+    bool added;
     bool success = false;
 
     if (inst == NULL) {
@@ -5223,65 +5695,73 @@ bool loader_phys_dev_ext_gpa(struct loader_instance *inst, const char *funcName,
         *term_addr = NULL;
     }
 
-    // We should always check to see if any ICD supports it.
-    if (!loader_check_icds_for_phys_dev_ext_address(inst, funcName)) {
-        // If we're not checking layers, or we are and it's not in a layer, just
-        // return
-        if (!perform_checking || !loader_check_layer_list_for_phys_dev_ext_address(inst, funcName)) {
-            goto out;
-        }
+    if (loaderUnknownExtMapFind(&inst->phys_dev_ext_map, funcName, &idx)) {
+        goto found;
     }
 
-    idx = murmurhash(funcName, strlen(funcName), seed) % MAX_NUM_UNKNOWN_EXTS;
-    if (perform_checking && !loader_name_in_phys_dev_ext_table(inst, &idx, funcName)) {
-        uint32_t i;
-        bool added = false;
+    // Without checking, only names that were already set up can be returned;
+    // any other index would point at dispatch entries nobody initialized.
+    if (!perform_checking) {
+        goto out;
+    }
 
-        // Only need to add first one to get index in Instance.  Others will use
-        // the same index.
-        if (!added && loader_add_phys_dev_ext_table(inst, &idx, funcName)) {
-            added = true;
-        }
+    // Check if any ICD or layer supports it.
+    if (!loader_check_icds_for_phys_dev_ext_address(inst, funcName) &&
+        !loader_check_layer_list_for_phys_dev_ext_address(inst, funcName)) {
+        goto out;
+    }
 
-        // Setup the ICD function pointers
-        struct loader_icd_term *icd_term = inst->icd_terms;
-        while (NULL != icd_term) {
-            if (MIN_PHYS_DEV_EXTENSION_ICD_INTERFACE_VERSION <= icd_term->scanned_icd->interface_version &&
-                NULL != icd_term->scanned_icd->GetPhysicalDeviceProcAddr) {
-                icd_term->phys_dev_ext[idx] =
-                    (PFN_PhysDevExt)icd_term->scanned_icd->GetPhysicalDeviceProcAddr(icd_term->instance, funcName);
+    if (VK_SUCCESS != loaderUnknownExtMapAdd(inst, &inst->phys_dev_ext_map, funcName, &idx, &added)) {
+        goto out;
+    }
 
-                // Make sure we set the instance dispatch to point to the
-                // loader's terminator now since we can at least handle it
-                // in one ICD.
-                inst->disp->phys_dev_ext[idx] = loader_get_phys_dev_ext_termin(idx);
-            } else {
-                icd_term->phys_dev_ext[idx] = NULL;
-            }
+    // Setup the ICD function pointers.  This is also done when another thread
+    // added the name first, since it may not have finished yet.
+    struct loader_icd_term *icd_term = inst->icd_terms;
+    while (NULL != icd_term) {
+        void *icd_func = NULL;
+        if (MIN_PHYS_DEV_EXTENSION_ICD_INTERFACE_VERSION <= icd_term->scanned_icd->interface_version &&
+            NULL != icd_term->scanned_icd->GetPhysicalDeviceProcAddr) {
+            icd_func = (void *)icd_term->scanned_icd->GetPhysicalDeviceProcAddr(icd_term->instance, funcName);
 
-            icd_term = icd_term->next;
+            // Make sure we set the instance dispatch to point to the
+            // loader's terminator now since we can at least handle it
+            // in one ICD.
+            loader_set_phys_dev_ext_entry(inst, &inst->disp->phys_dev_ext, idx, loaderUnknownExtPhysDevTermin(idx));
         }
+        loader_set_phys_dev_ext_entry(inst, &icd_term->phys_dev_ext, idx, icd_func);
 
-        // Now, search for the first layer attached and query using it to get
-        // the first entry point.
-        for (i = 0; i < inst->expanded_activated_layer_list.count; i++) {
-            struct loader_layer_properties *layer_prop = &inst->expanded_activated_layer_list.list[i];
-            if (layer_prop->interface_version > 1 && NULL != layer_prop->functions.get_physical_device_proc_addr) {
-                inst->disp->phys_dev_ext[idx] =
-                    (PFN_PhysDevExt)layer_prop->functions.get_physical_device_proc_addr((VkInstance)inst->instance, funcName);
-                if (NULL != inst->disp->phys_dev_ext[idx]) {
-                    break;
-                }
+        icd_term = icd_term->next;
+    }
+
+    // Now, search for the first layer attached and query using it to get
+    // the first entry point.
+    for (uint32_t i = 0; i < inst->expanded_activated_layer_list.count; i++) {
+        struct loader_layer_properties *layer_prop = &inst->expanded_activated_layer_list.list[i];
+        if (layer_prop->interface_version > 1 && NULL != layer_prop->functions.get_physical_device_proc_addr) {
+            void *layer_func =
+                (void *)layer_prop->functions.get_physical_device_proc_addr((VkInstance)inst->instance, funcName);
+            loader_set_phys_dev_ext_entry(inst, &inst->disp->phys_dev_ext, idx, layer_func);
+            if (NULL != layer_func) {
+                break;
             }
         }
     }
 
+found:
+    // Where the trampolines are written at runtime, there are none if they couldn't be written
     if (NULL != tramp_addr) {
-        *tramp_addr = loader_get_phys_dev_ext_tramp(idx);
+        *tramp_addr = loaderUnknownExtPhysDevTramp(idx);
+        if (NULL == *tramp_addr) {
+            goto out;
+        }
     }
 
     if (NULL != term_addr) {
-        *term_addr = loader_get_phys_dev_ext_termin(idx);
+        *term_addr = loaderUnknownExtPhysDevTermin(idx);
+        if (NULL == *term_addr) {
+            goto out;
+        }
     }
 
     success = true;
@@ -5297,28 +5777,55 @@ struct loader_instance *loader_get_instance(const VkInstance instance) {
     const VkLayerInstanceDispatchTable *disp;
     struct loader_instance *ptr_instance = NULL;
     disp = loader_get_instance_layer_dispatch(instance);
-    for (struct loader_instance *inst = loader.instances; inst; inst = inst->next) {
-        if (&inst->disp->layer_inst_disp == disp) {
-            ptr_instance = inst;
-            break;
-        }
-    }
+    loader_platform_thread_read_lock_rwlock(&loader_instance_list_lock);
+    ptr_instance = loaderHandleIndexFind(&loader.instance_index, disp);
+    loader_platform_thread_read_unlock_rwlock(&loader_instance_list_lock);
     return ptr_instance;
 }
 
-static loader_platform_dl_handle loaderOpenLayerFile(const struct loader_instance *inst, const char *chain_type,
-                                                     struct loader_layer_properties *prop) {
-    if ((prop->lib_handle = loader_platform_open_library(prop->lib_name)) == NULL) {
-        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, loader_platform_open_library_error(prop->lib_name));
-    } else {
-        loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "Loading layer library %s", prop->lib_name);
-    }
-
-    return prop->lib_handle;
+// inst->disp must already be allocated, since its address is the lookup key
+void loaderAddInstanceToList(struct loader_instance *inst) {
+    loader_platform_thread_write_lock_rwlock(&loader_instance_list_lock);
+    inst->next = loader.instances;
+    loader.instances = inst;
+    loaderHandleIndexInsert(&loader.instance_index, &inst->index_node, &inst->disp->layer_inst_disp, inst);
+    loader_platform_thread_write_unlock_rwlock(&loader_instance_list_lock);
 }
 
-static void loaderCloseLayerFile(const struct loader_instance *inst, struct loader_layer_properties *prop) {
-    if (prop->lib_handle) {
+// Safe to call for an instance that was never added, or was already removed
+void loaderRemoveInstanceFromList(struct loader_instance *inst) {
+    loader_platform_thread_write_lock_rwlock(&loader_instance_list_lock);
+    struct loader_instance *prev = NULL;
+    struct loader_instance *next = loader.instances;
+    while (next != NULL) {
+        if (next == inst) {
+            // Remove this instance from the list:
+            if (prev)
+                prev->next = next->next;
+            else
+                loader.instances = next->next;
+            break;
+        }
+        prev = next;
+        next = next->next;
+    }
+    loaderHandleIndexRemove(&loader.instance_index, &inst->index_node);
+    loader_platform_thread_write_unlock_rwlock(&loader_instance_list_lock);
+}
+
+static loader_platform_dl_handle loaderOpenLayerFile(const struct loader_instance *inst, const char *chain_type,
+                                                     struct loader_layer_properties *prop) {
+    if ((prop->lib_handle = loader_platform_open_library(prop->lib_name)) == NULL) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, loader_platform_open_library_error(prop->lib_name));
+    } else {
+        loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "Loading layer library %s", prop->lib_name);
+    }
+
+    return prop->lib_handle;
+}
+
+static void loaderCloseLayerFile(const struct loader_instance *inst, struct loader_layer_properties *prop) {
+    if (prop->lib_handle) {
         loader_platform_close_library(prop->lib_handle);
         loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "Unloading layer library %s", prop->lib_name);
         prop->lib_handle = NULL;
@@ -5566,11 +6073,6 @@ VKAPI_ATTR VkResult VKAPI_CALL loader_layer_create_device(VkInstance instance, V
     // Initialize any device extension dispatch entry's from the instance list
     loader_init_dispatch_dev_ext(inst, dev);
 
-    // Initialize WSI device extensions as part of core dispatch since loader
-    // has dedicated trampoline code for these
-    loader_init_device_extension_dispatch_table(&dev->loader_dispatch, inst->disp->layer_inst_disp.GetInstanceProcAddr,
-                                                dev->loader_dispatch.core_dispatch.GetDeviceProcAddr, inst->instance, *pDevice);
-
 out:
 
     // Failure cleanup
@@ -5595,9 +6097,12 @@ VKAPI_ATTR void VKAPI_CALL loader_layer_destroy_device(VkDevice device, const Vk
     }
 
     struct loader_icd_term *icd_term = loader_get_icd_and_device(device, &dev, NULL);
-    const struct loader_instance *inst = icd_term->this_instance;
-
     destroyFunction(device, pAllocator);
+    if (NULL == icd_term) {
+        return;
+    }
+
+    const struct loader_instance *inst = icd_term->this_instance;
     dev->chain_device = NULL;
     dev->icd_device = NULL;
     loader_remove_logical_device(inst, icd_term, dev, pAllocator);
@@ -5663,7 +6168,7 @@ VkResult loader_create_instance_chain(const VkInstanceCreateInfo *pCreateInfo, c
             if (NULL == layer_prop->functions.negotiate_layer_interface) {
                 PFN_vkNegotiateLoaderLayerInterfaceVersion negotiate_interface = NULL;
                 bool functions_in_interface = false;
-                if (strlen(layer_prop->functions.str_negotiate_interface) == 0) {
+                if (NULL == layer_prop->functions.str_negotiate_interface) {
                     negotiate_interface = (PFN_vkNegotiateLoaderLayerInterfaceVersion)loader_platform_get_proc_address(
                         lib_handle, "vkNegotiateLoaderLayerInterfaceVersion");
                 } else {
@@ -5704,7 +6209,7 @@ VkResult loader_create_instance_chain(const VkInstanceCreateInfo *pCreateInfo, c
 
                 if (!functions_in_interface) {
                     if ((cur_gipa = layer_prop->functions.get_instance_proc_addr) == NULL) {
-                        if (strlen(layer_prop->functions.str_gipa) == 0) {
+                        if (NULL == layer_prop->functions.str_gipa) {
                             cur_gipa =
                                 (PFN_vkGetInstanceProcAddr)loader_platform_get_proc_address(lib_handle, "vkGetInstanceProcAddr");
                             layer_prop->functions.get_instance_proc_addr = cur_gipa;
@@ -5794,6 +6299,167 @@ void loaderActivateInstanceLayerExtensions(struct loader_instance *inst, VkInsta
                                                   created_inst);
 }
 
+void loaderDeviceDispatchCacheInit(struct loader_device_dispatch_cache *cache) {
+    memset(cache, 0, sizeof(*cache));
+    loader_platform_thread_create_mutex(&cache->lock);
+}
+
+void loaderDeviceDispatchCacheDestroy(const struct loader_instance *inst, struct loader_device_dispatch_cache *cache) {
+    for (uint32_t i = 0; i < LOADER_DEVICE_DISPATCH_CACHE_SIZE; i++) {
+        loader_instance_heap_free(inst, cache->entries[i]);
+    }
+    loader_platform_thread_delete_mutex(&cache->lock);
+    memset(cache, 0, sizeof(*cache));
+}
+
+static bool loader_name_in_list(const char *name, uint32_t count, const char *const *names) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (!strcmp(name, names[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Finds the features a device is created with, or returns false if anything but one
+// VkPhysicalDeviceFeatures2 is chained to pCreateInfo.  The contents of other structures can't be
+// compared, so a device created with them never shares a table.
+static bool loader_device_dispatch_cache_get_features(const VkDeviceCreateInfo *pCreateInfo, bool *has_features,
+                                                      VkPhysicalDeviceFeatures *features) {
+    memset(features, 0, sizeof(*features));
+    *has_features = NULL != pCreateInfo->pEnabledFeatures;
+    if (*has_features) {
+        *features = *pCreateInfo->pEnabledFeatures;
+    }
+    for (const VkBaseInStructure *next = pCreateInfo->pNext; NULL != next; next = next->pNext) {
+        if (VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 != next->sType || *has_features) {
+            return false;
+        }
+        *has_features = true;
+        *features = ((const VkPhysicalDeviceFeatures2 *)next)->features;
+    }
+    return true;
+}
+
+static bool loader_device_dispatch_cache_matches(const struct loader_device_dispatch_cache_entry *entry, VkPhysicalDevice pd,
+                                                 const struct loader_layer_list *layers, const VkDeviceCreateInfo *pCreateInfo,
+                                                 bool has_features, const VkPhysicalDeviceFeatures *features) {
+    if (entry->physical_device != pd || entry->layer_count != layers->count ||
+        entry->extension_count != pCreateInfo->enabledExtensionCount || entry->has_features != has_features ||
+        0 != memcmp(&entry->features, features, sizeof(*features))) {
+        return false;
+    }
+    for (uint32_t i = 0; i < entry->layer_count; i++) {
+        if (strcmp(entry->layer_names[i], layers->list[i].info.layerName)) {
+            return false;
+        }
+    }
+    // Compared as sets both ways, so a name listed twice can't stand in for a missing one
+    for (uint32_t i = 0; i < entry->extension_count; i++) {
+        if (!loader_name_in_list(pCreateInfo->ppEnabledExtensionNames[i], entry->extension_count,
+                                 (const char *const *)entry->extension_names) ||
+            !loader_name_in_list(entry->extension_names[i], entry->extension_count, pCreateInfo->ppEnabledExtensionNames)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Keeps a copy of a freshly resolved table in the next slot round robin.  Must be called with the
+// cache's lock held.  If the copy can't be allocated the table just isn't cached.
+static void loader_device_dispatch_cache_store(const struct loader_instance *inst, struct loader_device_dispatch_cache *cache,
+                                               VkPhysicalDevice pd, const struct loader_layer_list *layers,
+                                               const VkDeviceCreateInfo *pCreateInfo, bool has_features,
+                                               const VkPhysicalDeviceFeatures *features, const VkLayerDispatchTable *table) {
+    size_t size = sizeof(struct loader_device_dispatch_cache_entry) +
+                  (layers->count + pCreateInfo->enabledExtensionCount) * sizeof(char *);
+    for (uint32_t i = 0; i < layers->count; i++) {
+        size += strlen(layers->list[i].info.layerName) + 1;
+    }
+    for (uint32_t i = 0; i < pCreateInfo->enabledExtensionCount; i++) {
+        size += strlen(pCreateInfo->ppEnabledExtensionNames[i]) + 1;
+    }
+    struct loader_device_dispatch_cache_entry *entry = loader_instance_heap_alloc(inst, size, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (NULL == entry) {
+        return;
+    }
+    entry->physical_device = pd;
+    entry->layer_count = layers->count;
+    entry->layer_names = (char **)(entry + 1);
+    entry->extension_count = pCreateInfo->enabledExtensionCount;
+    entry->extension_names = entry->layer_names + entry->layer_count;
+    char *name = (char *)(entry->extension_names + entry->extension_count);
+    for (uint32_t i = 0; i < entry->layer_count; i++) {
+        entry->layer_names[i] = name;
+        strcpy(name, layers->list[i].info.layerName);
+        name += strlen(name) + 1;
+    }
+    for (uint32_t i = 0; i < entry->extension_count; i++) {
+        entry->extension_names[i] = name;
+        strcpy(name, pCreateInfo->ppEnabledExtensionNames[i]);
+        name += strlen(name) + 1;
+    }
+    entry->has_features = has_features;
+    entry->features = *features;
+    entry->core_dispatch = *table;
+
+    uint32_t slot = cache->next_replace;
+    cache->next_replace = (cache->next_replace + 1) % LOADER_DEVICE_DISPATCH_CACHE_SIZE;
+    loader_instance_heap_free(inst, cache->entries[slot]);
+    cache->entries[slot] = entry;
+}
+
+// Fills in the device's dispatch table from the device chain's vkGetDeviceProcAddr, which means
+// hundreds of lookups.  Vulkan lets layers and drivers hand out different functions for each
+// device, so the table is only copied from an earlier device when VK_LOADER_DEVICE_DISPATCH_CACHE
+// is set.  The earlier device must have been created on the same physical device, through the
+// same layers, with the same extensions and features.  A device created with other structures
+// chained to its create info, or by a layer calling down the chain itself, is always resolved in
+// full.
+static void loader_init_device_dispatch(const struct loader_instance *inst, VkPhysicalDevice pd,
+                                        const VkDeviceCreateInfo *pCreateInfo, PFN_vkGetDeviceProcAddr gdpa, bool whole_chain,
+                                        struct loader_device *dev) {
+    struct loader_device_dispatch_cache *cache = (struct loader_device_dispatch_cache *)&inst->device_dispatch_cache;
+    const struct loader_layer_list *layers = &dev->expanded_activated_layer_list;
+    VkLayerDispatchTable *table = &dev->loader_dispatch.core_dispatch;
+    bool has_features = false;
+    VkPhysicalDeviceFeatures features;
+    bool cacheable =
+        cache->enabled && whole_chain && loader_device_dispatch_cache_get_features(pCreateInfo, &has_features, &features);
+
+    if (cacheable) {
+        bool found = false;
+        loader_platform_thread_lock_mutex(&cache->lock);
+        for (uint32_t i = 0; i < LOADER_DEVICE_DISPATCH_CACHE_SIZE; i++) {
+            if (NULL != cache->entries[i] &&
+                loader_device_dispatch_cache_matches(cache->entries[i], pd, layers, pCreateInfo, has_features, &features)) {
+                *table = cache->entries[i]->core_dispatch;
+                found = true;
+                break;
+            }
+        }
+        loader_platform_thread_unlock_mutex(&cache->lock);
+        if (found) {
+            loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0,
+                       "loader_init_device_dispatch: Reusing the dispatch table of an earlier device");
+            return;
+        }
+    }
+
+    loader_init_device_dispatch_table(&dev->loader_dispatch, gdpa, dev->chain_device);
+
+    // Initialize WSI device extensions as part of core dispatch since loader
+    // has dedicated trampoline code for these
+    loader_init_device_extension_dispatch_table(&dev->loader_dispatch, inst->disp->layer_inst_disp.GetInstanceProcAddr, gdpa,
+                                                inst->instance, dev->chain_device);
+
+    if (cacheable) {
+        loader_platform_thread_lock_mutex(&cache->lock);
+        loader_device_dispatch_cache_store(inst, cache, pd, layers, pCreateInfo, has_features, &features, table);
+        loader_platform_thread_unlock_mutex(&cache->lock);
+    }
+}
+
 VkResult loader_create_device_chain(const VkPhysicalDevice pd, const VkDeviceCreateInfo *pCreateInfo,
                                     const VkAllocationCallbacks *pAllocator, const struct loader_instance *inst,
                                     struct loader_device *dev, PFN_vkGetInstanceProcAddr callingLayer,
@@ -5882,7 +6548,7 @@ VkResult loader_create_device_chain(const VkPhysicalDevice pd, const VkDeviceCre
             // The Get*ProcAddr pointers will already be filled in if they were received from either the json file or the
             // version negotiation
             if ((fpGIPA = layer_prop->functions.get_instance_proc_addr) == NULL) {
-                if (strlen(layer_prop->functions.str_gipa) == 0) {
+                if (NULL == layer_prop->functions.str_gipa) {
                     fpGIPA = (PFN_vkGetInstanceProcAddr)loader_platform_get_proc_address(lib_handle, "vkGetInstanceProcAddr");
                     layer_prop->functions.get_instance_proc_addr = fpGIPA;
                 } else
@@ -5907,7 +6573,7 @@ VkResult loader_create_device_chain(const VkPhysicalDevice pd, const VkDeviceCre
             }
 
             if ((fpGDPA = layer_prop->functions.get_device_proc_addr) == NULL) {
-                if (strlen(layer_prop->functions.str_gdpa) == 0) {
+                if (NULL == layer_prop->functions.str_gdpa) {
                     fpGDPA = (PFN_vkGetDeviceProcAddr)loader_platform_get_proc_address(lib_handle, "vkGetDeviceProcAddr");
                     layer_prop->functions.get_device_proc_addr = fpGDPA;
                 } else
@@ -5960,7 +6626,7 @@ VkResult loader_create_device_chain(const VkPhysicalDevice pd, const VkDeviceCre
     }
 
     // Initialize device dispatch table
-    loader_init_device_dispatch_table(&dev->loader_dispatch, nextGDPA, dev->chain_device);
+    loader_init_device_dispatch(inst, pd, pCreateInfo, nextGDPA, NULL == callingLayer, dev);
 
     return res;
 }
@@ -6153,10 +6819,21 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateInstance(const VkInstanceCreateI
     VkInstanceCreateInfo icd_create_info;
     VkResult res = VK_SUCCESS;
     bool one_icd_successful = false;
+    char *env_value;
 
     struct loader_instance *ptr_instance = (struct loader_instance *)*pInstance;
     memcpy(&icd_create_info, pCreateInfo, sizeof(icd_create_info));
 
+    // Check if a user wants surface formats and present modes kept after the first query
+    env_value = loader_getenv("VK_LOADER_SURFACE_QUERY_CACHE", ptr_instance);
+    ptr_instance->wsi_surface_query_cache_enabled = NULL != env_value && atoi(env_value) != 0;
+    loader_free_getenv(env_value, ptr_instance);
+
+    // Check if a user wants device dispatch tables shared between devices created the same way
+    env_value = loader_getenv("VK_LOADER_DEVICE_DISPATCH_CACHE", ptr_instance);
+    ptr_instance->device_dispatch_cache.enabled = NULL != env_value && atoi(env_value) != 0;
+    loader_free_getenv(env_value, ptr_instance);
+
     icd_create_info.enabledLayerCount = 0;
     icd_create_info.ppEnabledLayerNames = NULL;
 
@@ -6324,20 +7001,7 @@ VKAPI_ATTR void VKAPI_CALL terminator_DestroyInstance(VkInstance instance, const
     struct loader_icd_term *next_icd_term;
 
     // Remove this instance from the list of instances:
-    struct loader_instance *prev = NULL;
-    struct loader_instance *next = loader.instances;
-    while (next != NULL) {
-        if (next == ptr_instance) {
-            // Remove this instance from the list:
-            if (prev)
-                prev->next = next->next;
-            else
-                loader.instances = next->next;
-            break;
-        }
-        prev = next;
-        next = next->next;
-    }
+    loaderRemoveInstanceFromList(ptr_instance);
 
     while (NULL != icd_terms) {
         if (icd_terms->instance) {
@@ -6353,10 +7017,8 @@ VKAPI_ATTR void VKAPI_CALL terminator_DestroyInstance(VkInstance instance, const
     loaderDeleteLayerListAndProperties(ptr_instance, &ptr_instance->instance_layer_list);
     loader_scanned_icd_clear(ptr_instance, &ptr_instance->icd_tramp_list);
     loader_destroy_generic_list(ptr_instance, (struct loader_generic_list *)&ptr_instance->ext_list);
+    // The physical device objects are in the instance's arena
     if (NULL != ptr_instance->phys_devs_term) {
-        for (uint32_t i = 0; i < ptr_instance->phys_dev_count_term; i++) {
-            loader_instance_heap_free(ptr_instance, ptr_instance->phys_devs_term[i]);
-        }
         loader_instance_heap_free(ptr_instance, ptr_instance->phys_devs_term);
     }
     if (NULL != ptr_instance->phys_dev_groups_term) {
@@ -6365,8 +7027,8 @@ VKAPI_ATTR void VKAPI_CALL terminator_DestroyInstance(VkInstance instance, const
         }
         loader_instance_heap_free(ptr_instance, ptr_instance->phys_dev_groups_term);
     }
-    loader_free_dev_ext_table(ptr_instance);
-    loader_free_phys_dev_ext_table(ptr_instance);
+    loaderUnknownExtMapDestroy(ptr_instance, &ptr_instance->dev_ext_map);
+    loaderUnknownExtMapDestroy(ptr_instance, &ptr_instance->phys_dev_ext_map);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateDevice(VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo *pCreateInfo,
@@ -6613,12 +7275,49 @@ out:
     return res;
 }
 
+uint32_t loaderPhysDevMapSlotCount(uint32_t count) {
+    // Keep the map at most half full
+    uint32_t slot_count = 8;
+    while (slot_count < count * 2) {
+        slot_count *= 2;
+    }
+    return slot_count;
+}
+
+void loaderPhysDevMapInit(struct loader_phys_dev_map *map, struct loader_phys_dev_map_slot *slots, uint32_t slot_count) {
+    memset(slots, 0, sizeof(struct loader_phys_dev_map_slot) * slot_count);
+    map->mask = slot_count - 1;
+    map->slots = slots;
+}
+
+// Returns the slot holding handle, or the empty slot it would go in
+static struct loader_phys_dev_map_slot *loaderPhysDevMapSlot(const struct loader_phys_dev_map *map, VkPhysicalDevice handle) {
+    // Handles are pointers, so mix the high bits into the low ones the mask keeps
+    uint32_t hash = (uint32_t)(((uint64_t)(uintptr_t)handle * 0x9E3779B97F4A7C15ull) >> 32);
+    for (uint32_t slot = hash & map->mask;; slot = (slot + 1) & map->mask) {
+        if (NULL == map->slots[slot].handle || map->slots[slot].handle == handle) {
+            return &map->slots[slot];
+        }
+    }
+}
+
+void loaderPhysDevMapAdd(struct loader_phys_dev_map *map, VkPhysicalDevice handle, void *object) {
+    struct loader_phys_dev_map_slot *slot = loaderPhysDevMapSlot(map, handle);
+    slot->handle = handle;
+    slot->object = object;
+}
+
+void *loaderPhysDevMapFind(const struct loader_phys_dev_map *map, VkPhysicalDevice handle) {
+    return loaderPhysDevMapSlot(map, handle)->object;
+}
+
 VkResult setupLoaderTrampPhysDevs(VkInstance instance) {
     VkResult res = VK_SUCCESS;
     VkPhysicalDevice *local_phys_devs = NULL;
     struct loader_instance *inst;
     uint32_t total_count = 0;
     struct loader_physical_device_tramp **new_phys_devs = NULL;
+    struct loader_phys_dev_map old_map;
 
     inst = loader_get_instance(instance);
     if (NULL == inst) {
@@ -6626,19 +7325,79 @@ VkResult setupLoaderTrampPhysDevs(VkInstance instance) {
         goto out;
     }
 
-    // Query how many GPUs there
-    res = inst->disp->layer_inst_disp.EnumeratePhysicalDevices(instance, &total_count, NULL);
-    if (res != VK_SUCCESS) {
-        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                   "setupLoaderTrampPhysDevs:  Failed during dispatch call "
-                   "of \'vkEnumeratePhysicalDevices\' to lower layers or "
-                   "loader to get count.");
-        goto out;
+    // Once the devices have been enumerated, ask for them with room for as many as the terminator
+    // found last time.  That is all of them unless one was added, so the count is only asked for
+    // separately the first time or when this comes back incomplete.
+    total_count = inst->total_gpu_count > inst->phys_dev_count_tramp ? inst->total_gpu_count : inst->phys_dev_count_tramp;
+    if (NULL != inst->phys_devs_tramp && 0 != total_count) {
+        local_phys_devs = loader_stack_alloc(sizeof(VkPhysicalDevice) * total_count);
+        if (NULL == local_phys_devs) {
+            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                       "setupLoaderTrampPhysDevs:  Failed to allocate local "
+                       "physical device array of size %d",
+                       total_count);
+            res = VK_ERROR_OUT_OF_HOST_MEMORY;
+            goto out;
+        }
+        memset(local_phys_devs, 0, sizeof(VkPhysicalDevice) * total_count);
+        res = inst->disp->layer_inst_disp.EnumeratePhysicalDevices(instance, &total_count, local_phys_devs);
+        if (VK_SUCCESS != res && VK_INCOMPLETE != res) {
+            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                       "setupLoaderTrampPhysDevs:  Failed during dispatch call "
+                       "of \'vkEnumeratePhysicalDevices\' to lower layers or "
+                       "loader to get content.");
+            goto out;
+        }
     }
 
-    // Really use what the total GPU count is since Optimus and other layers may mess
-    // the count up.
-    total_count = inst->total_gpu_count;
+    if (NULL == local_phys_devs || VK_INCOMPLETE == res) {
+        // Query how many GPUs there
+        res = inst->disp->layer_inst_disp.EnumeratePhysicalDevices(instance, &total_count, NULL);
+        if (res != VK_SUCCESS) {
+            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                       "setupLoaderTrampPhysDevs:  Failed during dispatch call "
+                       "of \'vkEnumeratePhysicalDevices\' to lower layers or "
+                       "loader to get count.");
+            goto out;
+        }
+
+        // Really use what the total GPU count is since Optimus and other layers may mess
+        // the count up.
+        total_count = inst->total_gpu_count;
+
+        // Create a temporary array (on the stack) to keep track of the
+        // returned VkPhysicalDevice values.
+        local_phys_devs = loader_stack_alloc(sizeof(VkPhysicalDevice) * total_count);
+        if (NULL == local_phys_devs) {
+            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                       "setupLoaderTrampPhysDevs:  Failed to allocate local "
+                       "physical device array of size %d",
+                       total_count);
+            res = VK_ERROR_OUT_OF_HOST_MEMORY;
+            goto out;
+        }
+        memset(local_phys_devs, 0, sizeof(VkPhysicalDevice) * total_count);
+
+        res = inst->disp->layer_inst_disp.EnumeratePhysicalDevices(instance, &total_count, local_phys_devs);
+        if (VK_SUCCESS != res) {
+            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                       "setupLoaderTrampPhysDevs:  Failed during dispatch call "
+                       "of \'vkEnumeratePhysicalDevices\' to lower layers or "
+                       "loader to get content.");
+            goto out;
+        }
+    }
+
+    // Nothing changes if the same devices came back in the same order
+    if (NULL != inst->phys_devs_tramp && total_count == inst->phys_dev_count_tramp) {
+        uint32_t same = 0;
+        while (same < total_count && local_phys_devs[same] == inst->phys_devs_tramp[same]->phys_dev) {
+            same++;
+        }
+        if (same == total_count) {
+            goto out;
+        }
+    }
 
     // Create an array for the new physical devices, which will be stored
     // in the instance for the trampoline code.
@@ -6654,42 +7413,31 @@ VkResult setupLoaderTrampPhysDevs(VkInstance instance) {
     }
     memset(new_phys_devs, 0, total_count * sizeof(struct loader_physical_device_tramp *));
 
-    // Create a temporary array (on the stack) to keep track of the
-    // returned VkPhysicalDevice values.
-    local_phys_devs = loader_stack_alloc(sizeof(VkPhysicalDevice) * total_count);
-    if (NULL == local_phys_devs) {
+    uint32_t old_slot_count = loaderPhysDevMapSlotCount(inst->phys_dev_count_tramp);
+    struct loader_phys_dev_map_slot *old_slots = loader_stack_alloc(sizeof(struct loader_phys_dev_map_slot) * old_slot_count);
+    if (NULL == old_slots) {
         loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                   "setupLoaderTrampPhysDevs:  Failed to allocate local "
-                   "physical device array of size %d",
-                   total_count);
+                   "setupLoaderTrampPhysDevs:  Failed to allocate physical "
+                   "device map of size %d",
+                   old_slot_count);
         res = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto out;
     }
-    memset(local_phys_devs, 0, sizeof(VkPhysicalDevice) * total_count);
-
-    res = inst->disp->layer_inst_disp.EnumeratePhysicalDevices(instance, &total_count, local_phys_devs);
-    if (VK_SUCCESS != res) {
-        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                   "setupLoaderTrampPhysDevs:  Failed during dispatch call "
-                   "of \'vkEnumeratePhysicalDevices\' to lower layers or "
-                   "loader to get content.");
-        goto out;
+    loaderPhysDevMapInit(&old_map, old_slots, old_slot_count);
+    for (uint32_t old_idx = 0; old_idx < inst->phys_dev_count_tramp; old_idx++) {
+        loaderPhysDevMapAdd(&old_map, inst->phys_devs_tramp[old_idx]->phys_dev, inst->phys_devs_tramp[old_idx]);
     }
 
-    // Copy or create everything to fill the new array of physical devices
+    // Copy or create everything to fill the new array of physical devices.  The objects come
+    // from the instance's arena, so one that is no longer returned stays there, unused, until the
+    // instance is destroyed.
     for (uint32_t new_idx = 0; new_idx < total_count; new_idx++) {
-        // Check if this physical device is already in the old buffer
-        for (uint32_t old_idx = 0; old_idx < inst->phys_dev_count_tramp; old_idx++) {
-            if (local_phys_devs[new_idx] == inst->phys_devs_tramp[old_idx]->phys_dev) {
-                new_phys_devs[new_idx] = inst->phys_devs_tramp[old_idx];
-                break;
-            }
-        }
+        new_phys_devs[new_idx] = loaderPhysDevMapFind(&old_map, local_phys_devs[new_idx]);
 
         // If this physical device isn't in the old buffer, create it
         if (NULL == new_phys_devs[new_idx]) {
-            new_phys_devs[new_idx] = (struct loader_physical_device_tramp *)loader_instance_heap_alloc(
-                inst, sizeof(struct loader_physical_device_tramp), VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+            new_phys_devs[new_idx] = (struct loader_physical_device_tramp *)loaderInstanceArenaAlloc(
+                inst, sizeof(struct loader_physical_device_tramp));
             if (NULL == new_phys_devs[new_idx]) {
                 loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                            "setupLoaderTrampPhysDevs:  Failed to allocate "
@@ -6710,31 +7458,10 @@ VkResult setupLoaderTrampPhysDevs(VkInstance instance) {
 out:
 
     if (VK_SUCCESS != res) {
-        if (NULL != new_phys_devs) {
-            for (uint32_t i = 0; i < total_count; i++) {
-                loader_instance_heap_free(inst, new_phys_devs[i]);
-            }
-            loader_instance_heap_free(inst, new_phys_devs);
-        }
+        loader_instance_heap_free(inst, new_phys_devs);
         total_count = 0;
-    } else {
-        // Free everything that didn't carry over to the new array of
-        // physical devices
-        if (NULL != inst->phys_devs_tramp) {
-            for (uint32_t i = 0; i < inst->phys_dev_count_tramp; i++) {
-                bool found = false;
-                for (uint32_t j = 0; j < total_count; j++) {
-                    if (inst->phys_devs_tramp[i] == new_phys_devs[j]) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    loader_instance_heap_free(inst, inst->phys_devs_tramp[i]);
-                }
-            }
-            loader_instance_heap_free(inst, inst->phys_devs_tramp);
-        }
+    } else if (NULL != new_phys_devs) {
+        loader_instance_heap_free(inst, inst->phys_devs_tramp);
 
         // Swap in the new physical device list
         inst->phys_dev_count_tramp = total_count;
@@ -6744,11 +7471,74 @@ out:
     return res;
 }
 
+// Returns the ICD's extensions for the physical device, querying the ICD and recording them in
+// the instance's arena the first time.  Nothing is recorded on failure, so the next call asks
+// again.  Threads making their first call at once may each build a copy; one of them is
+// published and the others stay in the arena until the instance is destroyed.
+static VkResult loader_get_device_extension_snapshot(const struct loader_instance *inst,
+                                                     struct loader_physical_device_term *phys_dev_term,
+                                                     const struct loader_device_extension_snapshot **snapshot) {
+    struct loader_icd_term *icd_term = phys_dev_term->this_icd_term;
+    struct loader_extension_list icd_exts = {0};
+    struct loader_device_extension_snapshot *new_snapshot;
+    VkExtensionProperties *icd_props = NULL;
+    uint32_t icd_prop_count = 0;
+    VkResult res;
+
+    *snapshot = loader_platform_atomic_load_ptr((void *const *)&phys_dev_term->ext_snapshot);
+    if (NULL != *snapshot) {
+        return VK_SUCCESS;
+    }
+
+    res = icd_term->dispatch.EnumerateDeviceExtensionProperties(phys_dev_term->phys_dev, NULL, &icd_prop_count, NULL);
+    if (VK_SUCCESS != res) {
+        goto out;
+    }
+    if (0 != icd_prop_count) {
+        icd_props = loader_stack_alloc(icd_prop_count * sizeof(VkExtensionProperties));
+        if (NULL == icd_props) {
+            res = VK_ERROR_OUT_OF_HOST_MEMORY;
+            goto out;
+        }
+        res = icd_term->dispatch.EnumerateDeviceExtensionProperties(phys_dev_term->phys_dev, NULL, &icd_prop_count, icd_props);
+        if (VK_SUCCESS != res) {
+            goto out;
+        }
+    }
+    res = loader_init_device_extensions(inst, phys_dev_term, icd_prop_count, icd_props, &icd_exts);
+    if (VK_SUCCESS != res) {
+        goto out;
+    }
+
+    new_snapshot = loaderInstanceArenaAlloc(inst, sizeof(*new_snapshot) + icd_exts.count * sizeof(VkExtensionProperties));
+    if (NULL == new_snapshot) {
+        res = VK_ERROR_OUT_OF_HOST_MEMORY;
+        goto out;
+    }
+    new_snapshot->count = icd_exts.count;
+    new_snapshot->list = (VkExtensionProperties *)(new_snapshot + 1);
+    if (0 != icd_exts.count) {
+        memcpy(new_snapshot->list, icd_exts.list, icd_exts.count * sizeof(VkExtensionProperties));
+    }
+    if (loader_platform_atomic_compare_exchange_ptr((void **)&phys_dev_term->ext_snapshot, NULL, new_snapshot)) {
+        *snapshot = new_snapshot;
+    } else {
+        *snapshot = loader_platform_atomic_load_ptr((void *const *)&phys_dev_term->ext_snapshot);
+    }
+
+out:
+    if (NULL != icd_exts.list) {
+        loader_destroy_generic_list(inst, (struct loader_generic_list *)&icd_exts);
+    }
+    return res;
+}
+
 VkResult setupLoaderTermPhysDevs(struct loader_instance *inst) {
     VkResult res = VK_SUCCESS;
     struct loader_icd_term *icd_term;
     struct loader_phys_dev_per_icd *icd_phys_dev_array = NULL;
     struct loader_physical_device_term **new_phys_devs = NULL;
+    struct loader_phys_dev_map old_map;
 
     inst->total_gpu_count = 0;
 
@@ -6808,6 +7598,24 @@ VkResult setupLoaderTermPhysDevs(struct loader_instance *inst) {
         goto out;
     }
 
+    // Nothing changes if every ICD returned the same devices in the same order
+    if (NULL != inst->phys_devs_term && inst->total_gpu_count == inst->phys_dev_count_term) {
+        bool changed = false;
+        uint32_t idx = 0;
+        for (uint32_t icd_idx = 0; icd_idx < inst->total_icd_count && !changed; icd_idx++) {
+            for (uint32_t pd_idx = 0; pd_idx < icd_phys_dev_array[icd_idx].count; pd_idx++, idx++) {
+                if (icd_phys_dev_array[icd_idx].phys_devs[pd_idx] != inst->phys_devs_term[idx]->phys_dev ||
+                    icd_phys_dev_array[icd_idx].this_icd_term != inst->phys_devs_term[idx]->this_icd_term) {
+                    changed = true;
+                    break;
+                }
+            }
+        }
+        if (!changed) {
+            goto out;
+        }
+    }
+
     new_phys_devs = loader_instance_heap_alloc(inst, sizeof(struct loader_physical_device_term *) * inst->total_gpu_count,
                                                VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
     if (NULL == new_phys_devs) {
@@ -6820,24 +7628,32 @@ VkResult setupLoaderTermPhysDevs(struct loader_instance *inst) {
     }
     memset(new_phys_devs, 0, sizeof(struct loader_physical_device_term *) * inst->total_gpu_count);
 
-    // Copy or create everything to fill the new array of physical devices
+    uint32_t old_slot_count = loaderPhysDevMapSlotCount(inst->phys_dev_count_term);
+    struct loader_phys_dev_map_slot *old_slots = loader_stack_alloc(sizeof(struct loader_phys_dev_map_slot) * old_slot_count);
+    if (NULL == old_slots) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                   "setupLoaderTermPhysDevs:  Failed to allocate physical "
+                   "device map of size %d",
+                   old_slot_count);
+        res = VK_ERROR_OUT_OF_HOST_MEMORY;
+        goto out;
+    }
+    loaderPhysDevMapInit(&old_map, old_slots, old_slot_count);
+    for (uint32_t old_idx = 0; old_idx < inst->phys_dev_count_term; old_idx++) {
+        loaderPhysDevMapAdd(&old_map, inst->phys_devs_term[old_idx]->phys_dev, inst->phys_devs_term[old_idx]);
+    }
+
+    // Copy or create everything to fill the new array of physical devices.  As in the trampoline,
+    // the objects come from the instance's arena.
     uint32_t idx = 0;
     for (uint32_t icd_idx = 0; icd_idx < inst->total_icd_count; icd_idx++) {
         for (uint32_t pd_idx = 0; pd_idx < icd_phys_dev_array[icd_idx].count; pd_idx++) {
-            // Check if this physical device is already in the old buffer
-            if (NULL != inst->phys_devs_term) {
-                for (uint32_t old_idx = 0; old_idx < inst->phys_dev_count_term; old_idx++) {
-                    if (icd_phys_dev_array[icd_idx].phys_devs[pd_idx] == inst->phys_devs_term[old_idx]->phys_dev) {
-                        new_phys_devs[idx] = inst->phys_devs_term[old_idx];
-                        break;
-                    }
-                }
-            }
+            new_phys_devs[idx] = loaderPhysDevMapFind(&old_map, icd_phys_dev_array[icd_idx].phys_devs[pd_idx]);
+
             // If this physical device isn't in the old buffer, then we
             // need to create it.
             if (NULL == new_phys_devs[idx]) {
-                new_phys_devs[idx] = loader_instance_heap_alloc(inst, sizeof(struct loader_physical_device_term),
-                                                                VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+                new_phys_devs[idx] = loaderInstanceArenaAlloc(inst, sizeof(struct loader_physical_device_term));
                 if (NULL == new_phys_devs[idx]) {
                     loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                                "setupLoaderTermPhysDevs:  Failed to allocate "
@@ -6852,6 +7668,7 @@ VkResult setupLoaderTermPhysDevs(struct loader_instance *inst) {
                 new_phys_devs[idx]->this_icd_term = icd_phys_dev_array[icd_idx].this_icd_term;
                 new_phys_devs[idx]->icd_index = (uint8_t)(icd_idx);
                 new_phys_devs[idx]->phys_dev = icd_phys_dev_array[icd_idx].phys_devs[pd_idx];
+                new_phys_devs[idx]->ext_snapshot = NULL;
             }
             idx++;
         }
@@ -6860,33 +7677,11 @@ VkResult setupLoaderTermPhysDevs(struct loader_instance *inst) {
 out:
 
     if (VK_SUCCESS != res) {
-        if (NULL != new_phys_devs) {
-            // We've encountered an error, so we should free the new buffers.
-            for (uint32_t i = 0; i < inst->total_gpu_count; i++) {
-                loader_instance_heap_free(inst, new_phys_devs[i]);
-            }
-            loader_instance_heap_free(inst, new_phys_devs);
-        }
+        // We've encountered an error, so we should free the new buffer
+        loader_instance_heap_free(inst, new_phys_devs);
         inst->total_gpu_count = 0;
-    } else {
-        // Free everything that didn't carry over to the new array of
-        // physical devices.  Everything else will have been copied over
-        // to the new array.
-        if (NULL != inst->phys_devs_term) {
-            for (uint32_t cur_pd = 0; cur_pd < inst->phys_dev_count_term; cur_pd++) {
-                bool found = false;
-                for (uint32_t new_pd_idx = 0; new_pd_idx < inst->total_gpu_count; new_pd_idx++) {
-                    if (inst->phys_devs_term[cur_pd] == new_phys_devs[new_pd_idx]) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    loader_instance_heap_free(inst, inst->phys_devs_term[cur_pd]);
-                }
-            }
-            loader_instance_heap_free(inst, inst->phys_devs_term);
-        }
+    } else if (NULL != new_phys_devs) {
+        loader_instance_heap_free(inst, inst->phys_devs_term);
 
         // Swap out old and new devices list
         inst->phys_dev_count_term = inst->total_gpu_count;
@@ -6901,11 +7696,15 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_EnumeratePhysicalDevices(VkInstance in
     struct loader_instance *inst = (struct loader_instance *)instance;
     VkResult res = VK_SUCCESS;
 
-    // Always call the setup loader terminator physical devices because they may
-    // have changed at any point.
-    res = setupLoaderTermPhysDevs(inst);
-    if (VK_SUCCESS != res) {
-        goto out;
+    // The physical devices may have changed at any point, so ask the ICDs again the first time
+    // each enumeration by the application gets here.  Layers calling down again within the same
+    // enumeration get the devices found then.
+    if (NULL == inst->phys_devs_term || inst->phys_dev_term_generation != inst->phys_dev_enum_generation) {
+        res = setupLoaderTermPhysDevs(inst);
+        if (VK_SUCCESS != res) {
+            goto out;
+        }
+        inst->phys_dev_term_generation = inst->phys_dev_enum_generation;
     }
 
     uint32_t copy_count = inst->total_gpu_count;
@@ -7009,7 +7808,6 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_EnumerateDeviceExtensionProperties(VkP
 
     struct loader_layer_list implicit_layer_list = {0};
     struct loader_extension_list all_exts = {0};
-    struct loader_extension_list icd_exts = {0};
 
     // Any layer or trampoline wrapping should be removed at this point in time can just cast to the expected
     // type for VkPhysicalDevice.
@@ -7036,7 +7834,6 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_EnumerateDeviceExtensionProperties(VkP
             if (pProperties == NULL) {
                 *pPropertyCount = count;
                 loader_destroy_generic_list(inst, (struct loader_generic_list *)&local_ext_list);
-                loader_platform_thread_unlock_mutex(&loader_lock);
                 return VK_SUCCESS;
             }
 
@@ -7048,14 +7845,12 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_EnumerateDeviceExtensionProperties(VkP
 
             loader_destroy_generic_list(inst, (struct loader_generic_list *)&local_ext_list);
             if (copy_size < count) {
-                loader_platform_thread_unlock_mutex(&loader_lock);
                 return VK_INCOMPLETE;
             }
         } else {
             loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                        "vkEnumerateDeviceExtensionProperties:  pLayerName "
                        "is too long or is badly formed");
-            loader_platform_thread_unlock_mutex(&loader_lock);
             return VK_ERROR_EXTENSION_NOT_PRESENT;
         }
 
@@ -7064,70 +7859,51 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_EnumerateDeviceExtensionProperties(VkP
 
     // This case is during the call down the instance chain with pLayerName == NULL
     struct loader_icd_term *icd_term = phys_dev_term->this_icd_term;
-    uint32_t icd_ext_count = *pPropertyCount;
+    const struct loader_device_extension_snapshot *snapshot;
+    uint32_t copy_size;
     VkResult res;
 
-    // Get the available device extensions
-    res = icd_term->dispatch.EnumerateDeviceExtensionProperties(phys_dev_term->phys_dev, NULL, &icd_ext_count, pProperties);
+    // The ICD's extensions don't change, so they're only asked for once
+    res = loader_get_device_extension_snapshot(icd_term->this_instance, phys_dev_term, &snapshot);
+    if (res != VK_SUCCESS) {
+        goto out;
+    }
+    res = loader_add_to_ext_list(icd_term->this_instance, &all_exts, snapshot->count, snapshot->list);
     if (res != VK_SUCCESS) {
         goto out;
     }
 
+    // We need to determine which implicit layers are active, and then add their extensions. This can't be cached as
+    // it depends on results of environment variables (which can change).
     if (!loaderInitLayerList(icd_term->this_instance, &implicit_layer_list)) {
         res = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto out;
     }
-
     loaderAddImplicitLayers(icd_term->this_instance, &implicit_layer_list, NULL, &icd_term->this_instance->instance_layer_list);
-    // We need to determine which implicit layers are active, and then add their extensions. This can't be cached as
-    // it depends on results of environment variables (which can change).
-    if (pProperties != NULL) {
-        // Initialize dev_extension list within the physicalDevice object
-        res = loader_init_device_extensions(icd_term->this_instance, phys_dev_term, icd_ext_count, pProperties, &icd_exts);
-        if (res != VK_SUCCESS) {
-            goto out;
-        }
-
-        // We need to determine which implicit layers are active, and then add their extensions. This can't be cached as
-        // it depends on results of environment variables (which can change).
-        res = loader_add_to_ext_list(icd_term->this_instance, &all_exts, icd_exts.count, icd_exts.list);
-        if (res != VK_SUCCESS) {
-            goto out;
-        }
-
-        loaderAddImplicitLayers(icd_term->this_instance, &implicit_layer_list, NULL, &icd_term->this_instance->instance_layer_list);
-
-        for (uint32_t i = 0; i < implicit_layer_list.count; i++) {
-            for (uint32_t j = 0; j < implicit_layer_list.list[i].device_extension_list.count; j++) {
-                res = loader_add_to_ext_list(icd_term->this_instance, &all_exts, 1,
-                                             &implicit_layer_list.list[i].device_extension_list.list[j].props);
-                if (res != VK_SUCCESS) {
-                    goto out;
-                }
+    for (uint32_t i = 0; i < implicit_layer_list.count; i++) {
+        for (uint32_t j = 0; j < implicit_layer_list.list[i].device_extension_list.count; j++) {
+            res = loader_add_to_ext_list(icd_term->this_instance, &all_exts, 1,
+                                         &implicit_layer_list.list[i].device_extension_list.list[j].props);
+            if (res != VK_SUCCESS) {
+                goto out;
             }
         }
-        uint32_t capacity = *pPropertyCount;
-        VkExtensionProperties *props = pProperties;
+    }
 
-        for (uint32_t i = 0; i < all_exts.count && i < capacity; i++) {
-            props[i] = all_exts.list[i];
-        }
+    if (pProperties == NULL) {
+        *pPropertyCount = all_exts.count;
+        goto out;
+    }
 
-        // Wasn't enough space for the extensions, we did partial copy now return VK_INCOMPLETE
-        if (capacity < all_exts.count) {
-            res = VK_INCOMPLETE;
-        } else {
-            *pPropertyCount = all_exts.count;
-        }
-    } else {
-        // Just return the count; need to add in the count of implicit layer extensions
-        // don't worry about duplicates being added in the count
-        *pPropertyCount = icd_ext_count;
+    copy_size = *pPropertyCount < all_exts.count ? *pPropertyCount : all_exts.count;
+    if (0 != copy_size) {
+        memcpy(pProperties, all_exts.list, copy_size * sizeof(VkExtensionProperties));
+    }
+    *pPropertyCount = copy_size;
 
-        for (uint32_t i = 0; i < implicit_layer_list.count; i++) {
-            *pPropertyCount += implicit_layer_list.list[i].device_extension_list.count;
-        }
-        res = VK_SUCCESS;
+    // Wasn't enough space for the extensions, we did partial copy now return VK_INCOMPLETE
+    if (copy_size < all_exts.count) {
+        res = VK_INCOMPLETE;
     }
 
 out:
@@ -7138,9 +7914,6 @@ out:
     if (NULL != all_exts.list) {
         loader_destroy_generic_list(icd_term->this_instance, (struct loader_generic_list *)&all_exts);
     }
-    if (NULL != icd_exts.list) {
-        loader_destroy_generic_list(icd_term->this_instance, (struct loader_generic_list *)&icd_exts);
-    }
 
     return res;
 }
@@ -7240,6 +8013,7 @@ terminator_EnumerateInstanceExtensionProperties(const VkEnumerateInstanceExtensi
     } else {
         // Scan/discover all ICD libraries
         memset(&icd_tramp_list, 0, sizeof(icd_tramp_list));
+        icd_tramp_list.open_on_demand = true;
         res = loader_icd_scan(NULL, &icd_tramp_list);
         if (VK_SUCCESS != res) {
             goto out;
@@ -7409,20 +8183,6 @@ VkResult setupLoaderTermPhysDevGroups(struct loader_instance *inst) {
         total_count += cur_icd_group_count;
     }
 
-    // Create an array for the new physical device groups, which will be stored
-    // in the instance for the Terminator code.
-    new_phys_dev_groups = (VkPhysicalDeviceGroupProperties **)loader_instance_heap_alloc(
-        inst, total_count * sizeof(VkPhysicalDeviceGroupProperties *), VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-    if (NULL == new_phys_dev_groups) {
-        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-            "setupLoaderTermPhysDevGroups:  Failed to allocate new physical device"
-            " group array of size %d",
-            total_count);
-        res = VK_ERROR_OUT_OF_HOST_MEMORY;
-        goto out;
-    }
-    memset(new_phys_dev_groups, 0, total_count * sizeof(VkPhysicalDeviceGroupProperties *));
-
     // Create a temporary array (on the stack) to keep track of the
     // returned VkPhysicalDevice values.
     local_phys_dev_groups = loader_stack_alloc(sizeof(VkPhysicalDeviceGroupProperties) * total_count);
@@ -7494,18 +8254,30 @@ VkResult setupLoaderTermPhysDevGroups(struct loader_instance *inst) {
         cur_icd_group_count += count_this_time;
     }
 
+    uint32_t term_slot_count = loaderPhysDevMapSlotCount(inst->phys_dev_count_term);
+    struct loader_phys_dev_map_slot *term_slots = loader_stack_alloc(sizeof(struct loader_phys_dev_map_slot) * term_slot_count);
+    if (NULL == term_slots) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+            "setupLoaderTermPhysDevGroups:  Failed to allocate physical "
+            "device map of size %d",
+            term_slot_count);
+        res = VK_ERROR_OUT_OF_HOST_MEMORY;
+        goto out;
+    }
+    struct loader_phys_dev_map term_map;
+    loaderPhysDevMapInit(&term_map, term_slots, term_slot_count);
+    for (uint32_t term_gpu = 0; term_gpu < inst->phys_dev_count_term; term_gpu++) {
+        loaderPhysDevMapAdd(&term_map, inst->phys_devs_term[term_gpu]->phys_dev, inst->phys_devs_term[term_gpu]);
+    }
+
     // Replace all the physical device IDs with the proper loader values
     for (uint32_t group = 0; group < total_count; group++) {
         for (uint32_t group_gpu = 0; group_gpu < local_phys_dev_groups[group].physicalDeviceCount; group_gpu++) {
-            bool found = false;
-            for (uint32_t term_gpu = 0; term_gpu < inst->phys_dev_count_term; term_gpu++) {
-                if (local_phys_dev_groups[group].physicalDevices[group_gpu] == inst->phys_devs_term[term_gpu]->phys_dev) {
-                    local_phys_dev_groups[group].physicalDevices[group_gpu] = (VkPhysicalDevice)inst->phys_devs_term[term_gpu];
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
+            struct loader_physical_device_term *phys_dev_term =
+                loaderPhysDevMapFind(&term_map, local_phys_dev_groups[group].physicalDevices[group_gpu]);
+            if (NULL != phys_dev_term) {
+                local_phys_dev_groups[group].physicalDevices[group_gpu] = (VkPhysicalDevice)phys_dev_term;
+            } else {
                 loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                     "setupLoaderTermPhysDevGroups:  Failed to find GPU %d in group %d"
                     " returned by \'EnumeratePhysicalDeviceGroups\' in list returned"
@@ -7516,6 +8288,35 @@ VkResult setupLoaderTermPhysDevGroups(struct loader_instance *inst) {
         }
     }
 
+    // Nothing changes if the ICDs returned the same groups in the same order
+    if (NULL != inst->phys_dev_groups_term && total_count == inst->phys_dev_group_count_term) {
+        uint32_t same = 0;
+        while (same < total_count &&
+               local_phys_dev_groups[same].physicalDeviceCount == inst->phys_dev_groups_term[same]->physicalDeviceCount &&
+               local_phys_dev_groups[same].subsetAllocation == inst->phys_dev_groups_term[same]->subsetAllocation &&
+               !memcmp(local_phys_dev_groups[same].physicalDevices, inst->phys_dev_groups_term[same]->physicalDevices,
+                       sizeof(VkPhysicalDevice) * local_phys_dev_groups[same].physicalDeviceCount)) {
+            same++;
+        }
+        if (same == total_count) {
+            goto out;
+        }
+    }
+
+    // Create an array for the new physical device groups, which will be stored
+    // in the instance for the Terminator code.
+    new_phys_dev_groups = (VkPhysicalDeviceGroupProperties **)loader_instance_heap_alloc(
+        inst, total_count * sizeof(VkPhysicalDeviceGroupProperties *), VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (NULL == new_phys_dev_groups) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+            "setupLoaderTermPhysDevGroups:  Failed to allocate new physical device"
+            " group array of size %d",
+            total_count);
+        res = VK_ERROR_OUT_OF_HOST_MEMORY;
+        goto out;
+    }
+    memset(new_phys_dev_groups, 0, total_count * sizeof(VkPhysicalDeviceGroupProperties *));
+
     // Copy or create everything to fill the new array of physical device groups
     for (uint32_t new_idx = 0; new_idx < total_count; new_idx++) {
         // Check if this physical device group with the same contents is already in the old buffer
@@ -7573,7 +8374,7 @@ out:
             loader_instance_heap_free(inst, new_phys_dev_groups);
         }
         total_count = 0;
-    } else {
+    } else if (NULL != new_phys_dev_groups) {
         // Free everything that didn't carry over to the new array of
         // physical device groups
         if (NULL != inst->phys_dev_groups_term) {
@@ -7606,11 +8407,14 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_EnumeratePhysicalDeviceGroups(
     struct loader_instance *inst = (struct loader_instance *)instance;
     VkResult res = VK_SUCCESS;
 
-    // Always call the setup loader terminator physical device groups because they may
-    // have changed at any point.
-    res = setupLoaderTermPhysDevGroups(inst);
-    if (VK_SUCCESS != res) {
-        goto out;
+    // Like the physical devices, only ask the ICDs again the first time each enumeration by the
+    // application gets here.
+    if (NULL == inst->phys_dev_groups_term || inst->phys_dev_group_term_generation != inst->phys_dev_enum_generation) {
+        res = setupLoaderTermPhysDevGroups(inst);
+        if (VK_SUCCESS != res) {
+            goto out;
+        }
+        inst->phys_dev_group_term_generation = inst->phys_dev_enum_generation;
     }
 
     uint32_t copy_count = inst->phys_dev_group_count_term;
@@ -51,8 +51,18 @@
 
 #define MAX_STRING_SIZE 1024
 
+// Size of the cache lines that the hot parts of loader_instance and its dispatch table are laid
+// out for
+#define LOADER_CACHE_LINE_SIZE 64
+
+// On x86-64 and AArch64 Linux the trampolines for unknown functions are written at runtime, see
+// unknown_ext_jit.h, and there is no fixed limit on how many unknown functions can be used.
+#if defined(__linux__) && ((defined(__x86_64__) && !defined(__ILP32__)) || defined(__aarch64__))
+#define LOADER_UNKNOWN_EXT_JIT 1
+#endif
+
 // This is defined in vk_layer.h, but if there's problems we need to create the define
-// here.
+// here.  Elsewhere it is the number of built in trampolines for unknown functions.
 #ifndef MAX_NUM_UNKNOWN_EXTS
 #define MAX_NUM_UNKNOWN_EXTS 250
 #endif
@@ -107,15 +117,17 @@ struct loader_device_extension_list {
     struct loader_dev_ext_props *list;
 };
 
+// The strings in these and in loader_layer_properties come from loaderStringTableIntern, and are
+// NULL when the manifest didn't set them.  They live as long as the record's 'strings' generation.
 struct loader_name_value {
-    char name[MAX_STRING_SIZE];
-    char value[MAX_STRING_SIZE];
+    const char *name;
+    const char *value;
 };
 
 struct loader_layer_functions {
-    char str_gipa[MAX_STRING_SIZE];
-    char str_gdpa[MAX_STRING_SIZE];
-    char str_negotiate_interface[MAX_STRING_SIZE];
+    const char *str_gipa;
+    const char *str_gdpa;
+    const char *str_negotiate_interface;
     PFN_vkNegotiateLoaderLayerInterfaceVersion negotiate_layer_interface;
     PFN_vkGetInstanceProcAddr get_instance_proc_addr;
     PFN_vkGetDeviceProcAddr get_device_proc_addr;
@@ -134,7 +146,7 @@ struct loader_layer_properties {
     VkLayerProperties info;
     enum layer_type_flags type_flags;
     uint32_t interface_version;  // PFN_vkNegotiateLoaderLayerInterfaceVersion
-    char lib_name[MAX_STRING_SIZE];
+    const char *lib_name;
     loader_platform_dl_handle lib_handle;
     struct loader_layer_functions functions;
     struct loader_extension_list instance_extension_list;
@@ -142,20 +154,21 @@ struct loader_layer_properties {
     struct loader_name_value disable_env_var;
     struct loader_name_value enable_env_var;
     uint32_t num_component_layers;
-    char (*component_layer_names)[MAX_STRING_SIZE];
+    const char **component_layer_names;
     struct {
-        char enumerate_instance_extension_properties[MAX_STRING_SIZE];
-        char enumerate_instance_layer_properties[MAX_STRING_SIZE];
-        char enumerate_instance_version[MAX_STRING_SIZE];
+        const char *enumerate_instance_extension_properties;
+        const char *enumerate_instance_layer_properties;
+        const char *enumerate_instance_version;
     } pre_instance_functions;
     uint32_t num_override_paths;
-    char (*override_paths)[MAX_STRING_SIZE];
+    const char **override_paths;
     bool is_override;
     bool has_expiration;
     struct loader_override_expiration expiration;
     bool keep;
     uint32_t num_blacklist_layers;
-    char (*blacklist_layer_names)[MAX_STRING_SIZE];
+    const char **blacklist_layer_names;
+    struct loader_string_generation *strings;
 };
 
 struct loader_layer_list {
@@ -164,19 +177,62 @@ struct loader_layer_list {
     struct loader_layer_properties *list;
 };
 
-struct loader_dispatch_hash_list {
-    size_t capacity;
+// List of manifest file names found while searching for ICDs or layers
+struct loader_data_files {
     uint32_t count;
-    uint32_t *index;  // index into the dev_ext dispatch table
+    uint32_t alloc_count;
+    char **filename_list;
 };
 
-// loader_dispatch_hash_entry and loader_dev_ext_dispatch_table.dev_ext have
-// one to one correspondence; one loader_dispatch_hash_entry for one dev_ext
-// dispatch entry.
-// Also have a one to one correspondence with functions in dev_ext_trampoline.c
-struct loader_dispatch_hash_entry {
+// Entry in a loader_unknown_ext_map.  Entries never change once they are published.
+struct loader_unknown_ext_entry {
+    uint32_t hash;
+    // Index into the unknown extension dispatch arrays, and of the trampoline handed out for this
+    // function.  Indices are allocated in order, independently of where the name hashes to.
+    uint32_t index;
     char *func_name;
-    struct loader_dispatch_hash_list list;  // to handle hashing collisions
+};
+
+// Open addressed table of entry pointers; see unknown_ext_map.h
+struct loader_unknown_ext_table {
+    uint32_t capacity;
+    struct loader_unknown_ext_entry **slots;
+};
+
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+// Array indexed like a loader_unknown_ext_map, for the names and dispatch entries of unknown
+// functions.  It grows by being copied into a bigger one; the trampolines read it without a lock,
+// so the copy it replaced is kept in 'retired' until the array itself is freed.  See
+// unknown_ext_map.h.
+struct loader_unknown_ext_array {
+    struct loader_unknown_ext_array *retired;
+    uint32_t capacity;
+    void *entries[];
+};
+#endif
+
+// Maps the name of an unknown device or physical device function to its dispatch index
+struct loader_unknown_ext_map {
+    struct loader_unknown_ext_table *table;
+    uint32_t count;
+    loader_platform_thread_mutex lock;
+    // Name of the function at each allocated index.  The physical device terminators, including
+    // the assembly ones, read this to report functions an ICD doesn't support.
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+    struct loader_unknown_ext_array *func_names;
+#else
+    const char *func_names[MAX_NUM_UNKNOWN_EXTS];
+#endif
+};
+
+// Bump allocator for objects that live as long as their instance; see instance_arena.h
+struct loader_instance_arena_block;
+
+struct loader_instance_arena {
+    struct loader_instance_arena_block *blocks;
+    char *next;
+    char *end;
+    loader_platform_thread_mutex lock;
 };
 
 typedef VkResult(VKAPI_PTR *PFN_vkDevExt)(VkDevice device);
@@ -186,11 +242,74 @@ struct loader_dev_ext_dispatch_table {
 
 struct loader_dev_dispatch_table {
     VkLayerDispatchTable core_dispatch;
-    struct loader_dev_ext_dispatch_table ext_dispatch;
+    // Entry points of unknown device functions.  Most devices never use one, so this is only
+    // allocated when the first one is set up for the device, and until then is a shared table
+    // sending every function to vkDevExtError.  It is never NULL.
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+    struct loader_unknown_ext_array *ext_dispatch;
+#else
+    struct loader_dev_ext_dispatch_table *ext_dispatch;
+#endif
+};
+
+// Recycled loader_device records for devices created without their own allocator
+struct loader_device_pool {
+    loader_platform_thread_mutex lock;
+    struct loader_device *free_list;
+};
+
+// Number of resolved device dispatch tables each instance keeps for reuse
+#define LOADER_DEVICE_DISPATCH_CACHE_SIZE 4
+
+// A device dispatch table resolved through a device chain, and what it was resolved for
+struct loader_device_dispatch_cache_entry {
+    // The physical device passed down the chain: the top layer's handle, or the loader's
+    // terminator one when there are no layers
+    VkPhysicalDevice physical_device;
+    // Names of the layers in the chain, from the application side down
+    uint32_t layer_count;
+    char **layer_names;
+    uint32_t extension_count;
+    char **extension_names;
+    // From pEnabledFeatures or a chained VkPhysicalDeviceFeatures2
+    bool has_features;
+    VkPhysicalDeviceFeatures features;
+    VkLayerDispatchTable core_dispatch;
+};
+
+// Dispatch tables of earlier devices, so creating another device the same way copies a table
+// instead of looking up every entry point again.  Vulkan doesn't promise that layers and drivers
+// hand out the same functions for every device, so this is only used when the user opts in.
+struct loader_device_dispatch_cache {
+    loader_platform_thread_mutex lock;
+    // Set by VK_LOADER_DEVICE_DISPATCH_CACHE
+    bool enabled;
+    uint32_t next_replace;
+    struct loader_device_dispatch_cache_entry *entries[LOADER_DEVICE_DISPATCH_CACHE_SIZE];
+};
+
+// Entry in a loader_handle_index, embedded in the object it refers to
+struct loader_handle_index_node {
+    const void *key;
+    void *object;
+    struct loader_handle_index_node *next;
+};
+
+#define LOADER_HANDLE_INDEX_INITIAL_BUCKETS 64
+
+// Hash index from the dispatch table pointer at the start of a dispatchable handle to the loader
+// object that owns it.  See handle_index.h.
+struct loader_handle_index {
+    struct loader_handle_index_node **buckets;
+    uint32_t bucket_count;
+    uint32_t count;
+    struct loader_handle_index_node *initial_buckets[LOADER_HANDLE_INDEX_INITIAL_BUCKETS];
 };
 
 // per CreateDevice structure
 struct loader_device {
+    // Kept first so that the core dispatch table starts the record.  Everything from chain_device
+    // on is cleared when the record is handed out.
     struct loader_dev_dispatch_table loader_dispatch;
     VkDevice chain_device;  // device object from the dispatch chain
     VkDevice icd_device;    // device object from the icd
@@ -205,6 +324,8 @@ struct loader_device {
     struct loader_layer_list expanded_activated_layer_list;
 
     VkAllocationCallbacks alloc_callbacks;
+    // Set when the record belongs to the instance's device pool rather than the application
+    bool pooled;
 
     // List of activated device extensions that have terminators implemented in the loader
     struct {
@@ -216,6 +337,11 @@ struct loader_device {
         bool ext_full_screen_exclusive_enabled;
     } extensions;
 
+    // Owning ICD and its position in the instance's ICD list, for handle lookups
+    struct loader_icd_term *icd_term;
+    uint32_t icd_index;
+    struct loader_handle_index_node index_node;
+
     struct loader_device *next;
 };
 
@@ -232,7 +358,11 @@ struct loader_icd_term {
 
     struct loader_icd_term *next;
 
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+    struct loader_unknown_ext_array *phys_dev_ext;
+#else
     PFN_PhysDevExt phys_dev_ext[MAX_NUM_UNKNOWN_EXTS];
+#endif
 };
 
 // Per ICD library structure
@@ -240,16 +370,53 @@ struct loader_icd_tramp_list {
     size_t capacity;
     uint32_t count;
     struct loader_scanned_icd *scanned_list;
+    // Set by callers that only need the ICDs' instance extensions.  Libraries whose extensions are
+    // in the ICD extension cache are then added with a NULL handle instead of being opened.
+    bool open_on_demand;
 };
 
+// Allocated on a cache line boundary from the instance's arena, so the layer dispatch table that
+// every instance call reads starts a cache line and only shares lines with itself.
 struct loader_instance_dispatch_table {
     VkLayerInstanceDispatchTable layer_inst_disp;  // must be first entry in structure
 
-    // Physical device functions unknown to the loader
+    // Physical device functions unknown to the loader.  The built in unknown function trampolines
+    // index this at a fixed offset, so it stays inline after the layer dispatch table.
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+    struct loader_unknown_ext_array *phys_dev_ext;
+#else
     PFN_PhysDevExt phys_dev_ext[MAX_NUM_UNKNOWN_EXTS];
+#endif
+};
+
+// Number of VkDebugUtilsMessageSeverityFlagBitsEXT values, from VERBOSE to ERROR
+#define LOADER_DEBUG_SEVERITY_COUNT 4
+
+// Index over an instance's debug callbacks, rebuilt by debug_utils.c whenever a messenger or
+// report callback is added or removed.  For each message severity it lists, in DbgFunctionHead
+// order, the callbacks that may want a message of that severity, along with the union of the
+// message types they want.  A message then only visits those callbacks, and one nobody wants is
+// dropped without visiting any.
+//
+// Messages are sent holding the instance's dbg_lock for reading, and callbacks are only added or
+// removed holding it for writing, so a replaced index or a removed callback is freed right away.
+struct loader_debug_callback_index {
+    VkDebugUtilsMessageTypeFlagsEXT wanted_types[LOADER_DEBUG_SEVERITY_COUNT];
+    uint32_t counts[LOADER_DEBUG_SEVERITY_COUNT];
+    VkLayerDbgFunctionNode **nodes[LOADER_DEBUG_SEVERITY_COUNT];
+    // Union of the report callbacks' flags, for messages sent with vkDebugReportMessageEXT
+    VkDebugReportFlagsEXT report_flags;
+    // Set if the index couldn't be allocated.  Every message then walks all of DbgFunctionHead.
+    bool walk_list;
 };
 
 // Per instance structure
+//
+// The fields up to the comment below are the ones the instance's trampolines and terminators read
+// on every call: the dispatch table, the ICDs, which extensions and WSI platforms are enabled, and
+// the allocator and debug callbacks.  They are kept together so they share the first few cache
+// lines of the structure.  Discovery and bookkeeping state comes after them, with the large
+// unknown function maps last.
 struct loader_instance {
     struct loader_instance_dispatch_table *disp;  // must be first entry in structure
 
@@ -257,6 +424,63 @@ struct loader_instance {
     uint16_t app_api_major_version;
     uint16_t app_api_minor_version;
 
+    uint32_t total_icd_count;
+    struct loader_icd_term *icd_terms;
+
+    VkInstance instance;  // layers/ICD instance returned to trampoline
+
+    union loader_instance_extension_enables enabled_known_extensions;
+
+    // Guarded by dbg_lock.  dbg_index is NULL until a callback is added.
+    VkLayerDbgFunctionNode *DbgFunctionHead;
+    struct loader_debug_callback_index *dbg_index;
+    // Copies of dbg_index's wanted_types and report_flags, read with loader_platform_atomic_load_u32
+    // so messages nobody wants are dropped without taking dbg_lock
+    volatile uint32_t dbg_wanted_types[LOADER_DEBUG_SEVERITY_COUNT];
+    volatile uint32_t dbg_report_flags;
+    loader_platform_thread_rwlock dbg_lock;
+    VkAllocationCallbacks alloc_callbacks;
+
+    bool wsi_surface_enabled;
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    bool wsi_win32_surface_enabled;
+#endif
+#ifdef VK_USE_PLATFORM_WAYLAND_KHR
+    bool wsi_wayland_surface_enabled;
+#endif
+#ifdef VK_USE_PLATFORM_XCB_KHR
+    bool wsi_xcb_surface_enabled;
+#endif
+#ifdef VK_USE_PLATFORM_XLIB_KHR
+    bool wsi_xlib_surface_enabled;
+#endif
+#ifdef VK_USE_PLATFORM_ANDROID_KHR
+    bool wsi_android_surface_enabled;
+#endif
+#ifdef VK_USE_PLATFORM_MACOS_MVK
+    bool wsi_macos_surface_enabled;
+#endif
+#ifdef VK_USE_PLATFORM_IOS_MVK
+    bool wsi_ios_surface_enabled;
+#endif
+    bool wsi_headless_surface_enabled;
+#if defined(VK_USE_PLATFORM_METAL_EXT)
+    bool wsi_metal_surface_enabled;
+#endif
+    bool wsi_display_enabled;
+    bool wsi_display_props2_enabled;
+    // Set by VK_LOADER_SURFACE_QUERY_CACHE, see wsi.c
+    bool wsi_surface_query_cache_enabled;
+
+    // Everything from here on is only used while enumerating, creating and destroying objects
+
+    // Serializes the entry points that change this instance's state: physical device enumeration,
+    // device creation and destruction, and debug callback changes.
+    loader_platform_thread_mutex lock;
+
+    struct loader_instance *next;
+    struct loader_handle_index_node index_node;
+
     // We need to manually track physical devices over time.  If the user
     // re-queries the information, we don't want to delete old data or
     // create new data unless necessary.
@@ -274,15 +498,15 @@ struct loader_instance {
     uint32_t phys_dev_group_count_tramp;
     struct VkPhysicalDeviceGroupProperties **phys_dev_groups_tramp;
 
-    struct loader_instance *next;
+    // Bumped by the trampolines each time the application enumerates physical devices or groups.
+    // The terminators only ask the ICDs again when it has changed since they last did, so the
+    // repeated calls one enumeration makes down the chain are answered from the arrays above.
+    uint32_t phys_dev_enum_generation;
+    uint32_t phys_dev_term_generation;
+    uint32_t phys_dev_group_term_generation;
 
-    uint32_t total_icd_count;
-    struct loader_icd_term *icd_terms;
     struct loader_icd_tramp_list icd_tramp_list;
 
-    struct loader_dispatch_hash_entry dev_ext_disp_hash[MAX_NUM_UNKNOWN_EXTS];
-    struct loader_dispatch_hash_entry phys_dev_ext_disp_hash[MAX_NUM_UNKNOWN_EXTS];
-
     struct loader_msg_callback_map_entry *icd_msg_callback_map;
 
     struct loader_layer_list instance_layer_list;
@@ -296,12 +520,8 @@ struct loader_instance {
     struct loader_layer_list app_activated_layer_list;
     struct loader_layer_list expanded_activated_layer_list;
 
-    VkInstance instance;  // layers/ICD instance returned to trampoline
-
     struct loader_extension_list ext_list;  // icds and loaders extensions
-    union loader_instance_extension_enables enabled_known_extensions;
 
-    VkLayerDbgFunctionNode *DbgFunctionHead;
     uint32_t num_tmp_report_callbacks;
     VkDebugReportCallbackCreateInfoEXT *tmp_report_create_infos;
     VkDebugReportCallbackEXT *tmp_report_callbacks;
@@ -309,36 +529,14 @@ struct loader_instance {
     VkDebugUtilsMessengerCreateInfoEXT *tmp_messenger_create_infos;
     VkDebugUtilsMessengerEXT *tmp_messengers;
 
-    VkAllocationCallbacks alloc_callbacks;
+    // ICD terminators, physical device objects, unknown function names, pooled device records and
+    // the dispatch table
+    struct loader_instance_arena arena;
+    struct loader_device_pool device_pool;
+    struct loader_device_dispatch_cache device_dispatch_cache;
 
-    bool wsi_surface_enabled;
-#ifdef VK_USE_PLATFORM_WIN32_KHR
-    bool wsi_win32_surface_enabled;
-#endif
-#ifdef VK_USE_PLATFORM_WAYLAND_KHR
-    bool wsi_wayland_surface_enabled;
-#endif
-#ifdef VK_USE_PLATFORM_XCB_KHR
-    bool wsi_xcb_surface_enabled;
-#endif
-#ifdef VK_USE_PLATFORM_XLIB_KHR
-    bool wsi_xlib_surface_enabled;
-#endif
-#ifdef VK_USE_PLATFORM_ANDROID_KHR
-    bool wsi_android_surface_enabled;
-#endif
-#ifdef VK_USE_PLATFORM_MACOS_MVK
-    bool wsi_macos_surface_enabled;
-#endif
-#ifdef VK_USE_PLATFORM_IOS_MVK
-    bool wsi_ios_surface_enabled;
-#endif
-    bool wsi_headless_surface_enabled;
-#if defined(VK_USE_PLATFORM_METAL_EXT)
-    bool wsi_metal_surface_enabled;
-#endif
-    bool wsi_display_enabled;
-    bool wsi_display_props2_enabled;
+    struct loader_unknown_ext_map dev_ext_map;
+    struct loader_unknown_ext_map phys_dev_ext_map;
 };
 
 // VkPhysicalDevice requires special treatment by loader.  Firstly, terminator
@@ -361,16 +559,32 @@ struct loader_physical_device_tramp {
     VkPhysicalDevice phys_dev;  // object from layers/loader terminator
 };
 
+// The device extensions an ICD reports for a physical device, recorded by the terminator of
+// vkEnumerateDeviceExtensionProperties the first time it's called.  Never changed afterwards, so
+// it's read without taking a lock.  The implicit layers' extensions aren't part of it, since which
+// implicit layers are active depends on the environment.
+struct loader_device_extension_snapshot {
+    uint32_t count;
+    VkExtensionProperties *list;
+};
+
 // Per enumerated PhysicalDevice structure, used to wrap in terminator code
 struct loader_physical_device_term {
     struct loader_instance_dispatch_table *disp;  // must be first entry in structure
     struct loader_icd_term *this_icd_term;
     uint8_t icd_index;
     VkPhysicalDevice phys_dev;  // object from ICD
+    // NULL until vkEnumerateDeviceExtensionProperties first succeeds, published atomically
+    const struct loader_device_extension_snapshot *ext_snapshot;
 };
 
 struct loader_struct {
     struct loader_instance *instances;
+
+    // Lookups by dispatch table pointer, keyed on &instance->disp->layer_inst_disp and
+    // &device->loader_dispatch
+    struct loader_handle_index instance_index;
+    struct loader_handle_index device_index;
 };
 
 struct loader_scanned_icd {
@@ -420,7 +634,9 @@ static inline void loader_init_dispatch(void *obj, const void *data) {
 // Global variables used across files
 extern struct loader_struct loader;
 extern THREAD_LOCAL_DECL struct loader_instance *tls_instance;
-extern loader_platform_thread_mutex loader_lock;
+// Protects loader.instances, the handle indexes, and the logical device lists of each ICD.  Writers
+// only hold it long enough to link or unlink an entry.
+extern loader_platform_thread_rwlock loader_instance_list_lock;
 extern loader_platform_thread_mutex loader_json_lock;
 
 struct loader_msg_callback_map_entry {
@@ -467,6 +683,11 @@ VkResult loader_add_device_extensions(const struct loader_instance *inst,
 VkResult loader_init_generic_list(const struct loader_instance *inst, struct loader_generic_list *list_info, size_t element_size);
 void loader_destroy_generic_list(const struct loader_instance *inst, struct loader_generic_list *list);
 void loaderDestroyLayerList(const struct loader_instance *inst, struct loader_device *device, struct loader_layer_list *layer_list);
+struct loader_layer_properties *loaderGetNextLayerPropertySlot(const struct loader_instance *inst,
+                                                               struct loader_layer_list *layer_list);
+void loaderFreeLayerProperties(const struct loader_instance *inst, struct loader_layer_properties *layer_properties);
+VkResult loaderCopyLayerProperties(const struct loader_instance *inst, struct loader_layer_properties *dst,
+                                   const struct loader_layer_properties *src);
 void loaderDeleteLayerListAndProperties(const struct loader_instance *inst, struct loader_layer_list *layer_list);
 void loaderAddLayerNameToList(const struct loader_instance *inst, const char *name, const enum layer_type_flags type_flags,
                               const struct loader_layer_list *source_list, struct loader_layer_list *target_list,
@@ -487,7 +708,13 @@ bool loader_phys_dev_ext_gpa(struct loader_instance *inst, const char *funcName,
 void *loader_get_phys_dev_ext_tramp(uint32_t index);
 void *loader_get_phys_dev_ext_termin(uint32_t index);
 struct loader_instance *loader_get_instance(const VkInstance instance);
+void loaderAddInstanceToList(struct loader_instance *inst);
+void loaderRemoveInstanceFromList(struct loader_instance *inst);
 void loaderDeactivateLayers(const struct loader_instance *instance, struct loader_device *device, struct loader_layer_list *list);
+void loaderDevicePoolInit(struct loader_device_pool *pool);
+void loaderDevicePoolDestroy(struct loader_device_pool *pool);
+void loaderDeviceDispatchCacheInit(struct loader_device_dispatch_cache *cache);
+void loaderDeviceDispatchCacheDestroy(const struct loader_instance *inst, struct loader_device_dispatch_cache *cache);
 struct loader_device *loader_create_logical_device(const struct loader_instance *inst, const VkAllocationCallbacks *pAllocator);
 void loader_add_logical_device(const struct loader_instance *inst, struct loader_icd_term *icd_term,
                                struct loader_device *found_dev);
@@ -522,6 +749,24 @@ VkResult loader_validate_device_extensions(struct loader_instance *this_instance
                                            const struct loader_layer_list *activated_device_layers,
                                            const struct loader_extension_list *icd_exts, const VkDeviceCreateInfo *pCreateInfo);
 
+// Small open-addressing map from the VkPhysicalDevice handles returned by the layers or ICDs to
+// the loader objects wrapping them, used to carry the objects over from one enumeration to the
+// next.  The caller provides loaderPhysDevMapSlotCount() slots, usually with loader_stack_alloc.
+struct loader_phys_dev_map_slot {
+    VkPhysicalDevice handle;
+    void *object;
+};
+
+struct loader_phys_dev_map {
+    uint32_t mask;
+    struct loader_phys_dev_map_slot *slots;
+};
+
+uint32_t loaderPhysDevMapSlotCount(uint32_t count);
+void loaderPhysDevMapInit(struct loader_phys_dev_map *map, struct loader_phys_dev_map_slot *slots, uint32_t slot_count);
+void loaderPhysDevMapAdd(struct loader_phys_dev_map *map, VkPhysicalDevice handle, void *object);
+void *loaderPhysDevMapFind(const struct loader_phys_dev_map *map, VkPhysicalDevice handle);
+
 VkResult setupLoaderTrampPhysDevs(VkInstance instance);
 VkResult setupLoaderTermPhysDevs(struct loader_instance *inst);
 
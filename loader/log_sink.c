@@ -0,0 +1,281 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vk_loader_platform.h"
+#include "log_sink.h"
+
+// Must be a power of two
+#define LOADER_LOG_SINK_SLOT_COUNT 4096
+#define LOADER_LOG_SINK_TEXT_SIZE 232
+
+// One slot holds a line, or part of a line too long for one slot.  The parts of a line are always
+// in consecutive slots.
+struct loader_log_sink_slot {
+    // Set to the slot's position + 1 once the part for that position has been written
+    volatile uint32_t sequence;
+    // Set on every part of a line except the last
+    uint32_t continued;
+    uint64_t timestamp_ns;
+    uint64_t thread_id;
+    char text[LOADER_LOG_SINK_TEXT_SIZE + 1];
+};
+
+static struct loader_log_sink {
+    bool enabled;
+    struct loader_log_sink_slot *slots;
+    uint64_t start_ns;
+
+    // Positions only ever increase and wrap around.  write_pos is the next position to claim and
+    // read_pos the first one not written out yet, so the buffer is full when they are
+    // LOADER_LOG_SINK_SLOT_COUNT apart.
+    volatile uint32_t write_pos;
+    volatile uint32_t read_pos;
+    volatile uint32_t dropped;
+    // Only used by whoever is draining
+    bool mid_line;
+
+    volatile uint32_t drain_sleeping;
+    volatile uint32_t drain_stop;
+    loader_platform_thread_mutex wake_lock;
+    loader_platform_thread_cond wake;
+
+    // Drain thread lifetime, protected by lifetime_lock
+    loader_platform_thread_mutex lifetime_lock;
+    uint32_t users;
+    bool drain_running;
+    loader_platform_thread drain_thread;
+} sink;
+
+static void loaderLogSinkOutput(const char *text) {
+#if defined(WIN32)
+    OutputDebugString(text);
+#endif
+    fputs(text, stderr);
+}
+
+// Writes out every part that has been completely written.  Only one thread may drain at a time:
+// the drain thread while it runs, otherwise the holder of lifetime_lock.
+static void loaderLogSinkDrain(void) {
+    char header[64];
+    bool wrote = false;
+
+    // Lines are dropped whole, so report them between lines
+    uint32_t dropped = loader_platform_atomic_load_u32(&sink.dropped);
+    if (0 != dropped && !sink.mid_line) {
+        loader_platform_atomic_fetch_add_u32(&sink.dropped, 0u - dropped);
+        snprintf(header, sizeof(header), "[loader log sink dropped %u lines]\n", dropped);
+        loaderLogSinkOutput(header);
+        wrote = true;
+    }
+
+    uint32_t pos = sink.read_pos;
+    for (;;) {
+        struct loader_log_sink_slot *slot = &sink.slots[pos & (LOADER_LOG_SINK_SLOT_COUNT - 1)];
+        if (loader_platform_atomic_load_u32(&slot->sequence) != pos + 1) {
+            break;
+        }
+
+        if (!sink.mid_line) {
+            snprintf(header, sizeof(header), "[%11.6f %8llx] ", (double)(slot->timestamp_ns - sink.start_ns) / 1e9,
+                     (unsigned long long)slot->thread_id);
+            loaderLogSinkOutput(header);
+        }
+        loaderLogSinkOutput(slot->text);
+        if (!slot->continued) {
+            loaderLogSinkOutput("\n");
+        }
+        sink.mid_line = 0 != slot->continued;
+
+        // Hand the slot back to the producers
+        pos++;
+        loader_platform_atomic_store_u32(&sink.read_pos, pos);
+        wrote = true;
+    }
+
+    if (wrote) {
+        fflush(stderr);
+    }
+}
+
+static bool loaderLogSinkPending(void) {
+    uint32_t pos = sink.read_pos;
+    return loader_platform_atomic_load_u32(&sink.slots[pos & (LOADER_LOG_SINK_SLOT_COUNT - 1)].sequence) == pos + 1 ||
+           0 != loader_platform_atomic_load_u32(&sink.dropped);
+}
+
+static void loaderLogSinkWakeDrain(void) {
+    // The drain thread sets drain_sleeping before its last look at the buffer and waits with
+    // wake_lock held, so taking the lock here means the wake-up can't be missed.
+    if (0 != loader_platform_atomic_load_u32(&sink.drain_sleeping)) {
+        loader_platform_thread_lock_mutex(&sink.wake_lock);
+        loader_platform_thread_cond_broadcast(&sink.wake);
+        loader_platform_thread_unlock_mutex(&sink.wake_lock);
+    }
+}
+
+static LOADER_PLATFORM_THREAD_PROC(loaderLogSinkDrainThread, arg) {
+    (void)arg;
+    for (;;) {
+        loaderLogSinkDrain();
+
+        loader_platform_thread_lock_mutex(&sink.wake_lock);
+        loader_platform_atomic_store_u32(&sink.drain_sleeping, 1);
+        if (0 == loader_platform_atomic_load_u32(&sink.drain_stop) && !loaderLogSinkPending()) {
+            loader_platform_thread_cond_wait(&sink.wake, &sink.wake_lock);
+        }
+        loader_platform_atomic_store_u32(&sink.drain_sleeping, 0);
+        bool stop = 0 != loader_platform_atomic_load_u32(&sink.drain_stop);
+        loader_platform_thread_unlock_mutex(&sink.wake_lock);
+
+        if (stop) {
+            break;
+        }
+    }
+    return 0;
+}
+
+// Must be called with lifetime_lock held
+static void loaderLogSinkStopDrainThread(void) {
+    loader_platform_thread_lock_mutex(&sink.wake_lock);
+    loader_platform_atomic_store_u32(&sink.drain_stop, 1);
+    loader_platform_thread_cond_broadcast(&sink.wake);
+    loader_platform_thread_unlock_mutex(&sink.wake_lock);
+
+    loader_platform_thread_join(sink.drain_thread);
+    sink.drain_running = false;
+}
+
+void loaderLogSinkInit(const char *sink_name) {
+    if (NULL == sink_name || 0 != strcmp(sink_name, "async")) {
+        return;
+    }
+
+    // The sink lives as long as the loader, so it doesn't use instance allocation callbacks.  If
+    // the buffer can't be allocated the loader keeps writing to stderr directly.
+    sink.slots = calloc(LOADER_LOG_SINK_SLOT_COUNT, sizeof(struct loader_log_sink_slot));
+    if (NULL == sink.slots) {
+        return;
+    }
+    loader_platform_thread_create_mutex(&sink.wake_lock);
+    loader_platform_thread_init_cond(&sink.wake);
+    loader_platform_thread_create_mutex(&sink.lifetime_lock);
+    sink.start_ns = loader_platform_time_ns();
+    sink.enabled = true;
+}
+
+void loaderLogSinkShutdown(void) {
+    if (!sink.enabled) {
+        return;
+    }
+
+    loader_platform_thread_lock_mutex(&sink.lifetime_lock);
+    if (sink.drain_running) {
+#if defined(_WIN32)
+        // Instances were leaked and this is DllMain, where waiting for a thread to exit deadlocks on
+        // the OS loader lock.  Leave the thread and its buffer alone.
+        loader_platform_thread_unlock_mutex(&sink.lifetime_lock);
+        return;
+#else
+        loaderLogSinkStopDrainThread();
+#endif
+    }
+    loaderLogSinkDrain();
+    sink.enabled = false;
+    loader_platform_thread_unlock_mutex(&sink.lifetime_lock);
+
+    loader_platform_thread_delete_mutex(&sink.lifetime_lock);
+    loader_platform_thread_delete_mutex(&sink.wake_lock);
+    free(sink.slots);
+    memset(&sink, 0, sizeof(sink));
+}
+
+bool loaderLogSinkEnabled(void) { return sink.enabled; }
+
+void loaderLogSinkWrite(const char *line, size_t length) {
+    uint32_t parts = 0 == length ? 1 : (uint32_t)((length + LOADER_LOG_SINK_TEXT_SIZE - 1) / LOADER_LOG_SINK_TEXT_SIZE);
+    uint32_t pos;
+
+    // A line that would take up most of the buffer is cut short rather than always dropped
+    if (parts > LOADER_LOG_SINK_SLOT_COUNT / 4) {
+        parts = LOADER_LOG_SINK_SLOT_COUNT / 4;
+        length = (size_t)parts * LOADER_LOG_SINK_TEXT_SIZE;
+    }
+
+    do {
+        pos = loader_platform_atomic_load_u32(&sink.write_pos);
+        if (pos + parts - loader_platform_atomic_load_u32(&sink.read_pos) > LOADER_LOG_SINK_SLOT_COUNT) {
+            loader_platform_atomic_fetch_add_u32(&sink.dropped, 1);
+            loaderLogSinkWakeDrain();
+            return;
+        }
+    } while (!loader_platform_atomic_compare_exchange_u32(&sink.write_pos, pos, pos + parts));
+
+    uint64_t timestamp_ns = loader_platform_time_ns();
+    uint64_t thread_id = (uint64_t)(uintptr_t)loader_platform_get_thread_id();
+    for (uint32_t part = 0; part < parts; part++) {
+        struct loader_log_sink_slot *slot = &sink.slots[(pos + part) & (LOADER_LOG_SINK_SLOT_COUNT - 1)];
+        size_t part_length = length < LOADER_LOG_SINK_TEXT_SIZE ? length : LOADER_LOG_SINK_TEXT_SIZE;
+
+        memcpy(slot->text, line, part_length);
+        slot->text[part_length] = '\0';
+        slot->continued = part + 1 < parts;
+        slot->timestamp_ns = timestamp_ns;
+        slot->thread_id = thread_id;
+        loader_platform_atomic_store_u32(&slot->sequence, pos + part + 1);
+
+        line += part_length;
+        length -= part_length;
+    }
+
+    loaderLogSinkWakeDrain();
+}
+
+void loaderLogSinkAcquire(void) {
+    if (!sink.enabled) {
+        return;
+    }
+
+    loader_platform_thread_lock_mutex(&sink.lifetime_lock);
+    if (0 == sink.users++) {
+        // If the thread can't be started, lines are kept until the last instance is destroyed
+        loader_platform_atomic_store_u32(&sink.drain_stop, 0);
+        sink.drain_running = loader_platform_thread_create(&sink.drain_thread, loaderLogSinkDrainThread, NULL);
+    }
+    loader_platform_thread_unlock_mutex(&sink.lifetime_lock);
+}
+
+void loaderLogSinkRelease(void) {
+    if (!sink.enabled) {
+        return;
+    }
+
+    loader_platform_thread_lock_mutex(&sink.lifetime_lock);
+    if (0 == --sink.users) {
+        if (sink.drain_running) {
+            loaderLogSinkStopDrainThread();
+        }
+        loaderLogSinkDrain();
+    }
+    loader_platform_thread_unlock_mutex(&sink.lifetime_lock);
+}
@@ -0,0 +1,56 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LOADER_LOG_SINK_H
+#define LOADER_LOG_SINK_H
+
+#include <stddef.h>
+
+#include "vk_loader_platform.h"
+
+// Asynchronous sink for VK_LOADER_DEBUG output.
+//
+// Setting VK_LOADER_DEBUG_SINK=async makes loader_log hand its lines to a ring buffer instead of
+// writing them to stderr itself.  Each line is stamped with the time since the sink started and
+// the id of the thread that logged it.  A drain thread writes the lines to stderr, and to the
+// debugger output on Windows.  The default, VK_LOADER_DEBUG_SINK=stderr, keeps the synchronous
+// writes.
+//
+// Adding a line takes no lock.  The logging thread only takes the sink's mutex to wake the drain
+// thread when it has gone to sleep on an empty buffer.  Lines that arrive while the buffer is full
+// are dropped and counted, and the count is reported with the next line written.
+//
+// The drain thread runs while at least one instance exists.  When the last instance is destroyed
+// it writes out everything still buffered and exits, so no thread has to be joined from DllMain.
+// Lines logged while no instance exists are written when the next instance is created or when the
+// loader is unloaded.
+
+// Called from loader_initialize and loader_release
+void loaderLogSinkInit(const char *sink_name);
+void loaderLogSinkShutdown(void);
+
+bool loaderLogSinkEnabled(void);
+void loaderLogSinkWrite(const char *line, size_t length);
+
+// Called once for each instance created and destroyed
+void loaderLogSinkAcquire(void);
+void loaderLogSinkRelease(void);
+
+#endif  // LOADER_LOG_SINK_H
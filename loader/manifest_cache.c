@@ -0,0 +1,945 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "vk_loader_platform.h"
+#include "loader.h"
+#include "manifest_cache.h"
+#include "murmurhash.h"
+#include "string_table.h"
+
+// Bump LOADER_MANIFEST_CACHE_VERSION whenever the layout of the file or of any payload changes.
+static const char LOADER_MANIFEST_CACHE_MAGIC[8] = {'V', 'K', 'L', 'D', 'R', 'M', 'C', '\0'};
+#define LOADER_MANIFEST_CACHE_VERSION 1
+
+// A real cache is a few kilobytes, anything this large is not something we wrote.
+#define LOADER_MANIFEST_CACHE_MAX_FILE_SIZE (16 * 1024 * 1024)
+
+enum loader_manifest_cache_kind {
+    LOADER_MANIFEST_CACHE_DATA_FILES = 1,  // Manifest file names found in a search path
+    LOADER_MANIFEST_CACHE_ICD = 2,         // Library path and API version from an ICD manifest
+    LOADER_MANIFEST_CACHE_LAYERS = 3,      // Layer properties read from a layer manifest
+};
+
+struct loader_manifest_cache_entry {
+    uint32_t kind;
+    uint32_t flags;
+    uint32_t key_hash;
+    char *key;
+    uint32_t stat_count;
+    struct loader_manifest_cache_stat *stats;
+    uint32_t payload_size;
+    uint8_t *payload;
+};
+
+struct loader_manifest_cache {
+    char *cache_file;
+    bool dirty;
+    uint32_t count;
+    uint32_t capacity;
+    struct loader_manifest_cache_entry *entries;
+};
+
+struct loader_manifest_cache_writer {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+};
+
+struct loader_manifest_cache_reader {
+    const uint8_t *data;
+    size_t size;
+    size_t pos;
+    bool failed;
+};
+
+// The cache outlives any single instance, so everything it owns is allocated without instance
+// allocation callbacks.
+static struct loader_manifest_cache *g_manifest_cache = NULL;
+
+// Serialization helpers
+
+static void loaderManifestCacheWriteBytes(struct loader_manifest_cache_writer *writer, const void *data, size_t size) {
+    if (writer->failed) {
+        return;
+    }
+    if (writer->size + size > writer->capacity) {
+        size_t new_capacity = writer->capacity == 0 ? 4096 : writer->capacity;
+        while (writer->size + size > new_capacity) {
+            new_capacity *= 2;
+        }
+        void *new_ptr =
+            loader_instance_heap_realloc(NULL, writer->data, writer->capacity, new_capacity, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+        if (NULL == new_ptr) {
+            writer->failed = true;
+            return;
+        }
+        writer->data = new_ptr;
+        writer->capacity = new_capacity;
+    }
+    memcpy(writer->data + writer->size, data, size);
+    writer->size += size;
+}
+
+static void loaderManifestCacheWriteU32(struct loader_manifest_cache_writer *writer, uint32_t value) {
+    loaderManifestCacheWriteBytes(writer, &value, sizeof(value));
+}
+
+static void loaderManifestCacheWriteU64(struct loader_manifest_cache_writer *writer, uint64_t value) {
+    loaderManifestCacheWriteBytes(writer, &value, sizeof(value));
+}
+
+// Strings are stored as a length followed by the characters and their null terminator, so the
+// reader can hand out pointers directly into the loaded buffer.
+// NULL is written as the empty string, which reads back as NULL through
+// loaderManifestCacheReadInternedString.
+static void loaderManifestCacheWriteString(struct loader_manifest_cache_writer *writer, const char *str) {
+    if (NULL == str) {
+        str = "";
+    }
+    uint32_t len = (uint32_t)strlen(str);
+    loaderManifestCacheWriteU32(writer, len);
+    loaderManifestCacheWriteBytes(writer, str, len + 1);
+}
+
+static const void *loaderManifestCacheReadBytes(struct loader_manifest_cache_reader *reader, size_t size) {
+    if (reader->failed || size > reader->size - reader->pos) {
+        reader->failed = true;
+        return NULL;
+    }
+    const void *data = reader->data + reader->pos;
+    reader->pos += size;
+    return data;
+}
+
+static uint32_t loaderManifestCacheReadU32(struct loader_manifest_cache_reader *reader) {
+    uint32_t value = 0;
+    const void *data = loaderManifestCacheReadBytes(reader, sizeof(value));
+    if (NULL != data) {
+        memcpy(&value, data, sizeof(value));
+    }
+    return value;
+}
+
+static uint64_t loaderManifestCacheReadU64(struct loader_manifest_cache_reader *reader) {
+    uint64_t value = 0;
+    const void *data = loaderManifestCacheReadBytes(reader, sizeof(value));
+    if (NULL != data) {
+        memcpy(&value, data, sizeof(value));
+    }
+    return value;
+}
+
+static const char *loaderManifestCacheReadString(struct loader_manifest_cache_reader *reader) {
+    uint32_t len = loaderManifestCacheReadU32(reader);
+    if (reader->failed || len == UINT32_MAX) {
+        reader->failed = true;
+        return NULL;
+    }
+    const char *str = loaderManifestCacheReadBytes(reader, (size_t)len + 1);
+    if (NULL == str || str[len] != '\0') {
+        reader->failed = true;
+        return NULL;
+    }
+    return str;
+}
+
+// Read a string into one of the fixed size character arrays of the loader structures.
+static void loaderManifestCacheReadFixedString(struct loader_manifest_cache_reader *reader, char *out, size_t out_size) {
+    const char *str = loaderManifestCacheReadString(reader);
+    if (NULL == str || strlen(str) >= out_size) {
+        reader->failed = true;
+        return;
+    }
+    strcpy(out, str);
+}
+
+// Read a string into one of the interned string pointers of the layer properties.
+static void loaderManifestCacheReadInternedString(struct loader_manifest_cache_reader *reader, const char **out) {
+    const char *str = loaderManifestCacheReadString(reader);
+    if (NULL == str || VK_SUCCESS != loaderStringTableIntern(str, out)) {
+        reader->failed = true;
+    }
+}
+
+static void loaderManifestCacheReadInternedName(struct loader_manifest_cache_reader *reader, const char **out) {
+    const char *str = loaderManifestCacheReadString(reader);
+    if (NULL == str || VK_SUCCESS != loaderStringTableInternName(str, out)) {
+        reader->failed = true;
+    }
+}
+
+// File identity
+
+void loaderManifestCacheStatPath(const char *path, struct loader_manifest_cache_stat *out) {
+    memset(out, 0, sizeof(*out));
+#if defined(_WIN32)
+    struct _stat64 st;
+    if (0 != _stat64(path, &st)) {
+        return;
+    }
+#else
+    struct stat st;
+    if (0 != stat(path, &st)) {
+        return;
+    }
+#if defined(__APPLE__)
+    out->mtime_nsec = (int64_t)st.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+    out->mtime_nsec = (int64_t)st.st_mtim.tv_nsec;
+#endif
+#endif
+    out->exists = 1;
+    out->dev = (uint64_t)st.st_dev;
+    out->ino = (uint64_t)st.st_ino;
+    out->size = (uint64_t)st.st_size;
+    out->mtime_sec = (int64_t)st.st_mtime;
+}
+
+bool loaderManifestCacheStatEqual(const struct loader_manifest_cache_stat *a, const struct loader_manifest_cache_stat *b) {
+    return a->exists == b->exists && a->dev == b->dev && a->ino == b->ino && a->size == b->size && a->mtime_sec == b->mtime_sec &&
+           a->mtime_nsec == b->mtime_nsec;
+}
+
+// Build the list of identities an entry depends on.  A search path depends on every element in
+// it (a directory's modification time changes whenever a file is added, removed or renamed in
+// it), while a manifest only depends on itself.
+static VkResult loaderManifestCacheCollectStats(uint32_t kind, const char *key, uint32_t *stat_count,
+                                                struct loader_manifest_cache_stat **stats) {
+    uint32_t count = 1;
+    if (kind == LOADER_MANIFEST_CACHE_DATA_FILES) {
+        for (const char *c = key; *c != '\0'; c++) {
+            if (*c == PATH_SEPARATOR) {
+                count++;
+            }
+        }
+    }
+
+    *stat_count = 0;
+    *stats = loader_instance_heap_alloc(NULL, sizeof(struct loader_manifest_cache_stat) * count, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == *stats) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    if (kind != LOADER_MANIFEST_CACHE_DATA_FILES) {
+        loaderManifestCacheStatPath(key, &(*stats)[0]);
+        *stat_count = 1;
+        return VK_SUCCESS;
+    }
+
+    // Search paths come from the environment, so their length isn't bounded enough for the stack
+    char *path_copy = loader_instance_heap_alloc(NULL, strlen(key) + 1, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == path_copy) {
+        loader_instance_heap_free(NULL, *stats);
+        *stats = NULL;
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    strcpy(path_copy, key);
+
+    char *cur_path = path_copy;
+    for (uint32_t i = 0; i < count; i++) {
+        char *next_path = strchr(cur_path, PATH_SEPARATOR);
+        if (NULL != next_path) {
+            *next_path++ = '\0';
+        }
+        loaderManifestCacheStatPath(cur_path, &(*stats)[i]);
+        cur_path = next_path;
+    }
+    loader_instance_heap_free(NULL, path_copy);
+    *stat_count = count;
+    return VK_SUCCESS;
+}
+
+// Entry management
+
+static void loaderManifestCacheFreeEntry(struct loader_manifest_cache_entry *entry) {
+    loader_instance_heap_free(NULL, entry->key);
+    loader_instance_heap_free(NULL, entry->stats);
+    loader_instance_heap_free(NULL, entry->payload);
+    memset(entry, 0, sizeof(*entry));
+}
+
+static void loaderManifestCacheClear(struct loader_manifest_cache *cache) {
+    for (uint32_t i = 0; i < cache->count; i++) {
+        loaderManifestCacheFreeEntry(&cache->entries[i]);
+    }
+    loader_instance_heap_free(NULL, cache->entries);
+    cache->entries = NULL;
+    cache->count = 0;
+    cache->capacity = 0;
+}
+
+static struct loader_manifest_cache_entry *loaderManifestCacheFindEntry(struct loader_manifest_cache *cache, uint32_t kind,
+                                                                        uint32_t flags, const char *key) {
+    uint32_t key_hash = murmurhash(key, strlen(key), 0);
+    for (uint32_t i = 0; i < cache->count; i++) {
+        struct loader_manifest_cache_entry *entry = &cache->entries[i];
+        if (entry->key_hash == key_hash && entry->kind == kind && entry->flags == flags && !strcmp(entry->key, key)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Look up an entry and make sure nothing it was built from changed since it was stored.
+static struct loader_manifest_cache_entry *loaderManifestCacheFindCurrentEntry(struct loader_manifest_cache *cache, uint32_t kind,
+                                                                               uint32_t flags, const char *key) {
+    struct loader_manifest_cache_entry *entry = loaderManifestCacheFindEntry(cache, kind, flags, key);
+    if (NULL == entry) {
+        return NULL;
+    }
+
+    uint32_t stat_count = 0;
+    struct loader_manifest_cache_stat *stats = NULL;
+    if (VK_SUCCESS != loaderManifestCacheCollectStats(kind, key, &stat_count, &stats)) {
+        return NULL;
+    }
+
+    bool current = (stat_count == entry->stat_count);
+    for (uint32_t i = 0; current && i < stat_count; i++) {
+        current = loaderManifestCacheStatEqual(&stats[i], &entry->stats[i]);
+    }
+    loader_instance_heap_free(NULL, stats);
+
+    return current ? entry : NULL;
+}
+
+// Add or replace an entry.  Ownership of the stats and of the payload moves to the cache, even on
+// failure.
+static bool loaderManifestCacheAddEntry(struct loader_manifest_cache *cache, uint32_t kind, uint32_t flags, const char *key,
+                                        uint32_t stat_count, struct loader_manifest_cache_stat *stats,
+                                        struct loader_manifest_cache_writer *payload) {
+    bool added = false;
+    char *key_copy = NULL;
+
+    if (payload->failed || payload->size > UINT32_MAX) {
+        goto out;
+    }
+    key_copy = loader_instance_heap_alloc(NULL, strlen(key) + 1, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == key_copy) {
+        goto out;
+    }
+    strcpy(key_copy, key);
+
+    struct loader_manifest_cache_entry *entry = loaderManifestCacheFindEntry(cache, kind, flags, key);
+    if (NULL == entry) {
+        if (cache->count == cache->capacity) {
+            uint32_t new_capacity = cache->capacity == 0 ? 32 : cache->capacity * 2;
+            void *new_ptr = loader_instance_heap_realloc(NULL, cache->entries,
+                                                         sizeof(struct loader_manifest_cache_entry) * cache->capacity,
+                                                         sizeof(struct loader_manifest_cache_entry) * new_capacity,
+                                                         VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+            if (NULL == new_ptr) {
+                goto out;
+            }
+            cache->entries = new_ptr;
+            cache->capacity = new_capacity;
+        }
+        entry = &cache->entries[cache->count++];
+    } else {
+        loaderManifestCacheFreeEntry(entry);
+    }
+
+    entry->kind = kind;
+    entry->flags = flags;
+    entry->key_hash = murmurhash(key, strlen(key), 0);
+    entry->key = key_copy;
+    entry->stat_count = stat_count;
+    entry->stats = stats;
+    entry->payload_size = (uint32_t)payload->size;
+    entry->payload = payload->data;
+    key_copy = NULL;
+    stats = NULL;
+    payload->data = NULL;
+    added = true;
+
+out:
+    loader_instance_heap_free(NULL, key_copy);
+    loader_instance_heap_free(NULL, stats);
+    loader_instance_heap_free(NULL, payload->data);
+    payload->data = NULL;
+    return added;
+}
+
+// Record the result of a search or parse against the current state of the files it came from.
+static void loaderManifestCacheStoreEntry(struct loader_manifest_cache *cache, uint32_t kind, uint32_t flags, const char *key,
+                                          struct loader_manifest_cache_writer *payload) {
+    struct loader_manifest_cache_stat *stats = NULL;
+    uint32_t stat_count = 0;
+
+    if (VK_SUCCESS != loaderManifestCacheCollectStats(kind, key, &stat_count, &stats)) {
+        loader_instance_heap_free(NULL, payload->data);
+        payload->data = NULL;
+        return;
+    }
+    if (loaderManifestCacheAddEntry(cache, kind, flags, key, stat_count, stats, payload)) {
+        cache->dirty = true;
+    }
+}
+
+// Loading and saving the cache file
+
+static void loaderManifestCacheLoad(const struct loader_instance *inst, struct loader_manifest_cache *cache) {
+    FILE *file = NULL;
+    uint8_t *file_data = NULL;
+    long file_size;
+    struct loader_manifest_cache_reader reader;
+
+    file = fopen(cache->cache_file, "rb");
+    if (NULL == file) {
+        // No cache yet, the first scan will write one.
+        goto out;
+    }
+    if (0 != fseek(file, 0, SEEK_END)) {
+        goto out;
+    }
+    file_size = ftell(file);
+    if (file_size <= 0 || file_size > LOADER_MANIFEST_CACHE_MAX_FILE_SIZE || 0 != fseek(file, 0, SEEK_SET)) {
+        goto out;
+    }
+    file_data = loader_instance_heap_alloc(NULL, (size_t)file_size, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == file_data || fread(file_data, 1, (size_t)file_size, file) != (size_t)file_size) {
+        goto out;
+    }
+
+    reader.data = file_data;
+    reader.size = (size_t)file_size;
+    reader.pos = 0;
+    reader.failed = false;
+
+    const void *magic = loaderManifestCacheReadBytes(&reader, sizeof(LOADER_MANIFEST_CACHE_MAGIC));
+    uint32_t version = loaderManifestCacheReadU32(&reader);
+    uint32_t header_version = loaderManifestCacheReadU32(&reader);
+    uint32_t entry_count = loaderManifestCacheReadU32(&reader);
+    if (reader.failed || memcmp(magic, LOADER_MANIFEST_CACHE_MAGIC, sizeof(LOADER_MANIFEST_CACHE_MAGIC)) ||
+        version != LOADER_MANIFEST_CACHE_VERSION || header_version != VK_HEADER_VERSION) {
+        loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "loaderManifestCacheLoad: Ignoring out of date manifest cache %s",
+                   cache->cache_file);
+        goto out;
+    }
+
+    for (uint32_t i = 0; i < entry_count && !reader.failed; i++) {
+        uint32_t kind = loaderManifestCacheReadU32(&reader);
+        uint32_t flags = loaderManifestCacheReadU32(&reader);
+        const char *key = loaderManifestCacheReadString(&reader);
+        uint32_t stat_count = loaderManifestCacheReadU32(&reader);
+        if (reader.failed || stat_count == 0 || stat_count > reader.size) {
+            reader.failed = true;
+            break;
+        }
+
+        struct loader_manifest_cache_writer payload = {0};
+        struct loader_manifest_cache_stat *stats =
+            loader_instance_heap_alloc(NULL, sizeof(struct loader_manifest_cache_stat) * stat_count, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+        if (NULL == stats) {
+            reader.failed = true;
+            break;
+        }
+        for (uint32_t s = 0; s < stat_count; s++) {
+            stats[s].dev = loaderManifestCacheReadU64(&reader);
+            stats[s].ino = loaderManifestCacheReadU64(&reader);
+            stats[s].size = loaderManifestCacheReadU64(&reader);
+            stats[s].mtime_sec = (int64_t)loaderManifestCacheReadU64(&reader);
+            stats[s].mtime_nsec = (int64_t)loaderManifestCacheReadU64(&reader);
+            stats[s].exists = loaderManifestCacheReadU32(&reader);
+        }
+        // The reader fails if fewer than payload_size bytes are left, so nothing is allocated or
+        // copied for a size the file can't back.
+        uint32_t payload_size = loaderManifestCacheReadU32(&reader);
+        const void *payload_data = loaderManifestCacheReadBytes(&reader, payload_size);
+        if (!reader.failed) {
+            loaderManifestCacheWriteBytes(&payload, payload_data, payload_size);
+        }
+        if (reader.failed || payload.failed) {
+            loader_instance_heap_free(NULL, stats);
+            loader_instance_heap_free(NULL, payload.data);
+            reader.failed = true;
+            break;
+        }
+
+        if (!loaderManifestCacheAddEntry(cache, kind, flags, key, stat_count, stats, &payload)) {
+            reader.failed = true;
+            break;
+        }
+    }
+
+    if (reader.failed) {
+        loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "loaderManifestCacheLoad: Ignoring malformed manifest cache %s",
+                   cache->cache_file);
+        loaderManifestCacheClear(cache);
+    }
+    cache->dirty = false;
+
+out:
+    if (NULL != file) {
+        fclose(file);
+    }
+    loader_instance_heap_free(NULL, file_data);
+}
+
+struct loader_manifest_cache *loaderManifestCacheOpen(const struct loader_instance *inst, const char *cache_file) {
+#if defined(_WIN32)
+    // Manifests on Windows are mostly discovered through the registry, which the cache can not
+    // validate cheaply.
+    (void)inst;
+    (void)cache_file;
+    return NULL;
+#else
+    if (NULL == cache_file || '\0' == cache_file[0]) {
+        return NULL;
+    }
+    if (NULL != g_manifest_cache) {
+        if (!strcmp(g_manifest_cache->cache_file, cache_file)) {
+            return g_manifest_cache;
+        }
+        loaderManifestCacheRelease();
+    }
+
+    struct loader_manifest_cache *cache =
+        loader_instance_heap_alloc(NULL, sizeof(struct loader_manifest_cache), VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == cache) {
+        return NULL;
+    }
+    memset(cache, 0, sizeof(struct loader_manifest_cache));
+    cache->cache_file = loader_instance_heap_alloc(NULL, strlen(cache_file) + 1, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == cache->cache_file) {
+        loader_instance_heap_free(NULL, cache);
+        return NULL;
+    }
+    strcpy(cache->cache_file, cache_file);
+
+    loaderManifestCacheLoad(inst, cache);
+    loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "loaderManifestCacheOpen: Using manifest cache %s with %d entries",
+               cache->cache_file, cache->count);
+
+    g_manifest_cache = cache;
+    return cache;
+#endif
+}
+
+// Write the cache back out if anything changed.  The new contents go to a temporary file that is
+// renamed over the old one, so concurrent processes only ever see a complete cache.
+void loaderManifestCacheFlush(const struct loader_instance *inst, struct loader_manifest_cache *cache) {
+    struct loader_manifest_cache_writer writer = {0};
+    char *temp_file = NULL;
+    FILE *file = NULL;
+    bool written = false;
+
+    if (NULL == cache || !cache->dirty) {
+        return;
+    }
+    // Don't keep retrying every scan if the location isn't writable.
+    cache->dirty = false;
+
+    loaderManifestCacheWriteBytes(&writer, LOADER_MANIFEST_CACHE_MAGIC, sizeof(LOADER_MANIFEST_CACHE_MAGIC));
+    loaderManifestCacheWriteU32(&writer, LOADER_MANIFEST_CACHE_VERSION);
+    loaderManifestCacheWriteU32(&writer, VK_HEADER_VERSION);
+    loaderManifestCacheWriteU32(&writer, cache->count);
+    for (uint32_t i = 0; i < cache->count; i++) {
+        const struct loader_manifest_cache_entry *entry = &cache->entries[i];
+        loaderManifestCacheWriteU32(&writer, entry->kind);
+        loaderManifestCacheWriteU32(&writer, entry->flags);
+        loaderManifestCacheWriteString(&writer, entry->key);
+        loaderManifestCacheWriteU32(&writer, entry->stat_count);
+        for (uint32_t s = 0; s < entry->stat_count; s++) {
+            loaderManifestCacheWriteU64(&writer, entry->stats[s].dev);
+            loaderManifestCacheWriteU64(&writer, entry->stats[s].ino);
+            loaderManifestCacheWriteU64(&writer, entry->stats[s].size);
+            loaderManifestCacheWriteU64(&writer, (uint64_t)entry->stats[s].mtime_sec);
+            loaderManifestCacheWriteU64(&writer, (uint64_t)entry->stats[s].mtime_nsec);
+            loaderManifestCacheWriteU32(&writer, entry->stats[s].exists);
+        }
+        loaderManifestCacheWriteU32(&writer, entry->payload_size);
+        loaderManifestCacheWriteBytes(&writer, entry->payload, entry->payload_size);
+    }
+    if (writer.failed) {
+        goto out;
+    }
+
+    size_t temp_file_size = strlen(cache->cache_file) + 32;
+    temp_file = loader_instance_heap_alloc(NULL, temp_file_size, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == temp_file) {
+        goto out;
+    }
+#if defined(_WIN32)
+    (void)snprintf(temp_file, temp_file_size, "%s.%lu.tmp", cache->cache_file, (unsigned long)GetCurrentProcessId());
+#else
+    (void)snprintf(temp_file, temp_file_size, "%s.%lu.tmp", cache->cache_file, (unsigned long)getpid());
+#endif
+
+    file = fopen(temp_file, "wb");
+    if (NULL == file) {
+        goto out;
+    }
+    written = fwrite(writer.data, 1, writer.size, file) == writer.size;
+    written = (0 == fclose(file)) && written;
+    file = NULL;
+    if (written) {
+        written = (0 == rename(temp_file, cache->cache_file));
+    }
+    if (!written) {
+        remove(temp_file);
+    }
+
+out:
+    if (!written) {
+        loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "loaderManifestCacheFlush: Failed to write manifest cache %s",
+                   cache->cache_file);
+    }
+    loader_instance_heap_free(NULL, temp_file);
+    loader_instance_heap_free(NULL, writer.data);
+}
+
+void loaderManifestCacheRelease(void) {
+    if (NULL == g_manifest_cache) {
+        return;
+    }
+    loaderManifestCacheClear(g_manifest_cache);
+    loader_instance_heap_free(NULL, g_manifest_cache->cache_file);
+    loader_instance_heap_free(NULL, g_manifest_cache);
+    g_manifest_cache = NULL;
+}
+
+// Manifest search results
+
+bool loaderManifestCacheFindDataFiles(const struct loader_instance *inst, struct loader_manifest_cache *cache,
+                                      const char *search_path, bool is_directory_list, struct loader_data_files *out_files) {
+    if (NULL == cache) {
+        return false;
+    }
+    struct loader_manifest_cache_entry *entry =
+        loaderManifestCacheFindCurrentEntry(cache, LOADER_MANIFEST_CACHE_DATA_FILES, is_directory_list ? 1 : 0, search_path);
+    if (NULL == entry) {
+        return false;
+    }
+
+    struct loader_manifest_cache_reader reader = {entry->payload, entry->payload_size, 0, false};
+    uint32_t first_file = out_files->count;
+    uint32_t file_count = loaderManifestCacheReadU32(&reader);
+    for (uint32_t i = 0; i < file_count && !reader.failed; i++) {
+        const char *file_name = loaderManifestCacheReadString(&reader);
+        if (NULL == file_name) {
+            break;
+        }
+        if (out_files->count == out_files->alloc_count) {
+            uint32_t new_alloc_count = out_files->alloc_count == 0 ? 64 : out_files->alloc_count * 2;
+            void *new_ptr = loader_instance_heap_realloc(inst, out_files->filename_list, out_files->alloc_count * sizeof(char *),
+                                                         new_alloc_count * sizeof(char *), VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+            if (NULL == new_ptr) {
+                reader.failed = true;
+                break;
+            }
+            out_files->filename_list = new_ptr;
+            out_files->alloc_count = new_alloc_count;
+        }
+        out_files->filename_list[out_files->count] =
+            loader_instance_heap_alloc(inst, strlen(file_name) + 1, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+        if (NULL == out_files->filename_list[out_files->count]) {
+            reader.failed = true;
+            break;
+        }
+        strcpy(out_files->filename_list[out_files->count++], file_name);
+    }
+
+    if (reader.failed) {
+        // Undo what was added so the caller can do the search the slow way
+        while (out_files->count > first_file) {
+            loader_instance_heap_free(inst, out_files->filename_list[--out_files->count]);
+            out_files->filename_list[out_files->count] = NULL;
+        }
+        return false;
+    }
+
+    loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "loaderManifestCacheFindDataFiles: Using %d cached manifest files for %s",
+               file_count, search_path);
+    return true;
+}
+
+void loaderManifestCacheStoreDataFiles(const struct loader_instance *inst, struct loader_manifest_cache *cache,
+                                       const char *search_path, bool is_directory_list, const struct loader_data_files *files,
+                                       uint32_t first_file) {
+    (void)inst;
+    if (NULL == cache) {
+        return;
+    }
+    struct loader_manifest_cache_writer payload = {0};
+    loaderManifestCacheWriteU32(&payload, files->count - first_file);
+    for (uint32_t i = first_file; i < files->count; i++) {
+        loaderManifestCacheWriteString(&payload, files->filename_list[i]);
+    }
+    loaderManifestCacheStoreEntry(cache, LOADER_MANIFEST_CACHE_DATA_FILES, is_directory_list ? 1 : 0, search_path, &payload);
+}
+
+// ICD manifests
+
+bool loaderManifestCacheFindIcd(const struct loader_instance *inst, struct loader_manifest_cache *cache, const char *manifest_file,
+                                char *lib_name, size_t lib_name_size, uint32_t *api_version) {
+    if (NULL == cache) {
+        return false;
+    }
+    struct loader_manifest_cache_entry *entry = loaderManifestCacheFindCurrentEntry(cache, LOADER_MANIFEST_CACHE_ICD, 0, manifest_file);
+    if (NULL == entry) {
+        return false;
+    }
+
+    struct loader_manifest_cache_reader reader = {entry->payload, entry->payload_size, 0, false};
+    loaderManifestCacheReadFixedString(&reader, lib_name, lib_name_size);
+    *api_version = loaderManifestCacheReadU32(&reader);
+    if (reader.failed) {
+        return false;
+    }
+
+    loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "loaderManifestCacheFindIcd: Using cached ICD manifest %s", manifest_file);
+    return true;
+}
+
+void loaderManifestCacheStoreIcd(const struct loader_instance *inst, struct loader_manifest_cache *cache, const char *manifest_file,
+                                 const char *lib_name, uint32_t api_version) {
+    (void)inst;
+    if (NULL == cache) {
+        return;
+    }
+    struct loader_manifest_cache_writer payload = {0};
+    loaderManifestCacheWriteString(&payload, lib_name);
+    loaderManifestCacheWriteU32(&payload, api_version);
+    loaderManifestCacheStoreEntry(cache, LOADER_MANIFEST_CACHE_ICD, 0, manifest_file, &payload);
+}
+
+// Layer manifests
+
+static void loaderManifestCacheWriteNameArray(struct loader_manifest_cache_writer *writer, uint32_t count,
+                                              const char *const *names) {
+    loaderManifestCacheWriteU32(writer, NULL == names ? 0 : count);
+    for (uint32_t i = 0; NULL != names && i < count; i++) {
+        loaderManifestCacheWriteString(writer, names[i]);
+    }
+}
+
+static void loaderManifestCacheReadNameArray(const struct loader_instance *inst, struct loader_manifest_cache_reader *reader,
+                                             uint32_t *count, const char ***names) {
+    *count = loaderManifestCacheReadU32(reader);
+    *names = NULL;
+    if (reader->failed || *count == 0) {
+        *count = 0;
+        return;
+    }
+    if (*count > reader->size) {
+        *count = 0;
+        reader->failed = true;
+        return;
+    }
+    *names = loader_instance_heap_alloc(inst, sizeof(const char *) * *count, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (NULL == *names) {
+        *count = 0;
+        reader->failed = true;
+        return;
+    }
+    memset((void *)*names, 0, sizeof(const char *) * *count);
+    for (uint32_t i = 0; i < *count; i++) {
+        loaderManifestCacheReadInternedName(reader, &(*names)[i]);
+    }
+}
+
+static void loaderManifestCacheWriteLayer(struct loader_manifest_cache_writer *writer, const struct loader_layer_properties *props) {
+    loaderManifestCacheWriteString(writer, props->info.layerName);
+    loaderManifestCacheWriteU32(writer, props->info.specVersion);
+    loaderManifestCacheWriteU32(writer, props->info.implementationVersion);
+    loaderManifestCacheWriteString(writer, props->info.description);
+    loaderManifestCacheWriteU32(writer, (uint32_t)props->type_flags);
+    loaderManifestCacheWriteU32(writer, props->interface_version);
+    loaderManifestCacheWriteString(writer, props->lib_name);
+    loaderManifestCacheWriteString(writer, props->functions.str_gipa);
+    loaderManifestCacheWriteString(writer, props->functions.str_gdpa);
+    loaderManifestCacheWriteString(writer, props->functions.str_negotiate_interface);
+
+    loaderManifestCacheWriteU32(writer, props->instance_extension_list.count);
+    for (uint32_t i = 0; i < props->instance_extension_list.count; i++) {
+        loaderManifestCacheWriteString(writer, props->instance_extension_list.list[i].extensionName);
+        loaderManifestCacheWriteU32(writer, props->instance_extension_list.list[i].specVersion);
+    }
+    loaderManifestCacheWriteU32(writer, props->device_extension_list.count);
+    for (uint32_t i = 0; i < props->device_extension_list.count; i++) {
+        const struct loader_dev_ext_props *dev_ext = &props->device_extension_list.list[i];
+        loaderManifestCacheWriteString(writer, dev_ext->props.extensionName);
+        loaderManifestCacheWriteU32(writer, dev_ext->props.specVersion);
+        loaderManifestCacheWriteU32(writer, dev_ext->entrypoint_count);
+        for (uint32_t j = 0; j < dev_ext->entrypoint_count; j++) {
+            loaderManifestCacheWriteString(writer, dev_ext->entrypoints[j]);
+        }
+    }
+
+    loaderManifestCacheWriteString(writer, props->disable_env_var.name);
+    loaderManifestCacheWriteString(writer, props->disable_env_var.value);
+    loaderManifestCacheWriteString(writer, props->enable_env_var.name);
+    loaderManifestCacheWriteString(writer, props->enable_env_var.value);
+    loaderManifestCacheWriteNameArray(writer, props->num_component_layers, props->component_layer_names);
+    loaderManifestCacheWriteString(writer, props->pre_instance_functions.enumerate_instance_extension_properties);
+    loaderManifestCacheWriteString(writer, props->pre_instance_functions.enumerate_instance_layer_properties);
+    loaderManifestCacheWriteString(writer, props->pre_instance_functions.enumerate_instance_version);
+    loaderManifestCacheWriteNameArray(writer, props->num_override_paths, props->override_paths);
+    loaderManifestCacheWriteU32(writer, props->is_override ? 1 : 0);
+    loaderManifestCacheWriteU32(writer, props->has_expiration ? 1 : 0);
+    loaderManifestCacheWriteU32(writer, props->expiration.year);
+    loaderManifestCacheWriteU32(writer, props->expiration.month);
+    loaderManifestCacheWriteU32(writer, props->expiration.day);
+    loaderManifestCacheWriteU32(writer, props->expiration.hour);
+    loaderManifestCacheWriteU32(writer, props->expiration.minute);
+    loaderManifestCacheWriteU32(writer, props->keep ? 1 : 0);
+    loaderManifestCacheWriteNameArray(writer, props->num_blacklist_layers, props->blacklist_layer_names);
+}
+
+// Fill in a zeroed layer property slot.  On failure, anything allocated so far is left in the
+// slot for loaderFreeLayerProperties() to clean up.
+static void loaderManifestCacheReadLayer(const struct loader_instance *inst, struct loader_manifest_cache_reader *reader,
+                                         struct loader_layer_properties *props) {
+    VkExtensionProperties ext_prop;
+
+    loaderManifestCacheReadFixedString(reader, props->info.layerName, sizeof(props->info.layerName));
+    props->info.specVersion = loaderManifestCacheReadU32(reader);
+    props->info.implementationVersion = loaderManifestCacheReadU32(reader);
+    loaderManifestCacheReadFixedString(reader, props->info.description, sizeof(props->info.description));
+    props->type_flags = (enum layer_type_flags)loaderManifestCacheReadU32(reader);
+    props->interface_version = loaderManifestCacheReadU32(reader);
+    loaderManifestCacheReadInternedString(reader, &props->lib_name);
+    loaderManifestCacheReadInternedString(reader, &props->functions.str_gipa);
+    loaderManifestCacheReadInternedString(reader, &props->functions.str_gdpa);
+    loaderManifestCacheReadInternedString(reader, &props->functions.str_negotiate_interface);
+
+    uint32_t inst_ext_count = loaderManifestCacheReadU32(reader);
+    for (uint32_t i = 0; i < inst_ext_count && !reader->failed; i++) {
+        loaderManifestCacheReadFixedString(reader, ext_prop.extensionName, sizeof(ext_prop.extensionName));
+        ext_prop.specVersion = loaderManifestCacheReadU32(reader);
+        if (!reader->failed && VK_SUCCESS != loader_add_to_ext_list(inst, &props->instance_extension_list, 1, &ext_prop)) {
+            reader->failed = true;
+        }
+    }
+    uint32_t dev_ext_count = loaderManifestCacheReadU32(reader);
+    for (uint32_t i = 0; i < dev_ext_count && !reader->failed; i++) {
+        loaderManifestCacheReadFixedString(reader, ext_prop.extensionName, sizeof(ext_prop.extensionName));
+        ext_prop.specVersion = loaderManifestCacheReadU32(reader);
+        uint32_t entry_count = loaderManifestCacheReadU32(reader);
+        if (reader->failed || entry_count > reader->size) {
+            reader->failed = true;
+            break;
+        }
+        char **entry_array = NULL;
+        if (entry_count > 0) {
+            entry_array = loader_instance_heap_alloc(inst, sizeof(char *) * entry_count, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+            if (NULL == entry_array) {
+                reader->failed = true;
+                break;
+            }
+            for (uint32_t j = 0; j < entry_count; j++) {
+                entry_array[j] = (char *)loaderManifestCacheReadString(reader);
+            }
+        }
+        if (!reader->failed &&
+            VK_SUCCESS != loader_add_to_dev_ext_list(inst, &props->device_extension_list, &ext_prop, entry_count, entry_array)) {
+            reader->failed = true;
+        }
+        loader_instance_heap_free(inst, entry_array);
+    }
+
+    loaderManifestCacheReadInternedString(reader, &props->disable_env_var.name);
+    loaderManifestCacheReadInternedString(reader, &props->disable_env_var.value);
+    loaderManifestCacheReadInternedString(reader, &props->enable_env_var.name);
+    loaderManifestCacheReadInternedString(reader, &props->enable_env_var.value);
+    loaderManifestCacheReadNameArray(inst, reader, &props->num_component_layers, &props->component_layer_names);
+    loaderManifestCacheReadInternedString(reader, &props->pre_instance_functions.enumerate_instance_extension_properties);
+    loaderManifestCacheReadInternedString(reader, &props->pre_instance_functions.enumerate_instance_layer_properties);
+    loaderManifestCacheReadInternedString(reader, &props->pre_instance_functions.enumerate_instance_version);
+    loaderManifestCacheReadNameArray(inst, reader, &props->num_override_paths, &props->override_paths);
+    props->is_override = loaderManifestCacheReadU32(reader) != 0;
+    props->has_expiration = loaderManifestCacheReadU32(reader) != 0;
+    props->expiration.year = (uint16_t)loaderManifestCacheReadU32(reader);
+    props->expiration.month = (uint8_t)loaderManifestCacheReadU32(reader);
+    props->expiration.day = (uint8_t)loaderManifestCacheReadU32(reader);
+    props->expiration.hour = (uint8_t)loaderManifestCacheReadU32(reader);
+    props->expiration.minute = (uint8_t)loaderManifestCacheReadU32(reader);
+    props->keep = loaderManifestCacheReadU32(reader) != 0;
+    loaderManifestCacheReadNameArray(inst, reader, &props->num_blacklist_layers, &props->blacklist_layer_names);
+}
+
+bool loaderManifestCacheFindLayers(const struct loader_instance *inst, struct loader_manifest_cache *cache,
+                                   const char *manifest_file, bool is_implicit, struct loader_layer_list *layer_list) {
+    if (NULL == cache) {
+        return false;
+    }
+    struct loader_manifest_cache_entry *entry =
+        loaderManifestCacheFindCurrentEntry(cache, LOADER_MANIFEST_CACHE_LAYERS, is_implicit ? 1 : 0, manifest_file);
+    if (NULL == entry) {
+        return false;
+    }
+
+    struct loader_manifest_cache_reader reader = {entry->payload, entry->payload_size, 0, false};
+    uint32_t first_layer = layer_list->count;
+    uint32_t layer_count = loaderManifestCacheReadU32(&reader);
+    for (uint32_t i = 0; i < layer_count && !reader.failed; i++) {
+        struct loader_layer_properties *props = loaderGetNextLayerPropertySlot(inst, layer_list);
+        if (NULL == props) {
+            reader.failed = true;
+            break;
+        }
+        props->strings = loaderStringTableAcquireGeneration();
+        if (NULL == props->strings) {
+            reader.failed = true;
+            break;
+        }
+        loaderManifestCacheReadLayer(inst, &reader, props);
+    }
+
+    if (reader.failed) {
+        // Undo what was added so the caller can parse the manifest instead
+        while (layer_list->count > first_layer) {
+            struct loader_layer_properties *props = &layer_list->list[--layer_list->count];
+            loaderFreeLayerProperties(inst, props);
+            memset(props, 0, sizeof(struct loader_layer_properties));
+        }
+        return false;
+    }
+
+    loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "loaderManifestCacheFindLayers: Using cached layer manifest %s",
+               manifest_file);
+    return true;
+}
+
+void loaderManifestCacheStoreLayers(const struct loader_instance *inst, struct loader_manifest_cache *cache,
+                                    const char *manifest_file, bool is_implicit, const struct loader_layer_list *layer_list,
+                                    uint32_t first_layer) {
+    (void)inst;
+    if (NULL == cache) {
+        return;
+    }
+    struct loader_manifest_cache_writer payload = {0};
+    loaderManifestCacheWriteU32(&payload, layer_list->count - first_layer);
+    for (uint32_t i = first_layer; i < layer_list->count; i++) {
+        loaderManifestCacheWriteLayer(&payload, &layer_list->list[i]);
+    }
+    loaderManifestCacheStoreEntry(cache, LOADER_MANIFEST_CACHE_LAYERS, is_implicit ? 1 : 0, manifest_file, &payload);
+}
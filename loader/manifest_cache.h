@@ -0,0 +1,74 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LOADER_MANIFEST_CACHE_H
+#define LOADER_MANIFEST_CACHE_H
+
+#include "loader.h"
+
+// Persistent cache of manifest discovery results.
+//
+// When the VK_LOADER_MANIFEST_CACHE environment variable names a file, the loader keeps the
+// results of searching the manifest directories and of parsing each ICD and layer manifest in
+// that file.  Every entry records the identity (device, inode, size and modification time) of
+// the directories or manifest file it was built from and is only used while those still match,
+// so a warm start can skip both the directory enumeration and the JSON parsing.
+//
+// The cache is process-wide and all of the functions below, apart from the stat helpers, must be
+// called with loader_json_lock held.
+
+struct loader_manifest_cache;
+
+// Identity of a file or directory that discovery results were built from.  A path that does not
+// exist has exists == 0 and all other fields zero.
+struct loader_manifest_cache_stat {
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+    uint32_t exists;
+};
+
+void loaderManifestCacheStatPath(const char *path, struct loader_manifest_cache_stat *out);
+bool loaderManifestCacheStatEqual(const struct loader_manifest_cache_stat *a, const struct loader_manifest_cache_stat *b);
+
+struct loader_manifest_cache *loaderManifestCacheOpen(const struct loader_instance *inst, const char *cache_file);
+void loaderManifestCacheFlush(const struct loader_instance *inst, struct loader_manifest_cache *cache);
+void loaderManifestCacheRelease(void);
+
+bool loaderManifestCacheFindDataFiles(const struct loader_instance *inst, struct loader_manifest_cache *cache,
+                                      const char *search_path, bool is_directory_list, struct loader_data_files *out_files);
+void loaderManifestCacheStoreDataFiles(const struct loader_instance *inst, struct loader_manifest_cache *cache,
+                                       const char *search_path, bool is_directory_list, const struct loader_data_files *files,
+                                       uint32_t first_file);
+
+bool loaderManifestCacheFindIcd(const struct loader_instance *inst, struct loader_manifest_cache *cache, const char *manifest_file,
+                                char *lib_name, size_t lib_name_size, uint32_t *api_version);
+void loaderManifestCacheStoreIcd(const struct loader_instance *inst, struct loader_manifest_cache *cache, const char *manifest_file,
+                                 const char *lib_name, uint32_t api_version);
+
+bool loaderManifestCacheFindLayers(const struct loader_instance *inst, struct loader_manifest_cache *cache,
+                                   const char *manifest_file, bool is_implicit, struct loader_layer_list *layer_list);
+void loaderManifestCacheStoreLayers(const struct loader_instance *inst, struct loader_manifest_cache *cache,
+                                    const char *manifest_file, bool is_implicit, const struct loader_layer_list *layer_list,
+                                    uint32_t first_layer);
+
+#endif  // LOADER_MANIFEST_CACHE_H
@@ -30,6 +30,9 @@
 #include "vk_loader_platform.h"
 #include "loader.h"
 
+// Where the trampolines are written at runtime these aren't used; see unknown_ext_jit.h
+#if !defined(LOADER_UNKNOWN_EXT_JIT)
+
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC optimize(3)  // force gcc to use tail-calls
 #endif
@@ -1054,3 +1057,5 @@ void *loader_get_phys_dev_ext_termin(uint32_t index) {
     }
     return NULL;
 }
+
+#endif  // !LOADER_UNKNOWN_EXT_JIT
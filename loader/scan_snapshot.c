@@ -0,0 +1,334 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vk_loader_platform.h"
+#include "loader.h"
+#include "scan_snapshot.h"
+
+// Environment variables that go into building the manifest search paths, plus the manifest cache
+// location so that pointing it somewhere new runs a scan that fills it.
+static const char *const loader_scan_snapshot_env_vars[] = {
+    "VK_ICD_FILENAMES", "VK_LAYER_PATH", "XDG_CONFIG_DIRS", "XDG_DATA_DIRS", "XDG_DATA_HOME", "HOME", "VK_LOADER_MANIFEST_CACHE",
+};
+
+// Like the manifest cache, snapshots outlive instances so everything here is allocated without
+// instance allocation callbacks.
+static struct loader_scan_snapshot *g_scan_snapshots[LOADER_SCAN_SNAPSHOT_KIND_COUNT];
+static struct loader_scan_snapshot *g_scan_recording = NULL;
+static enum loader_scan_snapshot_kind g_scan_recording_kind;
+static uint32_t g_scan_snapshot_generation = 0;
+
+static const char *loaderScanSnapshotKindName(enum loader_scan_snapshot_kind kind) {
+    switch (kind) {
+        case LOADER_SCAN_SNAPSHOT_ICDS:
+            return "ICD";
+        case LOADER_SCAN_SNAPSHOT_LAYERS:
+            return "layer";
+        case LOADER_SCAN_SNAPSHOT_IMPLICIT_LAYERS:
+            return "implicit layer";
+        default:
+            return "unknown";
+    }
+}
+
+// Build a string holding the value of every search path environment variable, so a snapshot taken
+// with one environment is never used with another.
+static char *loaderScanSnapshotBuildEnvKey(void) {
+    size_t key_size = 1;
+    for (uint32_t i = 0; i < sizeof(loader_scan_snapshot_env_vars) / sizeof(loader_scan_snapshot_env_vars[0]); i++) {
+        const char *value = getenv(loader_scan_snapshot_env_vars[i]);
+        key_size += strlen(loader_scan_snapshot_env_vars[i]) + 2;
+        if (NULL != value) {
+            key_size += strlen(value) + 1;
+        }
+    }
+
+    char *key = loader_instance_heap_alloc(NULL, key_size, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == key) {
+        return NULL;
+    }
+    char *cur = key;
+    for (uint32_t i = 0; i < sizeof(loader_scan_snapshot_env_vars) / sizeof(loader_scan_snapshot_env_vars[0]); i++) {
+        const char *value = getenv(loader_scan_snapshot_env_vars[i]);
+        // Unset and empty variables must not produce the same key
+        if (NULL != value) {
+            cur += sprintf(cur, "%s=%s\n", loader_scan_snapshot_env_vars[i], value);
+        } else {
+            cur += sprintf(cur, "%s\n", loader_scan_snapshot_env_vars[i]);
+        }
+    }
+    *cur = '\0';
+    return key;
+}
+
+static void loaderScanSnapshotFree(struct loader_scan_snapshot *snapshot) {
+    if (NULL == snapshot) {
+        return;
+    }
+    for (uint32_t i = 0; i < snapshot->dep_count; i++) {
+        loader_instance_heap_free(NULL, snapshot->dep_paths[i]);
+    }
+    loader_instance_heap_free(NULL, snapshot->dep_paths);
+    loader_instance_heap_free(NULL, snapshot->dep_stats);
+    loaderDeleteLayerListAndProperties(NULL, &snapshot->layers);
+    loader_instance_heap_free(NULL, snapshot->icds);
+    loader_instance_heap_free(NULL, snapshot->env_key);
+    loader_instance_heap_free(NULL, snapshot);
+}
+
+static void loaderScanSnapshotUnref(struct loader_scan_snapshot *snapshot) {
+    if (NULL != snapshot && --snapshot->ref_count == 0) {
+        loaderScanSnapshotFree(snapshot);
+    }
+}
+
+static bool loaderScanSnapshotIsCurrent(const struct loader_scan_snapshot *snapshot) {
+    char *env_key = loaderScanSnapshotBuildEnvKey();
+    bool current = (NULL != env_key && !strcmp(env_key, snapshot->env_key));
+    loader_instance_heap_free(NULL, env_key);
+
+    for (uint32_t i = 0; current && i < snapshot->dep_count; i++) {
+        struct loader_manifest_cache_stat stat;
+        loaderManifestCacheStatPath(snapshot->dep_paths[i], &stat);
+        current = loaderManifestCacheStatEqual(&stat, &snapshot->dep_stats[i]);
+    }
+    return current;
+}
+
+struct loader_scan_snapshot *loaderScanSnapshotAcquire(const struct loader_instance *inst, enum loader_scan_snapshot_kind kind) {
+#if defined(_WIN32)
+    // Manifests are found through the registry, which can't be checked for changes by stat'ing paths
+    (void)inst;
+    (void)kind;
+    return NULL;
+#else
+    struct loader_scan_snapshot *snapshot = g_scan_snapshots[kind];
+    if (NULL == snapshot) {
+        return NULL;
+    }
+
+    if (!loaderScanSnapshotIsCurrent(snapshot)) {
+        loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "loaderScanSnapshotAcquire: %s scan snapshot %u is out of date",
+                   loaderScanSnapshotKindName(kind), snapshot->generation);
+        g_scan_snapshots[kind] = NULL;
+        loaderScanSnapshotUnref(snapshot);
+        return NULL;
+    }
+
+    loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "loaderScanSnapshotAcquire: Using %s scan snapshot %u",
+               loaderScanSnapshotKindName(kind), snapshot->generation);
+    snapshot->ref_count++;
+    return snapshot;
+#endif
+}
+
+void loaderScanSnapshotRelease(struct loader_scan_snapshot *snapshot) {
+    if (NULL == snapshot) {
+        return;
+    }
+    loader_platform_thread_lock_mutex(&loader_json_lock);
+    loaderScanSnapshotUnref(snapshot);
+    loader_platform_thread_unlock_mutex(&loader_json_lock);
+}
+
+static VkResult loaderScanSnapshotCopyLayerList(const struct loader_instance *inst, const struct loader_layer_list *src,
+                                                struct loader_layer_list *dst) {
+    for (uint32_t i = 0; i < src->count; i++) {
+        struct loader_layer_properties *props = loaderGetNextLayerPropertySlot(inst, dst);
+        if (NULL == props) {
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+        if (VK_SUCCESS != loaderCopyLayerProperties(inst, props, &src->list[i])) {
+            memset(props, 0, sizeof(struct loader_layer_properties));
+            dst->count--;
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
+    return VK_SUCCESS;
+}
+
+VkResult loaderScanSnapshotCopyLayers(const struct loader_instance *inst, const struct loader_scan_snapshot *snapshot,
+                                      struct loader_layer_list *layers) {
+    return loaderScanSnapshotCopyLayerList(inst, &snapshot->layers, layers);
+}
+
+void loaderScanSnapshotBeginRecording(const struct loader_instance *inst, enum loader_scan_snapshot_kind kind) {
+#if defined(_WIN32)
+    (void)inst;
+    (void)kind;
+#else
+    (void)inst;
+    loaderScanSnapshotEndRecording();
+
+    struct loader_scan_snapshot *recording =
+        loader_instance_heap_alloc(NULL, sizeof(struct loader_scan_snapshot), VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == recording) {
+        return;
+    }
+    memset(recording, 0, sizeof(struct loader_scan_snapshot));
+    recording->env_key = loaderScanSnapshotBuildEnvKey();
+    if (NULL == recording->env_key) {
+        loaderScanSnapshotFree(recording);
+        return;
+    }
+    g_scan_recording = recording;
+    g_scan_recording_kind = kind;
+#endif
+}
+
+void loaderScanSnapshotRecordPath(const char *path) {
+    struct loader_scan_snapshot *recording = g_scan_recording;
+    if (NULL == recording || recording->failed) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < recording->dep_count; i++) {
+        if (!strcmp(recording->dep_paths[i], path)) {
+            return;
+        }
+    }
+
+    if (recording->dep_count == recording->dep_capacity) {
+        uint32_t new_capacity = recording->dep_capacity == 0 ? 16 : recording->dep_capacity * 2;
+        char **new_paths = loader_instance_heap_realloc(NULL, recording->dep_paths, sizeof(char *) * recording->dep_capacity,
+                                                        sizeof(char *) * new_capacity, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+        if (NULL == new_paths) {
+            recording->failed = true;
+            return;
+        }
+        recording->dep_paths = new_paths;
+        struct loader_manifest_cache_stat *new_stats = loader_instance_heap_realloc(
+            NULL, recording->dep_stats, sizeof(struct loader_manifest_cache_stat) * recording->dep_capacity,
+            sizeof(struct loader_manifest_cache_stat) * new_capacity, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+        if (NULL == new_stats) {
+            recording->failed = true;
+            return;
+        }
+        recording->dep_stats = new_stats;
+        recording->dep_capacity = new_capacity;
+    }
+
+    char *path_copy = loader_instance_heap_alloc(NULL, strlen(path) + 1, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (NULL == path_copy) {
+        recording->failed = true;
+        return;
+    }
+    strcpy(path_copy, path);
+    recording->dep_paths[recording->dep_count] = path_copy;
+    loaderManifestCacheStatPath(path_copy, &recording->dep_stats[recording->dep_count]);
+    recording->dep_count++;
+}
+
+// Record every element of a PATH_SEPARATOR delimited list.  A directory's modification time changes
+// whenever a file is added, removed or renamed in it, so recording the searched directories and the
+// manifests found in them catches every change that could alter the scan.
+void loaderScanSnapshotRecordPaths(const char *paths) {
+    if (NULL == g_scan_recording || g_scan_recording->failed || NULL == paths) {
+        return;
+    }
+
+    char *paths_copy = loader_stack_alloc(strlen(paths) + 1);
+    if (NULL == paths_copy) {
+        g_scan_recording->failed = true;
+        return;
+    }
+    strcpy(paths_copy, paths);
+
+    char *cur_path = paths_copy;
+    while (NULL != cur_path && !g_scan_recording->failed) {
+        char *next_path = strchr(cur_path, PATH_SEPARATOR);
+        if (NULL != next_path) {
+            *next_path++ = '\0';
+        }
+        if (*cur_path != '\0') {
+            loaderScanSnapshotRecordPath(cur_path);
+        }
+        cur_path = next_path;
+    }
+}
+
+void loaderScanSnapshotRecordIcd(const char *lib_name, uint32_t api_version) {
+    struct loader_scan_snapshot *recording = g_scan_recording;
+    if (NULL == recording || recording->failed) {
+        return;
+    }
+
+    if (recording->icd_count == recording->icd_capacity) {
+        uint32_t new_capacity = recording->icd_capacity == 0 ? 8 : recording->icd_capacity * 2;
+        struct loader_scan_snapshot_icd *new_icds = loader_instance_heap_realloc(
+            NULL, recording->icds, sizeof(struct loader_scan_snapshot_icd) * recording->icd_capacity,
+            sizeof(struct loader_scan_snapshot_icd) * new_capacity, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+        if (NULL == new_icds) {
+            recording->failed = true;
+            return;
+        }
+        recording->icds = new_icds;
+        recording->icd_capacity = new_capacity;
+    }
+
+    strncpy(recording->icds[recording->icd_count].lib_name, lib_name, MAX_STRING_SIZE - 1);
+    recording->icds[recording->icd_count].lib_name[MAX_STRING_SIZE - 1] = '\0';
+    recording->icds[recording->icd_count].api_version = api_version;
+    recording->icd_count++;
+}
+
+// Turn the recording into the current snapshot for its kind.  Layer scans pass their final list,
+// which is copied; ICD scans pass NULL.
+void loaderScanSnapshotCommit(const struct loader_instance *inst, const struct loader_layer_list *layers) {
+    struct loader_scan_snapshot *recording = g_scan_recording;
+    if (NULL == recording || recording->failed) {
+        loaderScanSnapshotEndRecording();
+        return;
+    }
+
+    if (NULL != layers && VK_SUCCESS != loaderScanSnapshotCopyLayerList(NULL, layers, &recording->layers)) {
+        loaderScanSnapshotEndRecording();
+        return;
+    }
+
+    g_scan_recording = NULL;
+    recording->ref_count = 1;
+    recording->generation = ++g_scan_snapshot_generation;
+    loaderScanSnapshotUnref(g_scan_snapshots[g_scan_recording_kind]);
+    g_scan_snapshots[g_scan_recording_kind] = recording;
+
+    loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0, "loaderScanSnapshotCommit: Saved %s scan snapshot %u depending on %u paths",
+               loaderScanSnapshotKindName(g_scan_recording_kind), recording->generation, recording->dep_count);
+}
+
+void loaderScanSnapshotEndRecording(void) {
+    loaderScanSnapshotFree(g_scan_recording);
+    g_scan_recording = NULL;
+}
+
+void loaderScanSnapshotReleaseAll(void) {
+    loaderScanSnapshotEndRecording();
+    for (uint32_t i = 0; i < LOADER_SCAN_SNAPSHOT_KIND_COUNT; i++) {
+        loaderScanSnapshotUnref(g_scan_snapshots[i]);
+        g_scan_snapshots[i] = NULL;
+    }
+}
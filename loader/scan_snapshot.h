@@ -0,0 +1,90 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LOADER_SCAN_SNAPSHOT_H
+#define LOADER_SCAN_SNAPSHOT_H
+
+#include "loader.h"
+#include "manifest_cache.h"
+
+// In-process snapshots of ICD and layer scan results.
+//
+// Every scan records the search path elements and manifest files it looked at, along with the
+// environment variables that built the search paths.  When it completes, the result is kept as the
+// snapshot for that kind of scan.  Later scans, from any instance or from the global enumerate
+// functions, reuse it for as long as re-stat'ing those paths shows nothing changed, instead of
+// enumerating directories and parsing JSON again.
+//
+// Snapshots are reference counted so a scan can copy one out after dropping loader_json_lock while
+// another scan replaces it.  Scans that find the override layer are never snapshotted, because its
+// enable state depends on environment variables and on its expiration date.
+
+enum loader_scan_snapshot_kind {
+    LOADER_SCAN_SNAPSHOT_ICDS = 0,             // loader_icd_scan()
+    LOADER_SCAN_SNAPSHOT_LAYERS = 1,           // loaderScanForLayers()
+    LOADER_SCAN_SNAPSHOT_IMPLICIT_LAYERS = 2,  // loaderScanForImplicitLayers()
+    LOADER_SCAN_SNAPSHOT_KIND_COUNT = 3,
+};
+
+struct loader_scan_snapshot_icd {
+    char lib_name[MAX_STRING_SIZE];
+    uint32_t api_version;
+};
+
+struct loader_scan_snapshot {
+    uint32_t ref_count;
+    uint32_t generation;
+    char *env_key;
+    bool failed;
+
+    // Paths the scan depended on, and their identity when it ran
+    uint32_t dep_count;
+    uint32_t dep_capacity;
+    char **dep_paths;
+    struct loader_manifest_cache_stat *dep_stats;
+
+    // Result of a layer scan
+    struct loader_layer_list layers;
+
+    // Result of an ICD scan, in manifest order
+    uint32_t icd_count;
+    uint32_t icd_capacity;
+    struct loader_scan_snapshot_icd *icds;
+};
+
+// Must be called with loader_json_lock held.  Returns a referenced snapshot that is still current,
+// or NULL if the scan has to run.
+struct loader_scan_snapshot *loaderScanSnapshotAcquire(const struct loader_instance *inst, enum loader_scan_snapshot_kind kind);
+// Takes loader_json_lock, so must be called without it.
+void loaderScanSnapshotRelease(struct loader_scan_snapshot *snapshot);
+VkResult loaderScanSnapshotCopyLayers(const struct loader_instance *inst, const struct loader_scan_snapshot *snapshot,
+                                      struct loader_layer_list *layers);
+
+// Recording, all with loader_json_lock held.  Record calls made outside of a recording are ignored.
+void loaderScanSnapshotBeginRecording(const struct loader_instance *inst, enum loader_scan_snapshot_kind kind);
+void loaderScanSnapshotRecordPath(const char *path);
+void loaderScanSnapshotRecordPaths(const char *paths);
+void loaderScanSnapshotRecordIcd(const char *lib_name, uint32_t api_version);
+void loaderScanSnapshotCommit(const struct loader_instance *inst, const struct loader_layer_list *layers);
+void loaderScanSnapshotEndRecording(void);
+
+void loaderScanSnapshotReleaseAll(void);
+
+#endif  // LOADER_SCAN_SNAPSHOT_H
@@ -0,0 +1,213 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string.h>
+
+#include "vk_loader_platform.h"
+#include "loader.h"
+#include "murmurhash.h"
+#include "string_table.h"
+
+// Must be a power of two
+#define LOADER_STRING_TABLE_INITIAL_CAPACITY 256
+#define LOADER_STRING_TABLE_BLOCK_SIZE (16 * 1024)
+// Bytes of strings a generation holds before the next record starts a new one
+#define LOADER_STRING_TABLE_GENERATION_SIZE (256 * 1024)
+
+struct loader_string_table_slot {
+    uint32_t hash;
+    const char *str;
+};
+
+// Strings are packed into blocks, which follow this header
+struct loader_string_table_block {
+    struct loader_string_table_block *next;
+};
+
+// The blocks of strings interned while this was the current generation.  Every layer record
+// referencing them holds a reference, and the table holds one for as long as it's current.
+struct loader_string_generation {
+    uint32_t ref_count;
+    size_t size;
+    struct loader_string_table_block *blocks;
+};
+
+// The slots only hold strings of the current generation
+static struct loader_string_table {
+    uint32_t capacity;
+    uint32_t count;
+    struct loader_string_table_slot *slots;
+    struct loader_string_generation *current;
+    char *block_next;
+    char *block_end;
+} g_string_table;
+
+static struct loader_string_table_slot *loaderStringTableProbe(struct loader_string_table_slot *slots, uint32_t capacity,
+                                                               const char *str, uint32_t hash) {
+    uint32_t mask = capacity - 1;
+    for (uint32_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        if (NULL == slots[slot].str || (slots[slot].hash == hash && !strcmp(slots[slot].str, str))) {
+            return &slots[slot];
+        }
+    }
+}
+
+static bool loaderStringTableGrow(void) {
+    uint32_t capacity = 0 == g_string_table.capacity ? LOADER_STRING_TABLE_INITIAL_CAPACITY : g_string_table.capacity * 2;
+    struct loader_string_table_slot *slots =
+        loader_instance_heap_alloc(NULL, sizeof(struct loader_string_table_slot) * capacity, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (NULL == slots) {
+        return false;
+    }
+    memset(slots, 0, sizeof(struct loader_string_table_slot) * capacity);
+    for (uint32_t i = 0; i < g_string_table.capacity; i++) {
+        if (NULL != g_string_table.slots[i].str) {
+            *loaderStringTableProbe(slots, capacity, g_string_table.slots[i].str, g_string_table.slots[i].hash) =
+                g_string_table.slots[i];
+        }
+    }
+    loader_instance_heap_free(NULL, g_string_table.slots);
+    g_string_table.slots = slots;
+    g_string_table.capacity = capacity;
+    return true;
+}
+
+static char *loaderStringTableCopy(const char *str, size_t size) {
+    if ((size_t)(g_string_table.block_end - g_string_table.block_next) < size) {
+        // Strings longer than a block get a block of their own
+        size_t block_size = size > LOADER_STRING_TABLE_BLOCK_SIZE ? size : LOADER_STRING_TABLE_BLOCK_SIZE;
+        struct loader_string_table_block *block = loader_instance_heap_alloc(
+            NULL, sizeof(struct loader_string_table_block) + block_size, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+        if (NULL == block) {
+            return NULL;
+        }
+        block->next = g_string_table.current->blocks;
+        g_string_table.current->blocks = block;
+        g_string_table.block_next = (char *)(block + 1);
+        g_string_table.block_end = g_string_table.block_next + block_size;
+    }
+    char *copy = g_string_table.block_next;
+    memcpy(copy, str, size);
+    g_string_table.block_next += size;
+    g_string_table.current->size += size;
+    return copy;
+}
+
+static void loaderStringTableFreeGeneration(struct loader_string_generation *generation) {
+    while (NULL != generation->blocks) {
+        struct loader_string_table_block *next = generation->blocks->next;
+        loader_instance_heap_free(NULL, generation->blocks);
+        generation->blocks = next;
+    }
+    loader_instance_heap_free(NULL, generation);
+}
+
+struct loader_string_generation *loaderStringTableAcquireGeneration(void) {
+    struct loader_string_generation *current = g_string_table.current;
+    if (NULL == current || current->size >= LOADER_STRING_TABLE_GENERATION_SIZE) {
+        struct loader_string_generation *generation = loader_instance_heap_alloc(
+            NULL, sizeof(struct loader_string_generation), VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+        if (NULL == generation) {
+            return NULL;
+        }
+        memset(generation, 0, sizeof(struct loader_string_generation));
+        generation->ref_count = 1;
+
+        // Strings of the old generation can't be handed out any more, it's freed with the last
+        // record using them
+        if (0 != g_string_table.capacity) {
+            memset(g_string_table.slots, 0, sizeof(struct loader_string_table_slot) * g_string_table.capacity);
+        }
+        g_string_table.count = 0;
+        g_string_table.block_next = NULL;
+        g_string_table.block_end = NULL;
+        g_string_table.current = generation;
+        loaderStringTableReleaseGeneration(current);
+    }
+    return loaderStringTableRetainGeneration(g_string_table.current);
+}
+
+struct loader_string_generation *loaderStringTableRetainGeneration(struct loader_string_generation *generation) {
+    if (NULL != generation) {
+        loader_platform_atomic_fetch_add_u32(&generation->ref_count, 1);
+    }
+    return generation;
+}
+
+void loaderStringTableReleaseGeneration(struct loader_string_generation *generation) {
+    if (NULL != generation && 1 == loader_platform_atomic_fetch_add_u32(&generation->ref_count, UINT32_MAX)) {
+        loaderStringTableFreeGeneration(generation);
+    }
+}
+
+VkResult loaderStringTableIntern(const char *str, const char **interned) {
+    *interned = NULL;
+    if (NULL == str || '\0' == str[0]) {
+        return VK_SUCCESS;
+    }
+
+    // Records acquire a generation before interning their strings, so there is always a current one
+    if (NULL == g_string_table.current) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    size_t len = strlen(str);
+    uint32_t hash = murmurhash(str, len, 0);
+    struct loader_string_table_slot *slot = NULL;
+    if (0 != g_string_table.capacity) {
+        slot = loaderStringTableProbe(g_string_table.slots, g_string_table.capacity, str, hash);
+        if (NULL != slot->str) {
+            *interned = slot->str;
+            return VK_SUCCESS;
+        }
+    }
+
+    // Keep the load factor at or below 3/4
+    if (NULL == slot || (g_string_table.count + 1) * 4 > g_string_table.capacity * 3) {
+        if (!loaderStringTableGrow()) {
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
+        slot = loaderStringTableProbe(g_string_table.slots, g_string_table.capacity, str, hash);
+    }
+
+    char *copy = loaderStringTableCopy(str, len + 1);
+    if (NULL == copy) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    slot->hash = hash;
+    slot->str = copy;
+    g_string_table.count++;
+    *interned = copy;
+    return VK_SUCCESS;
+}
+
+VkResult loaderStringTableInternName(const char *str, const char **interned) {
+    VkResult res = loaderStringTableIntern(str, interned);
+    if (NULL == *interned) {
+        *interned = "";
+    }
+    return res;
+}
+
+void loaderStringTableRelease(void) {
+    loaderStringTableReleaseGeneration(g_string_table.current);
+    loader_instance_heap_free(NULL, g_string_table.slots);
+    memset(&g_string_table, 0, sizeof(g_string_table));
+}
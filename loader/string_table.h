@@ -0,0 +1,62 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LOADER_STRING_TABLE_H
+#define LOADER_STRING_TABLE_H
+
+#include "loader.h"
+
+// Process-wide table of interned strings for the loader_layer_properties records.
+//
+// Layer records are copied into every instance's layer lists, the activated lists and the scan
+// snapshot.  They used to carry a dozen fixed MAX_STRING_SIZE buffers each.  They now point at
+// strings from this table, so copying a record copies pointers and equal strings from different
+// manifests share one copy.  Like the manifest cache and the scan snapshot, the table outlives
+// instances and doesn't use instance allocation callbacks.
+//
+// Strings are interned into the current generation.  A record takes a reference to it before its
+// strings are interned, and copies of the record take another, so a string lives as long as the
+// records pointing at it and nothing has to free strings one at a time.  Once the current
+// generation holds LOADER_STRING_TABLE_GENERATION_SIZE bytes, the next record starts a new one and
+// the old one is freed with the last record using it.  An application rescanning manifests that
+// keep changing therefore doesn't grow the table without bound.
+//
+// Must be called with loader_json_lock held, which every manifest scan already holds.  Retaining
+// and releasing a generation can be done without it.
+
+// Returns a reference to the generation the strings of a new record are interned into, or NULL if
+// out of memory
+struct loader_string_generation *loaderStringTableAcquireGeneration(void);
+// NULL is ignored by both
+struct loader_string_generation *loaderStringTableRetainGeneration(struct loader_string_generation *generation);
+void loaderStringTableReleaseGeneration(struct loader_string_generation *generation);
+
+// Sets *interned to the table's copy of str.  NULL and empty strings intern to NULL, which is how
+// layer records mark a string the manifest didn't set.
+VkResult loaderStringTableIntern(const char *str, const char **interned);
+
+// Same as loaderStringTableIntern, but NULL and empty strings give "".  Used for the entries of
+// the layer name and path arrays, which are compared against and so are never NULL.
+VkResult loaderStringTableInternName(const char *str, const char **interned);
+
+// Called from loader_release
+void loaderStringTableRelease(void);
+
+#endif  // LOADER_STRING_TABLE_H
@@ -35,6 +35,9 @@
 #include "wsi.h"
 #include "vk_loader_extensions.h"
 #include "gpa_helper.h"
+#include "instance_arena.h"
+#include "log_sink.h"
+#include "unknown_ext_map.h"
 
 
 // Trampoline entrypoints are in this file for core Vulkan commands
@@ -84,7 +87,8 @@ LOADER_EXPORT VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetDeviceProcAddr(VkDev
     // a VkDevice or child of VkDevice so return NULL.
     if (!strcmp(pName, "CreateDevice")) return NULL;
 
-    // Return the dispatch table entrypoint for the fastest case
+    // Return the dispatch table entrypoint for the fastest case.  With no device layers the table
+    // holds the ICD's own entry points, other than the terminators that unwrap a loader handle.
     const VkLayerDispatchTable *disp_table = *(VkLayerDispatchTable **)device;
     if (disp_table == NULL) return NULL;
 
@@ -130,7 +134,8 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateInstanceExtensionPropert
     // Prepend layers onto the chain if they implment this entry point
     for (uint32_t i = 0; i < layers.count; ++i) {
         if (!loaderImplicitLayerIsEnabled(NULL, layers.list + i) ||
-            layers.list[i].pre_instance_functions.enumerate_instance_extension_properties[0] == '\0') {
+            NULL == layers.list[i].pre_instance_functions.enumerate_instance_extension_properties ||
+            NULL == layers.list[i].lib_name) {
             continue;
         }
 
@@ -224,7 +229,8 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateInstanceLayerProperties(
     // Prepend layers onto the chain if they implment this entry point
     for (uint32_t i = 0; i < layers.count; ++i) {
         if (!loaderImplicitLayerIsEnabled(NULL, layers.list + i) ||
-            layers.list[i].pre_instance_functions.enumerate_instance_layer_properties[0] == '\0') {
+            NULL == layers.list[i].pre_instance_functions.enumerate_instance_layer_properties ||
+            NULL == layers.list[i].lib_name) {
             continue;
         }
 
@@ -318,7 +324,8 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateInstanceVersion(uint32_t
     // Prepend layers onto the chain if they implment this entry point
     for (uint32_t i = 0; i < layers.count; ++i) {
         if (!loaderImplicitLayerIsEnabled(NULL, layers.list + i) ||
-            layers.list[i].pre_instance_functions.enumerate_instance_version[0] == '\0') {
+            NULL == layers.list[i].pre_instance_functions.enumerate_instance_version ||
+            NULL == layers.list[i].lib_name) {
             continue;
         }
 
@@ -382,7 +389,6 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateInstance(const VkInstanceCr
                                                               const VkAllocationCallbacks *pAllocator, VkInstance *pInstance) {
     struct loader_instance *ptr_instance = NULL;
     VkInstance created_instance = VK_NULL_HANDLE;
-    bool loaderLocked = false;
     VkResult res = VK_ERROR_INITIALIZATION_FAILED;
 
     LOADER_PLATFORM_THREAD_ONCE(&once_init, loader_initialize);
@@ -405,10 +411,17 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateInstance(const VkInstanceCr
         goto out;
     }
 
+    // Nothing else can reach the new instance until it is returned, so creation needs no global lock
     tls_instance = ptr_instance;
-    loader_platform_thread_lock_mutex(&loader_lock);
-    loaderLocked = true;
     memset(ptr_instance, 0, sizeof(struct loader_instance));
+    loader_platform_thread_create_mutex(&ptr_instance->lock);
+    loader_platform_thread_create_rwlock(&ptr_instance->dbg_lock);
+    loaderInstanceArenaInit(&ptr_instance->arena);
+    loaderDevicePoolInit(&ptr_instance->device_pool);
+    loaderDeviceDispatchCacheInit(&ptr_instance->device_dispatch_cache);
+    loaderUnknownExtMapInit(&ptr_instance->dev_ext_map);
+    loaderUnknownExtMapInit(&ptr_instance->phys_dev_ext_map);
+    loaderLogSinkAcquire();
     if (pAllocator) {
         ptr_instance->alloc_callbacks = *pAllocator;
     }
@@ -496,8 +509,8 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateInstance(const VkInstanceCr
         goto out;
     }
 
-    ptr_instance->disp = loader_instance_heap_alloc(ptr_instance, sizeof(struct loader_instance_dispatch_table),
-                                                    VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    ptr_instance->disp =
+        loaderInstanceArenaAllocAligned(ptr_instance, sizeof(struct loader_instance_dispatch_table), LOADER_CACHE_LINE_SIZE);
     if (ptr_instance->disp == NULL) {
         loader_log(ptr_instance, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                    "vkCreateInstance:  Failed to allocate Loader's full Instance dispatch table.");
@@ -505,9 +518,11 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateInstance(const VkInstanceCr
         goto out;
     }
     memcpy(&ptr_instance->disp->layer_inst_disp, &instance_disp, sizeof(instance_disp));
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+    ptr_instance->disp->phys_dev_ext = (struct loader_unknown_ext_array *)&loader_unknown_ext_array_empty;
+#endif
 
-    ptr_instance->next = loader.instances;
-    loader.instances = ptr_instance;
+    loaderAddInstanceToList(ptr_instance);
 
     // Activate any layers on instance chain
     res = loaderEnableInstanceLayers(ptr_instance, &ici, &ptr_instance->instance_layer_list);
@@ -538,12 +553,7 @@ out:
 
     if (NULL != ptr_instance) {
         if (res != VK_SUCCESS) {
-            if (NULL != ptr_instance->next) {
-                loader.instances = ptr_instance->next;
-            }
-            if (NULL != ptr_instance->disp) {
-                loader_instance_heap_free(ptr_instance, ptr_instance->disp);
-            }
+            loaderRemoveInstanceFromList(ptr_instance);
             if (ptr_instance->num_tmp_report_callbacks > 0) {
                 // Remove temporary VK_EXT_debug_report items
                 util_DestroyDebugReportCallbacks(ptr_instance, pAllocator, ptr_instance->num_tmp_report_callbacks,
@@ -570,6 +580,15 @@ out:
             loader_scanned_icd_clear(ptr_instance, &ptr_instance->icd_tramp_list);
             loader_destroy_generic_list(ptr_instance, (struct loader_generic_list *)&ptr_instance->ext_list);
 
+            loaderUnknownExtMapDestroy(ptr_instance, &ptr_instance->dev_ext_map);
+            loaderUnknownExtMapDestroy(ptr_instance, &ptr_instance->phys_dev_ext_map);
+            loaderDevicePoolDestroy(&ptr_instance->device_pool);
+            loaderDeviceDispatchCacheDestroy(ptr_instance, &ptr_instance->device_dispatch_cache);
+            util_DestroyDebugCallbackIndex(ptr_instance);
+            loaderInstanceArenaDestroy(ptr_instance, &ptr_instance->arena);
+            loader_platform_thread_delete_mutex(&ptr_instance->lock);
+            loader_platform_thread_delete_rwlock(&ptr_instance->dbg_lock);
+            loaderLogSinkRelease();
             loader_instance_heap_free(ptr_instance, ptr_instance);
         } else {
             // Remove temporary VK_EXT_debug_report or VK_EXT_debug_utils items
@@ -578,10 +597,6 @@ out:
             util_DestroyDebugReportCallbacks(ptr_instance, pAllocator, ptr_instance->num_tmp_report_callbacks,
                                              ptr_instance->tmp_report_callbacks);
         }
-
-        if (loaderLocked) {
-            loader_platform_thread_unlock_mutex(&loader_lock);
-        }
     }
 
     return res;
@@ -599,9 +614,8 @@ LOADER_EXPORT VKAPI_ATTR void VKAPI_CALL vkDestroyInstance(VkInstance instance,
 
     disp = loader_get_instance_layer_dispatch(instance);
 
-    loader_platform_thread_lock_mutex(&loader_lock);
-
     ptr_instance = loader_get_instance(instance);
+    loader_platform_thread_lock_mutex(&ptr_instance->lock);
 
     if (pAllocator) {
         ptr_instance->alloc_callbacks = *pAllocator;
@@ -632,10 +646,8 @@ LOADER_EXPORT VKAPI_ATTR void VKAPI_CALL vkDestroyInstance(VkInstance instance,
         loaderDestroyLayerList(ptr_instance, NULL, &ptr_instance->app_activated_layer_list);
     }
 
+    // The physical device objects are in the instance's arena
     if (ptr_instance->phys_devs_tramp) {
-        for (uint32_t i = 0; i < ptr_instance->phys_dev_count_tramp; i++) {
-            loader_instance_heap_free(ptr_instance, ptr_instance->phys_devs_tramp[i]);
-        }
         loader_instance_heap_free(ptr_instance, ptr_instance->phys_devs_tramp);
     }
 
@@ -656,9 +668,17 @@ LOADER_EXPORT VKAPI_ATTR void VKAPI_CALL vkDestroyInstance(VkInstance instance,
                                          ptr_instance->tmp_report_callbacks);
         util_FreeDebugReportCreateInfos(pAllocator, ptr_instance->tmp_report_create_infos, ptr_instance->tmp_report_callbacks);
     }
-    loader_instance_heap_free(ptr_instance, ptr_instance->disp);
+    loaderDevicePoolDestroy(&ptr_instance->device_pool);
+    loaderDeviceDispatchCacheDestroy(ptr_instance, &ptr_instance->device_dispatch_cache);
+    util_DestroyDebugCallbackIndex(ptr_instance);
+    loaderInstanceArenaDestroy(ptr_instance, &ptr_instance->arena);
+    loader_platform_thread_unlock_mutex(&ptr_instance->lock);
+    loader_platform_thread_delete_mutex(&ptr_instance->lock);
+    loader_platform_thread_delete_rwlock(&ptr_instance->dbg_lock);
     loader_instance_heap_free(ptr_instance, ptr_instance);
-    loader_platform_thread_unlock_mutex(&loader_lock);
+
+    // Write out anything this instance logged that is still buffered
+    loaderLogSinkRelease();
 }
 
 LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumeratePhysicalDevices(VkInstance instance, uint32_t *pPhysicalDeviceCount,
@@ -668,14 +688,13 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumeratePhysicalDevices(VkInstan
     uint32_t i;
     struct loader_instance *inst;
 
-    loader_platform_thread_lock_mutex(&loader_lock);
-
     inst = loader_get_instance(instance);
     if (NULL == inst) {
-        res = VK_ERROR_INITIALIZATION_FAILED;
-        goto out;
+        return VK_ERROR_INITIALIZATION_FAILED;
     }
 
+    loader_platform_thread_lock_mutex(&inst->lock);
+
     if (NULL == pPhysicalDeviceCount) {
         loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                    "vkEnumeratePhysicalDevices: Received NULL pointer for physical device count return value.");
@@ -686,6 +705,7 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumeratePhysicalDevices(VkInstan
     // Setup the trampoline loader physical devices.  This will actually
     // call down and setup the terminator loader physical devices during the
     // process.
+    inst->phys_dev_enum_generation++;
     VkResult setup_res = setupLoaderTrampPhysDevs(instance);
     if (setup_res != VK_SUCCESS && setup_res != VK_INCOMPLETE) {
         res = setup_res;
@@ -713,7 +733,7 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumeratePhysicalDevices(VkInstan
 
 out:
 
-    loader_platform_thread_unlock_mutex(&loader_lock);
+    loader_platform_thread_unlock_mutex(&inst->lock);
     return res;
 }
 
@@ -770,25 +790,36 @@ LOADER_EXPORT VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceMemoryProperties(VkP
 
 LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateDevice(VkPhysicalDevice physicalDevice, const VkDeviceCreateInfo *pCreateInfo,
                                                             const VkAllocationCallbacks *pAllocator, VkDevice *pDevice) {
-    loader_platform_thread_lock_mutex(&loader_lock);
+    struct loader_instance *inst = ((struct loader_physical_device_tramp *)physicalDevice)->this_instance;
+    loader_platform_thread_lock_mutex(&inst->lock);
     VkResult res = loader_layer_create_device(NULL, physicalDevice, pCreateInfo, pAllocator, pDevice, NULL, NULL);
-    loader_platform_thread_unlock_mutex(&loader_lock);
+    loader_platform_thread_unlock_mutex(&inst->lock);
     return res;
 }
 
 LOADER_EXPORT VKAPI_ATTR void VKAPI_CALL vkDestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator) {
     const VkLayerDispatchTable *disp;
+    struct loader_device *dev;
 
     if (device == VK_NULL_HANDLE) {
         return;
     }
     disp = loader_get_dispatch(device);
 
-    loader_platform_thread_lock_mutex(&loader_lock);
+    struct loader_icd_term *icd_term = loader_get_icd_and_device(device, &dev, NULL);
+    if (NULL == icd_term) {
+        // Still destroy the device down the chain, there's just no loader record to free with it
+        loader_log(NULL, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "vkDestroyDevice: Device %p is not known to the loader", (void *)device);
+        loader_layer_destroy_device(device, pAllocator, disp->DestroyDevice);
+        return;
+    }
+    struct loader_instance *inst = (struct loader_instance *)icd_term->this_instance;
+
+    loader_platform_thread_lock_mutex(&inst->lock);
 
     loader_layer_destroy_device(device, pAllocator, disp->DestroyDevice);
 
-    loader_platform_thread_unlock_mutex(&loader_lock);
+    loader_platform_thread_unlock_mutex(&inst->lock);
 }
 
 LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateDeviceExtensionProperties(VkPhysicalDevice physicalDevice,
@@ -799,16 +830,18 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateDeviceExtensionPropertie
     const VkLayerInstanceDispatchTable *disp;
     phys_dev = (struct loader_physical_device_tramp *)physicalDevice;
 
-    loader_platform_thread_lock_mutex(&loader_lock);
-
     // always pass this call down the instance chain which will terminate
     // in the ICD. This allows layers to filter the extensions coming back
     // up the chain. In the terminator we look up layer extensions from the
     // manifest file if it wasn't provided by the layer itself.
+    // No lock is taken: the terminator reads the ICD's extension list,
+    // recorded on the first call and published atomically, and the layers'
+    // manifest lists, neither of which changes while the instance exists.
+    // Anything it logs is sent holding the instance's dbg_lock, so it can't
+    // race a messenger being destroyed on another thread.
     disp = loader_get_instance_layer_dispatch(physicalDevice);
     res = disp->EnumerateDeviceExtensionProperties(phys_dev->phys_dev, pLayerName, pPropertyCount, pProperties);
 
-    loader_platform_thread_unlock_mutex(&loader_lock);
     return res;
 }
 
@@ -819,20 +852,20 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateDeviceLayerProperties(Vk
     struct loader_physical_device_tramp *phys_dev;
     struct loader_layer_list *enabled_layers, layers_list;
     memset(&layers_list, 0, sizeof(layers_list));
-    loader_platform_thread_lock_mutex(&loader_lock);
 
     // Don't dispatch this call down the instance chain, want all device layers
     // enumerated and instance chain may not contain all device layers
     // TODO re-evaluate the above statement we maybe able to start calling
     // down the chain
 
+    // The activated layers are fixed when the instance is created, so they
+    // are read without a lock
     phys_dev = (struct loader_physical_device_tramp *)physicalDevice;
-    const struct loader_instance *inst = phys_dev->this_instance;
+    struct loader_instance *inst = phys_dev->this_instance;
 
     uint32_t count = inst->app_activated_layer_list.count;
     if (count == 0 || pProperties == NULL) {
         *pPropertyCount = count;
-        loader_platform_thread_unlock_mutex(&loader_lock);
         return VK_SUCCESS;
     }
     enabled_layers = (struct loader_layer_list *)&inst->app_activated_layer_list;
@@ -844,11 +877,9 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateDeviceLayerProperties(Vk
     *pPropertyCount = copy_size;
 
     if (copy_size < count) {
-        loader_platform_thread_unlock_mutex(&loader_lock);
         return VK_INCOMPLETE;
     }
 
-    loader_platform_thread_unlock_mutex(&loader_lock);
     return VK_SUCCESS;
 }
 
@@ -2024,20 +2055,6 @@ VkResult setupLoaderTrampPhysDevGroups(VkInstance instance) {
         goto out;
     }
 
-    // Create an array for the new physical device groups, which will be stored
-    // in the instance for the trampoline code.
-    new_phys_dev_groups = (VkPhysicalDeviceGroupPropertiesKHR **)loader_instance_heap_alloc(
-        inst, total_count * sizeof(VkPhysicalDeviceGroupPropertiesKHR *), VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-    if (NULL == new_phys_dev_groups) {
-        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-            "setupLoaderTrampPhysDevGroups:  Failed to allocate new physical device"
-            " group array of size %d",
-            total_count);
-        res = VK_ERROR_OUT_OF_HOST_MEMORY;
-        goto out;
-    }
-    memset(new_phys_dev_groups, 0, total_count * sizeof(VkPhysicalDeviceGroupPropertiesKHR *));
-
     // Create a temporary array (on the stack) to keep track of the
     // returned VkPhysicalDevice values.
     local_phys_dev_groups = loader_stack_alloc(sizeof(VkPhysicalDeviceGroupPropertiesKHR) * total_count);
@@ -2067,18 +2084,30 @@ VkResult setupLoaderTrampPhysDevGroups(VkInstance instance) {
         goto out;
     }
 
+    uint32_t tramp_slot_count = loaderPhysDevMapSlotCount(inst->phys_dev_count_tramp);
+    struct loader_phys_dev_map_slot *tramp_slots = loader_stack_alloc(sizeof(struct loader_phys_dev_map_slot) * tramp_slot_count);
+    if (NULL == tramp_slots) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+            "setupLoaderTrampPhysDevGroups:  Failed to allocate physical "
+            "device map of size %d",
+            tramp_slot_count);
+        res = VK_ERROR_OUT_OF_HOST_MEMORY;
+        goto out;
+    }
+    struct loader_phys_dev_map tramp_map;
+    loaderPhysDevMapInit(&tramp_map, tramp_slots, tramp_slot_count);
+    for (uint32_t tramp_gpu = 0; tramp_gpu < inst->phys_dev_count_tramp; tramp_gpu++) {
+        loaderPhysDevMapAdd(&tramp_map, inst->phys_devs_tramp[tramp_gpu]->phys_dev, inst->phys_devs_tramp[tramp_gpu]);
+    }
+
     // Replace all the physical device IDs with the proper loader values
     for (uint32_t group = 0; group < total_count; group++) {
         for (uint32_t group_gpu = 0; group_gpu < local_phys_dev_groups[group].physicalDeviceCount; group_gpu++) {
-            bool found = false;
-            for (uint32_t tramp_gpu = 0; tramp_gpu < inst->phys_dev_count_tramp; tramp_gpu++) {
-                if (local_phys_dev_groups[group].physicalDevices[group_gpu] == inst->phys_devs_tramp[tramp_gpu]->phys_dev) {
-                    local_phys_dev_groups[group].physicalDevices[group_gpu] = (VkPhysicalDevice)inst->phys_devs_tramp[tramp_gpu];
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
+            struct loader_physical_device_tramp *phys_dev_tramp =
+                loaderPhysDevMapFind(&tramp_map, local_phys_dev_groups[group].physicalDevices[group_gpu]);
+            if (NULL != phys_dev_tramp) {
+                local_phys_dev_groups[group].physicalDevices[group_gpu] = (VkPhysicalDevice)phys_dev_tramp;
+            } else {
                 loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                     "setupLoaderTrampPhysDevGroups:  Failed to find GPU %d in group %d"
                     " returned by \'EnumeratePhysicalDeviceGroupsKHR\' in list returned"
@@ -2089,6 +2118,35 @@ VkResult setupLoaderTrampPhysDevGroups(VkInstance instance) {
         }
     }
 
+    // Nothing changes if the same groups came back in the same order
+    if (NULL != inst->phys_dev_groups_tramp && total_count == inst->phys_dev_group_count_tramp) {
+        uint32_t same = 0;
+        while (same < total_count &&
+               local_phys_dev_groups[same].physicalDeviceCount == inst->phys_dev_groups_tramp[same]->physicalDeviceCount &&
+               local_phys_dev_groups[same].subsetAllocation == inst->phys_dev_groups_tramp[same]->subsetAllocation &&
+               !memcmp(local_phys_dev_groups[same].physicalDevices, inst->phys_dev_groups_tramp[same]->physicalDevices,
+                       sizeof(VkPhysicalDevice) * local_phys_dev_groups[same].physicalDeviceCount)) {
+            same++;
+        }
+        if (same == total_count) {
+            goto out;
+        }
+    }
+
+    // Create an array for the new physical device groups, which will be stored
+    // in the instance for the trampoline code.
+    new_phys_dev_groups = (VkPhysicalDeviceGroupPropertiesKHR **)loader_instance_heap_alloc(
+        inst, total_count * sizeof(VkPhysicalDeviceGroupPropertiesKHR *), VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (NULL == new_phys_dev_groups) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+            "setupLoaderTrampPhysDevGroups:  Failed to allocate new physical device"
+            " group array of size %d",
+            total_count);
+        res = VK_ERROR_OUT_OF_HOST_MEMORY;
+        goto out;
+    }
+    memset(new_phys_dev_groups, 0, total_count * sizeof(VkPhysicalDeviceGroupPropertiesKHR *));
+
     // Copy or create everything to fill the new array of physical device groups
     for (uint32_t new_idx = 0; new_idx < total_count; new_idx++) {
         // Check if this physical device group with the same contents is already in the old buffer
@@ -2146,7 +2204,7 @@ out:
             loader_instance_heap_free(inst, new_phys_dev_groups);
         }
         total_count = 0;
-    } else {
+    } else if (NULL != new_phys_dev_groups) {
         // Free everything that didn't carry over to the new array of
         // physical device groups
         if (NULL != inst->phys_dev_groups_tramp) {
@@ -2181,14 +2239,13 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumeratePhysicalDeviceGroups(
     uint32_t i;
     struct loader_instance *inst = NULL;
 
-    loader_platform_thread_lock_mutex(&loader_lock);
-
     inst = loader_get_instance(instance);
     if (NULL == inst) {
-        res = VK_ERROR_INITIALIZATION_FAILED;
-        goto out;
+        return VK_ERROR_INITIALIZATION_FAILED;
     }
 
+    loader_platform_thread_lock_mutex(&inst->lock);
+
     if (NULL == pPhysicalDeviceGroupCount) {
         loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                    "vkEnumeratePhysicalDeviceGroupsKHR: Received NULL pointer for physical "
@@ -2197,6 +2254,7 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumeratePhysicalDeviceGroups(
         goto out;
     }
 
+    inst->phys_dev_enum_generation++;
     VkResult setup_res = setupLoaderTrampPhysDevGroups(instance);
     if (VK_SUCCESS != setup_res) {
         res = setup_res;
@@ -2225,7 +2283,7 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkEnumeratePhysicalDeviceGroups(
 
 out:
 
-    loader_platform_thread_unlock_mutex(&loader_lock);
+    loader_platform_thread_unlock_mutex(&inst->lock);
     return res;
 }
 
@@ -28,6 +28,9 @@
  #include "vk_loader_platform.h"
  #include "loader.h"
 
+// Where the trampolines are written at runtime these aren't used; see unknown_ext_jit.h
+#if !defined(LOADER_UNKNOWN_EXT_JIT)
+
  #if defined(__GNUC__) && !defined(__clang__)
  #pragma GCC optimize(3)  // force gcc to use tail-calls
  #endif
@@ -48,7 +51,7 @@
          struct loader_instance *inst = (struct loader_instance *)icd_term->this_instance;                             \
          if (NULL == icd_term->phys_dev_ext[num]) {                                                                    \
              loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "Extension %s not supported for this physical device", \
-                        inst->phys_dev_ext_disp_hash[num].func_name);                                                  \
+                        inst->phys_dev_ext_map.func_names[num]);                                                       \
          }                                                                                                             \
          icd_term->phys_dev_ext[num](phys_dev_term->phys_dev);                                                         \
     }
@@ -58,7 +61,7 @@
    VKAPI_ATTR void VKAPI_CALL vkdev_ext##num(VkDevice device) {                   \
            const struct loader_dev_dispatch_table *disp;                          \
            disp = loader_get_dev_dispatch(device);                                \
-           disp->ext_dispatch.dev_ext[num](device);                               \
+           disp->ext_dispatch->dev_ext[num](device);                              \
        }
 
 
@@ -817,3 +820,5 @@ DevExtTramp(246)
 DevExtTramp(247)
 DevExtTramp(248)
 DevExtTramp(249)
+
+#endif  // !LOADER_UNKNOWN_EXT_JIT
@@ -65,7 +65,8 @@ DevExtTramp macro num
 public vkdev_ext&num&
 vkdev_ext&num&:
     mov     rax, qword ptr [rcx]                                               ; Dereference the handle to get the dispatch table
-    jmp     qword ptr [rax + (EXT_OFFSET_DEVICE_DISPATCH + (PTR_SIZE * num))]  ; Jump to the appropriate call chain
+    mov     rax, qword ptr [rax + EXT_OFFSET_DEVICE_DISPATCH]                  ; Load the table of unknown device functions
+    jmp     qword ptr [rax + (PTR_SIZE * num)]                                 ; Jump to the appropriate call chain
 endm
 
 ; 32-bit values and macro
@@ -107,8 +108,10 @@ endm
 DevExtTramp macro num
 public _vkdev_ext&num&@4
 _vkdev_ext&num&@4:
-    mov     eax, dword ptr [esp + 4]                                           ; Dereference the handle to get the dispatch table
-    jmp     dword ptr [eax + (EXT_OFFSET_DEVICE_DISPATCH + (PTR_SIZE * num))]  ; Jump to the appropriate call chain
+    mov     eax, dword ptr [esp + 4]                                           ; Load the VkDevice into eax
+    mov     eax, dword ptr [eax]                                               ; Dereference the handle to get the dispatch table
+    mov     eax, dword ptr [eax + EXT_OFFSET_DEVICE_DISPATCH]                  ; Load the table of unknown device functions
+    jmp     dword ptr [eax + (PTR_SIZE * num)]                                 ; Jump to the appropriate call chain
 endm
 
 ; This is also needed for 32-bit only
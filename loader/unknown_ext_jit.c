@@ -0,0 +1,442 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vk_loader_platform.h"
+#include "loader.h"
+#include "unknown_ext_map.h"
+#include "unknown_ext_jit.h"
+#include "vk_loader_extensions.h"
+
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+
+// Every stub gets a slot of the same size, and a chunk holds the stubs for a run of indices.  A
+// chunk is rounded up to whole pages, since that is what can be made executable.
+#define LOADER_UNKNOWN_EXT_JIT_SLOT_SIZE 128
+#define LOADER_UNKNOWN_EXT_JIT_CHUNK_SLOTS 32
+#define LOADER_UNKNOWN_EXT_JIT_INITIAL_CHUNKS 8
+
+enum loader_unknown_ext_stub {
+    LOADER_UNKNOWN_EXT_STUB_DEV_TRAMP,
+    LOADER_UNKNOWN_EXT_STUB_PHYS_DEV_TRAMP,
+    LOADER_UNKNOWN_EXT_STUB_PHYS_DEV_TERMIN,
+    LOADER_UNKNOWN_EXT_STUB_COUNT,
+};
+
+static loader_platform_thread_mutex loader_unknown_ext_jit_lock;
+
+// Set for good the first time a chunk can't be written or sealed.  Guarded by the lock.
+static bool loader_unknown_ext_jit_disabled;
+
+// The written chunks of each kind of stub, by chunk index.  These grow the same way as the arrays
+// the stubs read, and the arrays they replaced are kept until loaderUnknownExtJitRelease, so
+// finding a stub in a written chunk takes no lock.  Chunks are published with a release store once
+// sealed.
+static struct loader_unknown_ext_array *loader_unknown_ext_jit_chunks[LOADER_UNKNOWN_EXT_STUB_COUNT];
+
+static size_t loader_unknown_ext_jit_chunk_size;
+
+// Where a physical device terminator goes when the ICD doesn't have the function.  Matches the
+// static terminators, which log the error and then crash, since there is nothing to return.
+static void loaderUnknownExtJitTerminError(struct loader_physical_device_term *phys_dev_term, uint32_t index) {
+    const struct loader_instance *inst = phys_dev_term->this_icd_term->this_instance;
+    loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "Extension %s not supported for this physical device",
+               loaderUnknownExtMapName(&inst->phys_dev_ext_map, index));
+    abort();
+}
+
+// Offset of the pointer to the array a stub reads, within the structure the stub finds it in
+static size_t loaderUnknownExtJitArrayOffset(enum loader_unknown_ext_stub stub) {
+    switch (stub) {
+        case LOADER_UNKNOWN_EXT_STUB_DEV_TRAMP:
+            return offsetof(struct loader_dev_dispatch_table, ext_dispatch);
+        case LOADER_UNKNOWN_EXT_STUB_PHYS_DEV_TRAMP:
+            return offsetof(struct loader_instance_dispatch_table, phys_dev_ext);
+        case LOADER_UNKNOWN_EXT_STUB_PHYS_DEV_TERMIN:
+            return offsetof(struct loader_icd_term, phys_dev_ext);
+        default:
+            assert(false && "loaderUnknownExtJitArrayOffset: unknown stub");
+            return 0;
+    }
+}
+
+#define LOADER_UNKNOWN_EXT_JIT_CAPACITY_OFFSET offsetof(struct loader_unknown_ext_array, capacity)
+#define LOADER_UNKNOWN_EXT_JIT_ENTRIES_OFFSET offsetof(struct loader_unknown_ext_array, entries)
+
+#if defined(__x86_64__)
+
+static uint8_t *loaderUnknownExtJitEmit(uint8_t *code, const uint8_t *bytes, size_t size) {
+    memcpy(code, bytes, size);
+    return code + size;
+}
+
+static uint8_t *loaderUnknownExtJitEmit32(uint8_t *code, uint32_t value) {
+    memcpy(code, &value, sizeof(value));
+    return code + sizeof(value);
+}
+
+static uint8_t *loaderUnknownExtJitEmit64(uint8_t *code, uint64_t value) {
+    memcpy(code, &value, sizeof(value));
+    return code + sizeof(value);
+}
+
+// The first parameter is in rdi.  The stubs are led by an endbr64 so they can be called
+// indirectly with CET enabled, and check the array's capacity before reading an entry, since an
+// array only grows when an entry is set in it.
+static bool loaderUnknownExtJitWriteStub(enum loader_unknown_ext_stub stub, uint32_t index, uint8_t *code) {
+    static const uint8_t endbr64[] = {0xF3, 0x0F, 0x1E, 0xFA};
+    static const uint8_t mov_rax_rdi[] = {0x48, 0x8B, 0x07};          // mov rax, [rdi]
+    static const uint8_t mov_rax_rax_disp[] = {0x48, 0x8B, 0x80};     // mov rax, [rax + disp32]
+    static const uint8_t mov_rax_rdi_disp[] = {0x48, 0x8B, 0x87};     // mov rax, [rdi + disp32]
+    static const uint8_t mov_rdi_rdi_disp[] = {0x48, 0x8B, 0xBF};     // mov rdi, [rdi + disp32]
+    static const uint8_t cmp_rax_disp_imm[] = {0x81, 0xB8};           // cmp dword [rax + disp32], imm32
+    static const uint8_t jbe[] = {0x76};                              // jbe rel8
+    static const uint8_t jmp_rax_disp[] = {0xFF, 0xA0};               // jmp [rax + disp32]
+    static const uint8_t test_rax_jz[] = {0x48, 0x85, 0xC0, 0x74};    // test rax, rax; jz rel8
+    static const uint8_t jmp_rax[] = {0xFF, 0xE0};                    // jmp rax
+    static const uint8_t mov_esi[] = {0xBE};                          // mov esi, imm32
+    static const uint8_t movabs_rax[] = {0x48, 0xB8};                 // mov rax, imm64
+    size_t entry = LOADER_UNKNOWN_EXT_JIT_ENTRIES_OFFSET + (size_t)index * sizeof(void *);
+
+    if (entry > INT32_MAX) {
+        return false;
+    }
+
+    code = loaderUnknownExtJitEmit(code, endbr64, sizeof(endbr64));
+    switch (stub) {
+        case LOADER_UNKNOWN_EXT_STUB_DEV_TRAMP:
+            // Jump through the device's array, leaving the VkDevice as it is, or to vkDevExtError
+            // if the array doesn't reach index
+            code = loaderUnknownExtJitEmit(code, mov_rax_rdi, sizeof(mov_rax_rdi));
+            code = loaderUnknownExtJitEmit(code, mov_rax_rax_disp, sizeof(mov_rax_rax_disp));
+            code = loaderUnknownExtJitEmit32(code, (uint32_t)loaderUnknownExtJitArrayOffset(stub));
+            code = loaderUnknownExtJitEmit(code, cmp_rax_disp_imm, sizeof(cmp_rax_disp_imm));
+            code = loaderUnknownExtJitEmit32(code, (uint32_t)LOADER_UNKNOWN_EXT_JIT_CAPACITY_OFFSET);
+            code = loaderUnknownExtJitEmit32(code, index);
+            code = loaderUnknownExtJitEmit(code, jbe, sizeof(jbe));
+            *code++ = 6;
+            code = loaderUnknownExtJitEmit(code, jmp_rax_disp, sizeof(jmp_rax_disp));
+            code = loaderUnknownExtJitEmit32(code, (uint32_t)entry);
+            code = loaderUnknownExtJitEmit(code, movabs_rax, sizeof(movabs_rax));
+            code = loaderUnknownExtJitEmit64(code, (uint64_t)(uintptr_t)vkDevExtError);
+            loaderUnknownExtJitEmit(code, jmp_rax, sizeof(jmp_rax));
+            break;
+        case LOADER_UNKNOWN_EXT_STUB_PHYS_DEV_TRAMP:
+            // Jump through the instance's array with the physical device unwrapped.  The array
+            // always reaches the indices handed out for the instance.
+            code = loaderUnknownExtJitEmit(code, mov_rax_rdi, sizeof(mov_rax_rdi));
+            code = loaderUnknownExtJitEmit(code, mov_rdi_rdi_disp, sizeof(mov_rdi_rdi_disp));
+            code = loaderUnknownExtJitEmit32(code, (uint32_t)offsetof(struct loader_physical_device_tramp, phys_dev));
+            code = loaderUnknownExtJitEmit(code, mov_rax_rax_disp, sizeof(mov_rax_rax_disp));
+            code = loaderUnknownExtJitEmit32(code, (uint32_t)loaderUnknownExtJitArrayOffset(stub));
+            code = loaderUnknownExtJitEmit(code, jmp_rax_disp, sizeof(jmp_rax_disp));
+            loaderUnknownExtJitEmit32(code, (uint32_t)entry);
+            break;
+        case LOADER_UNKNOWN_EXT_STUB_PHYS_DEV_TERMIN:
+            // Jump to the ICD's function with the physical device unwrapped, or to the error if
+            // the ICD doesn't have one
+            code = loaderUnknownExtJitEmit(code, mov_rax_rdi_disp, sizeof(mov_rax_rdi_disp));
+            code = loaderUnknownExtJitEmit32(code, (uint32_t)offsetof(struct loader_physical_device_term, this_icd_term));
+            code = loaderUnknownExtJitEmit(code, mov_rax_rax_disp, sizeof(mov_rax_rax_disp));
+            code = loaderUnknownExtJitEmit32(code, (uint32_t)loaderUnknownExtJitArrayOffset(stub));
+            code = loaderUnknownExtJitEmit(code, cmp_rax_disp_imm, sizeof(cmp_rax_disp_imm));
+            code = loaderUnknownExtJitEmit32(code, (uint32_t)LOADER_UNKNOWN_EXT_JIT_CAPACITY_OFFSET);
+            code = loaderUnknownExtJitEmit32(code, index);
+            code = loaderUnknownExtJitEmit(code, jbe, sizeof(jbe));
+            *code++ = 21;
+            code = loaderUnknownExtJitEmit(code, mov_rax_rax_disp, sizeof(mov_rax_rax_disp));
+            code = loaderUnknownExtJitEmit32(code, (uint32_t)entry);
+            code = loaderUnknownExtJitEmit(code, test_rax_jz, sizeof(test_rax_jz));
+            *code++ = 9;
+            code = loaderUnknownExtJitEmit(code, mov_rdi_rdi_disp, sizeof(mov_rdi_rdi_disp));
+            code = loaderUnknownExtJitEmit32(code, (uint32_t)offsetof(struct loader_physical_device_term, phys_dev));
+            code = loaderUnknownExtJitEmit(code, jmp_rax, sizeof(jmp_rax));
+            code = loaderUnknownExtJitEmit(code, mov_esi, sizeof(mov_esi));
+            code = loaderUnknownExtJitEmit32(code, index);
+            code = loaderUnknownExtJitEmit(code, movabs_rax, sizeof(movabs_rax));
+            code = loaderUnknownExtJitEmit64(code, (uint64_t)(uintptr_t)loaderUnknownExtJitTerminError);
+            loaderUnknownExtJitEmit(code, jmp_rax, sizeof(jmp_rax));
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+#elif defined(__aarch64__)
+
+// ldr xt, [xn, #offset] and ldr wt, [xn, #offset] only take offsets that are a multiple of the
+// size loaded, below 4096 times it
+static bool loaderUnknownExtJitLdr(uint32_t *insn, uint32_t base, uint32_t size, uint32_t rt, uint32_t rn, size_t offset) {
+    if (0 != offset % size || offset / size >= 4096) {
+        return false;
+    }
+    *insn = base | ((uint32_t)(offset / size) << 10) | (rn << 5) | rt;
+    return true;
+}
+
+#define LOADER_ARM64_LDR_X(insn, rt, rn, offset) loaderUnknownExtJitLdr(insn, 0xF9400000, 8, rt, rn, offset)
+#define LOADER_ARM64_LDR_W(insn, rt, rn, offset) loaderUnknownExtJitLdr(insn, 0xB9400000, 4, rt, rn, offset)
+
+#define LOADER_ARM64_X0 0
+#define LOADER_ARM64_X1 1
+#define LOADER_ARM64_X9 9
+#define LOADER_ARM64_X16 16
+#define LOADER_ARM64_X17 17
+#define LOADER_ARM64_BR_X16 (0xD61F0000 | (LOADER_ARM64_X16 << 5))
+#define LOADER_ARM64_MOVZ_W17(imm) (0x52800000 | ((uint32_t)(imm) << 5) | LOADER_ARM64_X17)
+#define LOADER_ARM64_MOVK_W17_LSL16(imm) (0x72A00000 | ((uint32_t)(imm) << 5) | LOADER_ARM64_X17)
+#define LOADER_ARM64_CMP_W9_W17 (0x6B00001F | (LOADER_ARM64_X17 << 16) | (LOADER_ARM64_X9 << 5))
+#define LOADER_ARM64_B_LS(insns) (0x54000009 | ((uint32_t)(insns) << 5))
+#define LOADER_ARM64_CBZ_X16(insns) (0xB4000000 | ((uint32_t)(insns) << 5) | LOADER_ARM64_X16)
+#define LOADER_ARM64_ADD_X16_X17_LSL3 (0x8B000C00 | (LOADER_ARM64_X17 << 16) | (LOADER_ARM64_X16 << 5) | LOADER_ARM64_X16)
+#define LOADER_ARM64_MOV_W1_W17 (0x2A0003E0 | (LOADER_ARM64_X17 << 16) | LOADER_ARM64_X1)
+#define LOADER_ARM64_LDR_X16_LITERAL(insns) (0x58000000 | ((uint32_t)(insns) << 5) | LOADER_ARM64_X16)
+#define LOADER_ARM64_NOP 0xD503201F
+
+// The first parameter is in x0.  x16 and x17 are the scratch registers for branches between
+// modules, and x9 is free to use on entry to a function.  w17 holds the index, so the entry is
+// found with a register offset and there's no limit on the index.  The stubs that branch to an
+// error handler keep its address after their instructions, on an 8 byte boundary.
+static bool loaderUnknownExtJitWriteStub(enum loader_unknown_ext_stub stub, uint32_t index, uint8_t *code) {
+    uint32_t insns[LOADER_UNKNOWN_EXT_JIT_SLOT_SIZE / sizeof(uint32_t)];
+    uint32_t count = 0;
+    uint64_t error_addr;
+    bool valid = true;
+    size_t array_offset = loaderUnknownExtJitArrayOffset(stub);
+
+    switch (stub) {
+        case LOADER_UNKNOWN_EXT_STUB_DEV_TRAMP:
+            // Branch through the device's array, leaving the VkDevice as it is, or to
+            // vkDevExtError if the array doesn't reach index
+            error_addr = (uint64_t)(uintptr_t)vkDevExtError;
+            valid &= LOADER_ARM64_LDR_X(&insns[count++], LOADER_ARM64_X16, LOADER_ARM64_X0, 0);
+            valid &= LOADER_ARM64_LDR_X(&insns[count++], LOADER_ARM64_X16, LOADER_ARM64_X16, array_offset);
+            valid &= LOADER_ARM64_LDR_W(&insns[count++], LOADER_ARM64_X9, LOADER_ARM64_X16, LOADER_UNKNOWN_EXT_JIT_CAPACITY_OFFSET);
+            insns[count++] = LOADER_ARM64_MOVZ_W17(index & 0xFFFF);
+            insns[count++] = LOADER_ARM64_MOVK_W17_LSL16(index >> 16);
+            insns[count++] = LOADER_ARM64_CMP_W9_W17;
+            insns[count++] = LOADER_ARM64_B_LS(4);
+            insns[count++] = LOADER_ARM64_ADD_X16_X17_LSL3;
+            valid &= LOADER_ARM64_LDR_X(&insns[count++], LOADER_ARM64_X16, LOADER_ARM64_X16, LOADER_UNKNOWN_EXT_JIT_ENTRIES_OFFSET);
+            insns[count++] = LOADER_ARM64_BR_X16;
+            insns[count++] = LOADER_ARM64_LDR_X16_LITERAL(2);
+            insns[count++] = LOADER_ARM64_BR_X16;
+            break;
+        case LOADER_UNKNOWN_EXT_STUB_PHYS_DEV_TRAMP:
+            // Branch through the instance's array with the physical device unwrapped.  The array
+            // always reaches the indices handed out for the instance.
+            valid &= LOADER_ARM64_LDR_X(&insns[count++], LOADER_ARM64_X16, LOADER_ARM64_X0, 0);
+            valid &= LOADER_ARM64_LDR_X(&insns[count++], LOADER_ARM64_X0, LOADER_ARM64_X0,
+                                        offsetof(struct loader_physical_device_tramp, phys_dev));
+            valid &= LOADER_ARM64_LDR_X(&insns[count++], LOADER_ARM64_X16, LOADER_ARM64_X16, array_offset);
+            insns[count++] = LOADER_ARM64_MOVZ_W17(index & 0xFFFF);
+            insns[count++] = LOADER_ARM64_MOVK_W17_LSL16(index >> 16);
+            insns[count++] = LOADER_ARM64_ADD_X16_X17_LSL3;
+            valid &= LOADER_ARM64_LDR_X(&insns[count++], LOADER_ARM64_X16, LOADER_ARM64_X16, LOADER_UNKNOWN_EXT_JIT_ENTRIES_OFFSET);
+            insns[count++] = LOADER_ARM64_BR_X16;
+            memcpy(code, insns, count * sizeof(uint32_t));
+            return valid;
+        case LOADER_UNKNOWN_EXT_STUB_PHYS_DEV_TERMIN:
+            // Branch to the ICD's function with the physical device unwrapped, or to the error
+            // handler with the index in w1 if the ICD doesn't have one
+            error_addr = (uint64_t)(uintptr_t)loaderUnknownExtJitTerminError;
+            valid &= LOADER_ARM64_LDR_X(&insns[count++], LOADER_ARM64_X16, LOADER_ARM64_X0,
+                                        offsetof(struct loader_physical_device_term, this_icd_term));
+            valid &= LOADER_ARM64_LDR_X(&insns[count++], LOADER_ARM64_X16, LOADER_ARM64_X16, array_offset);
+            valid &= LOADER_ARM64_LDR_W(&insns[count++], LOADER_ARM64_X9, LOADER_ARM64_X16, LOADER_UNKNOWN_EXT_JIT_CAPACITY_OFFSET);
+            insns[count++] = LOADER_ARM64_MOVZ_W17(index & 0xFFFF);
+            insns[count++] = LOADER_ARM64_MOVK_W17_LSL16(index >> 16);
+            insns[count++] = LOADER_ARM64_CMP_W9_W17;
+            insns[count++] = LOADER_ARM64_B_LS(6);
+            insns[count++] = LOADER_ARM64_ADD_X16_X17_LSL3;
+            valid &= LOADER_ARM64_LDR_X(&insns[count++], LOADER_ARM64_X16, LOADER_ARM64_X16, LOADER_UNKNOWN_EXT_JIT_ENTRIES_OFFSET);
+            insns[count++] = LOADER_ARM64_CBZ_X16(3);
+            valid &= LOADER_ARM64_LDR_X(&insns[count++], LOADER_ARM64_X0, LOADER_ARM64_X0,
+                                        offsetof(struct loader_physical_device_term, phys_dev));
+            insns[count++] = LOADER_ARM64_BR_X16;
+            insns[count++] = LOADER_ARM64_MOV_W1_W17;
+            insns[count++] = LOADER_ARM64_LDR_X16_LITERAL(3);
+            insns[count++] = LOADER_ARM64_BR_X16;
+            break;
+        default:
+            return false;
+    }
+    if (0 != count % 2) {
+        insns[count++] = LOADER_ARM64_NOP;
+    }
+    memcpy(&insns[count], &error_addr, sizeof(error_addr));
+    count += 2;
+    memcpy(code, insns, count * sizeof(uint32_t));
+    return valid;
+}
+
+#endif
+
+// Writes and seals the chunk for stub and chunk_index.  Called with the lock held.
+static void *loaderUnknownExtJitCreateChunk(enum loader_unknown_ext_stub stub, uint32_t chunk_index) {
+    uint8_t *chunk = loader_platform_alloc_code_page(loader_unknown_ext_jit_chunk_size);
+    if (NULL == chunk) {
+        return NULL;
+    }
+
+    // Fill the gaps between stubs with instructions that trap.  On AArch64 the zeroed page already
+    // does, as zero is a permanently undefined instruction.
+#if defined(__x86_64__)
+    memset(chunk, 0xCC, loader_unknown_ext_jit_chunk_size);  // int3
+#endif
+    for (uint32_t slot = 0; slot < LOADER_UNKNOWN_EXT_JIT_CHUNK_SLOTS; slot++) {
+        uint32_t index = chunk_index * LOADER_UNKNOWN_EXT_JIT_CHUNK_SLOTS + slot;
+        if (!loaderUnknownExtJitWriteStub(stub, index, chunk + slot * LOADER_UNKNOWN_EXT_JIT_SLOT_SIZE)) {
+            goto fail;
+        }
+    }
+
+    __builtin___clear_cache((char *)chunk, (char *)chunk + loader_unknown_ext_jit_chunk_size);
+    if (!loader_platform_seal_code_page(chunk, loader_unknown_ext_jit_chunk_size)) {
+        goto fail;
+    }
+    return chunk;
+
+fail:
+    loader_platform_free_code_page(chunk, loader_unknown_ext_jit_chunk_size);
+    return NULL;
+}
+
+// Makes room for chunk_index in the chunks of stub.  Called with the lock held.
+static bool loaderUnknownExtJitReserveChunk(enum loader_unknown_ext_stub stub, uint32_t chunk_index) {
+    struct loader_unknown_ext_array *old_chunks = loader_unknown_ext_jit_chunks[stub];
+    struct loader_unknown_ext_array *new_chunks;
+    uint32_t capacity = old_chunks->capacity < LOADER_UNKNOWN_EXT_JIT_INITIAL_CHUNKS ? LOADER_UNKNOWN_EXT_JIT_INITIAL_CHUNKS
+                                                                                      : old_chunks->capacity;
+
+    if (chunk_index < old_chunks->capacity) {
+        return true;
+    }
+    while (capacity <= chunk_index) {
+        capacity *= 2;
+    }
+    new_chunks = loader_instance_heap_alloc(NULL, sizeof(struct loader_unknown_ext_array) + capacity * sizeof(void *),
+                                            VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (NULL == new_chunks) {
+        return false;
+    }
+    new_chunks->capacity = capacity;
+    for (uint32_t i = 0; i < capacity; i++) {
+        new_chunks->entries[i] = i < old_chunks->capacity ? old_chunks->entries[i] : NULL;
+    }
+    new_chunks->retired = old_chunks;
+    loader_platform_atomic_store_ptr((void **)&loader_unknown_ext_jit_chunks[stub], new_chunks);
+    return true;
+}
+
+// Returns the written stub for index, or NULL if it couldn't be written
+static void *loaderUnknownExtJitGetStub(enum loader_unknown_ext_stub stub, uint32_t index) {
+    uint32_t chunk_index = index / LOADER_UNKNOWN_EXT_JIT_CHUNK_SLOTS;
+    uint32_t slot = index % LOADER_UNKNOWN_EXT_JIT_CHUNK_SLOTS;
+    struct loader_unknown_ext_array *chunks = loader_platform_atomic_load_ptr((void *const *)&loader_unknown_ext_jit_chunks[stub]);
+    uint8_t *chunk = NULL;
+
+    if (chunk_index < chunks->capacity) {
+        chunk = loader_platform_atomic_load_ptr(&chunks->entries[chunk_index]);
+        if (NULL != chunk) {
+            return chunk + slot * LOADER_UNKNOWN_EXT_JIT_SLOT_SIZE;
+        }
+    }
+
+    loader_platform_thread_lock_mutex(&loader_unknown_ext_jit_lock);
+    if (!loader_unknown_ext_jit_disabled && loaderUnknownExtJitReserveChunk(stub, chunk_index)) {
+        chunks = loader_unknown_ext_jit_chunks[stub];
+        chunk = chunks->entries[chunk_index];
+        if (NULL == chunk) {
+            chunk = loaderUnknownExtJitCreateChunk(stub, chunk_index);
+            if (NULL == chunk) {
+                loader_log(NULL, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                           "loaderUnknownExtJitGetStub: Couldn't write trampolines for unknown functions, so none can be used");
+                loader_unknown_ext_jit_disabled = true;
+            } else {
+                loader_platform_atomic_store_ptr(&chunks->entries[chunk_index], chunk);
+            }
+        }
+    }
+    loader_platform_thread_unlock_mutex(&loader_unknown_ext_jit_lock);
+
+    return NULL == chunk ? NULL : chunk + slot * LOADER_UNKNOWN_EXT_JIT_SLOT_SIZE;
+}
+
+void loaderUnknownExtJitInit(void) {
+    size_t page_size = loader_platform_page_size();
+    size_t stub_bytes = LOADER_UNKNOWN_EXT_JIT_SLOT_SIZE * LOADER_UNKNOWN_EXT_JIT_CHUNK_SLOTS;
+
+    loader_platform_thread_create_mutex(&loader_unknown_ext_jit_lock);
+    for (uint32_t stub = 0; stub < LOADER_UNKNOWN_EXT_STUB_COUNT; stub++) {
+        loader_unknown_ext_jit_chunks[stub] = (struct loader_unknown_ext_array *)&loader_unknown_ext_array_empty;
+    }
+    loader_unknown_ext_jit_disabled = (0 == page_size);
+    if (!loader_unknown_ext_jit_disabled) {
+        loader_unknown_ext_jit_chunk_size = (stub_bytes + page_size - 1) / page_size * page_size;
+    }
+}
+
+void loaderUnknownExtJitRelease(void) {
+    for (uint32_t stub = 0; stub < LOADER_UNKNOWN_EXT_STUB_COUNT; stub++) {
+        struct loader_unknown_ext_array *chunks = loader_unknown_ext_jit_chunks[stub];
+        for (uint32_t chunk = 0; chunk < chunks->capacity; chunk++) {
+            if (NULL != chunks->entries[chunk]) {
+                loader_platform_free_code_page(chunks->entries[chunk], loader_unknown_ext_jit_chunk_size);
+            }
+        }
+        while (&loader_unknown_ext_array_empty != chunks) {
+            struct loader_unknown_ext_array *retired = chunks->retired;
+            loader_instance_heap_free(NULL, chunks);
+            chunks = retired;
+        }
+        loader_unknown_ext_jit_chunks[stub] = (struct loader_unknown_ext_array *)&loader_unknown_ext_array_empty;
+    }
+    loader_platform_thread_delete_mutex(&loader_unknown_ext_jit_lock);
+}
+
+void *loaderUnknownExtDevTramp(uint32_t index) { return loaderUnknownExtJitGetStub(LOADER_UNKNOWN_EXT_STUB_DEV_TRAMP, index); }
+
+void *loaderUnknownExtPhysDevTramp(uint32_t index) {
+    return loaderUnknownExtJitGetStub(LOADER_UNKNOWN_EXT_STUB_PHYS_DEV_TRAMP, index);
+}
+
+void *loaderUnknownExtPhysDevTermin(uint32_t index) {
+    return loaderUnknownExtJitGetStub(LOADER_UNKNOWN_EXT_STUB_PHYS_DEV_TERMIN, index);
+}
+
+#else  // !LOADER_UNKNOWN_EXT_JIT
+
+void loaderUnknownExtJitInit(void) {}
+
+void loaderUnknownExtJitRelease(void) {}
+
+void *loaderUnknownExtDevTramp(uint32_t index) { return loader_get_dev_ext_trampoline(index); }
+
+void *loaderUnknownExtPhysDevTramp(uint32_t index) { return loader_get_phys_dev_ext_tramp(index); }
+
+void *loaderUnknownExtPhysDevTermin(uint32_t index) { return loader_get_phys_dev_ext_termin(index); }
+
+#endif  // LOADER_UNKNOWN_EXT_JIT
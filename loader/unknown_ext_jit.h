@@ -0,0 +1,51 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LOADER_UNKNOWN_EXT_JIT_H
+#define LOADER_UNKNOWN_EXT_JIT_H
+
+#include <stdint.h>
+
+// Trampolines and terminators for functions unknown to the loader, written at runtime.
+//
+// On x86-64 and AArch64 Linux, where LOADER_UNKNOWN_EXT_JIT is defined, the stubs for unknown
+// device and physical device functions are written into pages of their own the first time an
+// index in the page is handed out.  The built in ones in dev_ext_trampoline.c, phys_dev_ext.c and
+// unknown_ext_chain* aren't compiled there.  The stubs jump through loader_unknown_ext_arrays, which
+// grow as functions are added, so there is no limit on the number of unknown functions.  The
+// device trampolines and the terminators check the array reaches their index, since a device or
+// ICD's array only grows when one of its entries is set.
+//
+// Pages are written and then made executable, never both at once.  If the system's W^X policy
+// doesn't allow that, no unknown functions can be returned from then on, and the functions below
+// return NULL.  The stubs live until the loader is unloaded.
+//
+// Everywhere else these return the built in stubs.
+
+// Called from loader_initialize and loader_release
+void loaderUnknownExtJitInit(void);
+void loaderUnknownExtJitRelease(void);
+
+// Return the stub for index
+void *loaderUnknownExtDevTramp(uint32_t index);
+void *loaderUnknownExtPhysDevTramp(uint32_t index);
+void *loaderUnknownExtPhysDevTermin(uint32_t index);
+
+#endif  // LOADER_UNKNOWN_EXT_JIT_H
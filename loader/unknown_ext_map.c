@@ -0,0 +1,270 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string.h>
+
+#include "vk_loader_platform.h"
+#include "loader.h"
+#include "instance_arena.h"
+#include "murmurhash.h"
+#include "unknown_ext_map.h"
+
+// Must be a power of two
+#define LOADER_UNKNOWN_EXT_MAP_INITIAL_CAPACITY 32
+
+#define LOADER_UNKNOWN_EXT_ARRAY_INITIAL_CAPACITY 16
+
+static struct loader_unknown_ext_table *loaderUnknownExtTableCreate(const struct loader_instance *inst, uint32_t capacity) {
+    size_t size = sizeof(struct loader_unknown_ext_table) + capacity * sizeof(struct loader_unknown_ext_entry *);
+    struct loader_unknown_ext_table *table = loaderInstanceArenaAlloc(inst, size);
+    if (NULL == table) {
+        return NULL;
+    }
+    memset(table, 0, size);
+    table->capacity = capacity;
+    table->slots = (struct loader_unknown_ext_entry **)(table + 1);
+    return table;
+}
+
+static struct loader_unknown_ext_entry *loaderUnknownExtTableLoad(const struct loader_unknown_ext_table *table, uint32_t slot) {
+    return loader_platform_atomic_load_ptr((void *const *)&table->slots[slot]);
+}
+
+// Linear probe for func_name.  Returns the entry, or NULL with *empty_slot set to the slot it
+// would go in.
+static struct loader_unknown_ext_entry *loaderUnknownExtTableProbe(const struct loader_unknown_ext_table *table,
+                                                                   const char *func_name, uint32_t hash, uint32_t *empty_slot) {
+    uint32_t mask = table->capacity - 1;
+    for (uint32_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        struct loader_unknown_ext_entry *entry = loaderUnknownExtTableLoad(table, slot);
+        if (NULL == entry) {
+            if (NULL != empty_slot) {
+                *empty_slot = slot;
+            }
+            return NULL;
+        }
+        if (entry->hash == hash && !strcmp(entry->func_name, func_name)) {
+            return entry;
+        }
+    }
+}
+
+void loaderUnknownExtMapInit(struct loader_unknown_ext_map *map) {
+    memset(map, 0, sizeof(*map));
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+    map->func_names = (struct loader_unknown_ext_array *)&loader_unknown_ext_array_empty;
+#endif
+    loader_platform_thread_create_mutex(&map->lock);
+}
+
+void loaderUnknownExtMapDestroy(const struct loader_instance *inst, struct loader_unknown_ext_map *map) {
+    // The tables and entries are in the instance's arena
+    (void)inst;
+    loader_platform_thread_delete_mutex(&map->lock);
+    memset(map, 0, sizeof(*map));
+}
+
+bool loaderUnknownExtMapFind(const struct loader_unknown_ext_map *map, const char *func_name, uint32_t *index) {
+    const struct loader_unknown_ext_table *table = loader_platform_atomic_load_ptr((void *const *)&map->table);
+    if (NULL == table) {
+        return false;
+    }
+    const struct loader_unknown_ext_entry *entry =
+        loaderUnknownExtTableProbe(table, func_name, murmurhash(func_name, strlen(func_name), 0), NULL);
+    if (NULL == entry) {
+        return false;
+    }
+    *index = entry->index;
+    return true;
+}
+
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+
+const struct loader_unknown_ext_array loader_unknown_ext_array_empty = {NULL, 0};
+
+VkResult loaderUnknownExtArrayReserve(const struct loader_instance *inst, const struct loader_device *dev,
+                                      struct loader_unknown_ext_array **array, uint32_t index, void *fill) {
+    struct loader_unknown_ext_array *old_array = *array;
+    struct loader_unknown_ext_array *new_array;
+    uint32_t capacity;
+    size_t size;
+
+    if (index < old_array->capacity) {
+        return VK_SUCCESS;
+    }
+    if (index >= UINT32_MAX / 2) {
+        return VK_ERROR_TOO_MANY_OBJECTS;
+    }
+    capacity = old_array->capacity < LOADER_UNKNOWN_EXT_ARRAY_INITIAL_CAPACITY ? LOADER_UNKNOWN_EXT_ARRAY_INITIAL_CAPACITY
+                                                                                : old_array->capacity * 2;
+    while (capacity <= index) {
+        capacity *= 2;
+    }
+
+    size = sizeof(struct loader_unknown_ext_array) + capacity * sizeof(void *);
+    if (NULL == dev) {
+        new_array = loaderInstanceArenaAlloc(inst, size);
+    } else {
+        new_array = loader_device_heap_alloc(dev, size, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE);
+    }
+    if (NULL == new_array) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    new_array->capacity = capacity;
+    for (uint32_t i = 0; i < capacity; i++) {
+        new_array->entries[i] = i < old_array->capacity ? old_array->entries[i] : fill;
+    }
+
+    // Trampolines may still be reading the old array, so it is only retired.  The empty array
+    // isn't retired because it was never allocated.
+    new_array->retired = old_array != &loader_unknown_ext_array_empty ? old_array : NULL;
+    loader_platform_atomic_store_ptr((void **)array, new_array);
+    return VK_SUCCESS;
+}
+
+void loaderUnknownExtArrayFree(const struct loader_device *dev, struct loader_unknown_ext_array *array) {
+    while (NULL != array && &loader_unknown_ext_array_empty != array) {
+        struct loader_unknown_ext_array *retired = array->retired;
+        loader_device_heap_free(dev, array);
+        array = retired;
+    }
+}
+
+const char *loaderUnknownExtMapName(const struct loader_unknown_ext_map *map, uint32_t index) {
+    const struct loader_unknown_ext_array *func_names = loader_platform_atomic_load_ptr((void *const *)&map->func_names);
+    if (index >= func_names->capacity) {
+        return NULL;
+    }
+    return loader_platform_atomic_load_ptr((void *const *)&func_names->entries[index]);
+}
+
+#else  // !LOADER_UNKNOWN_EXT_JIT
+
+const char *loaderUnknownExtMapName(const struct loader_unknown_ext_map *map, uint32_t index) {
+    if (index >= MAX_NUM_UNKNOWN_EXTS) {
+        return NULL;
+    }
+    return loader_platform_atomic_load_ptr((void *const *)&map->func_names[index]);
+}
+
+#endif  // LOADER_UNKNOWN_EXT_JIT
+
+// Copies the entries into a table twice the size and publishes it.  Must be called with the map's
+// lock held.
+static VkResult loaderUnknownExtMapGrow(const struct loader_instance *inst, struct loader_unknown_ext_map *map) {
+    struct loader_unknown_ext_table *old_table = map->table;
+    uint32_t capacity = NULL == old_table ? LOADER_UNKNOWN_EXT_MAP_INITIAL_CAPACITY : old_table->capacity * 2;
+    struct loader_unknown_ext_table *new_table = loaderUnknownExtTableCreate(inst, capacity);
+    if (NULL == new_table) {
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    if (NULL != old_table) {
+        for (uint32_t slot = 0; slot < old_table->capacity; slot++) {
+            struct loader_unknown_ext_entry *entry = old_table->slots[slot];
+            if (NULL != entry) {
+                uint32_t new_slot;
+                loaderUnknownExtTableProbe(new_table, entry->func_name, entry->hash, &new_slot);
+                new_table->slots[new_slot] = entry;
+            }
+        }
+        // Readers may still be probing the old table.  It is in the instance's arena, so it stays
+        // there until the instance is destroyed.
+    }
+
+    loader_platform_atomic_store_ptr((void **)&map->table, new_table);
+    return VK_SUCCESS;
+}
+
+VkResult loaderUnknownExtMapAdd(const struct loader_instance *inst, struct loader_unknown_ext_map *map, const char *func_name,
+                                uint32_t *index, bool *added) {
+    VkResult res = VK_SUCCESS;
+    size_t name_size = strlen(func_name) + 1;
+    uint32_t hash = murmurhash(func_name, name_size - 1, 0);
+    uint32_t slot;
+    struct loader_unknown_ext_entry *entry;
+
+    *added = false;
+    loader_platform_thread_lock_mutex(&map->lock);
+
+    // Another thread may have added the name since the caller last looked
+    if (NULL != map->table) {
+        entry = loaderUnknownExtTableProbe(map->table, func_name, hash, NULL);
+        if (NULL != entry) {
+            *index = entry->index;
+            goto out;
+        }
+    }
+
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+    res = loaderUnknownExtArrayReserve(inst, NULL, &map->func_names, map->count, NULL);
+    if (VK_SUCCESS != res) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "loaderUnknownExtMapAdd: Failed to grow the name array for %s",
+                   func_name);
+        goto out;
+    }
+#else
+    if (map->count >= MAX_NUM_UNKNOWN_EXTS) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                   "loaderUnknownExtMapAdd: All %d trampolines for unknown functions are in use, so %s can't be returned",
+                   (int)MAX_NUM_UNKNOWN_EXTS, func_name);
+        res = VK_ERROR_TOO_MANY_OBJECTS;
+        goto out;
+    }
+#endif
+
+    // Keep the load factor at or below 3/4 so probes stay short
+    if (NULL == map->table || (map->count + 1) * 4 > map->table->capacity * 3) {
+        res = loaderUnknownExtMapGrow(inst, map);
+        if (VK_SUCCESS != res) {
+            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "loaderUnknownExtMapAdd: Failed to grow the table for %s",
+                       func_name);
+            goto out;
+        }
+    }
+
+    entry = loaderInstanceArenaAlloc(inst, sizeof(struct loader_unknown_ext_entry) + name_size);
+    if (NULL == entry) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0, "loaderUnknownExtMapAdd: Failed to allocate memory for %s", func_name);
+        res = VK_ERROR_OUT_OF_HOST_MEMORY;
+        goto out;
+    }
+    entry->hash = hash;
+    entry->index = map->count;
+    entry->func_name = (char *)(entry + 1);
+    memcpy(entry->func_name, func_name, name_size);
+
+    // Publish the name before the entry, so anyone who finds the entry can also find its name
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+    loader_platform_atomic_store_ptr(&map->func_names->entries[entry->index], entry->func_name);
+#else
+    loader_platform_atomic_store_ptr((void **)&map->func_names[entry->index], entry->func_name);
+#endif
+    loaderUnknownExtTableProbe(map->table, func_name, hash, &slot);
+    loader_platform_atomic_store_ptr((void **)&map->table->slots[slot], entry);
+    map->count++;
+
+    *index = entry->index;
+    *added = true;
+
+out:
+    loader_platform_thread_unlock_mutex(&map->lock);
+    return res;
+}
@@ -0,0 +1,74 @@
+/*
+ *
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LOADER_UNKNOWN_EXT_MAP_H
+#define LOADER_UNKNOWN_EXT_MAP_H
+
+#include "loader.h"
+
+// Per-instance maps from the names of unknown device and physical device functions to the index of
+// the dispatch slot and trampoline the loader handed out for them.
+//
+// Applications look these names up from any thread, so finding a name takes no lock: the table
+// pointer and every slot are published with release stores and read with acquire loads.  Adding a
+// name takes the map's mutex.  When the table fills past three quarters it is copied into one twice
+// the size.  Tables and entries come from the instance's arena, so the old table stays there,
+// unmodified, until the instance is destroyed and a reader still probing it never sees freed memory.
+//
+// Indices are allocated in the order names are added.  Where the trampolines are written at
+// runtime there is no limit on them, and the names by index are kept in a loader_unknown_ext_array.
+// Elsewhere they are limited by the number of built in trampolines, MAX_NUM_UNKNOWN_EXTS.  The
+// table itself has no fixed size.
+
+void loaderUnknownExtMapInit(struct loader_unknown_ext_map *map);
+void loaderUnknownExtMapDestroy(const struct loader_instance *inst, struct loader_unknown_ext_map *map);
+
+// Returns true and sets *index if func_name is in the map.  Takes no lock.
+bool loaderUnknownExtMapFind(const struct loader_unknown_ext_map *map, const char *func_name, uint32_t *index);
+
+// Adds func_name if it isn't already in the map and sets *index to its index.  *added is set to
+// false if another thread added the name first.  Where the trampolines are built in, fails with
+// VK_ERROR_TOO_MANY_OBJECTS once all MAX_NUM_UNKNOWN_EXTS of them are in use; the map itself has no
+// limit, and where the trampolines are written at runtime neither does the index.
+VkResult loaderUnknownExtMapAdd(const struct loader_instance *inst, struct loader_unknown_ext_map *map, const char *func_name,
+                                uint32_t *index, bool *added);
+
+// Returns the name at index, or NULL if the index hasn't been allocated.  Takes no lock.  Indices are
+// allocated in order, so callers can walk the map by counting up until this returns NULL.
+const char *loaderUnknownExtMapName(const struct loader_unknown_ext_map *map, uint32_t index);
+
+#if defined(LOADER_UNKNOWN_EXT_JIT)
+
+// What arrays start out pointing to, so the trampolines never find a NULL array
+extern const struct loader_unknown_ext_array loader_unknown_ext_array_empty;
+
+// Makes sure *array has an entry at index.  If it doesn't, it is copied into a bigger array, with
+// the new entries set to fill, which is published with a release store.  The copy comes from the
+// instance's arena when dev is NULL and from the device's allocator otherwise.  Callers serialize
+// changes to the same array.
+VkResult loaderUnknownExtArrayReserve(const struct loader_instance *inst, const struct loader_device *dev,
+                                      struct loader_unknown_ext_array **array, uint32_t index, void *fill);
+
+// Frees a device's array and the ones it replaced
+void loaderUnknownExtArrayFree(const struct loader_device *dev, struct loader_unknown_ext_array *array);
+
+#endif  // LOADER_UNKNOWN_EXT_JIT
+
+#endif  // LOADER_UNKNOWN_EXT_MAP_H
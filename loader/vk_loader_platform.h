@@ -48,6 +48,8 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <libgen.h>
+#include <time.h>
+#include <sys/mman.h>
 
 // VK Library Filenames, Paths, etc.:
 #define PATH_SEPARATOR ':'
@@ -100,6 +102,19 @@ static inline bool loader_platform_is_path_absolute(const char *path) {
 
 static inline char *loader_platform_dirname(char *path) { return dirname(path); }
 
+// Pages for code the loader writes at runtime.  A page is mapped writable, filled in, and then
+// sealed, which makes it executable and read-only, so it is never writable and executable at once.
+// Sealing fails where the system's W^X policy forbids making written memory executable.
+static inline size_t loader_platform_page_size(void) { return (size_t)sysconf(_SC_PAGESIZE); }
+static inline void *loader_platform_alloc_code_page(size_t size) {
+    void *page = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return MAP_FAILED == page ? NULL : page;
+}
+static inline bool loader_platform_seal_code_page(void *page, size_t size) {
+    return 0 == mprotect(page, size, PROT_READ | PROT_EXEC);
+}
+static inline void loader_platform_free_code_page(void *page, size_t size) { munmap(page, size); }
+
 // Dynamic Loading of libraries:
 typedef void *loader_platform_dl_handle;
 static inline loader_platform_dl_handle loader_platform_open_library(const char *libPath) {
@@ -144,6 +159,49 @@ static inline void loader_platform_thread_cond_wait(loader_platform_thread_cond
 }
 static inline void loader_platform_thread_cond_broadcast(loader_platform_thread_cond *pCond) { pthread_cond_broadcast(pCond); }
 
+// Thread reader/writer lock:
+typedef pthread_rwlock_t loader_platform_thread_rwlock;
+static inline void loader_platform_thread_create_rwlock(loader_platform_thread_rwlock *pLock) { pthread_rwlock_init(pLock, NULL); }
+static inline void loader_platform_thread_read_lock_rwlock(loader_platform_thread_rwlock *pLock) { pthread_rwlock_rdlock(pLock); }
+static inline void loader_platform_thread_read_unlock_rwlock(loader_platform_thread_rwlock *pLock) { pthread_rwlock_unlock(pLock); }
+static inline void loader_platform_thread_write_lock_rwlock(loader_platform_thread_rwlock *pLock) { pthread_rwlock_wrlock(pLock); }
+static inline void loader_platform_thread_write_unlock_rwlock(loader_platform_thread_rwlock *pLock) { pthread_rwlock_unlock(pLock); }
+static inline void loader_platform_thread_delete_rwlock(loader_platform_thread_rwlock *pLock) { pthread_rwlock_destroy(pLock); }
+
+// Atomic pointer access, for data that is read without holding a lock:
+static inline void *loader_platform_atomic_load_ptr(void *const *ptr) { return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+static inline void loader_platform_atomic_store_ptr(void **ptr, void *value) { __atomic_store_n(ptr, value, __ATOMIC_RELEASE); }
+static inline uint32_t loader_platform_atomic_load_u32(const volatile uint32_t *ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+}
+static inline void loader_platform_atomic_store_u32(volatile uint32_t *ptr, uint32_t value) {
+    __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST);
+}
+static inline uint32_t loader_platform_atomic_fetch_add_u32(volatile uint32_t *ptr, uint32_t value) {
+    return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+}
+static inline bool loader_platform_atomic_compare_exchange_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired) {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+static inline bool loader_platform_atomic_compare_exchange_ptr(void **ptr, void *expected, void *desired) {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+// Threads:
+typedef pthread_t loader_platform_thread;
+#define LOADER_PLATFORM_THREAD_PROC(name, arg) void *name(void *arg)
+static inline bool loader_platform_thread_create(loader_platform_thread *pThread, void *(*proc)(void *), void *arg) {
+    return 0 == pthread_create(pThread, NULL, proc, arg);
+}
+static inline void loader_platform_thread_join(loader_platform_thread thread) { pthread_join(thread, NULL); }
+
+// Monotonic time in nanoseconds, for timestamps:
+static inline uint64_t loader_platform_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
 #define loader_stack_alloc(size) alloca(size)
 
 #elif defined(_WIN32)  // defined(__linux__)
@@ -279,6 +337,23 @@ static inline char *loader_platform_dirname(char *path) {
     return path;
 }
 
+// __declspec(thread) is not supported by MinGW compiler (ignored with warning or
+//                    cause error depending on compiler switches)
+//
+// __thread should be used instead
+//
+// __MINGW32__ defined for both 32 and 64 bit MinGW compilers, so it is enough to
+// detect any (32 or 64) flavor of MinGW compiler.
+//
+// @note __GNUC__ could be used as a more generic way to detect _any_
+//       GCC[-compatible] compiler on Windows, but this fix was tested
+//       only with MinGW, so keep it explicit at the moment.
+#if defined(__MINGW32__)
+#define THREAD_LOCAL_DECL __thread
+#else
+#define THREAD_LOCAL_DECL __declspec(thread)
+#endif
+
 // Dynamic Loading:
 typedef HMODULE loader_platform_dl_handle;
 static loader_platform_dl_handle loader_platform_open_library(const char *lib_path) {
@@ -291,7 +366,8 @@ static loader_platform_dl_handle loader_platform_open_library(const char *lib_pa
     return lib_handle;
 }
 static char *loader_platform_open_library_error(const char *libPath) {
-    static char errorMsg[164];
+    // Instances may be created on several threads at once
+    static THREAD_LOCAL_DECL char errorMsg[164];
     (void)snprintf(errorMsg, 163, "Failed to open dynamic library \"%s\" with error %lu", libPath, GetLastError());
     return errorMsg;
 }
@@ -310,23 +386,6 @@ static char *loader_platform_get_proc_address_error(const char *name) {
 // Threads:
 typedef HANDLE loader_platform_thread;
 
-// __declspec(thread) is not supported by MinGW compiler (ignored with warning or
-//                    cause error depending on compiler switches)
-//
-// __thread should be used instead
-//
-// __MINGW32__ defined for both 32 and 64 bit MinGW compilers, so it is enough to
-// detect any (32 or 64) flavor of MinGW compiler.
-//
-// @note __GNUC__ could be used as a more generic way to detect _any_
-//       GCC[-compatible] compiler on Windows, but this fix was tested
-//       only with MinGW, so keep it explicit at the moment.
-#if defined(__MINGW32__)
-#define THREAD_LOCAL_DECL __thread
-#else
-#define THREAD_LOCAL_DECL __declspec(thread)
-#endif
-
 // The once init functionality is not used when building a DLL on Windows. This is because there is no way to clean up the
 // resources allocated by anything allocated by once init. This isn't a problem for static libraries, but it is for dynamic
 // ones. When building a DLL, we use DllMain() instead to allow properly cleaning up resources.
@@ -351,6 +410,57 @@ static void loader_platform_thread_cond_wait(loader_platform_thread_cond *pCond,
 }
 static void loader_platform_thread_cond_broadcast(loader_platform_thread_cond *pCond) { WakeAllConditionVariable(pCond); }
 
+// Thread reader/writer lock:
+typedef SRWLOCK loader_platform_thread_rwlock;
+static void loader_platform_thread_create_rwlock(loader_platform_thread_rwlock *pLock) { InitializeSRWLock(pLock); }
+static void loader_platform_thread_read_lock_rwlock(loader_platform_thread_rwlock *pLock) { AcquireSRWLockShared(pLock); }
+static void loader_platform_thread_read_unlock_rwlock(loader_platform_thread_rwlock *pLock) { ReleaseSRWLockShared(pLock); }
+static void loader_platform_thread_write_lock_rwlock(loader_platform_thread_rwlock *pLock) { AcquireSRWLockExclusive(pLock); }
+static void loader_platform_thread_write_unlock_rwlock(loader_platform_thread_rwlock *pLock) { ReleaseSRWLockExclusive(pLock); }
+// SRW locks hold no resources
+static void loader_platform_thread_delete_rwlock(loader_platform_thread_rwlock *pLock) { (void)pLock; }
+
+// Atomic pointer access, for data that is read without holding a lock:
+static void *loader_platform_atomic_load_ptr(void *const *ptr) {
+    return InterlockedCompareExchangePointer((PVOID volatile *)ptr, NULL, NULL);
+}
+static void loader_platform_atomic_store_ptr(void **ptr, void *value) { InterlockedExchangePointer((PVOID volatile *)ptr, value); }
+static uint32_t loader_platform_atomic_load_u32(const volatile uint32_t *ptr) {
+    return (uint32_t)InterlockedCompareExchange((LONG volatile *)ptr, 0, 0);
+}
+static void loader_platform_atomic_store_u32(volatile uint32_t *ptr, uint32_t value) {
+    InterlockedExchange((LONG volatile *)ptr, (LONG)value);
+}
+static uint32_t loader_platform_atomic_fetch_add_u32(volatile uint32_t *ptr, uint32_t value) {
+    return (uint32_t)InterlockedExchangeAdd((LONG volatile *)ptr, (LONG)value);
+}
+static bool loader_platform_atomic_compare_exchange_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired) {
+    return (uint32_t)InterlockedCompareExchange((LONG volatile *)ptr, (LONG)desired, (LONG)expected) == expected;
+}
+static bool loader_platform_atomic_compare_exchange_ptr(void **ptr, void *expected, void *desired) {
+    return InterlockedCompareExchangePointer((PVOID volatile *)ptr, desired, expected) == expected;
+}
+
+// Threads:
+typedef HANDLE loader_platform_thread;
+#define LOADER_PLATFORM_THREAD_PROC(name, arg) DWORD WINAPI name(LPVOID arg)
+static bool loader_platform_thread_create(loader_platform_thread *pThread, LPTHREAD_START_ROUTINE proc, void *arg) {
+    *pThread = CreateThread(NULL, 0, proc, arg, 0, NULL);
+    return NULL != *pThread;
+}
+static void loader_platform_thread_join(loader_platform_thread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+// Monotonic time in nanoseconds, for timestamps:
+static uint64_t loader_platform_time_ns(void) {
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+}
+
 #define loader_stack_alloc(size) _alloca(size)
 #else  // defined(_WIN32)
 
@@ -158,6 +158,173 @@ bool wsi_unsupported_instance_extension(const VkExtensionProperties *ext_prop) {
     return false;
 }
 
+// Surface query cache
+//
+// Applications that recreate their swapchain in a loop tend to ask for the surface's formats and
+// present modes each time, with both calls of the count and data pattern.  With
+// VK_LOADER_SURFACE_QUERY_CACHE set, the loader asks the ICD once per surface and physical device
+// and answers both calls from what it kept until the surface is destroyed.  Surface capabilities
+// change with the window's size, so they are always passed down.
+
+enum loader_surface_query {
+    LOADER_SURFACE_QUERY_FORMATS,
+    LOADER_SURFACE_QUERY_PRESENT_MODES,
+    LOADER_SURFACE_QUERY_COUNT,
+};
+
+struct loader_surface_query_cache {
+    struct loader_surface_query_cache *next;
+    struct loader_physical_device_term *phys_dev_term;
+    struct {
+        bool valid;
+        uint32_t count;
+        void *results;
+    } queries[LOADER_SURFACE_QUERY_COUNT];
+};
+
+static const size_t loader_surface_query_result_size[LOADER_SURFACE_QUERY_COUNT] = {
+    sizeof(VkSurfaceFormatKHR),
+    sizeof(VkPresentModeKHR),
+};
+
+static VkResult wsi_call_surface_query(enum loader_surface_query query, struct loader_physical_device_term *phys_dev_term,
+                                       VkSurfaceKHR surface, uint32_t *pCount, void *pResults) {
+    struct loader_icd_term *icd_term = phys_dev_term->this_icd_term;
+    switch (query) {
+        case LOADER_SURFACE_QUERY_FORMATS:
+            return icd_term->dispatch.GetPhysicalDeviceSurfaceFormatsKHR(phys_dev_term->phys_dev, surface, pCount,
+                                                                         (VkSurfaceFormatKHR *)pResults);
+        case LOADER_SURFACE_QUERY_PRESENT_MODES:
+            return icd_term->dispatch.GetPhysicalDeviceSurfacePresentModesKHR(phys_dev_term->phys_dev, surface, pCount,
+                                                                              (VkPresentModeKHR *)pResults);
+        default:
+            assert(false && "wsi_call_surface_query: unknown query");
+            return VK_ERROR_INITIALIZATION_FAILED;
+    }
+}
+
+// Makes the count and data calls of a query and keeps the results in entry.  Asks again if the
+// results grew between the two calls.
+static VkResult wsi_fill_surface_query_cache(const struct loader_instance *inst, struct loader_surface_query_cache *entry,
+                                             enum loader_surface_query query, VkSurfaceKHR surface) {
+    void *results = NULL;
+    uint32_t count;
+    VkResult res;
+
+    do {
+        loader_instance_heap_free(inst, results);
+        results = NULL;
+
+        res = wsi_call_surface_query(query, entry->phys_dev_term, surface, &count, NULL);
+        if (VK_SUCCESS != res) {
+            goto out;
+        }
+        if (0 != count) {
+            results = loader_instance_heap_alloc(inst, count * loader_surface_query_result_size[query],
+                                                 VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+            if (NULL == results) {
+                res = VK_ERROR_OUT_OF_HOST_MEMORY;
+                goto out;
+            }
+        }
+        res = wsi_call_surface_query(query, entry->phys_dev_term, surface, &count, results);
+    } while (VK_INCOMPLETE == res);
+
+    if (VK_SUCCESS == res) {
+        entry->queries[query].valid = true;
+        entry->queries[query].count = count;
+        entry->queries[query].results = results;
+        results = NULL;
+    }
+
+out:
+    loader_instance_heap_free(inst, results);
+    return res;
+}
+
+// Answers a format or present mode query for icd_surface from its cache, asking the ICD first if
+// this is the first time the query is made for the physical device.  surface is the handle to pass
+// the ICD.  Returns false if the query has to be passed down as usual.
+static bool wsi_cached_surface_query(struct loader_physical_device_term *phys_dev_term, VkIcdSurface *icd_surface,
+                                     VkSurfaceKHR surface, enum loader_surface_query query, uint32_t *pCount, void *pResults,
+                                     VkResult *pResult) {
+    const struct loader_instance *inst = phys_dev_term->this_icd_term->this_instance;
+    struct loader_surface_query_cache *entry;
+    bool answered = false;
+
+    if (!icd_surface->query_cache_enabled) {
+        return false;
+    }
+
+    loader_platform_thread_lock_mutex(&icd_surface->query_cache_lock);
+
+    for (entry = icd_surface->query_cache; NULL != entry; entry = entry->next) {
+        if (entry->phys_dev_term == phys_dev_term) {
+            break;
+        }
+    }
+    if (NULL == entry) {
+        entry = loader_instance_heap_alloc(inst, sizeof(struct loader_surface_query_cache), VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+        if (NULL == entry) {
+            goto out;
+        }
+        memset(entry, 0, sizeof(struct loader_surface_query_cache));
+        entry->phys_dev_term = phys_dev_term;
+        entry->next = icd_surface->query_cache;
+        icd_surface->query_cache = entry;
+    }
+
+    if (!entry->queries[query].valid) {
+        VkResult res = wsi_fill_surface_query_cache(inst, entry, query, surface);
+        if (VK_SUCCESS != res) {
+            // Errors such as a lost surface aren't kept, so the next call asks the ICD again.  If
+            // the loader ran out of memory the query is passed down uncached.
+            if (VK_ERROR_OUT_OF_HOST_MEMORY != res) {
+                *pResult = res;
+                answered = true;
+            }
+            goto out;
+        }
+    }
+
+    uint32_t cached_count = entry->queries[query].count;
+    if (NULL == pResults) {
+        *pCount = cached_count;
+        *pResult = VK_SUCCESS;
+    } else {
+        uint32_t copy_count = *pCount < cached_count ? *pCount : cached_count;
+        memcpy(pResults, entry->queries[query].results, copy_count * loader_surface_query_result_size[query]);
+        *pCount = copy_count;
+        *pResult = copy_count < cached_count ? VK_INCOMPLETE : VK_SUCCESS;
+    }
+    answered = true;
+
+out:
+    loader_platform_thread_unlock_mutex(&icd_surface->query_cache_lock);
+    return answered;
+}
+
+// Frees the loader's surface.  The ICDs' own surfaces must already have been destroyed.
+static void FreeIcdSurfaceStruct(struct loader_instance *instance, VkIcdSurface *pIcdSurface) {
+    if (pIcdSurface->query_cache_enabled) {
+        struct loader_surface_query_cache *entry = pIcdSurface->query_cache;
+        while (NULL != entry) {
+            struct loader_surface_query_cache *next = entry->next;
+            for (uint32_t query = 0; query < LOADER_SURFACE_QUERY_COUNT; query++) {
+                loader_instance_heap_free(instance, entry->queries[query].results);
+            }
+            loader_instance_heap_free(instance, entry);
+            entry = next;
+        }
+        loader_platform_thread_delete_mutex(&pIcdSurface->query_cache_lock);
+    }
+    if (pIcdSurface->lazy) {
+        loader_platform_thread_delete_mutex(&pIcdSurface->lazy_lock);
+    }
+    loader_instance_heap_free(instance, pIcdSurface->real_icd_surfaces);
+    loader_instance_heap_free(instance, pIcdSurface);
+}
+
 // Functions for the VK_KHR_surface extension:
 
 // This is the trampoline entrypoint for DestroySurfaceKHR
@@ -192,10 +359,9 @@ VKAPI_ATTR void VKAPI_CALL terminator_DestroySurfaceKHR(VkInstance instance, VkS
                     assert((VkSurfaceKHR)NULL == icd_surface->real_icd_surfaces[i]);
                 }
             }
-            loader_instance_heap_free(ptr_instance, icd_surface->real_icd_surfaces);
         }
 
-        loader_instance_heap_free(ptr_instance, (void *)(uintptr_t)surface);
+        FreeIcdSurfaceStruct(ptr_instance, icd_surface);
     }
 }
 
@@ -238,10 +404,14 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceSupportKHR(VkP
         assert(false && "loader: null GetPhysicalDeviceSurfaceSupportKHR ICD pointer");
     }
 
-    VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)surface;
-    if (NULL != icd_surface->real_icd_surfaces && (VkSurfaceKHR)NULL != icd_surface->real_icd_surfaces[phys_dev_term->icd_index]) {
-        return icd_term->dispatch.GetPhysicalDeviceSurfaceSupportKHR(
-            phys_dev_term->phys_dev, queueFamilyIndex, icd_surface->real_icd_surfaces[phys_dev_term->icd_index], pSupported);
+    VkSurfaceKHR real_icd_surface;
+    VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)surface, phys_dev_term->icd_index, &real_icd_surface);
+    if (VK_SUCCESS != res) {
+        return res;
+    }
+    if ((VkSurfaceKHR)NULL != real_icd_surface) {
+        return icd_term->dispatch.GetPhysicalDeviceSurfaceSupportKHR(phys_dev_term->phys_dev, queueFamilyIndex, real_icd_surface,
+                                                                     pSupported);
     }
 
     return icd_term->dispatch.GetPhysicalDeviceSurfaceSupportKHR(phys_dev_term->phys_dev, queueFamilyIndex, surface, pSupported);
@@ -284,10 +454,14 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceCapabilitiesKH
         assert(false && "loader: null GetPhysicalDeviceSurfaceCapabilitiesKHR ICD pointer");
     }
 
-    VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)surface;
-    if (NULL != icd_surface->real_icd_surfaces && (VkSurfaceKHR)NULL != icd_surface->real_icd_surfaces[phys_dev_term->icd_index]) {
-        return icd_term->dispatch.GetPhysicalDeviceSurfaceCapabilitiesKHR(
-            phys_dev_term->phys_dev, icd_surface->real_icd_surfaces[phys_dev_term->icd_index], pSurfaceCapabilities);
+    VkSurfaceKHR real_icd_surface;
+    VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)surface, phys_dev_term->icd_index, &real_icd_surface);
+    if (VK_SUCCESS != res) {
+        return res;
+    }
+    if ((VkSurfaceKHR)NULL != real_icd_surface) {
+        return icd_term->dispatch.GetPhysicalDeviceSurfaceCapabilitiesKHR(phys_dev_term->phys_dev, real_icd_surface,
+                                                                          pSurfaceCapabilities);
     }
 
     return icd_term->dispatch.GetPhysicalDeviceSurfaceCapabilitiesKHR(phys_dev_term->phys_dev, surface, pSurfaceCapabilities);
@@ -333,10 +507,18 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceFormatsKHR(VkP
     }
 
     VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)surface;
-    if (NULL != icd_surface->real_icd_surfaces && (VkSurfaceKHR)NULL != icd_surface->real_icd_surfaces[phys_dev_term->icd_index]) {
-        return icd_term->dispatch.GetPhysicalDeviceSurfaceFormatsKHR(phys_dev_term->phys_dev,
-                                                                     icd_surface->real_icd_surfaces[phys_dev_term->icd_index],
-                                                                     pSurfaceFormatCount, pSurfaceFormats);
+    VkSurfaceKHR real_icd_surface;
+    VkResult res = wsi_get_icd_surface(icd_term, icd_surface, phys_dev_term->icd_index, &real_icd_surface);
+    if (VK_SUCCESS != res) {
+        return res;
+    }
+    if (wsi_cached_surface_query(phys_dev_term, icd_surface, (VkSurfaceKHR)NULL != real_icd_surface ? real_icd_surface : surface,
+                                 LOADER_SURFACE_QUERY_FORMATS, pSurfaceFormatCount, pSurfaceFormats, &res)) {
+        return res;
+    }
+    if ((VkSurfaceKHR)NULL != real_icd_surface) {
+        return icd_term->dispatch.GetPhysicalDeviceSurfaceFormatsKHR(phys_dev_term->phys_dev, real_icd_surface, pSurfaceFormatCount,
+                                                                     pSurfaceFormats);
     }
 
     return icd_term->dispatch.GetPhysicalDeviceSurfaceFormatsKHR(phys_dev_term->phys_dev, surface, pSurfaceFormatCount,
@@ -383,9 +565,18 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfacePresentModesKH
     }
 
     VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)surface;
-    if (NULL != icd_surface->real_icd_surfaces && (VkSurfaceKHR)NULL != icd_surface->real_icd_surfaces[phys_dev_term->icd_index]) {
-        return icd_term->dispatch.GetPhysicalDeviceSurfacePresentModesKHR(
-            phys_dev_term->phys_dev, icd_surface->real_icd_surfaces[phys_dev_term->icd_index], pPresentModeCount, pPresentModes);
+    VkSurfaceKHR real_icd_surface;
+    VkResult res = wsi_get_icd_surface(icd_term, icd_surface, phys_dev_term->icd_index, &real_icd_surface);
+    if (VK_SUCCESS != res) {
+        return res;
+    }
+    if (wsi_cached_surface_query(phys_dev_term, icd_surface, (VkSurfaceKHR)NULL != real_icd_surface ? real_icd_surface : surface,
+                                 LOADER_SURFACE_QUERY_PRESENT_MODES, pPresentModeCount, pPresentModes, &res)) {
+        return res;
+    }
+    if ((VkSurfaceKHR)NULL != real_icd_surface) {
+        return icd_term->dispatch.GetPhysicalDeviceSurfacePresentModesKHR(phys_dev_term->phys_dev, real_icd_surface,
+                                                                          pPresentModeCount, pPresentModes);
     }
 
     return icd_term->dispatch.GetPhysicalDeviceSurfacePresentModesKHR(phys_dev_term->phys_dev, surface, pPresentModeCount,
@@ -409,20 +600,22 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateSwapchainKHR(VkDevice device, co
     struct loader_device *dev;
     struct loader_icd_term *icd_term = loader_get_icd_and_device(device, &dev, &icd_index);
     if (NULL != icd_term && NULL != icd_term->dispatch.CreateSwapchainKHR) {
-        VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)pCreateInfo->surface;
-        if (NULL != icd_surface->real_icd_surfaces) {
-            if ((VkSurfaceKHR)NULL != icd_surface->real_icd_surfaces[icd_index]) {
-                // We found the ICD, and there is an ICD KHR surface
-                // associated with it, so copy the CreateInfo struct
-                // and point it at the ICD's surface.
-                VkSwapchainCreateInfoKHR *pCreateCopy = loader_stack_alloc(sizeof(VkSwapchainCreateInfoKHR));
-                if (NULL == pCreateCopy) {
-                    return VK_ERROR_OUT_OF_HOST_MEMORY;
-                }
-                memcpy(pCreateCopy, pCreateInfo, sizeof(VkSwapchainCreateInfoKHR));
-                pCreateCopy->surface = icd_surface->real_icd_surfaces[icd_index];
-                return icd_term->dispatch.CreateSwapchainKHR(device, pCreateCopy, pAllocator, pSwapchain);
+        VkSurfaceKHR real_icd_surface;
+        VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)pCreateInfo->surface, icd_index, &real_icd_surface);
+        if (VK_SUCCESS != res) {
+            return res;
+        }
+        if ((VkSurfaceKHR)NULL != real_icd_surface) {
+            // We found the ICD, and there is an ICD KHR surface
+            // associated with it, so copy the CreateInfo struct
+            // and point it at the ICD's surface.
+            VkSwapchainCreateInfoKHR *pCreateCopy = loader_stack_alloc(sizeof(VkSwapchainCreateInfoKHR));
+            if (NULL == pCreateCopy) {
+                return VK_ERROR_OUT_OF_HOST_MEMORY;
             }
+            memcpy(pCreateCopy, pCreateInfo, sizeof(VkSwapchainCreateInfoKHR));
+            pCreateCopy->surface = real_icd_surface;
+            return icd_term->dispatch.CreateSwapchainKHR(device, pCreateCopy, pAllocator, pSwapchain);
         }
         return icd_term->dispatch.CreateSwapchainKHR(device, pCreateInfo, pAllocator, pSwapchain);
     }
@@ -460,10 +653,16 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkQueuePresentKHR(VkQueue queue, co
     return disp->QueuePresentKHR(queue, pPresentInfo);
 }
 
-static VkIcdSurface *AllocateIcdSurfaceStruct(struct loader_instance *instance, size_t base_size, size_t platform_size) {
+// Allocates the loader's surface and its per-ICD surface array.  When lazy is set, the ICD surfaces
+// are left for wsi_get_icd_surface to create on first use with pAllocator, so the platform
+// information in the returned surface must be filled in before it is handed out.
+static VkIcdSurface *AllocateIcdSurfaceStruct(struct loader_instance *instance, size_t base_size, size_t platform_size, bool lazy,
+                                              const VkAllocationCallbacks *pAllocator) {
     // Next, if so, proceed with the implementation of this function:
     VkIcdSurface *pIcdSurface = loader_instance_heap_alloc(instance, sizeof(VkIcdSurface), VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
     if (pIcdSurface != NULL) {
+        memset(pIcdSurface, 0, sizeof(VkIcdSurface));
+
         // Setup the new sizes and offsets so we can grow the structures in the
         // future without having problems
         pIcdSurface->base_size = (uint32_t)base_size;
@@ -471,18 +670,109 @@ static VkIcdSurface *AllocateIcdSurfaceStruct(struct loader_instance *instance,
         pIcdSurface->non_platform_offset = (uint32_t)((uint8_t *)(&pIcdSurface->base_size) - (uint8_t *)pIcdSurface);
         pIcdSurface->entire_size = sizeof(VkIcdSurface);
 
-        pIcdSurface->real_icd_surfaces = loader_instance_heap_alloc(instance, sizeof(VkSurfaceKHR) * instance->total_icd_count,
-                                                                    VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+        // The once-flags for lazy surfaces share the allocation with the surfaces themselves
+        size_t surfaces_size = sizeof(VkSurfaceKHR) * instance->total_icd_count;
+        size_t alloc_size = surfaces_size + (lazy ? sizeof(uint32_t) * instance->total_icd_count : 0);
+        pIcdSurface->real_icd_surfaces = loader_instance_heap_alloc(instance, alloc_size, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
         if (pIcdSurface->real_icd_surfaces == NULL) {
             loader_instance_heap_free(instance, pIcdSurface);
             pIcdSurface = NULL;
         } else {
-            memset(pIcdSurface->real_icd_surfaces, 0, sizeof(VkSurfaceKHR) * instance->total_icd_count);
+            memset(pIcdSurface->real_icd_surfaces, 0, alloc_size);
+            if (lazy) {
+                pIcdSurface->lazy = true;
+                pIcdSurface->real_icd_created = (volatile uint32_t *)((uint8_t *)pIcdSurface->real_icd_surfaces + surfaces_size);
+                if (NULL != pAllocator) {
+                    pIcdSurface->has_allocator = true;
+                    pIcdSurface->allocator = *pAllocator;
+                }
+                loader_platform_thread_create_mutex(&pIcdSurface->lazy_lock);
+            }
+            if (instance->wsi_surface_query_cache_enabled) {
+                pIcdSurface->query_cache_enabled = true;
+                loader_platform_thread_create_mutex(&pIcdSurface->query_cache_lock);
+            }
         }
     }
     return pIcdSurface;
 }
 
+// Creates the ICD's own surface for a lazy surface from the platform information the loader kept.
+// Leaves *pSurface NULL if the ICD can't create surfaces for the platform.
+static VkResult wsi_create_lazy_icd_surface(struct loader_icd_term *icd_term, VkIcdSurface *icd_surface, VkSurfaceKHR *pSurface) {
+    const VkAllocationCallbacks *pAllocator = icd_surface->has_allocator ? &icd_surface->allocator : NULL;
+
+    switch (((VkIcdSurfaceBase *)icd_surface)->platform) {
+#ifdef VK_USE_PLATFORM_WAYLAND_KHR
+        case VK_ICD_WSI_PLATFORM_WAYLAND:
+            if (NULL != icd_term->dispatch.CreateWaylandSurfaceKHR) {
+                VkWaylandSurfaceCreateInfoKHR create_info = {VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR};
+                create_info.display = icd_surface->wayland_surf.display;
+                create_info.surface = icd_surface->wayland_surf.surface;
+                return icd_term->dispatch.CreateWaylandSurfaceKHR(icd_term->instance, &create_info, pAllocator, pSurface);
+            }
+            break;
+#endif  // VK_USE_PLATFORM_WAYLAND_KHR
+#ifdef VK_USE_PLATFORM_XCB_KHR
+        case VK_ICD_WSI_PLATFORM_XCB:
+            if (NULL != icd_term->dispatch.CreateXcbSurfaceKHR) {
+                VkXcbSurfaceCreateInfoKHR create_info = {VK_STRUCTURE_TYPE_XCB_SURFACE_CREATE_INFO_KHR};
+                create_info.connection = icd_surface->xcb_surf.connection;
+                create_info.window = icd_surface->xcb_surf.window;
+                return icd_term->dispatch.CreateXcbSurfaceKHR(icd_term->instance, &create_info, pAllocator, pSurface);
+            }
+            break;
+#endif  // VK_USE_PLATFORM_XCB_KHR
+        case VK_ICD_WSI_PLATFORM_HEADLESS:
+            if (NULL != icd_term->dispatch.CreateHeadlessSurfaceEXT) {
+                VkHeadlessSurfaceCreateInfoEXT create_info = {VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT};
+                return icd_term->dispatch.CreateHeadlessSurfaceEXT(icd_term->instance, &create_info, pAllocator, pSurface);
+            }
+            break;
+        default:
+            break;
+    }
+    return VK_SUCCESS;
+}
+
+VkResult wsi_get_icd_surface(struct loader_icd_term *icd_term, VkIcdSurface *icd_surface, uint32_t icd_index,
+                             VkSurfaceKHR *pIcdSurface) {
+    VkResult res = VK_SUCCESS;
+
+    if (NULL == icd_surface->real_icd_surfaces) {
+        *pIcdSurface = (VkSurfaceKHR)NULL;
+        return VK_SUCCESS;
+    }
+    if (!icd_surface->lazy || 0 != loader_platform_atomic_load_u32(&icd_surface->real_icd_created[icd_index])) {
+        *pIcdSurface = icd_surface->real_icd_surfaces[icd_index];
+        return VK_SUCCESS;
+    }
+
+    // First use of the surface with this ICD.  Another thread may be creating it, so check again
+    // with the lock held.
+    loader_platform_thread_lock_mutex(&icd_surface->lazy_lock);
+    if (0 == icd_surface->real_icd_created[icd_index]) {
+        if (icd_term->scanned_icd->interface_version >= ICD_VER_SUPPORTS_ICD_SURFACE_KHR) {
+            res = wsi_create_lazy_icd_surface(icd_term, icd_surface, &icd_surface->real_icd_surfaces[icd_index]);
+            if (VK_SUCCESS != res) {
+                // Left unset, so the next call with this ICD tries again
+                loader_log(icd_term->this_instance, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                           "wsi_get_icd_surface: Failed to create a surface in ICD %s (error %d)", icd_term->scanned_icd->lib_name,
+                           res);
+                icd_surface->real_icd_surfaces[icd_index] = (VkSurfaceKHR)NULL;
+                goto out;
+            }
+        }
+        // Publish the surface before the flag, so anyone who sees the flag also sees the surface
+        loader_platform_atomic_store_u32(&icd_surface->real_icd_created[icd_index], 1);
+    }
+
+out:
+    *pIcdSurface = icd_surface->real_icd_surfaces[icd_index];
+    loader_platform_thread_unlock_mutex(&icd_surface->lazy_lock);
+    return res;
+}
+
 #ifdef VK_USE_PLATFORM_WIN32_KHR
 
 // Functions for the VK_KHR_win32_surface extension:
@@ -519,7 +809,8 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateWin32SurfaceKHR(VkInstance insta
     }
 
     // Next, if so, proceed with the implementation of this function:
-    pIcdSurface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(pIcdSurface->win_surf.base), sizeof(pIcdSurface->win_surf));
+    pIcdSurface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(pIcdSurface->win_surf.base),
+                                           sizeof(pIcdSurface->win_surf), false, NULL);
     if (pIcdSurface == NULL) {
         vkRes = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto out;
@@ -554,9 +845,8 @@ out:
                     icd_term->dispatch.DestroySurfaceKHR(icd_term->instance, pIcdSurface->real_icd_surfaces[i], pAllocator);
                 }
             }
-            loader_instance_heap_free(ptr_instance, pIcdSurface->real_icd_surfaces);
         }
-        loader_instance_heap_free(ptr_instance, pIcdSurface);
+        FreeIcdSurfaceStruct(ptr_instance, pIcdSurface);
     }
 
     return vkRes;
@@ -618,7 +908,6 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateWaylandSurfaceKHR(VkInstance ins
                                                                   const VkAllocationCallbacks *pAllocator, VkSurfaceKHR *pSurface) {
     VkResult vkRes = VK_SUCCESS;
     VkIcdSurface *pIcdSurface = NULL;
-    uint32_t i = 0;
 
     // First, check to ensure the appropriate extension was enabled:
     struct loader_instance *ptr_instance = loader_get_instance(instance);
@@ -630,7 +919,8 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateWaylandSurfaceKHR(VkInstance ins
     }
 
     // Next, if so, proceed with the implementation of this function:
-    pIcdSurface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(pIcdSurface->wayland_surf.base), sizeof(pIcdSurface->wayland_surf));
+    pIcdSurface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(pIcdSurface->wayland_surf.base),
+                                           sizeof(pIcdSurface->wayland_surf), true, pAllocator);
     if (pIcdSurface == NULL) {
         vkRes = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto out;
@@ -640,36 +930,10 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateWaylandSurfaceKHR(VkInstance ins
     pIcdSurface->wayland_surf.display = pCreateInfo->display;
     pIcdSurface->wayland_surf.surface = pCreateInfo->surface;
 
-    // Loop through each ICD and determine if they need to create a surface
-    for (struct loader_icd_term *icd_term = ptr_instance->icd_terms; icd_term != NULL; icd_term = icd_term->next, i++) {
-        if (icd_term->scanned_icd->interface_version >= ICD_VER_SUPPORTS_ICD_SURFACE_KHR) {
-            if (NULL != icd_term->dispatch.CreateWaylandSurfaceKHR) {
-                vkRes = icd_term->dispatch.CreateWaylandSurfaceKHR(icd_term->instance, pCreateInfo, pAllocator,
-                                                                   &pIcdSurface->real_icd_surfaces[i]);
-                if (VK_SUCCESS != vkRes) {
-                    goto out;
-                }
-            }
-        }
-    }
-
+    // The ICDs' own surfaces are created by wsi_get_icd_surface the first time each one is needed
     *pSurface = (VkSurfaceKHR)pIcdSurface;
 
 out:
-
-    if (VK_SUCCESS != vkRes && NULL != pIcdSurface) {
-        if (NULL != pIcdSurface->real_icd_surfaces) {
-            i = 0;
-            for (struct loader_icd_term *icd_term = ptr_instance->icd_terms; icd_term != NULL; icd_term = icd_term->next, i++) {
-                if ((VkSurfaceKHR)NULL != pIcdSurface->real_icd_surfaces[i] && NULL != icd_term->dispatch.DestroySurfaceKHR) {
-                    icd_term->dispatch.DestroySurfaceKHR(icd_term->instance, pIcdSurface->real_icd_surfaces[i], pAllocator);
-                }
-            }
-            loader_instance_heap_free(ptr_instance, pIcdSurface->real_icd_surfaces);
-        }
-        loader_instance_heap_free(ptr_instance, pIcdSurface);
-    }
-
     return vkRes;
 }
 
@@ -733,7 +997,6 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateXcbSurfaceKHR(VkInstance instanc
                                                               const VkAllocationCallbacks *pAllocator, VkSurfaceKHR *pSurface) {
     VkResult vkRes = VK_SUCCESS;
     VkIcdSurface *pIcdSurface = NULL;
-    uint32_t i = 0;
 
     // First, check to ensure the appropriate extension was enabled:
     struct loader_instance *ptr_instance = loader_get_instance(instance);
@@ -745,7 +1008,8 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateXcbSurfaceKHR(VkInstance instanc
     }
 
     // Next, if so, proceed with the implementation of this function:
-    pIcdSurface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(pIcdSurface->xcb_surf.base), sizeof(pIcdSurface->xcb_surf));
+    pIcdSurface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(pIcdSurface->xcb_surf.base),
+                                           sizeof(pIcdSurface->xcb_surf), true, pAllocator);
     if (pIcdSurface == NULL) {
         vkRes = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto out;
@@ -755,36 +1019,10 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateXcbSurfaceKHR(VkInstance instanc
     pIcdSurface->xcb_surf.connection = pCreateInfo->connection;
     pIcdSurface->xcb_surf.window = pCreateInfo->window;
 
-    // Loop through each ICD and determine if they need to create a surface
-    for (struct loader_icd_term *icd_term = ptr_instance->icd_terms; icd_term != NULL; icd_term = icd_term->next, i++) {
-        if (icd_term->scanned_icd->interface_version >= ICD_VER_SUPPORTS_ICD_SURFACE_KHR) {
-            if (NULL != icd_term->dispatch.CreateXcbSurfaceKHR) {
-                vkRes = icd_term->dispatch.CreateXcbSurfaceKHR(icd_term->instance, pCreateInfo, pAllocator,
-                                                               &pIcdSurface->real_icd_surfaces[i]);
-                if (VK_SUCCESS != vkRes) {
-                    goto out;
-                }
-            }
-        }
-    }
-
+    // The ICDs' own surfaces are created by wsi_get_icd_surface the first time each one is needed
     *pSurface = (VkSurfaceKHR)pIcdSurface;
 
 out:
-
-    if (VK_SUCCESS != vkRes && NULL != pIcdSurface) {
-        if (NULL != pIcdSurface->real_icd_surfaces) {
-            i = 0;
-            for (struct loader_icd_term *icd_term = ptr_instance->icd_terms; icd_term != NULL; icd_term = icd_term->next, i++) {
-                if ((VkSurfaceKHR)NULL != pIcdSurface->real_icd_surfaces[i] && NULL != icd_term->dispatch.DestroySurfaceKHR) {
-                    icd_term->dispatch.DestroySurfaceKHR(icd_term->instance, pIcdSurface->real_icd_surfaces[i], pAllocator);
-                }
-            }
-            loader_instance_heap_free(ptr_instance, pIcdSurface->real_icd_surfaces);
-        }
-        loader_instance_heap_free(ptr_instance, pIcdSurface);
-    }
-
     return vkRes;
 }
 
@@ -861,8 +1099,10 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateXlibSurfaceKHR(VkInstance instan
         goto out;
     }
 
-    // Next, if so, proceed with the implementation of this function:
-    pIcdSurface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(pIcdSurface->xlib_surf.base), sizeof(pIcdSurface->xlib_surf));
+    // Next, if so, proceed with the implementation of this function.  Xlib surfaces are created
+    // eagerly, since a Display may only be used from the thread the application uses it on.
+    pIcdSurface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(pIcdSurface->xlib_surf.base),
+                                           sizeof(pIcdSurface->xlib_surf), false, NULL);
     if (pIcdSurface == NULL) {
         vkRes = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto out;
@@ -897,9 +1137,8 @@ out:
                     icd_term->dispatch.DestroySurfaceKHR(icd_term->instance, pIcdSurface->real_icd_surfaces[i], pAllocator);
                 }
             }
-            loader_instance_heap_free(ptr_instance, pIcdSurface->real_icd_surfaces);
         }
-        loader_instance_heap_free(ptr_instance, pIcdSurface);
+        FreeIcdSurfaceStruct(ptr_instance, pIcdSurface);
     }
 
     return vkRes;
@@ -1005,7 +1244,6 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateHeadlessSurfaceEXT(VkInstance in
     struct loader_instance *inst = loader_get_instance(instance);
     VkIcdSurface *pIcdSurface = NULL;
     VkResult vkRes = VK_SUCCESS;
-    uint32_t i = 0;
 
     if (!inst->wsi_headless_surface_enabled) {
         loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
@@ -1015,43 +1253,18 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateHeadlessSurfaceEXT(VkInstance in
     }
 
     // Next, if so, proceed with the implementation of this function:
-    pIcdSurface = AllocateIcdSurfaceStruct(inst, sizeof(pIcdSurface->headless_surf.base), sizeof(pIcdSurface->headless_surf));
+    pIcdSurface = AllocateIcdSurfaceStruct(inst, sizeof(pIcdSurface->headless_surf.base),
+                                           sizeof(pIcdSurface->headless_surf), true, pAllocator);
     if (pIcdSurface == NULL) {
         vkRes = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto out;
     }
 
     pIcdSurface->headless_surf.base.platform = VK_ICD_WSI_PLATFORM_HEADLESS;
-    // Loop through each ICD and determine if they need to create a surface
-    for (struct loader_icd_term *icd_term = inst->icd_terms; icd_term != NULL; icd_term = icd_term->next, i++) {
-        if (icd_term->scanned_icd->interface_version >= ICD_VER_SUPPORTS_ICD_SURFACE_KHR) {
-            if (NULL != icd_term->dispatch.CreateHeadlessSurfaceEXT) {
-                vkRes = icd_term->dispatch.CreateHeadlessSurfaceEXT(icd_term->instance, pCreateInfo, pAllocator,
-                                                                    &pIcdSurface->real_icd_surfaces[i]);
-                if (VK_SUCCESS != vkRes) {
-                    goto out;
-                }
-            }
-        }
-    }
-
+    // The ICDs' own surfaces are created by wsi_get_icd_surface the first time each one is needed
     *pSurface = (VkSurfaceKHR)pIcdSurface;
 
 out:
-
-    if (VK_SUCCESS != vkRes && NULL != pIcdSurface) {
-        if (NULL != pIcdSurface->real_icd_surfaces) {
-            i = 0;
-            for (struct loader_icd_term *icd_term = inst->icd_terms; icd_term != NULL; icd_term = icd_term->next, i++) {
-                if ((VkSurfaceKHR)NULL != pIcdSurface->real_icd_surfaces[i] && NULL != icd_term->dispatch.DestroySurfaceKHR) {
-                    icd_term->dispatch.DestroySurfaceKHR(icd_term->instance, pIcdSurface->real_icd_surfaces[i], pAllocator);
-                }
-            }
-            loader_instance_heap_free(inst, pIcdSurface->real_icd_surfaces);
-        }
-        loader_instance_heap_free(inst, pIcdSurface);
-    }
-
     return vkRes;
 }
 
@@ -1089,7 +1302,8 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateMacOSSurfaceMVK(VkInstance insta
     }
 
     // Next, if so, proceed with the implementation of this function:
-    pIcdSurface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(pIcdSurface->macos_surf.base), sizeof(pIcdSurface->macos_surf));
+    pIcdSurface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(pIcdSurface->macos_surf.base),
+                                           sizeof(pIcdSurface->macos_surf), false, NULL);
     if (pIcdSurface == NULL) {
         vkRes = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto out;
@@ -1123,9 +1337,8 @@ out:
                     icd_term->dispatch.DestroySurfaceKHR(icd_term->instance, pIcdSurface->real_icd_surfaces[i], pAllocator);
                 }
             }
-            loader_instance_heap_free(ptr_instance, pIcdSurface->real_icd_surfaces);
         }
-        loader_instance_heap_free(ptr_instance, pIcdSurface);
+        FreeIcdSurfaceStruct(ptr_instance, pIcdSurface);
     }
 
     return vkRes;
@@ -1202,7 +1415,8 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateMetalSurfaceEXT(VkInstance insta
     }
 
     // Next, if so, proceed with the implementation of this function:
-    icd_surface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(icd_surface->metal_surf.base), sizeof(icd_surface->metal_surf));
+    icd_surface = AllocateIcdSurfaceStruct(ptr_instance, sizeof(icd_surface->metal_surf.base),
+                                           sizeof(icd_surface->metal_surf), false, NULL);
     if (icd_surface == NULL) {
         result = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto out;
@@ -1235,9 +1449,8 @@ out:
                     icd_term->dispatch.DestroySurfaceKHR(icd_term->instance, icd_surface->real_icd_surfaces[i], pAllocator);
                 }
             }
-            loader_instance_heap_free(ptr_instance, icd_surface->real_icd_surfaces);
         }
-        loader_instance_heap_free(ptr_instance, icd_surface);
+        FreeIcdSurfaceStruct(ptr_instance, icd_surface);
     }
     return result;
 }
@@ -1465,7 +1678,8 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateDisplayPlaneSurfaceKHR(VkInstanc
     }
 
     // Next, if so, proceed with the implementation of this function:
-    pIcdSurface = AllocateIcdSurfaceStruct(inst, sizeof(pIcdSurface->display_surf.base), sizeof(pIcdSurface->display_surf));
+    pIcdSurface = AllocateIcdSurfaceStruct(inst, sizeof(pIcdSurface->display_surf.base),
+                                           sizeof(pIcdSurface->display_surf), false, NULL);
     if (pIcdSurface == NULL) {
         vkRes = VK_ERROR_OUT_OF_HOST_MEMORY;
         goto out;
@@ -1505,9 +1719,8 @@ out:
                     icd_term->dispatch.DestroySurfaceKHR(icd_term->instance, pIcdSurface->real_icd_surfaces[i], pAllocator);
                 }
             }
-            loader_instance_heap_free(inst, pIcdSurface->real_icd_surfaces);
         }
-        loader_instance_heap_free(inst, pIcdSurface);
+        FreeIcdSurfaceStruct(inst, pIcdSurface);
     }
 
     return vkRes;
@@ -1532,22 +1745,25 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateSharedSwapchainsKHR(VkDevice dev
     struct loader_device *dev;
     struct loader_icd_term *icd_term = loader_get_icd_and_device(device, &dev, &icd_index);
     if (NULL != icd_term && NULL != icd_term->dispatch.CreateSharedSwapchainsKHR) {
-        VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)pCreateInfos->surface;
-        if (NULL != icd_surface->real_icd_surfaces) {
-            if ((VkSurfaceKHR)NULL != icd_surface->real_icd_surfaces[icd_index]) {
-                // We found the ICD, and there is an ICD KHR surface
-                // associated with it, so copy the CreateInfo struct
-                // and point it at the ICD's surface.
-                VkSwapchainCreateInfoKHR *pCreateCopy = loader_stack_alloc(sizeof(VkSwapchainCreateInfoKHR) * swapchainCount);
-                if (NULL == pCreateCopy) {
-                    return VK_ERROR_OUT_OF_HOST_MEMORY;
-                }
-                memcpy(pCreateCopy, pCreateInfos, sizeof(VkSwapchainCreateInfoKHR) * swapchainCount);
-                for (uint32_t sc = 0; sc < swapchainCount; sc++) {
-                    pCreateCopy[sc].surface = icd_surface->real_icd_surfaces[icd_index];
-                }
-                return icd_term->dispatch.CreateSharedSwapchainsKHR(device, swapchainCount, pCreateCopy, pAllocator, pSwapchains);
+        VkSurfaceKHR real_icd_surface;
+        VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)pCreateInfos->surface,
+                                           icd_index, &real_icd_surface);
+        if (VK_SUCCESS != res) {
+            return res;
+        }
+        if ((VkSurfaceKHR)NULL != real_icd_surface) {
+            // We found the ICD, and there is an ICD KHR surface
+            // associated with it, so copy the CreateInfo struct
+            // and point it at the ICD's surface.
+            VkSwapchainCreateInfoKHR *pCreateCopy = loader_stack_alloc(sizeof(VkSwapchainCreateInfoKHR) * swapchainCount);
+            if (NULL == pCreateCopy) {
+                return VK_ERROR_OUT_OF_HOST_MEMORY;
+            }
+            memcpy(pCreateCopy, pCreateInfos, sizeof(VkSwapchainCreateInfoKHR) * swapchainCount);
+            for (uint32_t sc = 0; sc < swapchainCount; sc++) {
+                pCreateCopy[sc].surface = real_icd_surface;
             }
+            return icd_term->dispatch.CreateSharedSwapchainsKHR(device, swapchainCount, pCreateCopy, pAllocator, pSwapchains);
         }
         return icd_term->dispatch.CreateSharedSwapchainsKHR(device, swapchainCount, pCreateInfos, pAllocator, pSwapchains);
     }
@@ -1577,9 +1793,13 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetDeviceGroupSurfacePresentModesKHR(
     struct loader_device *dev;
     struct loader_icd_term *icd_term = loader_get_icd_and_device(device, &dev, &icd_index);
     if (NULL != icd_term && NULL != icd_term->dispatch.GetDeviceGroupSurfacePresentModesKHR) {
-        VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)surface;
-        if (NULL != icd_surface->real_icd_surfaces && (VkSurfaceKHR)NULL != icd_surface->real_icd_surfaces[icd_index]) {
-            return icd_term->dispatch.GetDeviceGroupSurfacePresentModesKHR(device, icd_surface->real_icd_surfaces[icd_index], pModes);
+        VkSurfaceKHR real_icd_surface;
+        VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)surface, icd_index, &real_icd_surface);
+        if (VK_SUCCESS != res) {
+            return res;
+        }
+        if ((VkSurfaceKHR)NULL != real_icd_surface) {
+            return icd_term->dispatch.GetDeviceGroupSurfacePresentModesKHR(device, real_icd_surface, pModes);
         }
         return icd_term->dispatch.GetDeviceGroupSurfacePresentModesKHR(device, surface, pModes);
     }
@@ -1608,10 +1828,14 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDevicePresentRectanglesKHR(
         loader_log(icd_term->this_instance, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                    "ICD associated with VkPhysicalDevice does not support GetPhysicalDevicePresentRectanglesKHX");
     }
-    VkIcdSurface *icd_surface = (VkIcdSurface *)(surface);
-    uint8_t icd_index = phys_dev_term->icd_index;
-    if (NULL != icd_surface->real_icd_surfaces && NULL != (void *)icd_surface->real_icd_surfaces[icd_index]) {
-        return icd_term->dispatch.GetPhysicalDevicePresentRectanglesKHR(phys_dev_term->phys_dev, icd_surface->real_icd_surfaces[icd_index], pRectCount, pRects);
+    VkSurfaceKHR real_icd_surface;
+    VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)surface, phys_dev_term->icd_index, &real_icd_surface);
+    if (VK_SUCCESS != res) {
+        return res;
+    }
+    if ((VkSurfaceKHR)NULL != real_icd_surface) {
+        return icd_term->dispatch.GetPhysicalDevicePresentRectanglesKHR(phys_dev_term->phys_dev, real_icd_surface, pRectCount,
+                                                                        pRects);
     }
     return icd_term->dispatch.GetPhysicalDevicePresentRectanglesKHR(phys_dev_term->phys_dev, surface, pRectCount, pRects);
 }
@@ -25,6 +25,8 @@
 #include "vk_loader_platform.h"
 #include "loader.h"
 
+struct loader_surface_query_cache;
+
 typedef struct {
     union {
 #ifdef VK_USE_PLATFORM_WAYLAND_KHR
@@ -53,8 +55,28 @@ typedef struct {
     uint32_t non_platform_offset;  // Start offset to base_size
     uint32_t entire_size;          // Size of entire VkIcdSurface
     VkSurfaceKHR *real_icd_surfaces;
+    // Set when the ICD surfaces are only created the first time they are needed.  real_icd_created
+    // then holds a once-flag per ICD, and lazy_lock and the creation allocator are kept for creating
+    // them.  Always read ICD surfaces through wsi_get_icd_surface.
+    bool lazy;
+    bool has_allocator;
+    volatile uint32_t *real_icd_created;
+    VkAllocationCallbacks allocator;
+    loader_platform_thread_mutex lazy_lock;
+    // Formats and present modes already queried for this surface, one entry per physical device.
+    // Only used when query_cache_enabled is set, and protected by query_cache_lock.
+    bool query_cache_enabled;
+    struct loader_surface_query_cache *query_cache;
+    loader_platform_thread_mutex query_cache_lock;
 } VkIcdSurface;
 
+// Sets *pIcdSurface to the ICD's own surface for icd_surface, creating it first if the surface is
+// lazy and this is the first use.  Sets it to VK_NULL_HANDLE if the ICD has no surface of its own,
+// in which case the loader's surface should be passed down instead.  Returns the ICD's error if
+// the lazy creation fails; it is tried again on the next call.
+VkResult wsi_get_icd_surface(struct loader_icd_term *icd_term, VkIcdSurface *icd_surface, uint32_t icd_index,
+                             VkSurfaceKHR *pIcdSurface);
+
 bool wsi_swapchain_instance_gpa(struct loader_instance *ptr_instance, const char *name, void **addr);
 
 void wsi_create_instance(struct loader_instance *ptr_instance, const VkInstanceCreateInfo *pCreateInfo);
@@ -92,6 +92,59 @@ PRE_INSTANCE_FUNCTIONS = ['vkEnumerateInstanceExtensionProperties',
                           'vkEnumerateInstanceLayerProperties',
                           'vkEnumerateInstanceVersion']
 
+# Commands that are never looked up through a dispatch table
+LOOKUP_SKIP_NAMES = ['CreateInstance',
+                     'CreateDevice',
+                     'EnumerateInstanceExtensionProperties',
+                     'EnumerateInstanceLayerProperties',
+                     'EnumerateInstanceVersion']
+
+#
+# Hash a command name the same way loader_dispatch_name_hash() does in the generated C code.
+def DispatchNameHash(seed, name):
+    hash = seed if seed != 0 else 0x811c9dc5
+    for c in name.encode('ascii'):
+        hash = ((hash ^ c) * 0x01000193) & 0xffffffff
+    return hash
+
+#
+# Build a minimal perfect hash over a list of names using hash and displace.  Names are spread over
+# as many buckets as there are names by their unseeded hash.  Starting with the fullest, each bucket
+# with several names gets the smallest seed that sends all of them to free slots.  Buckets with a
+# single name are then pointed straight at one of the remaining slots by storing -(slot + 1).
+# Returns the names in slot order and the per-bucket displacements.
+def BuildDispatchNamePerfectHash(names):
+    names = sorted(names)
+    count = len(names)
+    buckets = [[] for _ in range(count)]
+    for name in names:
+        buckets[DispatchNameHash(0, name) % count].append(name)
+
+    slots = [None] * count
+    displacements = [0] * count
+    for bucket_index in sorted(range(count), key=lambda b: (-len(buckets[b]), b)):
+        bucket = buckets[bucket_index]
+        if len(bucket) < 2:
+            break
+        seed = 1
+        while True:
+            trial = [DispatchNameHash(seed, name) % count for name in bucket]
+            if len(set(trial)) == len(trial) and all(slots[slot] is None for slot in trial):
+                break
+            seed += 1
+        for name, slot in zip(bucket, trial):
+            slots[slot] = name
+        displacements[bucket_index] = seed
+
+    free_slots = [slot for slot in range(count) if slots[slot] is None]
+    for bucket_index in range(count):
+        if len(buckets[bucket_index]) == 1:
+            slot = free_slots.pop(0)
+            slots[slot] = buckets[bucket_index][0]
+            displacements[bucket_index] = -slot - 1
+
+    return slots, displacements
+
 #
 # LoaderExtensionGeneratorOptions - subclass of GeneratorOptions.
 class LoaderExtensionGeneratorOptions(GeneratorOptions):
@@ -197,6 +250,7 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
             preamble += '#ifndef _GNU_SOURCE\n'
             preamble += '#define _GNU_SOURCE\n'
             preamble += '#endif\n'
+            preamble += '#include <stddef.h>\n'
             preamble += '#include <stdio.h>\n'
             preamble += '#include <stdlib.h>\n'
             preamble += '#include <string.h>\n'
@@ -467,6 +521,9 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
         protos += 'VKAPI_ATTR void* VKAPI_CALL loader_lookup_instance_dispatch_table(const VkLayerInstanceDispatchTable *table, const char *name,\n'
         protos += '                                                                  bool *found_name);\n'
         protos += '\n'
+        protos += '// Core command trampoline lookup function, global commands are not included\n'
+        protos += 'void *loader_lookup_core_trampoline(const char *name);\n'
+        protos += '\n'
         protos += 'VKAPI_ATTR bool VKAPI_CALL loader_icd_init_entries(struct loader_icd_term *icd_term, VkInstance inst,\n'
         protos += '                                                   const PFN_vkGetInstanceProcAddr fp_gipa);\n'
         protos += '\n'
@@ -753,7 +810,6 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
                 tables += 'VKAPI_ATTR void VKAPI_CALL loader_init_device_dispatch_table(struct loader_dev_dispatch_table *dev_table, PFN_vkGetDeviceProcAddr gpa,\n'
                 tables += '                                                             VkDevice dev) {\n'
                 tables += '    VkLayerDispatchTable *table = &dev_table->core_dispatch;\n'
-                tables += '    for (uint32_t i = 0; i < MAX_NUM_UNKNOWN_EXTS; i++) dev_table->ext_dispatch.dev_ext[i] = (PFN_vkDevExt)vkDevExtError;\n'
 
             elif x == 1:
                 cur_type = 'device'
@@ -835,75 +891,135 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
     # Create a lookup table function from the appropriate list of entrypoints and
     # return it as a string
     def OutputLoaderLookupFunc(self):
-        commands = []
         tables = ''
-        cur_type = ''
-        cur_extension_name = ''
-
-        for x in range(0, 2):
-            if x == 0:
-                cur_type = 'device'
-
-                tables += '// Device command lookup function\n'
-                tables += 'VKAPI_ATTR void* VKAPI_CALL loader_lookup_device_dispatch_table(const VkLayerDispatchTable *table, const char *name) {\n'
-                tables += '    if (!name || name[0] != \'v\' || name[1] != \'k\') return NULL;\n'
-                tables += '\n'
-                tables += '    name += 2;\n'
-            else:
-                cur_type = 'instance'
-
-                tables += '// Instance command lookup function\n'
-                tables += 'VKAPI_ATTR void* VKAPI_CALL loader_lookup_instance_dispatch_table(const VkLayerInstanceDispatchTable *table, const char *name,\n'
-                tables += '                                                                 bool *found_name) {\n'
-                tables += '    if (!name || name[0] != \'v\' || name[1] != \'k\') {\n'
-                tables += '        *found_name = false;\n'
-                tables += '        return NULL;\n'
-                tables += '    }\n'
-                tables += '\n'
-                tables += '    *found_name = true;\n'
-                tables += '    name += 2;\n'
-
-            for y in range(0, 2):
-                if y == 0:
-                    commands = self.core_commands
+        tables += '// Dispatch lookups by name go through minimal perfect hashes built by the generator over every\n'
+        tables += '// command that could be in the table, so resolving a name costs one hash and one strcmp.\n'
+        tables += 'static inline uint32_t loader_dispatch_name_hash(uint32_t seed, const char *name) {\n'
+        tables += '    uint32_t hash = seed != 0 ? seed : 0x811c9dc5;\n'
+        tables += '    for (; *name != \'\\0\'; name++) {\n'
+        tables += '        hash = (hash ^ (uint8_t)*name) * 0x01000193;\n'
+        tables += '    }\n'
+        tables += '    return hash;\n'
+        tables += '}\n'
+        tables += '\n'
+        tables += '// Returns the only slot the name can be in.  The caller still has to compare the name.\n'
+        tables += 'static inline uint32_t loader_dispatch_name_slot(const int32_t *displacements, uint32_t count, const char *name) {\n'
+        tables += '    int32_t displacement = displacements[loader_dispatch_name_hash(0, name) % count];\n'
+        tables += '    if (displacement < 0) return (uint32_t)(-displacement - 1);\n'
+        tables += '    return loader_dispatch_name_hash((uint32_t)displacement, name) % count;\n'
+        tables += '}\n'
+        tables += '\n'
+        tables += '// Offset used for commands that are not compiled into the dispatch table on this platform\n'
+        tables += '#define LOADER_DISPATCH_NO_OFFSET UINT32_MAX\n'
+        tables += '\n'
+        tables += 'struct loader_dispatch_name_entry {\n'
+        tables += '    const char *name;  // without the "vk" prefix\n'
+        tables += '    uint32_t offset;   // into the dispatch table\n'
+        tables += '};\n'
+        tables += '\n'
+        tables += 'struct loader_trampoline_name_entry {\n'
+        tables += '    const char *name;  // without the "vk" prefix\n'
+        tables += '    void *addr;\n'
+        tables += '};\n'
+        tables += '\n'
+
+        device_commands = []
+        instance_commands = []
+        trampoline_commands = [cur_cmd for cur_cmd in self.core_commands if cur_cmd.name not in ADD_INST_CMDS]
+        for commands in [self.core_commands, self.ext_commands]:
+            for cur_cmd in commands:
+                if cur_cmd.name[2:] in LOOKUP_SKIP_NAMES:
+                    continue
+                if cur_cmd.handle_type == 'VkInstance' or cur_cmd.handle_type == 'VkPhysicalDevice':
+                    instance_commands.append(cur_cmd)
                 else:
-                    commands = self.ext_commands
-
-                for cur_cmd in commands:
-                    is_inst_handle_type = cur_cmd.handle_type == 'VkInstance' or cur_cmd.handle_type == 'VkPhysicalDevice'
-                    if ((cur_type == 'instance' and is_inst_handle_type) or (cur_type == 'device' and not is_inst_handle_type)):
-
-                        if cur_cmd.ext_name != cur_extension_name:
-                            if 'VK_VERSION_' in cur_cmd.ext_name:
-                                tables += '\n    // ---- Core %s commands\n' % cur_cmd.ext_name[11:]
-                            else:
-                                tables += '\n    // ---- %s extension commands\n' % cur_cmd.ext_name
-                            cur_extension_name = cur_cmd.ext_name
-
-                        # Remove 'vk' from proto name
-                        base_name = cur_cmd.name[2:]
-
-                        if (base_name == 'CreateInstance' or base_name == 'CreateDevice' or
-                            base_name == 'EnumerateInstanceExtensionProperties' or
-                            base_name == 'EnumerateInstanceLayerProperties' or
-                            base_name == 'EnumerateInstanceVersion'):
-                            continue
-
-                        if cur_cmd.protect is not None:
-                            tables += '#ifdef %s\n' % cur_cmd.protect
-
-                        tables += '    if (!strcmp(name, "%s")) return (void *)table->%s;\n' % (base_name, base_name)
-
-                        if cur_cmd.protect is not None:
-                            tables += '#endif // %s\n' % cur_cmd.protect
-
-            tables += '\n'
-            if x == 1:
-                tables += '    *found_name = false;\n'
-            tables += '    return NULL;\n'
-            tables += '}\n\n'
+                    device_commands.append(cur_cmd)
+
+        tables += self.OutputDispatchNameTable('device', 'VkLayerDispatchTable', device_commands)
+        tables += self.OutputDispatchNameTable('instance', 'VkLayerInstanceDispatchTable', instance_commands)
+        tables += self.OutputDispatchNameTable('core_trampoline', None, trampoline_commands)
+
+        tables += '// Device command lookup function\n'
+        tables += 'VKAPI_ATTR void* VKAPI_CALL loader_lookup_device_dispatch_table(const VkLayerDispatchTable *table, const char *name) {\n'
+        tables += '    if (!name || name[0] != \'v\' || name[1] != \'k\') return NULL;\n'
+        tables += '\n'
+        tables += '    name += 2;\n'
+        tables += '    const struct loader_dispatch_name_entry *entry = &loader_device_names[loader_dispatch_name_slot(\n'
+        tables += '        loader_device_name_displacements, LOADER_DEVICE_NAME_COUNT, name)];\n'
+        tables += '    if (strcmp(name, entry->name) || entry->offset == LOADER_DISPATCH_NO_OFFSET) return NULL;\n'
+        tables += '    return *(void *const *)((const char *)table + entry->offset);\n'
+        tables += '}\n\n'
+
+        tables += '// Instance command lookup function\n'
+        tables += 'VKAPI_ATTR void* VKAPI_CALL loader_lookup_instance_dispatch_table(const VkLayerInstanceDispatchTable *table, const char *name,\n'
+        tables += '                                                                 bool *found_name) {\n'
+        tables += '    if (!name || name[0] != \'v\' || name[1] != \'k\') {\n'
+        tables += '        *found_name = false;\n'
+        tables += '        return NULL;\n'
+        tables += '    }\n'
+        tables += '\n'
+        tables += '    name += 2;\n'
+        tables += '    const struct loader_dispatch_name_entry *entry = &loader_instance_names[loader_dispatch_name_slot(\n'
+        tables += '        loader_instance_name_displacements, LOADER_INSTANCE_NAME_COUNT, name)];\n'
+        tables += '    if (strcmp(name, entry->name) || entry->offset == LOADER_DISPATCH_NO_OFFSET) {\n'
+        tables += '        *found_name = false;\n'
+        tables += '        return NULL;\n'
+        tables += '    }\n'
+        tables += '\n'
+        tables += '    *found_name = true;\n'
+        tables += '    return *(void *const *)((const char *)table + entry->offset);\n'
+        tables += '}\n\n'
+
+        tables += '// Core command trampoline lookup function\n'
+        tables += 'void *loader_lookup_core_trampoline(const char *name) {\n'
+        tables += '    if (!name || name[0] != \'v\' || name[1] != \'k\') return NULL;\n'
+        tables += '\n'
+        tables += '    name += 2;\n'
+        tables += '    const struct loader_trampoline_name_entry *entry = &loader_core_trampoline_names[loader_dispatch_name_slot(\n'
+        tables += '        loader_core_trampoline_name_displacements, LOADER_CORE_TRAMPOLINE_NAME_COUNT, name)];\n'
+        tables += '    if (strcmp(name, entry->name)) return NULL;\n'
+        tables += '    return entry->addr;\n'
+        tables += '}\n\n'
         return tables
 
+    #
+    # Output the perfect hash displacements and slot ordered entries for one lookup table.  With a
+    # dispatch table type the entries hold offsets into it, otherwise they hold the trampolines.
+    def OutputDispatchNameTable(self, table_name, table_type, commands):
+        commands_by_name = {}
+        for cur_cmd in commands:
+            commands_by_name[cur_cmd.name[2:]] = cur_cmd
+        slots, displacements = BuildDispatchNamePerfectHash(list(commands_by_name.keys()))
+
+        count_define = 'LOADER_%s_NAME_COUNT' % table_name.upper()
+        table = ''
+        table += '#define %s %d\n' % (count_define, len(slots))
+        table += '\n'
+        table += 'static const int32_t loader_%s_name_displacements[%s] = {\n' % (table_name, count_define)
+        for line_start in range(0, len(displacements), 16):
+            table += '    %s,\n' % ', '.join(str(d) for d in displacements[line_start:line_start + 16])
+        table += '};\n'
+        table += '\n'
+        if table_type is not None:
+            table += 'static const struct loader_dispatch_name_entry loader_%s_names[%s] = {\n' % (table_name, count_define)
+        else:
+            table += 'static const struct loader_trampoline_name_entry loader_%s_names[%s] = {\n' % (table_name, count_define)
+        for base_name in slots:
+            cur_cmd = commands_by_name[base_name]
+            if table_type is None:
+                table += '    {"%s", (void *)%s},\n' % (base_name, cur_cmd.name)
+            elif cur_cmd.protect is None:
+                table += '    {"%s", offsetof(%s, %s)},\n' % (base_name, table_type, base_name)
+            else:
+                table += '#ifdef %s\n' % cur_cmd.protect
+                table += '    {"%s", offsetof(%s, %s)},\n' % (base_name, table_type, base_name)
+                table += '#else\n'
+                table += '    {"%s", LOADER_DISPATCH_NO_OFFSET},\n' % base_name
+                table += '#endif // %s\n' % cur_cmd.protect
+        table += '};\n'
+        table += '\n'
+        return table
+
     #
     # Create the appropriate trampoline (and possibly terminator) functinos
     def CreateTrampTermFuncs(self):
@@ -980,14 +1096,14 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
                     requires_terminator = 1
                     always_use_param_name = False
                     surface_type_to_replace = 'VkSurfaceKHR'
-                    surface_name_replacement = 'icd_surface->real_icd_surfaces[icd_index]'
+                    surface_name_replacement = 'real_icd_surface'
                 if param.type == 'VkPhysicalDeviceSurfaceInfo2KHR':
                     has_surface = 1
                     surface_var_name = param.name + '->surface'
                     requires_terminator = 1
                     update_structure_surface = 1
                     update_structure_string = '        VkPhysicalDeviceSurfaceInfo2KHR info_copy = *pSurfaceInfo;\n'
-                    update_structure_string += '        info_copy.surface = icd_surface->real_icd_surfaces[icd_index];\n'
+                    update_structure_string += '        info_copy.surface = real_icd_surface;\n'
                     always_use_param_name = False
                     surface_type_to_replace = 'VkPhysicalDeviceSurfaceInfo2KHR'
                     surface_name_replacement = '&info_copy'
@@ -1100,9 +1216,12 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
                     funcs += '    }\n'
 
                     if has_surface == 1:
-                        funcs += '    VkIcdSurface *icd_surface = (VkIcdSurface *)(%s);\n' % (surface_var_name)
-                        funcs += '    uint8_t icd_index = phys_dev_term->icd_index;\n'
-                        funcs += '    if (NULL != icd_surface->real_icd_surfaces && NULL != (void *)icd_surface->real_icd_surfaces[icd_index]) {\n'
+                        funcs += '    VkSurfaceKHR real_icd_surface;\n'
+                        funcs += '    VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)(%s), phys_dev_term->icd_index, &real_icd_surface);\n' % (surface_var_name)
+                        funcs += '    if (VK_SUCCESS != res) {\n'
+                        funcs += '        return%s;\n' % (' res' if has_return_type else '')
+                        funcs += '    }\n'
+                        funcs += '    if ((VkSurfaceKHR)NULL != real_icd_surface) {\n'
 
                         # If there's a structure with a surface, we need to update its internals with the correct surface for the ICD
                         if update_structure_surface == 1:
@@ -1154,8 +1273,12 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
                     funcs += '    struct loader_device *dev;\n'
                     funcs += '    struct loader_icd_term *icd_term = loader_get_icd_and_device(device, &dev, &icd_index);\n'
                     funcs += '    if (NULL != icd_term && NULL != icd_term->dispatch.%s) {\n' % base_name
-                    funcs += '        VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)%s;\n' % (surface_var_name)
-                    funcs += '        if (NULL != icd_surface->real_icd_surfaces && (VkSurfaceKHR)NULL != icd_surface->real_icd_surfaces[icd_index]) {\n'
+                    funcs += '        VkSurfaceKHR real_icd_surface;\n'
+                    funcs += '        VkResult res = wsi_get_icd_surface(icd_term, (VkIcdSurface *)(uintptr_t)%s, icd_index, &real_icd_surface);\n' % (surface_var_name)
+                    funcs += '        if (VK_SUCCESS != res) {\n'
+                    funcs += '            return%s;\n' % (' res' if has_return_type else '')
+                    funcs += '        }\n'
+                    funcs += '        if ((VkSurfaceKHR)NULL != real_icd_surface) {\n'
                     funcs += '        %sicd_term->dispatch.%s(' % (return_prefix, base_name)
                     count = 0
                     for param in ext_cmd.params:
@@ -1163,7 +1286,7 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
                             funcs += ', '
 
                         if param.type == 'VkSurfaceKHR':
-                            funcs += 'icd_surface->real_icd_surfaces[icd_index]'
+                            funcs += 'real_icd_surface'
                         else:
                             funcs += param.name
 
@@ -1205,7 +1328,12 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
                         funcs += '            if (NULL != icd_term && NULL != icd_term->dispatch.CreateSwapchainKHR) {\n'
                         funcs += '                VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)pNameInfo->object;\n'
                         funcs += '                if (NULL != icd_surface->real_icd_surfaces) {\n'
-                        funcs += '                    local_name_info.object = (uint64_t)icd_surface->real_icd_surfaces[icd_index];\n'
+                        funcs += '                    VkSurfaceKHR real_icd_surface;\n'
+                        funcs += '                    VkResult res = wsi_get_icd_surface(icd_term, icd_surface, icd_index, &real_icd_surface);\n'
+                        funcs += '                    if (VK_SUCCESS != res) {\n'
+                        funcs += '                        return res;\n'
+                        funcs += '                    }\n'
+                        funcs += '                    local_name_info.object = (uint64_t)real_icd_surface;\n'
                         funcs += '                }\n'
                         funcs += '            }\n'
                         funcs += '        }\n'
@@ -1221,7 +1349,12 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
                         funcs += '            if (NULL != icd_term && NULL != icd_term->dispatch.CreateSwapchainKHR) {\n'
                         funcs += '                VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)pTagInfo->object;\n'
                         funcs += '                if (NULL != icd_surface->real_icd_surfaces) {\n'
-                        funcs += '                    local_tag_info.object = (uint64_t)icd_surface->real_icd_surfaces[icd_index];\n'
+                        funcs += '                    VkSurfaceKHR real_icd_surface;\n'
+                        funcs += '                    VkResult res = wsi_get_icd_surface(icd_term, icd_surface, icd_index, &real_icd_surface);\n'
+                        funcs += '                    if (VK_SUCCESS != res) {\n'
+                        funcs += '                        return res;\n'
+                        funcs += '                    }\n'
+                        funcs += '                    local_tag_info.object = (uint64_t)real_icd_surface;\n'
                         funcs += '                }\n'
                         funcs += '            }\n'
                         funcs += '        }\n'
@@ -1237,7 +1370,12 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
                         funcs += '            if (NULL != icd_term && NULL != icd_term->dispatch.CreateSwapchainKHR) {\n'
                         funcs += '                VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)pNameInfo->objectHandle;\n'
                         funcs += '                if (NULL != icd_surface->real_icd_surfaces) {\n'
-                        funcs += '                    local_name_info.objectHandle = (uint64_t)icd_surface->real_icd_surfaces[icd_index];\n'
+                        funcs += '                    VkSurfaceKHR real_icd_surface;\n'
+                        funcs += '                    VkResult res = wsi_get_icd_surface(icd_term, icd_surface, icd_index, &real_icd_surface);\n'
+                        funcs += '                    if (VK_SUCCESS != res) {\n'
+                        funcs += '                        return res;\n'
+                        funcs += '                    }\n'
+                        funcs += '                    local_name_info.objectHandle = (uint64_t)real_icd_surface;\n'
                         funcs += '                }\n'
                         funcs += '            }\n'
                         funcs += '        }\n'
@@ -1253,7 +1391,12 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
                         funcs += '            if (NULL != icd_term && NULL != icd_term->dispatch.CreateSwapchainKHR) {\n'
                         funcs += '                VkIcdSurface *icd_surface = (VkIcdSurface *)(uintptr_t)pTagInfo->objectHandle;\n'
                         funcs += '                if (NULL != icd_surface->real_icd_surfaces) {\n'
-                        funcs += '                    local_tag_info.objectHandle = (uint64_t)icd_surface->real_icd_surfaces[icd_index];\n'
+                        funcs += '                    VkSurfaceKHR real_icd_surface;\n'
+                        funcs += '                    VkResult res = wsi_get_icd_surface(icd_term, icd_surface, icd_index, &real_icd_surface);\n'
+                        funcs += '                    if (VK_SUCCESS != res) {\n'
+                        funcs += '                        return res;\n'
+                        funcs += '                    }\n'
+                        funcs += '                    local_tag_info.objectHandle = (uint64_t)real_icd_surface;\n'
                         funcs += '                }\n'
                         funcs += '            }\n'
                         funcs += '        }\n'
@@ -1271,7 +1414,7 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
                         if param.type == 'VkPhysicalDevice':
                             funcs += 'phys_dev_term->phys_dev'
                         elif param.type == 'VkSurfaceKHR':
-                            funcs += 'icd_surface->real_icd_surfaces[icd_index]'
+                            funcs += 'real_icd_surface'
                         elif ('DebugMarkerSetObject' in ext_cmd.name or 'SetDebugUtilsObject' in ext_cmd.name) and param.name == 'pNameInfo':
                             funcs += '&local_name_info'
                         elif ('DebugMarkerSetObject' in ext_cmd.name or 'SetDebugUtilsObject' in ext_cmd.name) and param.name == 'pTagInfo':
@@ -1324,52 +1467,88 @@ class LoaderExtensionOutputGenerator(OutputGenerator):
 
 
     #
-    # Create a function for the extension GPA call
+    # Create a function for the extension GPA call.  The commands go in a minimal perfect hash like
+    # the dispatch lookups, each with the instance extension that has to be enabled for it, if any.
     def InstExtensionGPA(self):
-        entries = []
-        gpa_func = ''
-        cur_extension_name = ''
-
-        gpa_func += '// GPA helpers for extensions\n'
-        gpa_func += 'bool extension_instance_gpa(struct loader_instance *ptr_instance, const char *name, void **addr) {\n'
-        gpa_func += '    *addr = NULL;\n\n'
-
+        commands_by_name = {}
+        checks = []
         for cur_cmd in self.ext_commands:
             if ('VK_VERSION_' in cur_cmd.ext_name or
                 cur_cmd.ext_name in WSI_EXT_NAMES or
                 cur_cmd.ext_name in AVOID_EXT_NAMES or
                 cur_cmd.name in AVOID_CMD_NAMES ):
                 continue
+            if cur_cmd.name[2:] in commands_by_name:
+                continue
 
-            if cur_cmd.ext_name != cur_extension_name:
-                gpa_func += '\n    // ---- %s extension commands\n' % cur_cmd.ext_name
-                cur_extension_name = cur_cmd.ext_name
-
-            if cur_cmd.protect is not None:
-                gpa_func += '#ifdef %s\n' % cur_cmd.protect
-
-            #base_name = cur_cmd.name[2:]
+            check = 'ALWAYS'
+            if cur_cmd.ext_type == 'instance':
+                check = cur_cmd.ext_name[3:].upper()
+                if check not in checks:
+                    checks.append(check)
             base_name = SHARED_ALIASES[cur_cmd.name] if cur_cmd.name in SHARED_ALIASES else cur_cmd.name[2:]
+            commands_by_name[cur_cmd.name[2:]] = (base_name, check, cur_cmd.protect)
+        slots, displacements = BuildDispatchNamePerfectHash(list(commands_by_name.keys()))
 
-            if (cur_cmd.ext_type == 'instance'):
-                gpa_func += '    if (!strcmp("%s", name)) {\n' % (cur_cmd.name)
-                gpa_func += '        *addr = (ptr_instance->enabled_known_extensions.'
-                gpa_func += cur_cmd.ext_name[3:].lower()
-                gpa_func += ' == 1)\n'
-                gpa_func += '                     ? (void *)%s\n' % (base_name)
-                gpa_func += '                     : NULL;\n'
-                gpa_func += '        return true;\n'
-                gpa_func += '    }\n'
+        gpa_func = ''
+        gpa_func += '// Extension entry points vkGetInstanceProcAddr hands out, looked up the same way as the dispatch\n'
+        gpa_func += '// tables.  Commands of instance extensions are only handed out once their extension is enabled.\n'
+        gpa_func += 'enum loader_extension_trampoline_check {\n'
+        gpa_func += '    LOADER_EXTENSION_TRAMPOLINE_ALWAYS,\n'
+        for check in checks:
+            gpa_func += '    LOADER_EXTENSION_TRAMPOLINE_%s,\n' % check
+        gpa_func += '};\n'
+        gpa_func += '\n'
+        gpa_func += 'struct loader_extension_trampoline_name_entry {\n'
+        gpa_func += '    const char *name;  // without the "vk" prefix\n'
+        gpa_func += '    void *addr;        // NULL if the command isn\'t compiled in on this platform\n'
+        gpa_func += '    uint32_t check;\n'
+        gpa_func += '};\n'
+        gpa_func += '\n'
+        gpa_func += '#define LOADER_EXTENSION_TRAMPOLINE_NAME_COUNT %d\n' % len(slots)
+        gpa_func += '\n'
+        gpa_func += 'static const int32_t loader_extension_trampoline_name_displacements[LOADER_EXTENSION_TRAMPOLINE_NAME_COUNT] = {\n'
+        for line_start in range(0, len(displacements), 16):
+            gpa_func += '    %s,\n' % ', '.join(str(d) for d in displacements[line_start:line_start + 16])
+        gpa_func += '};\n'
+        gpa_func += '\n'
+        gpa_func += 'static const struct loader_extension_trampoline_name_entry loader_extension_trampoline_names[LOADER_EXTENSION_TRAMPOLINE_NAME_COUNT] = {\n'
+        for name in slots:
+            base_name, check, protect = commands_by_name[name]
+            if protect is None:
+                gpa_func += '    {"%s", (void *)%s, LOADER_EXTENSION_TRAMPOLINE_%s},\n' % (name, base_name, check)
             else:
-                gpa_func += '    if (!strcmp("%s", name)) {\n' % (cur_cmd.name)
-                gpa_func += '        *addr = (void *)%s;\n' % (base_name)
-                gpa_func += '        return true;\n'
-                gpa_func += '    }\n'
-
-            if cur_cmd.protect is not None:
-                gpa_func += '#endif // %s\n' % cur_cmd.protect
-
-        gpa_func += '    return false;\n'
+                gpa_func += '#ifdef %s\n' % protect
+                gpa_func += '    {"%s", (void *)%s, LOADER_EXTENSION_TRAMPOLINE_%s},\n' % (name, base_name, check)
+                gpa_func += '#else\n'
+                gpa_func += '    {"%s", NULL, LOADER_EXTENSION_TRAMPOLINE_%s},\n' % (name, check)
+                gpa_func += '#endif // %s\n' % protect
+        gpa_func += '};\n'
+        gpa_func += '\n'
+        gpa_func += 'static bool loader_extension_trampoline_enabled(const struct loader_instance *ptr_instance, uint32_t check) {\n'
+        gpa_func += '    switch (check) {\n'
+        for check in checks:
+            gpa_func += '        case LOADER_EXTENSION_TRAMPOLINE_%s:\n' % check
+            gpa_func += '            return ptr_instance->enabled_known_extensions.%s == 1;\n' % check.lower()
+        gpa_func += '        default:\n'
+        gpa_func += '            return true;\n'
+        gpa_func += '    }\n'
+        gpa_func += '}\n'
+        gpa_func += '\n'
+        gpa_func += '// GPA helpers for extensions\n'
+        gpa_func += 'bool extension_instance_gpa(struct loader_instance *ptr_instance, const char *name, void **addr) {\n'
+        gpa_func += '    *addr = NULL;\n'
+        gpa_func += '    if (!name || name[0] != \'v\' || name[1] != \'k\') return false;\n'
+        gpa_func += '\n'
+        gpa_func += '    name += 2;\n'
+        gpa_func += '    const struct loader_extension_trampoline_name_entry *entry = &loader_extension_trampoline_names[loader_dispatch_name_slot(\n'
+        gpa_func += '        loader_extension_trampoline_name_displacements, LOADER_EXTENSION_TRAMPOLINE_NAME_COUNT, name)];\n'
+        gpa_func += '    if (strcmp(name, entry->name) || NULL == entry->addr) return false;\n'
+        gpa_func += '\n'
+        gpa_func += '    if (loader_extension_trampoline_enabled(ptr_instance, entry->check)) {\n'
+        gpa_func += '        *addr = entry->addr;\n'
+        gpa_func += '    }\n'
+        gpa_func += '    return true;\n'
         gpa_func += '}\n\n'
 
         return gpa_func
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// A driver for the loader tests that has one physical device and does nothing with it.
+//
+// The same source builds two ICDs, so tests can run the loader with two drivers that behave
+// differently.  VkICD_test_icd exports vkLoaderTestIcdUnknownFunction, a device function the
+// loader doesn't know about.  VkICD_test_icd_minimal, built with TEST_ICD_MINIMAL, doesn't, and
+// fails the first headless surface it's asked to create in each instance.  The name of each one's
+// physical device says which it is.
+
+#include <string.h>
+
+#include "vulkan/vk_icd.h"
+
+#if defined(__GNUC__) && __GNUC__ >= 4
+#define TEST_ICD_EXPORT __attribute__((visibility("default")))
+#else
+#define TEST_ICD_EXPORT
+#endif
+
+#if defined(TEST_ICD_MINIMAL)
+#define TEST_ICD_DEVICE_NAME "Loader test ICD (minimal)"
+#else
+#define TEST_ICD_DEVICE_NAME "Loader test ICD"
+#endif
+
+namespace test_icd {
+
+// The loader writes its dispatch pointer over the start of every dispatchable handle
+struct PhysicalDevice {
+    VK_LOADER_DATA loader_data;
+};
+
+struct Instance {
+    VK_LOADER_DATA loader_data;
+    PhysicalDevice physical_device;
+    uint32_t surfaces_created;
+};
+
+struct Device {
+    VK_LOADER_DATA loader_data;
+};
+
+// The formats and present modes returned for a surface say how many times they've been asked for,
+// so tests can tell whether the loader passed a query down or answered it itself
+struct Surface {
+    uint32_t format_queries;
+    uint32_t present_mode_queries;
+};
+
+static const VkExtensionProperties instance_extensions[] = {
+    {VK_KHR_SURFACE_EXTENSION_NAME, VK_KHR_SURFACE_SPEC_VERSION},
+    {VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_SPEC_VERSION},
+};
+
+static VKAPI_ATTR VkResult VKAPI_CALL CreateInstance(const VkInstanceCreateInfo *, const VkAllocationCallbacks *,
+                                                     VkInstance *pInstance) {
+    Instance *instance = new Instance();
+    set_loader_magic_value(instance);
+    set_loader_magic_value(&instance->physical_device);
+    *pInstance = reinterpret_cast<VkInstance>(instance);
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL DestroyInstance(VkInstance instance, const VkAllocationCallbacks *) {
+    delete reinterpret_cast<Instance *>(instance);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL EnumerateInstanceExtensionProperties(const char *, uint32_t *pPropertyCount,
+                                                                           VkExtensionProperties *pProperties) {
+    const uint32_t count = sizeof(instance_extensions) / sizeof(instance_extensions[0]);
+    if (NULL == pProperties) {
+        *pPropertyCount = count;
+        return VK_SUCCESS;
+    }
+    const uint32_t copy_count = *pPropertyCount < count ? *pPropertyCount : count;
+    memcpy(pProperties, instance_extensions, copy_count * sizeof(VkExtensionProperties));
+    *pPropertyCount = copy_count;
+    return copy_count < count ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL EnumeratePhysicalDevices(VkInstance instance, uint32_t *pPhysicalDeviceCount,
+                                                               VkPhysicalDevice *pPhysicalDevices) {
+    if (NULL == pPhysicalDevices) {
+        *pPhysicalDeviceCount = 1;
+        return VK_SUCCESS;
+    }
+    if (0 == *pPhysicalDeviceCount) {
+        return VK_INCOMPLETE;
+    }
+    pPhysicalDevices[0] = reinterpret_cast<VkPhysicalDevice>(&reinterpret_cast<Instance *>(instance)->physical_device);
+    *pPhysicalDeviceCount = 1;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFeatures(VkPhysicalDevice, VkPhysicalDeviceFeatures *pFeatures) {
+    memset(pFeatures, 0, sizeof(*pFeatures));
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceFormatProperties(VkPhysicalDevice, VkFormat,
+                                                                    VkFormatProperties *pFormatProperties) {
+    memset(pFormatProperties, 0, sizeof(*pFormatProperties));
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceImageFormatProperties(VkPhysicalDevice, VkFormat, VkImageType,
+                                                                             VkImageTiling, VkImageUsageFlags,
+                                                                             VkImageCreateFlags, VkImageFormatProperties *) {
+    return VK_ERROR_FORMAT_NOT_SUPPORTED;
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceProperties(VkPhysicalDevice, VkPhysicalDeviceProperties *pProperties) {
+    memset(pProperties, 0, sizeof(*pProperties));
+    pProperties->apiVersion = VK_MAKE_VERSION(1, 0, VK_HEADER_VERSION);
+    pProperties->deviceType = VK_PHYSICAL_DEVICE_TYPE_CPU;
+    strncpy(pProperties->deviceName, TEST_ICD_DEVICE_NAME, VK_MAX_PHYSICAL_DEVICE_NAME_SIZE - 1);
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceQueueFamilyProperties(VkPhysicalDevice, uint32_t *pQueueFamilyPropertyCount,
+                                                                         VkQueueFamilyProperties *pQueueFamilyProperties) {
+    if (NULL == pQueueFamilyProperties) {
+        *pQueueFamilyPropertyCount = 1;
+        return;
+    }
+    if (0 < *pQueueFamilyPropertyCount) {
+        memset(pQueueFamilyProperties, 0, sizeof(*pQueueFamilyProperties));
+        pQueueFamilyProperties->queueFlags = VK_QUEUE_GRAPHICS_BIT;
+        pQueueFamilyProperties->queueCount = 1;
+        *pQueueFamilyPropertyCount = 1;
+    }
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceMemoryProperties(VkPhysicalDevice,
+                                                                    VkPhysicalDeviceMemoryProperties *pMemoryProperties) {
+    memset(pMemoryProperties, 0, sizeof(*pMemoryProperties));
+}
+
+static VKAPI_ATTR void VKAPI_CALL GetPhysicalDeviceSparseImageFormatProperties(VkPhysicalDevice, VkFormat, VkImageType,
+                                                                               VkSampleCountFlagBits, VkImageUsageFlags,
+                                                                               VkImageTiling, uint32_t *pPropertyCount,
+                                                                               VkSparseImageFormatProperties *) {
+    *pPropertyCount = 0;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL EnumerateDeviceExtensionProperties(VkPhysicalDevice, const char *, uint32_t *pPropertyCount,
+                                                                         VkExtensionProperties *) {
+    *pPropertyCount = 0;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice, const VkDeviceCreateInfo *, const VkAllocationCallbacks *,
+                                                   VkDevice *pDevice) {
+    Device *device = new Device();
+    set_loader_magic_value(device);
+    *pDevice = reinterpret_cast<VkDevice>(device);
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCallbacks *) {
+    delete reinterpret_cast<Device *>(device);
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL CreateHeadlessSurfaceEXT(VkInstance instance, const VkHeadlessSurfaceCreateInfoEXT *,
+                                                               const VkAllocationCallbacks *, VkSurfaceKHR *pSurface) {
+#if defined(TEST_ICD_MINIMAL)
+    if (0 == reinterpret_cast<Instance *>(instance)->surfaces_created++) {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+#else
+    reinterpret_cast<Instance *>(instance)->surfaces_created++;
+#endif
+    *pSurface = (VkSurfaceKHR)(uintptr_t) new Surface();
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL DestroySurfaceKHR(VkInstance, VkSurfaceKHR surface, const VkAllocationCallbacks *) {
+    delete (Surface *)(uintptr_t)surface;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceSupportKHR(VkPhysicalDevice, uint32_t, VkSurfaceKHR,
+                                                                         VkBool32 *pSupported) {
+    *pSupported = VK_TRUE;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceCapabilitiesKHR(VkPhysicalDevice, VkSurfaceKHR,
+                                                                              VkSurfaceCapabilitiesKHR *pSurfaceCapabilities) {
+    memset(pSurfaceCapabilities, 0, sizeof(*pSurfaceCapabilities));
+    pSurfaceCapabilities->minImageCount = 1;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfaceFormatsKHR(VkPhysicalDevice, VkSurfaceKHR surface,
+                                                                         uint32_t *pSurfaceFormatCount,
+                                                                         VkSurfaceFormatKHR *pSurfaceFormats) {
+    if (NULL == pSurfaceFormats) {
+        *pSurfaceFormatCount = 1;
+        return VK_SUCCESS;
+    }
+    if (0 == *pSurfaceFormatCount) {
+        return VK_INCOMPLETE;
+    }
+    pSurfaceFormats[0].format = static_cast<VkFormat>(++((Surface *)(uintptr_t)surface)->format_queries);
+    pSurfaceFormats[0].colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+    *pSurfaceFormatCount = 1;
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL GetPhysicalDeviceSurfacePresentModesKHR(VkPhysicalDevice, VkSurfaceKHR surface,
+                                                                              uint32_t *pPresentModeCount,
+                                                                              VkPresentModeKHR *pPresentModes) {
+    if (NULL == pPresentModes) {
+        *pPresentModeCount = 1;
+        return VK_SUCCESS;
+    }
+    if (0 == *pPresentModeCount) {
+        return VK_INCOMPLETE;
+    }
+    pPresentModes[0] = static_cast<VkPresentModeKHR>(++((Surface *)(uintptr_t)surface)->present_mode_queries);
+    *pPresentModeCount = 1;
+    return VK_SUCCESS;
+}
+
+#if !defined(TEST_ICD_MINIMAL)
+// Returns a value the loader's vkDevExtError doesn't, so tests can tell it reached the ICD
+static VKAPI_ATTR VkResult VKAPI_CALL LoaderTestIcdUnknownFunction(VkDevice) { return VK_SUCCESS; }
+#endif
+
+static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice, const char *pName);
+
+struct NamedFunction {
+    const char *name;
+    PFN_vkVoidFunction function;
+};
+
+#define TEST_ICD_FUNCTION(name, function) \
+    { name, reinterpret_cast<PFN_vkVoidFunction>(function) }
+
+static const NamedFunction instance_functions[] = {
+    TEST_ICD_FUNCTION("vkCreateInstance", CreateInstance),
+    TEST_ICD_FUNCTION("vkDestroyInstance", DestroyInstance),
+    TEST_ICD_FUNCTION("vkEnumerateInstanceExtensionProperties", EnumerateInstanceExtensionProperties),
+    TEST_ICD_FUNCTION("vkEnumeratePhysicalDevices", EnumeratePhysicalDevices),
+    TEST_ICD_FUNCTION("vkGetPhysicalDeviceFeatures", GetPhysicalDeviceFeatures),
+    TEST_ICD_FUNCTION("vkGetPhysicalDeviceFormatProperties", GetPhysicalDeviceFormatProperties),
+    TEST_ICD_FUNCTION("vkGetPhysicalDeviceImageFormatProperties", GetPhysicalDeviceImageFormatProperties),
+    TEST_ICD_FUNCTION("vkGetPhysicalDeviceProperties", GetPhysicalDeviceProperties),
+    TEST_ICD_FUNCTION("vkGetPhysicalDeviceQueueFamilyProperties", GetPhysicalDeviceQueueFamilyProperties),
+    TEST_ICD_FUNCTION("vkGetPhysicalDeviceMemoryProperties", GetPhysicalDeviceMemoryProperties),
+    TEST_ICD_FUNCTION("vkGetPhysicalDeviceSparseImageFormatProperties", GetPhysicalDeviceSparseImageFormatProperties),
+    TEST_ICD_FUNCTION("vkEnumerateDeviceExtensionProperties", EnumerateDeviceExtensionProperties),
+    TEST_ICD_FUNCTION("vkCreateDevice", CreateDevice),
+    TEST_ICD_FUNCTION("vkCreateHeadlessSurfaceEXT", CreateHeadlessSurfaceEXT),
+    TEST_ICD_FUNCTION("vkDestroySurfaceKHR", DestroySurfaceKHR),
+    TEST_ICD_FUNCTION("vkGetPhysicalDeviceSurfaceSupportKHR", GetPhysicalDeviceSurfaceSupportKHR),
+    TEST_ICD_FUNCTION("vkGetPhysicalDeviceSurfaceCapabilitiesKHR", GetPhysicalDeviceSurfaceCapabilitiesKHR),
+    TEST_ICD_FUNCTION("vkGetPhysicalDeviceSurfaceFormatsKHR", GetPhysicalDeviceSurfaceFormatsKHR),
+    TEST_ICD_FUNCTION("vkGetPhysicalDeviceSurfacePresentModesKHR", GetPhysicalDeviceSurfacePresentModesKHR),
+};
+
+static const NamedFunction device_functions[] = {
+    TEST_ICD_FUNCTION("vkGetDeviceProcAddr", GetDeviceProcAddr),
+    TEST_ICD_FUNCTION("vkDestroyDevice", DestroyDevice),
+#if !defined(TEST_ICD_MINIMAL)
+    TEST_ICD_FUNCTION("vkLoaderTestIcdUnknownFunction", LoaderTestIcdUnknownFunction),
+#endif
+};
+
+template <size_t N>
+static PFN_vkVoidFunction FindFunction(const NamedFunction (&functions)[N], const char *pName) {
+    for (size_t i = 0; i < N; ++i) {
+        if (!strcmp(functions[i].name, pName)) {
+            return functions[i].function;
+        }
+    }
+    return NULL;
+}
+
+static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice, const char *pName) {
+    return FindFunction(device_functions, pName);
+}
+
+}  // namespace test_icd
+
+extern "C" {
+
+TEST_ICD_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vk_icdNegotiateLoaderICDInterfaceVersion(uint32_t *pSupportedVersion) {
+    if (*pSupportedVersion > 4) {
+        *pSupportedVersion = 4;
+    }
+    return VK_SUCCESS;
+}
+
+// Device functions are returned too, which is how the loader finds out an ICD has an unknown one
+TEST_ICD_EXPORT VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vk_icdGetInstanceProcAddr(VkInstance, const char *pName) {
+    PFN_vkVoidFunction function = test_icd::FindFunction(test_icd::instance_functions, pName);
+    return NULL != function ? function : test_icd::FindFunction(test_icd::device_functions, pName);
+}
+
+// There are no physical device functions the loader doesn't know about
+TEST_ICD_EXPORT VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vk_icdGetPhysicalDeviceProcAddr(VkInstance, const char *) { return NULL; }
+
+}  // extern "C"
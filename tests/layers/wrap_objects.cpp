@@ -1432,6 +1432,47 @@ static inline PFN_vkVoidFunction layer_intercept_instance_proc(const char *name)
     return NULL;
 }
 
+// Functions the loader knows nothing about, for testing how many of them it can hand out.  Each
+// writes its own index, so a test can tell the right one was reached.
+static const uint32_t unknown_function_count = 300;
+
+template <uint32_t N>
+VKAPI_ATTR VkResult VKAPI_CALL UnknownFunction(void *, uint32_t *pIndex) {
+    *pIndex = N;
+    return VK_SUCCESS;
+}
+
+// Fills table[Begin, Begin + Count) by halves, which keeps template recursion shallow
+template <uint32_t Begin, uint32_t Count>
+struct UnknownFunctionTable {
+    static void Fill(PFN_vkVoidFunction *table) {
+        UnknownFunctionTable<Begin, Count / 2>::Fill(table);
+        UnknownFunctionTable<Begin + Count / 2, Count - Count / 2>::Fill(table);
+    }
+};
+
+template <uint32_t Begin>
+struct UnknownFunctionTable<Begin, 1> {
+    static void Fill(PFN_vkVoidFunction *table) { table[Begin] = reinterpret_cast<PFN_vkVoidFunction>(UnknownFunction<Begin>); }
+};
+
+// Returns UnknownFunction<N> for prefix followed by N
+static PFN_vkVoidFunction layer_intercept_unknown_proc(const char *name, const char *prefix) {
+    static PFN_vkVoidFunction table[unknown_function_count];
+    if (table[0] == NULL) {
+        UnknownFunctionTable<0, unknown_function_count>::Fill(table);
+    }
+
+    size_t prefix_len = strlen(prefix);
+    if (strncmp(name, prefix, prefix_len) != 0 || name[prefix_len] < '0' || name[prefix_len] > '9')
+        return NULL;
+    char *end;
+    unsigned long index = strtoul(name + prefix_len, &end, 10);
+    if (*end != '\0' || index >= unknown_function_count)
+        return NULL;
+    return table[index];
+}
+
 VK_LAYER_EXPORT VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetDeviceProcAddr(VkDevice device, const char* funcName)
 {
     PFN_vkVoidFunction addr;
@@ -1459,6 +1500,10 @@ VK_LAYER_EXPORT VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetDeviceProcAddr(VkD
     if (!strcmp("vkQueuePresentKHR", funcName))
         return reinterpret_cast<PFN_vkVoidFunction>(vkQueuePresentKHR);
 
+    addr = layer_intercept_unknown_proc(funcName, "vkLoaderTestUnknownDeviceFunction");
+    if (addr)
+        return addr;
+
     VkLayerDispatchTable *pDisp =  device_dispatch_table(device);
     if (pDisp->GetDeviceProcAddr == NULL)
     {
@@ -1535,6 +1580,10 @@ VK_LAYER_EXPORT VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetInstanceProcAddr(V
         return reinterpret_cast<PFN_vkVoidFunction>(vkGetPhysicalDeviceWin32PresentationSupportKHR);
 #endif // VK_USE_PLATFORM_WIN32_KHR
 
+    addr = layer_intercept_unknown_proc(funcName, "vkLoaderTestUnknownPhysicalDeviceFunction");
+    if (addr)
+        return addr;
+
     if (pTable->GetInstanceProcAddr == NULL)
         return NULL;
     return pTable->GetInstanceProcAddr(instance, funcName);
@@ -1547,6 +1596,10 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetPhysicalDeviceProcAddr(VkInstance in
     (void)unwrap_instance(instance, &inst);
     VkLayerInstanceDispatchTable* pTable = &inst->layer_disp;
 
+    PFN_vkVoidFunction addr = layer_intercept_unknown_proc(funcName, "vkLoaderTestUnknownPhysicalDeviceFunction");
+    if (addr)
+        return addr;
+
     if (pTable->GetPhysicalDeviceProcAddr == NULL)
         return NULL;
     return pTable->GetPhysicalDeviceProcAddr(instance, funcName);
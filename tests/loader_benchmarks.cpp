@@ -0,0 +1,809 @@
+/*
+ * Copyright (c) 2020 The Khronos Group Inc.
+ * Copyright (c) 2020 Valve Corporation
+ * Copyright (c) 2020 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Microbenchmarks for the loader's own overhead.  These are not unit tests and are not run by
+// ctest; run vk_loader_benchmarks directly, optionally with the names of the benchmarks to run.
+// Results depend on the installed drivers, so compare runs on the same machine only.
+
+#include <stdint.h>
+#include <sys/stat.h>
+#if defined(_WIN32)
+#include <direct.h>
+#endif
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+namespace {
+
+typedef std::chrono::steady_clock bench_clock;
+
+const std::chrono::milliseconds kRunTime(500);
+
+struct Benchmark {
+    const char *name;
+    const char *description;
+    bool (*run)();
+};
+
+VkInstance CreateInstance() {
+    VkInstanceCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    VkInstance instance = VK_NULL_HANDLE;
+    if (vkCreateInstance(&info, nullptr, &instance) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+    return instance;
+}
+
+VkPhysicalDevice FirstPhysicalDevice(VkInstance instance) {
+    uint32_t count = 1;
+    VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+    VkResult res = vkEnumeratePhysicalDevices(instance, &count, &physical_device);
+    if ((res != VK_SUCCESS && res != VK_INCOMPLETE) || count == 0) {
+        return VK_NULL_HANDLE;
+    }
+    return physical_device;
+}
+
+// One iteration of the contention workload: the entry points that used to serialize on the
+// global loader lock.
+void ContentionIteration(VkInstance instance) {
+    uint32_t count = 1;
+    VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+    vkEnumeratePhysicalDevices(instance, &count, &physical_device);
+    if (count == 0 || physical_device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    uint32_t ext_count = 0;
+    vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &ext_count, nullptr);
+
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queue_info = {};
+    queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue_info.queueFamilyIndex = 0;
+    queue_info.queueCount = 1;
+    queue_info.pQueuePriorities = &priority;
+
+    VkDeviceCreateInfo device_info = {};
+    device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    device_info.queueCreateInfoCount = 1;
+    device_info.pQueueCreateInfos = &queue_info;
+
+    VkDevice device = VK_NULL_HANDLE;
+    if (vkCreateDevice(physical_device, &device_info, nullptr, &device) == VK_SUCCESS) {
+        vkDestroyDevice(device, nullptr);
+    }
+}
+
+// Each thread owns its own instance and hammers enumerate/create/destroy on it.  Reports the
+// aggregate rate for each thread count and how many times the single thread rate that is.  How it
+// changes as threads are added depends on the driver, so compare the scaling against a build of the
+// loader from before the lock split on the same machine.
+bool InstanceContention() {
+    static const unsigned kThreadCounts[] = {1, 2, 4, 8, 16, 32};
+    double single_thread_rate = 0.0;
+
+    VkInstance probe = CreateInstance();
+    if (probe == VK_NULL_HANDLE) {
+        printf("    vkCreateInstance failed, skipping\n");
+        return false;
+    }
+    if (FirstPhysicalDevice(probe) == VK_NULL_HANDLE) {
+        printf("    no physical devices, measuring enumeration only\n");
+    }
+    vkDestroyInstance(probe, nullptr);
+
+    for (unsigned thread_count : kThreadCounts) {
+        std::vector<VkInstance> instances(thread_count, VK_NULL_HANDLE);
+        for (unsigned i = 0; i < thread_count; ++i) {
+            instances[i] = CreateInstance();
+            if (instances[i] == VK_NULL_HANDLE) {
+                printf("    vkCreateInstance failed for thread %u\n", i);
+                for (unsigned j = 0; j < i; ++j) vkDestroyInstance(instances[j], nullptr);
+                return false;
+            }
+        }
+
+        std::atomic<bool> start(false);
+        std::atomic<bool> stop(false);
+        std::vector<uint64_t> iterations(thread_count, 0);
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < thread_count; ++i) {
+            threads.emplace_back([&, i]() {
+                while (!start.load()) std::this_thread::yield();
+                uint64_t n = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    ContentionIteration(instances[i]);
+                    ++n;
+                }
+                iterations[i] = n;
+            });
+        }
+
+        bench_clock::time_point begin = bench_clock::now();
+        start.store(true);
+        std::this_thread::sleep_for(kRunTime);
+        stop.store(true);
+        for (std::thread &t : threads) t.join();
+        double seconds = std::chrono::duration<double>(bench_clock::now() - begin).count();
+
+        uint64_t total = 0;
+        for (uint64_t n : iterations) total += n;
+        double rate = total / seconds;
+        if (thread_count == 1) {
+            single_thread_rate = rate;
+        }
+        if (single_thread_rate > 0.0) {
+            printf("    %2u threads: %12.0f iterations/sec, %5.2fx one thread\n", thread_count, rate, rate / single_thread_rate);
+        } else {
+            printf("    %2u threads: %12.0f iterations/sec\n", thread_count, rate);
+        }
+
+        for (VkInstance instance : instances) vkDestroyInstance(instance, nullptr);
+    }
+    return true;
+}
+
+// Time a call that has to map its handle back to the loader's objects while more and more other
+// instances are alive.  The rate should not depend on the instance count.
+bool HandleLookup() {
+    static const uint32_t kExtraInstances[] = {0, 16, 64, 256};
+    const uint32_t kIterations = 200000;
+
+    VkInstance instance = CreateInstance();
+    if (instance == VK_NULL_HANDLE) {
+        printf("    vkCreateInstance failed, skipping\n");
+        return false;
+    }
+
+    std::vector<VkInstance> extra;
+    bool ok = true;
+    for (uint32_t target : kExtraInstances) {
+        while (extra.size() < target) {
+            VkInstance other = CreateInstance();
+            if (other == VK_NULL_HANDLE) {
+                printf("    vkCreateInstance failed after %u extra instances\n", static_cast<unsigned>(extra.size()));
+                ok = false;
+                break;
+            }
+            extra.push_back(other);
+        }
+        if (!ok) break;
+
+        bench_clock::time_point begin = bench_clock::now();
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            uint32_t count = 0;
+            vkEnumeratePhysicalDevices(instance, &count, nullptr);
+        }
+        double seconds = std::chrono::duration<double>(bench_clock::now() - begin).count();
+        printf("    %3u other instances: %8.1f ns/vkEnumeratePhysicalDevices\n", target, seconds * 1e9 / kIterations);
+    }
+
+    for (VkInstance other : extra) vkDestroyInstance(other, nullptr);
+    vkDestroyInstance(instance, nullptr);
+    return ok;
+}
+
+// Every core entry point, the way a loader library such as volk resolves the whole API at startup
+const char *const kCoreEntryPoints[] = {
+    "vkAllocateCommandBuffers", "vkAllocateDescriptorSets", "vkAllocateMemory", "vkBeginCommandBuffer", "vkBindBufferMemory",
+    "vkBindBufferMemory2", "vkBindImageMemory", "vkBindImageMemory2", "vkCmdBeginQuery", "vkCmdBeginRenderPass",
+    "vkCmdBeginRenderPass2", "vkCmdBindDescriptorSets", "vkCmdBindIndexBuffer", "vkCmdBindPipeline", "vkCmdBindVertexBuffers",
+    "vkCmdBlitImage", "vkCmdClearAttachments", "vkCmdClearColorImage", "vkCmdClearDepthStencilImage", "vkCmdCopyBuffer",
+    "vkCmdCopyBufferToImage", "vkCmdCopyImage", "vkCmdCopyImageToBuffer", "vkCmdCopyQueryPoolResults", "vkCmdDispatch",
+    "vkCmdDispatchBase", "vkCmdDispatchIndirect", "vkCmdDraw", "vkCmdDrawIndexed", "vkCmdDrawIndexedIndirect",
+    "vkCmdDrawIndexedIndirectCount", "vkCmdDrawIndirect", "vkCmdDrawIndirectCount", "vkCmdEndQuery", "vkCmdEndRenderPass",
+    "vkCmdEndRenderPass2", "vkCmdExecuteCommands", "vkCmdFillBuffer", "vkCmdNextSubpass", "vkCmdNextSubpass2",
+    "vkCmdPipelineBarrier", "vkCmdPushConstants", "vkCmdResetEvent", "vkCmdResetQueryPool", "vkCmdResolveImage",
+    "vkCmdSetBlendConstants", "vkCmdSetDepthBias", "vkCmdSetDepthBounds", "vkCmdSetDeviceMask", "vkCmdSetEvent",
+    "vkCmdSetLineWidth", "vkCmdSetScissor", "vkCmdSetStencilCompareMask", "vkCmdSetStencilReference", "vkCmdSetStencilWriteMask",
+    "vkCmdSetViewport", "vkCmdUpdateBuffer", "vkCmdWaitEvents", "vkCmdWriteTimestamp", "vkCreateBuffer", "vkCreateBufferView",
+    "vkCreateCommandPool", "vkCreateComputePipelines", "vkCreateDescriptorPool", "vkCreateDescriptorSetLayout",
+    "vkCreateDescriptorUpdateTemplate", "vkCreateDevice", "vkCreateEvent", "vkCreateFence", "vkCreateFramebuffer",
+    "vkCreateGraphicsPipelines", "vkCreateImage", "vkCreateImageView", "vkCreatePipelineCache", "vkCreatePipelineLayout",
+    "vkCreateQueryPool", "vkCreateRenderPass", "vkCreateRenderPass2", "vkCreateSampler", "vkCreateSamplerYcbcrConversion",
+    "vkCreateSemaphore", "vkCreateShaderModule", "vkDestroyBuffer", "vkDestroyBufferView", "vkDestroyCommandPool",
+    "vkDestroyDescriptorPool", "vkDestroyDescriptorSetLayout", "vkDestroyDescriptorUpdateTemplate", "vkDestroyDevice",
+    "vkDestroyEvent", "vkDestroyFence", "vkDestroyFramebuffer", "vkDestroyImage", "vkDestroyImageView", "vkDestroyInstance",
+    "vkDestroyPipeline", "vkDestroyPipelineCache", "vkDestroyPipelineLayout", "vkDestroyQueryPool", "vkDestroyRenderPass",
+    "vkDestroySampler", "vkDestroySamplerYcbcrConversion", "vkDestroySemaphore", "vkDestroyShaderModule", "vkDeviceWaitIdle",
+    "vkEndCommandBuffer", "vkEnumerateDeviceExtensionProperties", "vkEnumerateDeviceLayerProperties",
+    "vkEnumeratePhysicalDeviceGroups", "vkEnumeratePhysicalDevices", "vkFlushMappedMemoryRanges", "vkFreeCommandBuffers",
+    "vkFreeDescriptorSets", "vkFreeMemory", "vkGetBufferDeviceAddress", "vkGetBufferMemoryRequirements",
+    "vkGetBufferMemoryRequirements2", "vkGetBufferOpaqueCaptureAddress", "vkGetDescriptorSetLayoutSupport",
+    "vkGetDeviceGroupPeerMemoryFeatures", "vkGetDeviceMemoryCommitment", "vkGetDeviceMemoryOpaqueCaptureAddress",
+    "vkGetDeviceProcAddr", "vkGetDeviceQueue", "vkGetDeviceQueue2", "vkGetEventStatus", "vkGetFenceStatus",
+    "vkGetImageMemoryRequirements", "vkGetImageMemoryRequirements2", "vkGetImageSparseMemoryRequirements",
+    "vkGetImageSparseMemoryRequirements2", "vkGetImageSubresourceLayout", "vkGetInstanceProcAddr",
+    "vkGetPhysicalDeviceExternalBufferProperties", "vkGetPhysicalDeviceExternalFenceProperties",
+    "vkGetPhysicalDeviceExternalSemaphoreProperties", "vkGetPhysicalDeviceFeatures", "vkGetPhysicalDeviceFeatures2",
+    "vkGetPhysicalDeviceFormatProperties", "vkGetPhysicalDeviceFormatProperties2", "vkGetPhysicalDeviceImageFormatProperties",
+    "vkGetPhysicalDeviceImageFormatProperties2", "vkGetPhysicalDeviceMemoryProperties", "vkGetPhysicalDeviceMemoryProperties2",
+    "vkGetPhysicalDeviceProperties", "vkGetPhysicalDeviceProperties2", "vkGetPhysicalDeviceQueueFamilyProperties",
+    "vkGetPhysicalDeviceQueueFamilyProperties2", "vkGetPhysicalDeviceSparseImageFormatProperties",
+    "vkGetPhysicalDeviceSparseImageFormatProperties2", "vkGetPipelineCacheData", "vkGetQueryPoolResults",
+    "vkGetRenderAreaGranularity", "vkGetSemaphoreCounterValue", "vkInvalidateMappedMemoryRanges", "vkMapMemory",
+    "vkMergePipelineCaches", "vkQueueBindSparse", "vkQueueSubmit", "vkQueueWaitIdle", "vkResetCommandBuffer", "vkResetCommandPool",
+    "vkResetDescriptorPool", "vkResetEvent", "vkResetFences", "vkResetQueryPool", "vkSetEvent", "vkSignalSemaphore",
+    "vkTrimCommandPool", "vkUnmapMemory", "vkUpdateDescriptorSetWithTemplate", "vkUpdateDescriptorSets", "vkWaitForFences",
+    "vkWaitSemaphores",
+};
+
+// Resolve every core entry point through vkGetInstanceProcAddr, and through vkGetDeviceProcAddr if a
+// device can be created.
+bool ProcAddrLookup() {
+    const uint32_t kRounds = 2000;
+    const uint32_t name_count = sizeof(kCoreEntryPoints) / sizeof(kCoreEntryPoints[0]);
+
+    VkInstance instance = CreateInstance();
+    if (instance == VK_NULL_HANDLE) {
+        printf("    vkCreateInstance failed, skipping\n");
+        return false;
+    }
+
+    uintptr_t sink = 0;
+    bench_clock::time_point begin = bench_clock::now();
+    for (uint32_t round = 0; round < kRounds; ++round) {
+        for (uint32_t i = 0; i < name_count; ++i) {
+            sink += reinterpret_cast<uintptr_t>(vkGetInstanceProcAddr(instance, kCoreEntryPoints[i]));
+        }
+    }
+    double seconds = std::chrono::duration<double>(bench_clock::now() - begin).count();
+    printf("    vkGetInstanceProcAddr: %8.1f ns/name\n", seconds * 1e9 / (kRounds * name_count));
+
+    VkPhysicalDevice physical_device = FirstPhysicalDevice(instance);
+    if (physical_device != VK_NULL_HANDLE) {
+        float priority = 1.0f;
+        VkDeviceQueueCreateInfo queue_info = {};
+        queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queue_info.queueFamilyIndex = 0;
+        queue_info.queueCount = 1;
+        queue_info.pQueuePriorities = &priority;
+
+        VkDeviceCreateInfo device_info = {};
+        device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        device_info.queueCreateInfoCount = 1;
+        device_info.pQueueCreateInfos = &queue_info;
+
+        VkDevice device = VK_NULL_HANDLE;
+        if (vkCreateDevice(physical_device, &device_info, nullptr, &device) == VK_SUCCESS) {
+            begin = bench_clock::now();
+            for (uint32_t round = 0; round < kRounds; ++round) {
+                for (uint32_t i = 0; i < name_count; ++i) {
+                    sink += reinterpret_cast<uintptr_t>(vkGetDeviceProcAddr(device, kCoreEntryPoints[i]));
+                }
+            }
+            seconds = std::chrono::duration<double>(bench_clock::now() - begin).count();
+            printf("    vkGetDeviceProcAddr:   %8.1f ns/name\n", seconds * 1e9 / (kRounds * name_count));
+            vkDestroyDevice(device, nullptr);
+        }
+    }
+
+    vkDestroyInstance(instance, nullptr);
+    // Keep the lookups from being optimized away
+    return sink != 1;
+}
+
+VKAPI_ATTR VkBool32 VKAPI_CALL CountMessages(VkDebugUtilsMessageSeverityFlagBitsEXT, VkDebugUtilsMessageTypeFlagsEXT,
+                                             const VkDebugUtilsMessengerCallbackDataEXT *, void *user_data) {
+    ++*static_cast<uint64_t *>(user_data);
+    return VK_FALSE;
+}
+
+// Instance creation with nobody listening to the loader's messages, then with a messenger that
+// accepts everything.  The first case should not pay for formatting the discovery chatter.  Output
+// from VK_LOADER_DEBUG is read once per process, so compare that by running with it set and unset.
+bool InstanceLogging() {
+    uint64_t message_count = 0;
+    VkDebugUtilsMessengerCreateInfoEXT messenger_info = {};
+    messenger_info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+    messenger_info.messageSeverity =
+        VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT |
+        VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    messenger_info.messageType =
+        VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT |
+        VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    messenger_info.pfnUserCallback = CountMessages;
+    messenger_info.pUserData = &message_count;
+
+    const char *debug_env = getenv("VK_LOADER_DEBUG");
+    printf("    VK_LOADER_DEBUG=%s\n", debug_env != nullptr ? debug_env : "(unset)");
+
+    for (int with_messenger = 0; with_messenger < 2; ++with_messenger) {
+        VkInstanceCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        info.pNext = with_messenger ? &messenger_info : nullptr;
+
+        message_count = 0;
+        uint64_t iterations = 0;
+        bench_clock::time_point begin = bench_clock::now();
+        bench_clock::time_point end = begin + kRunTime;
+        while (bench_clock::now() < end) {
+            VkInstance instance = VK_NULL_HANDLE;
+            if (vkCreateInstance(&info, nullptr, &instance) != VK_SUCCESS) {
+                printf("    vkCreateInstance failed, skipping\n");
+                return false;
+            }
+            vkDestroyInstance(instance, nullptr);
+            ++iterations;
+        }
+        double seconds = std::chrono::duration<double>(bench_clock::now() - begin).count();
+        printf("    %-16s %10.1f us/instance, %6.1f messages/instance\n", with_messenger ? "all messages:" : "no messenger:",
+               seconds * 1e6 / iterations, static_cast<double>(message_count) / iterations);
+    }
+    return true;
+}
+
+// Counts the calling thread's cache misses while it is started.  Only Linux has the counters, and
+// only when perf events are allowed for the user (see /proc/sys/kernel/perf_event_paranoid).
+class CacheMissCounter {
+   public:
+    CacheMissCounter() {
+#if defined(__linux__)
+        perf_event_attr attr = {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~CacheMissCounter() {
+#if defined(__linux__)
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+    bool Available() const { return fd_ >= 0; }
+    void Start() {
+#if defined(__linux__)
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+    uint64_t Stop() {
+        uint64_t count = 0;
+#if defined(__linux__)
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd_, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+        return count;
+    }
+
+   private:
+    int fd_ = -1;
+};
+
+// Cache misses of single dispatched calls made right after the caches have been flushed by
+// walking a large buffer, the way a call made once a frame finds them.  Only the loader's and the
+// driver's data are cold, so fewer misses means the loader's hot state is packed more tightly.
+// The misses of starting and stopping the counter alone are subtracted.
+bool DispatchCacheMisses() {
+    const uint32_t kCalls = 1000;
+    const size_t kEvictSize = 32 * 1024 * 1024;
+
+    CacheMissCounter counter;
+    if (!counter.Available()) {
+        printf("    perf events are not available, skipping\n");
+        return true;
+    }
+
+    VkInstance instance = CreateInstance();
+    if (instance == VK_NULL_HANDLE) {
+        printf("    vkCreateInstance failed, skipping\n");
+        return false;
+    }
+    VkPhysicalDevice physical_device = FirstPhysicalDevice(instance);
+    if (physical_device == VK_NULL_HANDLE) {
+        printf("    no physical devices, skipping\n");
+        vkDestroyInstance(instance, nullptr);
+        return true;
+    }
+
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queue_info = {};
+    queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue_info.queueFamilyIndex = 0;
+    queue_info.queueCount = 1;
+    queue_info.pQueuePriorities = &priority;
+
+    VkDeviceCreateInfo device_info = {};
+    device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    device_info.queueCreateInfoCount = 1;
+    device_info.pQueueCreateInfos = &queue_info;
+
+    VkDevice device = VK_NULL_HANDLE;
+    if (vkCreateDevice(physical_device, &device_info, nullptr, &device) != VK_SUCCESS) {
+        device = VK_NULL_HANDLE;
+    }
+
+    std::vector<uint8_t> evict(kEvictSize);
+    uint64_t evict_sum = 0;
+    auto evict_caches = [&]() {
+        for (size_t i = 0; i < kEvictSize; i += 64) {
+            evict[i]++;
+            evict_sum += evict[i];
+        }
+    };
+
+    uint64_t baseline = 0;
+    for (uint32_t i = 0; i < kCalls; ++i) {
+        evict_caches();
+        counter.Start();
+        baseline += counter.Stop();
+    }
+
+    struct DispatchedCall {
+        const char *name;
+        void (*call)(VkPhysicalDevice, VkDevice);
+    };
+    const DispatchedCall calls[] = {
+        {"vkGetPhysicalDeviceFeatures",
+         [](VkPhysicalDevice pd, VkDevice) {
+             VkPhysicalDeviceFeatures features;
+             vkGetPhysicalDeviceFeatures(pd, &features);
+         }},
+        {"vkGetPhysicalDeviceFormatProperties",
+         [](VkPhysicalDevice pd, VkDevice) {
+             VkFormatProperties props;
+             vkGetPhysicalDeviceFormatProperties(pd, VK_FORMAT_R8G8B8A8_UNORM, &props);
+         }},
+        {"vkGetDeviceQueue",
+         [](VkPhysicalDevice, VkDevice dev) {
+             VkQueue queue;
+             vkGetDeviceQueue(dev, 0, 0, &queue);
+         }},
+    };
+
+    printf("    counter overhead: %6.2f misses\n", static_cast<double>(baseline) / kCalls);
+    for (const DispatchedCall &call : calls) {
+        if (device == VK_NULL_HANDLE && strcmp(call.name, "vkGetDeviceQueue") == 0) continue;
+
+        uint64_t misses = 0;
+        for (uint32_t i = 0; i < kCalls; ++i) {
+            evict_caches();
+            counter.Start();
+            call.call(physical_device, device);
+            misses += counter.Stop();
+        }
+        double per_call = (static_cast<double>(misses) - static_cast<double>(baseline)) / kCalls;
+        printf("    %-36s %6.2f misses/call\n", call.name, per_call);
+    }
+
+    if (device != VK_NULL_HANDLE) vkDestroyDevice(device, nullptr);
+    vkDestroyInstance(instance, nullptr);
+    // Keep the eviction from being optimized away
+    return evict_sum != 1;
+}
+
+const char kManifestDir[] = "loader_benchmark_manifests";
+
+// Sets the variable, or removes it if value is null
+void SetEnv(const char *name, const char *value) {
+#if defined(_WIN32)
+    _putenv_s(name, value != nullptr ? value : "");
+#else
+    if (value != nullptr) {
+        setenv(name, value, 1);
+    } else {
+        unsetenv(name);
+    }
+#endif
+}
+
+// Writes a layer manifest with the given number of extensions, and component layers if any are
+// named.  Returns the manifest's size, or 0 if it couldn't be written.
+size_t WriteLayerManifest(const std::string &name, uint32_t extension_count, const std::vector<std::string> &components) {
+    std::string json = "{\n    \"file_format_version\": \"1.1.2\",\n    \"layer\": {\n";
+    json += "        \"name\": \"" + name + "\",\n";
+    json += "        \"type\": \"GLOBAL\",\n";
+    if (components.empty()) {
+        json += "        \"library_path\": \"./libVkLayer_benchmark.so\",\n";
+    }
+    json += "        \"api_version\": \"1.2.135\",\n";
+    json += "        \"implementation_version\": \"1\",\n";
+    json += "        \"description\": \"Synthetic layer for the manifest_parse benchmark\",\n";
+    if (!components.empty()) {
+        json += "        \"component_layers\": [";
+        for (size_t i = 0; i < components.size(); ++i) {
+            json += (i ? ", \"" : "\"") + components[i] + "\"";
+        }
+        json += "],\n";
+    }
+    json += "        \"instance_extensions\": [\n";
+    for (uint32_t i = 0; i < extension_count; ++i) {
+        json += "            {\"name\": \"VK_EXT_benchmark_instance_" + std::to_string(i) + "\", \"spec_version\": \"1\"}";
+        json += i + 1 < extension_count ? ",\n" : "\n";
+    }
+    json += "        ],\n        \"device_extensions\": [\n";
+    for (uint32_t i = 0; i < extension_count; ++i) {
+        std::string index = std::to_string(i);
+        json += "            {\"name\": \"VK_EXT_benchmark_device_" + index + "\", \"spec_version\": \"1\", \"entrypoints\": [";
+        json += "\"vkBenchmarkCreate" + index + "\", \"vkBenchmarkDestroy" + index + "\"]}";
+        json += i + 1 < extension_count ? ",\n" : "\n";
+    }
+    json += "        ]\n    }\n}\n";
+
+    std::string path = std::string(kManifestDir) + "/" + name + ".json";
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return 0;
+    }
+    size_t written = fwrite(json.data(), 1, json.size(), file);
+    fclose(file);
+    return written == json.size() ? written : 0;
+}
+
+// Explicit layer scans over a corpus of synthetic manifests: many small layers, a few layers with
+// hundreds of extensions and meta-layers naming them all.  The installed explicit layers are
+// scanned too, so the corpus includes whatever real manifests the machine has.  VK_LAYER_PATH
+// alternates between two spellings of the same path so every scan has to parse the manifests
+// again instead of reusing the last scan.
+bool ManifestParse() {
+    static const uint32_t kSmallLayers = 32;
+    static const uint32_t kLargeLayers = 4;
+    static const uint32_t kMetaLayers = 2;
+
+#if defined(_WIN32)
+    _mkdir(kManifestDir);
+#else
+    mkdir(kManifestDir, 0755);
+#endif
+    size_t corpus_bytes = 0;
+    std::vector<std::string> names;
+    bool written = true;
+    for (uint32_t i = 0; i < kSmallLayers && written; ++i) {
+        names.push_back("VK_LAYER_BENCHMARK_small_" + std::to_string(i));
+        size_t size = WriteLayerManifest(names.back(), 4, std::vector<std::string>());
+        corpus_bytes += size;
+        written = size != 0;
+    }
+    for (uint32_t i = 0; i < kLargeLayers && written; ++i) {
+        names.push_back("VK_LAYER_BENCHMARK_large_" + std::to_string(i));
+        size_t size = WriteLayerManifest(names.back(), 256, std::vector<std::string>());
+        corpus_bytes += size;
+        written = size != 0;
+    }
+    for (uint32_t i = 0; i < kMetaLayers && written; ++i) {
+        size_t size = WriteLayerManifest("VK_LAYER_BENCHMARK_meta_" + std::to_string(i), 0, names);
+        corpus_bytes += size;
+        written = size != 0;
+    }
+    if (!written) {
+        printf("    failed to write manifests to %s, skipping\n", kManifestDir);
+        return false;
+    }
+
+#if defined(_WIN32)
+    std::string paths[2] = {kManifestDir, std::string(kManifestDir) + "/."};
+#else
+    const std::string installed =
+        ":/usr/local/share/vulkan/explicit_layer.d:/usr/share/vulkan/explicit_layer.d:/etc/vulkan/explicit_layer.d";
+    std::string paths[2] = {kManifestDir + installed, std::string(kManifestDir) + "/." + installed};
+#endif
+    const char *old_layer_path = getenv("VK_LAYER_PATH");
+    bool had_layer_path = old_layer_path != nullptr;
+    std::string saved_layer_path = had_layer_path ? old_layer_path : "";
+
+    uint32_t layer_count = 0;
+    uint64_t scans = 0;
+    bench_clock::time_point begin = bench_clock::now();
+    bench_clock::time_point end = begin + kRunTime;
+    while (bench_clock::now() < end) {
+        SetEnv("VK_LAYER_PATH", paths[scans & 1].c_str());
+        vkEnumerateInstanceLayerProperties(&layer_count, nullptr);
+        ++scans;
+    }
+    double seconds = std::chrono::duration<double>(bench_clock::now() - begin).count();
+    printf("    %u layers found, %.1f KiB of synthetic manifests\n", layer_count, corpus_bytes / 1024.0);
+    printf("    %10.1f us/scan\n", seconds * 1e6 / scans);
+
+    SetEnv("VK_LAYER_PATH", had_layer_path ? saved_layer_path.c_str() : nullptr);
+    return layer_count >= kSmallLayers + kLargeLayers;
+}
+
+// Records batches of commands for the run time, resetting the command buffer between batches so
+// it doesn't keep growing.  Returns the time per command in nanoseconds, or a negative value if
+// the command buffer couldn't be begun.
+template <typename Record>
+double TimeRecording(VkCommandBuffer command_buffer, uint32_t commands_per_record, Record record) {
+    const uint32_t kBatch = 4096;
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    bench_clock::duration recording(0);
+    uint64_t commands = 0;
+    bench_clock::time_point end = bench_clock::now() + kRunTime;
+    while (bench_clock::now() < end) {
+        if (vkBeginCommandBuffer(command_buffer, &begin_info) != VK_SUCCESS) {
+            return -1.0;
+        }
+        bench_clock::time_point begin = bench_clock::now();
+        for (uint32_t i = 0; i < kBatch; ++i) {
+            record(command_buffer);
+        }
+        recording += bench_clock::now() - begin;
+        vkEndCommandBuffer(command_buffer);
+        vkResetCommandBuffer(command_buffer, 0);
+        commands += kBatch * commands_per_record;
+    }
+    return std::chrono::duration<double>(recording).count() * 1e9 / commands;
+}
+
+// Command recording through the exported entry points and through the pointers vkGetDeviceProcAddr
+// returns.  With no layers the exported entry point jumps through the command buffer's dispatch
+// table to the driver, while vkGetDeviceProcAddr hands out the driver's own entry point, so the
+// difference is the loader's share of each command.  vkCmdSetLineWidth stands in for vkCmdDraw:
+// both take the same path through the loader, but it can be recorded outside a render pass with no
+// pipeline bound, which every driver accepts.  The VK_EXT_debug_utils label commands, which the
+// loader offers even for drivers without them, are timed too when the instance has the extension;
+// their exported counterparts come from vkGetInstanceProcAddr.
+bool CommandRecording() {
+    uint32_t ext_count = 0;
+    vkEnumerateInstanceExtensionProperties(nullptr, &ext_count, nullptr);
+    std::vector<VkExtensionProperties> exts(ext_count);
+    vkEnumerateInstanceExtensionProperties(nullptr, &ext_count, exts.data());
+    bool has_debug_utils = false;
+    for (uint32_t i = 0; i < ext_count; ++i) {
+        has_debug_utils = has_debug_utils || strcmp(exts[i].extensionName, VK_EXT_DEBUG_UTILS_EXTENSION_NAME) == 0;
+    }
+
+    const char *debug_utils_name = VK_EXT_DEBUG_UTILS_EXTENSION_NAME;
+    VkInstanceCreateInfo instance_info = {};
+    instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    instance_info.enabledExtensionCount = has_debug_utils ? 1 : 0;
+    instance_info.ppEnabledExtensionNames = &debug_utils_name;
+    VkInstance instance = VK_NULL_HANDLE;
+    if (vkCreateInstance(&instance_info, nullptr, &instance) != VK_SUCCESS) {
+        printf("    vkCreateInstance failed, skipping\n");
+        return false;
+    }
+    VkPhysicalDevice physical_device = FirstPhysicalDevice(instance);
+    if (physical_device == VK_NULL_HANDLE) {
+        printf("    no physical devices, skipping\n");
+        vkDestroyInstance(instance, nullptr);
+        return true;
+    }
+
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queue_info = {};
+    queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue_info.queueFamilyIndex = 0;
+    queue_info.queueCount = 1;
+    queue_info.pQueuePriorities = &priority;
+
+    VkDeviceCreateInfo device_info = {};
+    device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    device_info.queueCreateInfoCount = 1;
+    device_info.pQueueCreateInfos = &queue_info;
+
+    VkDevice device = VK_NULL_HANDLE;
+    if (vkCreateDevice(physical_device, &device_info, nullptr, &device) != VK_SUCCESS) {
+        printf("    vkCreateDevice failed, skipping\n");
+        vkDestroyInstance(instance, nullptr);
+        return true;
+    }
+
+    VkCommandPoolCreateInfo pool_info = {};
+    pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    pool_info.queueFamilyIndex = 0;
+    VkCommandPool pool = VK_NULL_HANDLE;
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    if (vkCreateCommandPool(device, &pool_info, nullptr, &pool) == VK_SUCCESS) {
+        VkCommandBufferAllocateInfo alloc_info = {};
+        alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        alloc_info.commandPool = pool;
+        alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        alloc_info.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(device, &alloc_info, &command_buffer) != VK_SUCCESS) {
+            command_buffer = VK_NULL_HANDLE;
+        }
+    }
+
+    bool ok = command_buffer != VK_NULL_HANDLE;
+    if (ok) {
+        PFN_vkCmdSetLineWidth set_line_width =
+            reinterpret_cast<PFN_vkCmdSetLineWidth>(vkGetDeviceProcAddr(device, "vkCmdSetLineWidth"));
+        double exported = TimeRecording(command_buffer, 1, [](VkCommandBuffer cb) { vkCmdSetLineWidth(cb, 1.0f); });
+        double direct = TimeRecording(command_buffer, 1, [=](VkCommandBuffer cb) { set_line_width(cb, 1.0f); });
+        printf("    %-36s %6.2f ns/command exported, %6.2f ns/command from vkGetDeviceProcAddr\n", "vkCmdSetLineWidth:", exported,
+               direct);
+        ok = exported >= 0.0 && direct >= 0.0;
+    } else {
+        printf("    no command buffer could be allocated\n");
+    }
+
+    if (ok && has_debug_utils) {
+        VkDebugUtilsLabelEXT label = {};
+        label.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+        label.pLabelName = "benchmark";
+        PFN_vkCmdBeginDebugUtilsLabelEXT begin_tramp = reinterpret_cast<PFN_vkCmdBeginDebugUtilsLabelEXT>(
+            vkGetInstanceProcAddr(instance, "vkCmdBeginDebugUtilsLabelEXT"));
+        PFN_vkCmdEndDebugUtilsLabelEXT end_tramp =
+            reinterpret_cast<PFN_vkCmdEndDebugUtilsLabelEXT>(vkGetInstanceProcAddr(instance, "vkCmdEndDebugUtilsLabelEXT"));
+        PFN_vkCmdBeginDebugUtilsLabelEXT begin_direct = reinterpret_cast<PFN_vkCmdBeginDebugUtilsLabelEXT>(
+            vkGetDeviceProcAddr(device, "vkCmdBeginDebugUtilsLabelEXT"));
+        PFN_vkCmdEndDebugUtilsLabelEXT end_direct =
+            reinterpret_cast<PFN_vkCmdEndDebugUtilsLabelEXT>(vkGetDeviceProcAddr(device, "vkCmdEndDebugUtilsLabelEXT"));
+        if (begin_tramp && end_tramp && begin_direct && end_direct) {
+            double exported = TimeRecording(command_buffer, 2, [&](VkCommandBuffer cb) {
+                begin_tramp(cb, &label);
+                end_tramp(cb);
+            });
+            double direct = TimeRecording(command_buffer, 2, [&](VkCommandBuffer cb) {
+                begin_direct(cb, &label);
+                end_direct(cb);
+            });
+            printf("    %-36s %6.2f ns/command exported, %6.2f ns/command from vkGetDeviceProcAddr\n",
+                   "vkCmd{Begin,End}DebugUtilsLabelEXT:", exported, direct);
+        }
+    }
+
+    if (pool != VK_NULL_HANDLE) vkDestroyCommandPool(device, pool, nullptr);
+    vkDestroyDevice(device, nullptr);
+    vkDestroyInstance(instance, nullptr);
+    return ok;
+}
+
+const Benchmark kBenchmarks[] = {
+    {"instance_contention", "per-thread instances enumerating and creating devices concurrently", InstanceContention},
+    {"handle_lookup", "handle to loader object lookups with many instances alive", HandleLookup},
+    {"proc_addr_lookup", "resolving every core entry point by name", ProcAddrLookup},
+    {"instance_logging", "instance creation with loader messages ignored and with a messenger", InstanceLogging},
+    {"dispatch_cache_misses", "cache misses of dispatched calls made with cold caches", DispatchCacheMisses},
+    {"manifest_parse", "explicit layer scans over a corpus of synthetic and installed manifests", ManifestParse},
+    {"command_recording", "commands recorded through the exported entry points and vkGetDeviceProcAddr", CommandRecording},
+};
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    bool ok = true;
+    for (const Benchmark &bench : kBenchmarks) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc && !selected; ++i) {
+            selected = strcmp(argv[i], bench.name) == 0;
+        }
+        if (!selected) continue;
+
+        printf("%s: %s\n", bench.name, bench.description);
+        if (!bench.run()) {
+            ok = false;
+        }
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
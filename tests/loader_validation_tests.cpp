@@ -33,12 +33,26 @@
 #include <stdint.h>  // For UINT32_MAX
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "test_common.h"
+#if !defined(_WIN32)
+#include <fcntl.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #include <vulkan/vulkan.h>
 
 namespace VK {
@@ -291,6 +305,7 @@ std::vector<AllocTrack> g_allocated_vector;
 bool g_intentional_fail_enabled = false;
 uint32_t g_intenional_fail_index = 0;
 uint32_t g_intenional_fail_count = 0;
+uint32_t g_allocation_count = 0;
 
 void FreeAllocTracker() { g_allocated_vector.clear(); }
 
@@ -358,6 +373,7 @@ VKAPI_ATTR void *VKAPI_CALL AllocCallbackFunc(void *pUserData, size_t size, size
                 g_allocated_vector[iii].user_data = (uint64_t)pUserData;
                 g_allocated_vector[iii].active = true;
                 g_allocated_vector[iii].was_allocated = true;
+                g_allocation_count++;
             }
             return g_allocated_vector[iii].aligned_start_addr;
         }
@@ -502,6 +518,47 @@ TEST(CreateInstance, LayerPresent) {
     }
 }
 
+// Core entry points resolve to the loader's own exports.
+TEST(GetInstanceProcAddr, CoreEntryPoints) {
+    VkInstance instance = VK_NULL_HANDLE;
+    VkResult result = vkCreateInstance(VK::InstanceCreateInfo(), VK_NULL_HANDLE, &instance);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    ASSERT_EQ(vkGetInstanceProcAddr(instance, "vkCmdDraw"), reinterpret_cast<PFN_vkVoidFunction>(vkCmdDraw));
+    ASSERT_EQ(vkGetInstanceProcAddr(instance, "vkCreateDevice"), reinterpret_cast<PFN_vkVoidFunction>(vkCreateDevice));
+    ASSERT_EQ(vkGetInstanceProcAddr(instance, "vkResetQueryPool"), reinterpret_cast<PFN_vkVoidFunction>(vkResetQueryPool));
+
+    vkDestroyInstance(instance, nullptr);
+}
+
+// Unknown entry points keep the trampoline they were first given, and no two names share one, even
+// once enough names have been seen that the loader has to grow its table.
+TEST(GetInstanceProcAddr, UnknownEntryPointsStable) {
+    VkInstance instance = VK_NULL_HANDLE;
+    VkResult result = vkCreateInstance(VK::InstanceCreateInfo(), VK_NULL_HANDLE, &instance);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    const uint32_t nameCount = 100;
+    std::vector<std::string> names;
+    std::vector<PFN_vkVoidFunction> first;
+    for (uint32_t i = 0; i < nameCount; ++i) {
+        names.push_back("vkLoaderTestUnknownFunction" + std::to_string(i));
+        first.push_back(vkGetInstanceProcAddr(instance, names.back().c_str()));
+    }
+
+    std::vector<PFN_vkVoidFunction> found;
+    for (uint32_t i = 0; i < nameCount; ++i) {
+        ASSERT_EQ(vkGetInstanceProcAddr(instance, names[i].c_str()), first[i]);
+        if (first[i] != nullptr) {
+            found.push_back(first[i]);
+        }
+    }
+    std::sort(found.begin(), found.end());
+    ASSERT_EQ(std::adjacent_find(found.begin(), found.end()), found.end());
+
+    vkDestroyInstance(instance, nullptr);
+}
+
 // Used by run_loader_tests.sh to test that calling vkEnumeratePhysicalDevices without first querying
 // the count, works.
 TEST(EnumeratePhysicalDevices, OneCall) {
@@ -593,6 +650,30 @@ TEST(EnumeratePhysicalDevices, TwoCallIncomplete) {
     vkDestroyInstance(instance, nullptr);
 }
 
+// Keep enough instances alive to grow the loader's handle index, and make sure every instance is
+// still found after some of them are destroyed.
+TEST(EnumeratePhysicalDevices, ManyInstances) {
+    const uint32_t instanceCount = 150;
+    std::vector<VkInstance> instances(instanceCount, VK_NULL_HANDLE);
+    for (uint32_t i = 0; i < instanceCount; ++i) {
+        VkResult result = vkCreateInstance(VK::InstanceCreateInfo(), VK_NULL_HANDLE, &instances[i]);
+        ASSERT_EQ(result, VK_SUCCESS);
+    }
+
+    for (uint32_t i = 0; i < instanceCount; i += 2) {
+        vkDestroyInstance(instances[i], nullptr);
+        instances[i] = VK_NULL_HANDLE;
+    }
+
+    for (uint32_t i = 1; i < instanceCount; i += 2) {
+        uint32_t physicalCount = 0;
+        VkResult result = vkEnumeratePhysicalDevices(instances[i], &physicalCount, nullptr);
+        ASSERT_EQ(result, VK_SUCCESS);
+        ASSERT_GT(physicalCount, 0u);
+        vkDestroyInstance(instances[i], nullptr);
+    }
+}
+
 // Test to make sure that layers enabled in the instance show up in the list of device layers.
 TEST(EnumerateDeviceLayers, LayersMatch) {
     char const *const names1[] = {"VK_LAYER_LUNARG_meta"};
@@ -769,6 +850,99 @@ TEST(CreateDevice, LayersNotPresent) {
     vkDestroyInstance(instance, nullptr);
 }
 
+#if !defined(_WIN32)
+// Counts the loader's messages saying a device dispatch table was reused
+VKAPI_ATTR VkBool32 VKAPI_CALL CountDispatchTableReuse(VkDebugUtilsMessageSeverityFlagBitsEXT, VkDebugUtilsMessageTypeFlagsEXT,
+                                                       const VkDebugUtilsMessengerCallbackDataEXT *data, void *user_data) {
+    if (data->pMessage != nullptr && strstr(data->pMessage, "Reusing the dispatch table") != nullptr) {
+        ++*static_cast<uint32_t *>(user_data);
+    }
+    return VK_FALSE;
+}
+
+// Creates two devices the same way and a third with features, and counts the dispatch tables that
+// were copied from an earlier device.  With VK_LOADER_DEVICE_DISPATCH_CACHE set the second device
+// reuses the first one's table, and all three have to work.  By default no table is reused.
+TEST(CreateDevice, DispatchTableReused) {
+    auto create_devices = []() -> uint32_t {
+        char const *const extensions[] = {VK_EXT_DEBUG_UTILS_EXTENSION_NAME};
+        auto const info = VK::InstanceCreateInfo().enabledExtensionCount(1).ppEnabledExtensionNames(extensions);
+        VkInstance instance = VK_NULL_HANDLE;
+        VkResult result = vkCreateInstance(info, VK_NULL_HANDLE, &instance);
+        EXPECT_EQ(result, VK_SUCCESS);
+        if (result != VK_SUCCESS) {
+            return 0;
+        }
+
+        auto createMessenger =
+            reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT"));
+        auto destroyMessenger = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
+            vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT"));
+        EXPECT_NE(createMessenger, nullptr);
+        EXPECT_NE(destroyMessenger, nullptr);
+
+        uint32_t reused = 0;
+        VkDebugUtilsMessengerCreateInfoEXT messenger_info = {};
+        messenger_info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+        messenger_info.messageSeverity =
+            VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+        messenger_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT;
+        messenger_info.pfnUserCallback = CountDispatchTableReuse;
+        messenger_info.pUserData = &reused;
+        VkDebugUtilsMessengerEXT messenger = VK_NULL_HANDLE;
+        if (createMessenger != nullptr && destroyMessenger != nullptr) {
+            EXPECT_EQ(createMessenger(instance, &messenger_info, nullptr, &messenger), VK_SUCCESS);
+        }
+
+        uint32_t physicalCount = 1;
+        VkPhysicalDevice physical = VK_NULL_HANDLE;
+        result = vkEnumeratePhysicalDevices(instance, &physicalCount, &physical);
+        EXPECT_TRUE(result == VK_SUCCESS || result == VK_INCOMPLETE);
+        EXPECT_EQ(physicalCount, 1u);
+
+        float const priorities[] = {0.0f};  // Temporary required due to MSVC bug.
+        VkDeviceQueueCreateInfo const queueInfo[1]{
+            VK::DeviceQueueCreateInfo().queueFamilyIndex(0).queueCount(1).pQueuePriorities(priorities)};
+        VkPhysicalDeviceFeatures const features = {};
+        auto const deviceInfo = VK::DeviceCreateInfo().queueCreateInfoCount(1).pQueueCreateInfos(queueInfo);
+        auto const featuresInfo =
+            VK::DeviceCreateInfo().queueCreateInfoCount(1).pQueueCreateInfos(queueInfo).pEnabledFeatures(&features);
+        VkDeviceCreateInfo const *deviceInfos[3] = {deviceInfo, deviceInfo, featuresInfo};
+
+        VkDevice devices[3] = {VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE};
+        for (uint32_t i = 0; i < 3 && physical != VK_NULL_HANDLE; i++) {
+            EXPECT_EQ(vkCreateDevice(physical, deviceInfos[i], nullptr, &devices[i]), VK_SUCCESS);
+        }
+        for (auto device : devices) {
+            if (device == VK_NULL_HANDLE) {
+                continue;
+            }
+            VkQueue queue = VK_NULL_HANDLE;
+            vkGetDeviceQueue(device, 0, 0, &queue);
+            EXPECT_NE(queue, (VkQueue)VK_NULL_HANDLE);
+            if (queue != VK_NULL_HANDLE) {
+                EXPECT_EQ(vkQueueWaitIdle(queue), VK_SUCCESS);
+            }
+            EXPECT_EQ(vkDeviceWaitIdle(device), VK_SUCCESS);
+            vkDestroyDevice(device, nullptr);
+        }
+
+        if (messenger != VK_NULL_HANDLE) {
+            destroyMessenger(instance, messenger, nullptr);
+        }
+        vkDestroyInstance(instance, nullptr);
+        return reused;
+    };
+
+    EXPECT_EQ(create_devices(), 0u);
+
+    ASSERT_EQ(setenv("VK_LOADER_DEVICE_DISPATCH_CACHE", "1", 1), 0);
+    uint32_t const reused = create_devices();
+    unsetenv("VK_LOADER_DEVICE_DISPATCH_CACHE");
+    EXPECT_EQ(reused, 1u);
+}
+#endif
+
 TEST_F(EnumerateInstanceLayerProperties, PropertyCountLessThanAvailable) {
     uint32_t count = 0u;
     VkResult result = vkEnumerateInstanceLayerProperties(&count, nullptr);
@@ -978,6 +1152,30 @@ TEST_F(EnumerateInstanceExtensionProperties, InstanceExtensionEnumerated) {
               &properties[count]);
 }
 
+// Later enumerations take the ICDs' extensions from the ICD extension cache instead of opening the
+// drivers, and must report the same list.
+TEST_F(EnumerateInstanceExtensionProperties, CachedMatchesFirst) {
+    auto const enumerate = []() {
+        std::vector<std::string> names;
+        uint32_t count = 0u;
+        EXPECT_EQ(vkEnumerateInstanceExtensionProperties(nullptr, &count, nullptr), VK_SUCCESS);
+        std::vector<VkExtensionProperties> properties(count);
+        EXPECT_EQ(vkEnumerateInstanceExtensionProperties(nullptr, &count, properties.data()), VK_SUCCESS);
+        for (uint32_t p = 0; p < count; ++p) {
+            names.push_back(properties[p].extensionName);
+        }
+        return names;
+    };
+
+    auto const first = enumerate();
+    EXPECT_EQ(first, enumerate());
+
+    VkInstance instance = VK_NULL_HANDLE;
+    ASSERT_EQ(vkCreateInstance(VK::InstanceCreateInfo(), VK_NULL_HANDLE, &instance), VK_SUCCESS);
+    EXPECT_EQ(first, enumerate());
+    vkDestroyInstance(instance, nullptr);
+}
+
 TEST(EnumerateDeviceExtensionProperties, DeviceExtensionEnumerated) {
     VkInstance instance = VK_NULL_HANDLE;
     VkResult result = vkCreateInstance(VK::InstanceCreateInfo(), VK_NULL_HANDLE, &instance);
@@ -1012,6 +1210,314 @@ TEST(EnumerateDeviceExtensionProperties, DeviceExtensionEnumerated) {
     vkDestroyInstance(instance, nullptr);
 }
 
+// The ICD's extension list is recorded on the first query and read without the instance's lock,
+// so threads making the first queries on a physical device at once must all see the list a later
+// query sees.
+TEST(EnumerateDeviceExtensionProperties, ConcurrentCallsMatch) {
+    VkInstance instance = VK_NULL_HANDLE;
+    VkResult result = vkCreateInstance(VK::InstanceCreateInfo(), VK_NULL_HANDLE, &instance);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    uint32_t physicalCount = 1;
+    VkPhysicalDevice physical = VK_NULL_HANDLE;
+    result = vkEnumeratePhysicalDevices(instance, &physicalCount, &physical);
+    ASSERT_TRUE(result == VK_SUCCESS || result == VK_INCOMPLETE);
+    ASSERT_EQ(physicalCount, 1u);
+
+    const uint32_t kThreads = 8;
+    const uint32_t kIterations = 100;
+    std::vector<std::vector<std::vector<VkExtensionProperties>>> seen(kThreads);
+    std::vector<uint32_t> failures(kThreads, 0);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (uint32_t i = 0; i < kIterations; ++i) {
+                uint32_t thread_count = 0u;
+                VkResult thread_result = vkEnumerateDeviceExtensionProperties(physical, nullptr, &thread_count, nullptr);
+                std::vector<VkExtensionProperties> properties(thread_count);
+                if (thread_result == VK_SUCCESS) {
+                    thread_result = vkEnumerateDeviceExtensionProperties(physical, nullptr, &thread_count, properties.data());
+                }
+                if (thread_result != VK_SUCCESS || thread_count != properties.size()) {
+                    failures[t]++;
+                }
+                seen[t].push_back(properties);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    uint32_t count = 0u;
+    result = vkEnumerateDeviceExtensionProperties(physical, nullptr, &count, nullptr);
+    ASSERT_EQ(result, VK_SUCCESS);
+    std::vector<VkExtensionProperties> expected(count);
+    result = vkEnumerateDeviceExtensionProperties(physical, nullptr, &count, expected.data());
+    ASSERT_EQ(result, VK_SUCCESS);
+    ASSERT_EQ(count, expected.size());
+
+    for (uint32_t t = 0; t < kThreads; ++t) {
+        EXPECT_EQ(failures[t], 0u);
+        uint32_t mismatches = 0;
+        for (std::vector<VkExtensionProperties> const &properties : seen[t]) {
+            if (properties.size() != expected.size() ||
+                !std::equal(properties.begin(), properties.end(), expected.begin(),
+                            [](VkExtensionProperties const &a, VkExtensionProperties const &b) {
+                                return strcmp(a.extensionName, b.extensionName) == 0 && a.specVersion == b.specVersion;
+                            })) {
+                mismatches++;
+            }
+        }
+        EXPECT_EQ(mismatches, 0u);
+    }
+
+    vkDestroyInstance(instance, nullptr);
+}
+
+VKAPI_ATTR VkBool32 VKAPI_CALL CountAnyMessage(VkDebugUtilsMessageSeverityFlagBitsEXT, VkDebugUtilsMessageTypeFlagsEXT,
+                                               const VkDebugUtilsMessengerCallbackDataEXT *, void *user_data) {
+    static_cast<std::atomic<uint32_t> *>(user_data)->fetch_add(1);
+    return VK_FALSE;
+}
+
+// Without the instance's lock, messages the loader logs while enumerating device extensions race
+// messengers being created and destroyed on another thread, which applications may do.
+TEST(EnumerateDeviceExtensionProperties, WhileMessengersChange) {
+    char const *const extensions[] = {VK_EXT_DEBUG_UTILS_EXTENSION_NAME};
+    auto const info = VK::InstanceCreateInfo().enabledExtensionCount(1).ppEnabledExtensionNames(extensions);
+    VkInstance instance = VK_NULL_HANDLE;
+    VkResult result = vkCreateInstance(info, VK_NULL_HANDLE, &instance);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    uint32_t physicalCount = 1;
+    VkPhysicalDevice physical = VK_NULL_HANDLE;
+    result = vkEnumeratePhysicalDevices(instance, &physicalCount, &physical);
+    ASSERT_TRUE(result == VK_SUCCESS || result == VK_INCOMPLETE);
+    ASSERT_EQ(physicalCount, 1u);
+
+    auto createMessenger =
+        reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT"));
+    auto destroyMessenger =
+        reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT"));
+    ASSERT_NE(createMessenger, nullptr);
+    ASSERT_NE(destroyMessenger, nullptr);
+
+    uint32_t count = 0u;
+    ASSERT_EQ(vkEnumerateDeviceExtensionProperties(physical, nullptr, &count, nullptr), VK_SUCCESS);
+
+    std::atomic<uint32_t> messages(0);
+    std::atomic<bool> done(false);
+    uint32_t failures = 0;
+    std::thread enumerator([&]() {
+        do {
+            uint32_t thread_count = 0u;
+            if (vkEnumerateDeviceExtensionProperties(physical, nullptr, &thread_count, nullptr) != VK_SUCCESS ||
+                thread_count != count) {
+                failures++;
+            }
+        } while (!done);
+    });
+
+    VkDebugUtilsMessengerCreateInfoEXT messenger_info = {};
+    messenger_info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+    messenger_info.messageSeverity =
+        VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT |
+        VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    messenger_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT |
+                                 VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    messenger_info.pfnUserCallback = CountAnyMessage;
+    messenger_info.pUserData = &messages;
+    uint32_t changes = 0;
+    for (; changes < 1000; ++changes) {
+        VkDebugUtilsMessengerEXT messenger = VK_NULL_HANDLE;
+        if (createMessenger(instance, &messenger_info, nullptr, &messenger) != VK_SUCCESS) {
+            break;
+        }
+        destroyMessenger(instance, messenger, nullptr);
+    }
+    done = true;
+    enumerator.join();
+
+    EXPECT_EQ(changes, 1000u);
+    EXPECT_EQ(failures, 0u);
+
+    vkDestroyInstance(instance, nullptr);
+}
+
+// Used by run_loader_tests.sh to test the asynchronous VK_LOADER_DEBUG sink.  With VK_LOADER_DEBUG=all,
+// several threads log many times more lines than the sink's ring buffer holds, while an instance
+// kept alive here keeps the drain thread running.
+TEST(LogSink, ConcurrentWriters) {
+    VkInstance instance = VK_NULL_HANDLE;
+    VkResult result = vkCreateInstance(VK::InstanceCreateInfo(), VK_NULL_HANDLE, &instance);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    const uint32_t kThreads = 8;
+    std::vector<uint32_t> failures(kThreads, 0);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (uint32_t i = 0; i < 50; ++i) {
+                VkInstance thread_instance = VK_NULL_HANDLE;
+                if (vkCreateInstance(VK::InstanceCreateInfo(), VK_NULL_HANDLE, &thread_instance) != VK_SUCCESS) {
+                    failures[t]++;
+                    continue;
+                }
+                uint32_t physicalCount = 0;
+                vkEnumeratePhysicalDevices(thread_instance, &physicalCount, nullptr);
+                vkDestroyInstance(thread_instance, nullptr);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (uint32_t t = 0; t < kThreads; ++t) {
+        EXPECT_EQ(failures[t], 0u);
+    }
+
+    vkDestroyInstance(instance, nullptr);
+}
+
+// Counts only the test's own messages, so loader messages don't disturb the counts
+VKAPI_ATTR VkBool32 VKAPI_CALL CountRoutingMessages(VkDebugUtilsMessageSeverityFlagBitsEXT, VkDebugUtilsMessageTypeFlagsEXT,
+                                                    const VkDebugUtilsMessengerCallbackDataEXT *data, void *user_data) {
+    if (data->pMessageIdName != nullptr && strcmp(data->pMessageIdName, "SeverityAndTypeRouting") == 0) {
+        ++*static_cast<uint32_t *>(user_data);
+    }
+    return VK_FALSE;
+}
+
+// Messages only reach the messengers that want both their severity and their type, and stop
+// reaching a messenger once it is destroyed.
+TEST(DebugUtilsMessenger, SeverityAndTypeRouting) {
+    char const *const extensions[] = {VK_EXT_DEBUG_UTILS_EXTENSION_NAME};
+    auto const info = VK::InstanceCreateInfo().enabledExtensionCount(1).ppEnabledExtensionNames(extensions);
+    VkInstance instance = VK_NULL_HANDLE;
+    VkResult result = vkCreateInstance(info, VK_NULL_HANDLE, &instance);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    auto createMessenger =
+        reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT"));
+    auto destroyMessenger =
+        reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT"));
+    auto submitMessage =
+        reinterpret_cast<PFN_vkSubmitDebugUtilsMessageEXT>(vkGetInstanceProcAddr(instance, "vkSubmitDebugUtilsMessageEXT"));
+    ASSERT_NE(createMessenger, nullptr);
+    ASSERT_NE(destroyMessenger, nullptr);
+    ASSERT_NE(submitMessage, nullptr);
+
+    uint32_t errors = 0, performance = 0;
+    VkDebugUtilsMessengerCreateInfoEXT messenger_info = {};
+    messenger_info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+    messenger_info.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    messenger_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT;
+    messenger_info.pfnUserCallback = CountRoutingMessages;
+    messenger_info.pUserData = &errors;
+    VkDebugUtilsMessengerEXT error_messenger = VK_NULL_HANDLE;
+    ASSERT_EQ(createMessenger(instance, &messenger_info, nullptr, &error_messenger), VK_SUCCESS);
+
+    messenger_info.messageSeverity =
+        VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    messenger_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    messenger_info.pUserData = &performance;
+    VkDebugUtilsMessengerEXT performance_messenger = VK_NULL_HANDLE;
+    ASSERT_EQ(createMessenger(instance, &messenger_info, nullptr, &performance_messenger), VK_SUCCESS);
+
+    VkDebugUtilsMessengerCallbackDataEXT data = {};
+    data.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CALLBACK_DATA_EXT;
+    data.pMessageIdName = "SeverityAndTypeRouting";
+    data.pMessage = "test message";
+
+    submitMessage(instance, VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT, &data);
+    EXPECT_EQ(errors, 1u);
+    EXPECT_EQ(performance, 0u);
+
+    submitMessage(instance, VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT, VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT,
+                  &data);
+    EXPECT_EQ(errors, 1u);
+    EXPECT_EQ(performance, 1u);
+
+    submitMessage(instance, VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT, VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT, &data);
+    EXPECT_EQ(errors, 1u);
+    EXPECT_EQ(performance, 1u);
+
+    destroyMessenger(instance, error_messenger, nullptr);
+    submitMessage(instance, VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT,
+                  VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT, &data);
+    EXPECT_EQ(errors, 1u);
+    EXPECT_EQ(performance, 2u);
+
+    destroyMessenger(instance, performance_messenger, nullptr);
+    vkDestroyInstance(instance, nullptr);
+}
+
+// Messages are sent without the instance's lock while another thread adds and removes messengers
+// that want them.  Every message must still reach the messenger that stays, and a messenger being
+// removed must never be called after it is freed.
+TEST(DebugUtilsMessenger, RoutingWhileMessengersChange) {
+    char const *const extensions[] = {VK_EXT_DEBUG_UTILS_EXTENSION_NAME};
+    auto const info = VK::InstanceCreateInfo().enabledExtensionCount(1).ppEnabledExtensionNames(extensions);
+    VkInstance instance = VK_NULL_HANDLE;
+    VkResult result = vkCreateInstance(info, VK_NULL_HANDLE, &instance);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    auto createMessenger =
+        reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT"));
+    auto destroyMessenger =
+        reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT"));
+    auto submitMessage =
+        reinterpret_cast<PFN_vkSubmitDebugUtilsMessageEXT>(vkGetInstanceProcAddr(instance, "vkSubmitDebugUtilsMessageEXT"));
+    ASSERT_NE(createMessenger, nullptr);
+    ASSERT_NE(destroyMessenger, nullptr);
+    ASSERT_NE(submitMessage, nullptr);
+
+    uint32_t errors = 0, churned = 0;
+    VkDebugUtilsMessengerCreateInfoEXT messenger_info = {};
+    messenger_info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+    messenger_info.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    messenger_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT;
+    messenger_info.pfnUserCallback = CountRoutingMessages;
+    messenger_info.pUserData = &errors;
+    VkDebugUtilsMessengerEXT error_messenger = VK_NULL_HANDLE;
+    ASSERT_EQ(createMessenger(instance, &messenger_info, nullptr, &error_messenger), VK_SUCCESS);
+
+    uint32_t sent = 0;
+    std::atomic<bool> done(false);
+    std::thread sender([&]() {
+        VkDebugUtilsMessengerCallbackDataEXT data = {};
+        data.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CALLBACK_DATA_EXT;
+        data.pMessageIdName = "SeverityAndTypeRouting";
+        data.pMessage = "test message";
+        do {
+            submitMessage(instance, VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT,
+                          &data);
+            ++sent;
+        } while (!done);
+    });
+
+    // The messengers added here want errors too, so the sender may be calling one as it's destroyed
+    messenger_info.pUserData = &churned;
+    uint32_t changes = 0;
+    for (; changes < 10000; ++changes) {
+        VkDebugUtilsMessengerEXT churned_messenger = VK_NULL_HANDLE;
+        if (createMessenger(instance, &messenger_info, nullptr, &churned_messenger) != VK_SUCCESS) {
+            break;
+        }
+        destroyMessenger(instance, churned_messenger, nullptr);
+    }
+    done = true;
+    sender.join();
+
+    EXPECT_EQ(changes, 10000u);
+    EXPECT_EQ(errors, sent);
+    EXPECT_LE(churned, sent);
+
+    destroyMessenger(instance, error_messenger, nullptr);
+    vkDestroyInstance(instance, nullptr);
+}
+
 TEST_F(ImplicitLayer, Present) {
     auto const info = VK::InstanceCreateInfo();
     VkInstance instance = VK_NULL_HANDLE;
@@ -1021,6 +1527,616 @@ TEST_F(ImplicitLayer, Present) {
     vkDestroyInstance(instance, nullptr);
 }
 
+#if !defined(_WIN32)
+// Enumerating layers through a cold and then a warm manifest cache must give the same answer as
+// scanning without one.
+TEST(ManifestCache, LayersMatchUncached) {
+    auto const enumerate = []() {
+        std::vector<std::string> names;
+        uint32_t count = 0u;
+        EXPECT_EQ(vkEnumerateInstanceLayerProperties(&count, nullptr), VK_SUCCESS);
+        std::vector<VkLayerProperties> properties(count);
+        EXPECT_EQ(vkEnumerateInstanceLayerProperties(&count, properties.data()), VK_SUCCESS);
+        for (uint32_t p = 0; p < count; ++p) {
+            names.push_back(properties[p].layerName);
+        }
+        return names;
+    };
+
+    std::string const cache_file = ::testing::TempDir() + "loader_manifest_cache_test_" + std::to_string(getpid()) + ".bin";
+    std::remove(cache_file.c_str());
+
+    auto const uncached = enumerate();
+
+    ASSERT_EQ(setenv("VK_LOADER_MANIFEST_CACHE", cache_file.c_str(), 1), 0);
+    auto const cold = enumerate();
+    FILE *file = fopen(cache_file.c_str(), "rb");
+    EXPECT_NE(file, nullptr);
+    if (file) {
+        fclose(file);
+    }
+    auto const warm = enumerate();
+    unsetenv("VK_LOADER_MANIFEST_CACHE");
+    std::remove(cache_file.c_str());
+
+    EXPECT_EQ(uncached, cold);
+    EXPECT_EQ(uncached, warm);
+}
+
+// A cache file cut off part way through, most likely in the middle of its last entry's payload,
+// must be ignored rather than read past its end.
+TEST(ManifestCache, TruncatedFileIgnored) {
+    auto const enumerate = []() {
+        std::vector<std::string> names;
+        uint32_t count = 0u;
+        EXPECT_EQ(vkEnumerateInstanceLayerProperties(&count, nullptr), VK_SUCCESS);
+        std::vector<VkLayerProperties> properties(count);
+        EXPECT_EQ(vkEnumerateInstanceLayerProperties(&count, properties.data()), VK_SUCCESS);
+        for (uint32_t p = 0; p < count; ++p) {
+            names.push_back(properties[p].layerName);
+        }
+        return names;
+    };
+
+    std::string const cache_file = ::testing::TempDir() + "loader_manifest_cache_truncated_" + std::to_string(getpid());
+    std::remove((cache_file + ".bin").c_str());
+
+    auto const uncached = enumerate();
+
+    ASSERT_EQ(setenv("VK_LOADER_MANIFEST_CACHE", (cache_file + ".bin").c_str(), 1), 0);
+    enumerate();
+    std::vector<char> contents;
+    FILE *file = fopen((cache_file + ".bin").c_str(), "rb");
+    if (file) {
+        char buffer[4096];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            contents.insert(contents.end(), buffer, buffer + read);
+        }
+        fclose(file);
+    }
+    std::remove((cache_file + ".bin").c_str());
+    ASSERT_GT(contents.size(), 16u);
+
+    // The cache is kept open per file name, so each cut gets a file of its own
+    size_t const cuts[] = {contents.size() - 1, contents.size() - 8, contents.size() / 2};
+    for (size_t cut : cuts) {
+        std::string const cut_file = cache_file + "_" + std::to_string(cut) + ".bin";
+        file = fopen(cut_file.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(fwrite(contents.data(), 1, cut, file), cut);
+        fclose(file);
+
+        ASSERT_EQ(setenv("VK_LOADER_MANIFEST_CACHE", cut_file.c_str(), 1), 0);
+        EXPECT_EQ(enumerate(), uncached) << "cut at " << cut;
+        std::remove(cut_file.c_str());
+    }
+    unsetenv("VK_LOADER_MANIFEST_CACHE");
+}
+
+// A layer manifest added after a scan must show up in the next one, even though the earlier scan
+// result is kept for reuse.
+TEST(ScanSnapshot, NewLayerManifestFound) {
+    auto const count_layers = []() {
+        uint32_t count = 0u;
+        EXPECT_EQ(vkEnumerateInstanceLayerProperties(&count, nullptr), VK_SUCCESS);
+        return count;
+    };
+
+    char layer_dir[] = "/tmp/loader_scan_snapshot_XXXXXX";
+    ASSERT_NE(mkdtemp(layer_dir), nullptr);
+    std::string const manifest = std::string(layer_dir) + "/VkLayer_scan_snapshot_test.json";
+
+    char const *old_layer_path = getenv("VK_LAYER_PATH");
+    std::string const saved_layer_path = old_layer_path ? old_layer_path : "";
+    ASSERT_EQ(setenv("VK_LAYER_PATH", layer_dir, 1), 0);
+
+    uint32_t const before = count_layers();
+    EXPECT_EQ(count_layers(), before);
+
+    FILE *file = fopen(manifest.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    fputs(
+        "{\"file_format_version\": \"1.1.0\", \"layer\": {\"name\": \"VK_LAYER_LUNARG_scan_snapshot_test\", "
+        "\"type\": \"GLOBAL\", \"library_path\": \"./libVkLayer_scan_snapshot_test.so\", \"api_version\": \"1.0.0\", "
+        "\"implementation_version\": \"1\", \"description\": \"test\"}}",
+        file);
+    fclose(file);
+
+    EXPECT_EQ(count_layers(), before + 1);
+
+    std::remove(manifest.c_str());
+    EXPECT_EQ(count_layers(), before);
+    rmdir(layer_dir);
+
+    if (old_layer_path) {
+        setenv("VK_LAYER_PATH", saved_layer_path.c_str(), 1);
+    } else {
+        unsetenv("VK_LAYER_PATH");
+    }
+}
+
+// Returns a layer manifest for name, padded with spaces to size bytes.  Without its closing braces
+// the manifest can't be parsed, and the parser reads up to the end of the text looking for them.
+static std::string PaddedLayerManifest(std::string const &name, size_t size, bool closed) {
+    std::string manifest = "{\"file_format_version\": \"1.1.0\", \"layer\": {\"name\": \"" + name +
+                           "\", \"type\": \"GLOBAL\", \"library_path\": \"./libVkLayer_manifest_read_test.so\", "
+                           "\"api_version\": \"1.0.0\", \"implementation_version\": \"1\", \"description\": \"test\"";
+    std::string const end = closed ? "}}" : "";
+    manifest.append(size - manifest.size() - end.size(), ' ');
+    return manifest + end;
+}
+
+static std::vector<std::string> EnumerateLayerNames() {
+    uint32_t count = 0u;
+    EXPECT_EQ(vkEnumerateInstanceLayerProperties(&count, nullptr), VK_SUCCESS);
+    std::vector<VkLayerProperties> properties(count);
+    EXPECT_EQ(vkEnumerateInstanceLayerProperties(&count, properties.data()), VK_SUCCESS);
+    std::vector<std::string> names;
+    for (uint32_t p = 0; p < count; ++p) {
+        names.push_back(properties[p].layerName);
+    }
+    return names;
+}
+
+// Manifests around the page size, where the read buffer is sized exactly to the file, must still be
+// parsed correctly, and one that can't be parsed must not be read past its end.
+TEST(ManifestRead, PageMultipleSizes) {
+    size_t const page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char layer_dir[] = "/tmp/loader_manifest_read_XXXXXX";
+    ASSERT_NE(mkdtemp(layer_dir), nullptr);
+
+    struct Manifest {
+        std::string name;
+        size_t size;
+        bool closed;
+    };
+    std::vector<Manifest> const manifests = {
+        {"VK_LAYER_LUNARG_manifest_read_page_less_one", page - 1, true},
+        {"VK_LAYER_LUNARG_manifest_read_page", page, true},
+        {"VK_LAYER_LUNARG_manifest_read_two_pages", 2 * page, true},
+        {"VK_LAYER_LUNARG_manifest_read_page_unclosed", page, false},
+    };
+    std::vector<std::string> files;
+    for (auto const &manifest : manifests) {
+        files.push_back(std::string(layer_dir) + "/" + manifest.name + ".json");
+        std::string const text = PaddedLayerManifest(manifest.name, manifest.size, manifest.closed);
+        ASSERT_EQ(text.size(), manifest.size);
+        FILE *file = fopen(files.back().c_str(), "w");
+        ASSERT_NE(file, nullptr);
+        fwrite(text.data(), 1, text.size(), file);
+        fclose(file);
+    }
+
+    char const *old_layer_path = getenv("VK_LAYER_PATH");
+    std::string const saved_layer_path = old_layer_path ? old_layer_path : "";
+    ASSERT_EQ(setenv("VK_LAYER_PATH", layer_dir, 1), 0);
+    auto const names = EnumerateLayerNames();
+    if (old_layer_path) {
+        setenv("VK_LAYER_PATH", saved_layer_path.c_str(), 1);
+    } else {
+        unsetenv("VK_LAYER_PATH");
+    }
+
+    for (auto const &manifest : manifests) {
+        bool const found = std::find(names.begin(), names.end(), manifest.name) != names.end();
+        EXPECT_EQ(found, manifest.closed) << manifest.name;
+    }
+
+    for (auto const &file : files) {
+        std::remove(file.c_str());
+    }
+    rmdir(layer_dir);
+}
+
+// A manifest that isn't a regular file can't report its size, and is read until it ends.  The
+// writer keeps reopening the FIFO, since the loader may open it more than once.
+TEST(ManifestRead, Fifo) {
+    char layer_dir[] = "/tmp/loader_manifest_read_XXXXXX";
+    ASSERT_NE(mkdtemp(layer_dir), nullptr);
+    std::string const name = "VK_LAYER_LUNARG_manifest_read_fifo";
+    std::string const fifo = std::string(layer_dir) + "/" + name + ".json";
+    ASSERT_EQ(mkfifo(fifo.c_str(), 0600), 0);
+    std::string const text = PaddedLayerManifest(name, 512, true);
+
+    char const *old_layer_path = getenv("VK_LAYER_PATH");
+    std::string const saved_layer_path = old_layer_path ? old_layer_path : "";
+    ASSERT_EQ(setenv("VK_LAYER_PATH", layer_dir, 1), 0);
+
+    // A reader that closes the FIFO without reading it mustn't kill the test
+    auto const old_sigpipe = signal(SIGPIPE, SIG_IGN);
+    std::atomic<bool> stop(false);
+    std::thread writer([&]() {
+        while (!stop) {
+            int fd = open(fifo.c_str(), O_WRONLY | O_NONBLOCK);
+            if (fd < 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            fcntl(fd, F_SETFL, 0);
+            ssize_t written = write(fd, text.data(), text.size());
+            (void)written;
+            close(fd);
+        }
+    });
+
+    auto const names = EnumerateLayerNames();
+    if (old_layer_path) {
+        setenv("VK_LAYER_PATH", saved_layer_path.c_str(), 1);
+    } else {
+        unsetenv("VK_LAYER_PATH");
+    }
+
+    stop = true;
+    writer.join();
+    signal(SIGPIPE, old_sigpipe);
+    std::remove(fifo.c_str());
+    rmdir(layer_dir);
+
+    EXPECT_NE(std::find(names.begin(), names.end(), name), names.end());
+}
+
+#if defined(__GLIBC__)
+static size_t HeapInUse() {
+#if __GLIBC_PREREQ(2, 33)
+    return mallinfo2().uordblks;
+#else
+    return static_cast<size_t>(mallinfo().uordblks);
+#endif
+}
+
+// Every rescan of a changed manifest interns a new library path.  Strings no layer record uses any
+// more must be freed, so rescanning a manifest that keeps changing mustn't grow the heap much
+// beyond what one scan needs.
+TEST(StringTable, ChangingManifestBounded) {
+    char layer_dir[] = "/tmp/loader_string_table_XXXXXX";
+    ASSERT_NE(mkdtemp(layer_dir), nullptr);
+    std::string const manifest = std::string(layer_dir) + "/VkLayer_string_table_test.json";
+
+    char const *old_layer_path = getenv("VK_LAYER_PATH");
+    std::string const saved_layer_path = old_layer_path ? old_layer_path : "";
+    ASSERT_EQ(setenv("VK_LAYER_PATH", layer_dir, 1), 0);
+
+    // Each path is about 800 bytes, so 2000 of them would take well over the bound below.  The
+    // length alternates so the size of the manifest changes with each rewrite.
+    uint32_t const iterations = 2000;
+    size_t baseline = 0;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        std::string const library = "./" + std::to_string(i) + std::string(800 + i % 2, 'x') + ".so";
+        FILE *file = fopen(manifest.c_str(), "w");
+        ASSERT_NE(file, nullptr);
+        fprintf(file,
+                "{\"file_format_version\": \"1.1.0\", \"layer\": {\"name\": \"VK_LAYER_LUNARG_string_table_test\", "
+                "\"type\": \"GLOBAL\", \"library_path\": \"%s\", \"api_version\": \"1.0.0\", "
+                "\"implementation_version\": \"1\", \"description\": \"test\"}}",
+                library.c_str());
+        fclose(file);
+
+        auto const names = EnumerateLayerNames();
+        EXPECT_NE(std::find(names.begin(), names.end(), "VK_LAYER_LUNARG_string_table_test"), names.end());
+        if (i == 0) {
+            baseline = HeapInUse();
+        }
+    }
+    size_t const in_use = HeapInUse();
+    size_t const growth = in_use > baseline ? in_use - baseline : 0;
+
+    std::remove(manifest.c_str());
+    rmdir(layer_dir);
+    if (old_layer_path) {
+        setenv("VK_LAYER_PATH", saved_layer_path.c_str(), 1);
+    } else {
+        unsetenv("VK_LAYER_PATH");
+    }
+
+    EXPECT_LT(growth, static_cast<size_t>(1024 * 1024));
+}
+#endif
+#endif
+
+#if defined(__linux__)
+// The wrap_objects layer hands out 300 functions of each kind the loader doesn't know, more than the
+// 250 trampolines built into the loader.  Where the loader writes its trampolines at runtime, every
+// one of them must be returned and reach the layer; elsewhere at least the built in ones must.
+TEST(WrapObjects, UnknownFunctions) {
+    uint32_t const functionCount = 300;
+#if (defined(__x86_64__) && !defined(__ILP32__)) || defined(__aarch64__)
+    uint32_t const expectedCount = functionCount;
+#else
+    uint32_t const expectedCount = 250;
+#endif
+
+    // The layer has to list its device functions in its manifest, so write one for the library in VK_LAYER_PATH
+    char const *old_layer_path = getenv("VK_LAYER_PATH");
+    std::string const saved_layer_path = old_layer_path ? old_layer_path : "";
+    std::string library;
+    for (size_t start = 0; start <= saved_layer_path.size() && library.empty();) {
+        size_t end = saved_layer_path.find(':', start);
+        if (end == std::string::npos) {
+            end = saved_layer_path.size();
+        }
+        std::string const candidate = saved_layer_path.substr(start, end - start) + "/libVkLayer_wrap_objects.so";
+        if (end > start && access(candidate.c_str(), R_OK) == 0) {
+            library = candidate;
+        }
+        start = end + 1;
+    }
+    if (library.empty()) {
+        std::cout << "libVkLayer_wrap_objects.so not found in VK_LAYER_PATH, skipping" << std::endl;
+        return;
+    }
+
+    std::vector<std::string> deviceNames;
+    std::vector<std::string> physicalDeviceNames;
+    std::string entrypoints;
+    for (uint32_t i = 0; i < functionCount; ++i) {
+        deviceNames.push_back("vkLoaderTestUnknownDeviceFunction" + std::to_string(i));
+        physicalDeviceNames.push_back("vkLoaderTestUnknownPhysicalDeviceFunction" + std::to_string(i));
+        entrypoints += (i ? ", \"" : "\"") + deviceNames.back() + "\"";
+    }
+
+    char layer_dir[] = "/tmp/loader_unknown_functions_XXXXXX";
+    ASSERT_NE(mkdtemp(layer_dir), nullptr);
+    std::string const manifest = std::string(layer_dir) + "/VkLayer_wrap_objects.json";
+    FILE *file = fopen(manifest.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    fprintf(file,
+            "{\"file_format_version\": \"1.1.0\", \"layer\": {\"name\": \"VK_LAYER_LUNARG_wrap_objects\", "
+            "\"type\": \"GLOBAL\", \"library_path\": \"%s\", \"api_version\": \"1.0.0\", \"implementation_version\": \"1\", "
+            "\"description\": \"test\", \"device_extensions\": [{\"name\": \"VK_LOADER_TEST_unknown_functions\", "
+            "\"spec_version\": \"1\", \"entrypoints\": [%s]}]}}",
+            library.c_str(), entrypoints.c_str());
+    fclose(file);
+    ASSERT_EQ(setenv("VK_LAYER_PATH", layer_dir, 1), 0);
+
+    char const *const layers[] = {"VK_LAYER_LUNARG_wrap_objects"};  // Temporary required due to MSVC bug.
+    VkInstance instance = VK_NULL_HANDLE;
+    VkResult result =
+        vkCreateInstance(VK::InstanceCreateInfo().enabledLayerCount(1).ppEnabledLayerNames(layers), VK_NULL_HANDLE, &instance);
+
+    if (old_layer_path) {
+        setenv("VK_LAYER_PATH", saved_layer_path.c_str(), 1);
+    } else {
+        unsetenv("VK_LAYER_PATH");
+    }
+    std::remove(manifest.c_str());
+    rmdir(layer_dir);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    typedef VkResult(VKAPI_PTR * PFN_UnknownPhysicalDeviceFunction)(VkPhysicalDevice physicalDevice, uint32_t * pIndex);
+    typedef VkResult(VKAPI_PTR * PFN_UnknownDeviceFunction)(VkDevice device, uint32_t * pIndex);
+    std::vector<PFN_UnknownPhysicalDeviceFunction> physicalDeviceFunctions;
+    std::vector<PFN_UnknownDeviceFunction> deviceFunctions;
+    for (uint32_t i = 0; i < functionCount; ++i) {
+        physicalDeviceFunctions.push_back(
+            reinterpret_cast<PFN_UnknownPhysicalDeviceFunction>(vkGetInstanceProcAddr(instance, physicalDeviceNames[i].c_str())));
+        deviceFunctions.push_back(
+            reinterpret_cast<PFN_UnknownDeviceFunction>(vkGetInstanceProcAddr(instance, deviceNames[i].c_str())));
+        if (i < expectedCount) {
+            ASSERT_NE(physicalDeviceFunctions[i], nullptr) << physicalDeviceNames[i];
+            ASSERT_NE(deviceFunctions[i], nullptr) << deviceNames[i];
+        }
+    }
+
+    uint32_t physicalCount = 1;
+    VkPhysicalDevice physical = VK_NULL_HANDLE;
+    result = vkEnumeratePhysicalDevices(instance, &physicalCount, &physical);
+    ASSERT_TRUE(result == VK_SUCCESS || result == VK_INCOMPLETE);
+    ASSERT_EQ(physicalCount, 1u);
+
+    float const priorities[] = {0.0f};  // Temporary required due to MSVC bug.
+    VkDeviceQueueCreateInfo const queueInfo[1]{
+        VK::DeviceQueueCreateInfo().queueFamilyIndex(0).queueCount(1).pQueuePriorities(priorities)};
+    auto const deviceInfo = VK::DeviceCreateInfo().queueCreateInfoCount(1).pQueueCreateInfos(queueInfo);
+    VkDevice device = VK_NULL_HANDLE;
+    result = vkCreateDevice(physical, deviceInfo, nullptr, &device);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    for (uint32_t i = 0; i < functionCount; ++i) {
+        uint32_t index = UINT32_MAX;
+        if (physicalDeviceFunctions[i] != nullptr) {
+            EXPECT_EQ(physicalDeviceFunctions[i](physical, &index), VK_SUCCESS);
+            EXPECT_EQ(index, i) << physicalDeviceNames[i];
+        }
+        index = UINT32_MAX;
+        if (deviceFunctions[i] != nullptr) {
+            EXPECT_EQ(deviceFunctions[i](device, &index), VK_SUCCESS);
+            EXPECT_EQ(index, i) << deviceNames[i];
+        }
+    }
+
+    vkDestroyDevice(device, nullptr);
+    vkDestroyInstance(instance, nullptr);
+}
+#endif
+
+#if defined(TEST_ICD_PATH)
+// Points the loader at the two test ICDs built from tests/icd for as long as it exists
+class TestIcds {
+   public:
+    TestIcds() {
+        char const *old_icd_filenames = getenv("VK_ICD_FILENAMES");
+        had_icd_filenames = old_icd_filenames != nullptr;
+        saved_icd_filenames = had_icd_filenames ? old_icd_filenames : "";
+        setenv("VK_ICD_FILENAMES", TEST_ICD_PATH "/VkICD_test_icd.json:" TEST_ICD_PATH "/VkICD_test_icd_minimal.json", 1);
+    }
+    ~TestIcds() {
+        if (had_icd_filenames) {
+            setenv("VK_ICD_FILENAMES", saved_icd_filenames.c_str(), 1);
+        } else {
+            unsetenv("VK_ICD_FILENAMES");
+        }
+    }
+
+    // Sets physical[0] to the physical device of VkICD_test_icd, and physical[1] to that of VkICD_test_icd_minimal
+    static void PhysicalDevices(VkInstance instance, VkPhysicalDevice (&physical)[2]) {
+        physical[0] = physical[1] = VK_NULL_HANDLE;
+        uint32_t count = 0;
+        ASSERT_EQ(vkEnumeratePhysicalDevices(instance, &count, nullptr), VK_SUCCESS);
+        std::vector<VkPhysicalDevice> all(count);
+        ASSERT_EQ(vkEnumeratePhysicalDevices(instance, &count, all.data()), VK_SUCCESS);
+        for (auto device : all) {
+            VkPhysicalDeviceProperties properties;
+            vkGetPhysicalDeviceProperties(device, &properties);
+            if (!strcmp(properties.deviceName, "Loader test ICD")) {
+                physical[0] = device;
+            } else if (!strcmp(properties.deviceName, "Loader test ICD (minimal)")) {
+                physical[1] = device;
+            }
+        }
+        ASSERT_NE(physical[0], (VkPhysicalDevice)VK_NULL_HANDLE);
+        ASSERT_NE(physical[1], (VkPhysicalDevice)VK_NULL_HANDLE);
+    }
+
+   private:
+    bool had_icd_filenames;
+    std::string saved_icd_filenames;
+};
+
+// Only one of the ICDs has vkLoaderTestIcdUnknownFunction.  The trampoline the loader returns for
+// it must reach that ICD for its devices, and return an error for the other ICD's devices, both
+// for devices that existed when the function was looked up and for those created after.
+TEST(TestIcd, UnknownDeviceFunctionInOneIcd) {
+    TestIcds icds;
+    VkInstance instance = VK_NULL_HANDLE;
+    ASSERT_EQ(vkCreateInstance(VK::InstanceCreateInfo(), VK_NULL_HANDLE, &instance), VK_SUCCESS);
+    VkPhysicalDevice physical[2];
+    TestIcds::PhysicalDevices(instance, physical);
+    if (HasFatalFailure()) {
+        vkDestroyInstance(instance, nullptr);
+        return;
+    }
+
+    float const priorities[] = {0.0f};  // Temporary required due to MSVC bug.
+    VkDeviceQueueCreateInfo const queueInfo[1]{
+        VK::DeviceQueueCreateInfo().queueFamilyIndex(0).queueCount(1).pQueuePriorities(priorities)};
+    auto const deviceInfo = VK::DeviceCreateInfo().queueCreateInfoCount(1).pQueueCreateInfos(queueInfo);
+
+    VkDevice devices[4] = {VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE};
+    ASSERT_EQ(vkCreateDevice(physical[0], deviceInfo, nullptr, &devices[0]), VK_SUCCESS);
+    ASSERT_EQ(vkCreateDevice(physical[1], deviceInfo, nullptr, &devices[1]), VK_SUCCESS);
+
+    typedef VkResult(VKAPI_PTR * PFN_vkLoaderTestIcdUnknownFunction)(VkDevice device);
+    auto const function = reinterpret_cast<PFN_vkLoaderTestIcdUnknownFunction>(
+        vkGetInstanceProcAddr(instance, "vkLoaderTestIcdUnknownFunction"));
+    ASSERT_NE(function, nullptr);
+
+    ASSERT_EQ(vkCreateDevice(physical[0], deviceInfo, nullptr, &devices[2]), VK_SUCCESS);
+    ASSERT_EQ(vkCreateDevice(physical[1], deviceInfo, nullptr, &devices[3]), VK_SUCCESS);
+
+    EXPECT_EQ(function(devices[0]), VK_SUCCESS);
+    EXPECT_EQ(function(devices[1]), VK_ERROR_EXTENSION_NOT_PRESENT);
+    EXPECT_EQ(function(devices[2]), VK_SUCCESS);
+    EXPECT_EQ(function(devices[3]), VK_ERROR_EXTENSION_NOT_PRESENT);
+
+    for (auto device : devices) {
+        vkDestroyDevice(device, nullptr);
+    }
+    vkDestroyInstance(instance, nullptr);
+}
+
+// Headless surfaces are only created in an ICD the first time they are used with it.  VkICD_test_icd_minimal
+// fails the first one, which must fail the query that needed it, and the next query must try again.
+TEST(TestIcd, LazySurfaceCreationFailsInOneIcd) {
+    TestIcds icds;
+    char const *const extensions[] = {VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME};
+    VkInstance instance = VK_NULL_HANDLE;
+    ASSERT_EQ(vkCreateInstance(VK::InstanceCreateInfo().enabledExtensionCount(2).ppEnabledExtensionNames(extensions),
+                               VK_NULL_HANDLE, &instance),
+              VK_SUCCESS);
+    VkPhysicalDevice physical[2];
+    TestIcds::PhysicalDevices(instance, physical);
+    if (HasFatalFailure()) {
+        vkDestroyInstance(instance, nullptr);
+        return;
+    }
+
+    auto const createHeadlessSurface =
+        reinterpret_cast<PFN_vkCreateHeadlessSurfaceEXT>(vkGetInstanceProcAddr(instance, "vkCreateHeadlessSurfaceEXT"));
+    ASSERT_NE(createHeadlessSurface, nullptr);
+    VkHeadlessSurfaceCreateInfoEXT surfaceInfo = {VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT};
+    VkSurfaceKHR surface = VK_NULL_HANDLE;
+    ASSERT_EQ(createHeadlessSurface(instance, &surfaceInfo, nullptr, &surface), VK_SUCCESS);
+
+    VkBool32 supported = VK_FALSE;
+    EXPECT_EQ(vkGetPhysicalDeviceSurfaceSupportKHR(physical[0], 0, surface, &supported), VK_SUCCESS);
+    EXPECT_EQ(supported, VK_TRUE);
+
+    supported = VK_FALSE;
+    uint32_t count = 0;
+    EXPECT_EQ(vkGetPhysicalDeviceSurfaceSupportKHR(physical[1], 0, surface, &supported), VK_ERROR_OUT_OF_DEVICE_MEMORY);
+    EXPECT_EQ(vkGetPhysicalDeviceSurfaceFormatsKHR(physical[1], surface, &count, nullptr), VK_SUCCESS);
+    EXPECT_EQ(count, 1u);
+    EXPECT_EQ(vkGetPhysicalDeviceSurfaceSupportKHR(physical[1], 0, surface, &supported), VK_SUCCESS);
+    EXPECT_EQ(supported, VK_TRUE);
+
+    count = 0;
+    EXPECT_EQ(vkGetPhysicalDeviceSurfaceFormatsKHR(physical[0], surface, &count, nullptr), VK_SUCCESS);
+    EXPECT_EQ(count, 1u);
+
+    vkDestroySurfaceKHR(instance, surface, nullptr);
+    vkDestroyInstance(instance, nullptr);
+}
+
+// VkICD_test_icd returns the number of times it has been asked for a surface's formats or present
+// modes as the format or present mode.  With VK_LOADER_SURFACE_QUERY_CACHE set, repeated queries
+// must be answered by the loader and see the same value.  By default every query reaches the ICD.
+TEST(TestIcd, SurfaceQueryCache) {
+    TestIcds icds;
+    auto query_twice = [](std::vector<uint32_t> &formats, std::vector<uint32_t> &present_modes) {
+        char const *const extensions[] = {VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME};
+        VkInstance instance = VK_NULL_HANDLE;
+        ASSERT_EQ(vkCreateInstance(VK::InstanceCreateInfo().enabledExtensionCount(2).ppEnabledExtensionNames(extensions),
+                                   VK_NULL_HANDLE, &instance),
+                  VK_SUCCESS);
+        VkPhysicalDevice physical[2];
+        TestIcds::PhysicalDevices(instance, physical);
+        auto const createHeadlessSurface =
+            reinterpret_cast<PFN_vkCreateHeadlessSurfaceEXT>(vkGetInstanceProcAddr(instance, "vkCreateHeadlessSurfaceEXT"));
+        VkHeadlessSurfaceCreateInfoEXT surfaceInfo = {VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT};
+        VkSurfaceKHR surface = VK_NULL_HANDLE;
+        if (!::testing::Test::HasFatalFailure() && createHeadlessSurface != nullptr &&
+            createHeadlessSurface(instance, &surfaceInfo, nullptr, &surface) == VK_SUCCESS) {
+            for (int i = 0; i < 2; ++i) {
+                uint32_t count = 0;
+                EXPECT_EQ(vkGetPhysicalDeviceSurfaceFormatsKHR(physical[0], surface, &count, nullptr), VK_SUCCESS);
+                std::vector<VkSurfaceFormatKHR> surfaceFormats(count);
+                EXPECT_EQ(vkGetPhysicalDeviceSurfaceFormatsKHR(physical[0], surface, &count, surfaceFormats.data()), VK_SUCCESS);
+                for (auto const &surfaceFormat : surfaceFormats) {
+                    formats.push_back(surfaceFormat.format);
+                }
+
+                count = 0;
+                EXPECT_EQ(vkGetPhysicalDeviceSurfacePresentModesKHR(physical[0], surface, &count, nullptr), VK_SUCCESS);
+                std::vector<VkPresentModeKHR> presentModes(count);
+                EXPECT_EQ(vkGetPhysicalDeviceSurfacePresentModesKHR(physical[0], surface, &count, presentModes.data()),
+                          VK_SUCCESS);
+                for (auto presentMode : presentModes) {
+                    present_modes.push_back(presentMode);
+                }
+            }
+            vkDestroySurfaceKHR(instance, surface, nullptr);
+        } else {
+            ADD_FAILURE() << "Couldn't create a headless surface";
+        }
+        vkDestroyInstance(instance, nullptr);
+    };
+
+    std::vector<uint32_t> formats, present_modes;
+    query_twice(formats, present_modes);
+    EXPECT_EQ(formats, (std::vector<uint32_t>{1, 2}));
+    EXPECT_EQ(present_modes, (std::vector<uint32_t>{1, 2}));
+
+    formats.clear();
+    present_modes.clear();
+    ASSERT_EQ(setenv("VK_LOADER_SURFACE_QUERY_CACHE", "1", 1), 0);
+    query_twice(formats, present_modes);
+    unsetenv("VK_LOADER_SURFACE_QUERY_CACHE");
+    EXPECT_EQ(formats, (std::vector<uint32_t>{1, 1}));
+    EXPECT_EQ(present_modes, (std::vector<uint32_t>{1, 1}));
+}
+#endif
+
 TEST(WrapObjects, Insert) {
     VkInstance instance = VK_NULL_HANDLE;
     VkResult result = vkCreateInstance(VK::InstanceCreateInfo(), VK_NULL_HANDLE, &instance);
@@ -1131,6 +2247,83 @@ TEST(Allocation, EnumeratePhysicalDevices) {
     FreeAllocTracker();
 }
 
+// Enumerating the same physical devices again should hand back the same handles without
+// allocating anything.
+TEST(Allocation, EnumeratePhysicalDevicesRepeated) {
+    auto const info = VK::InstanceCreateInfo();
+    VkInstance instance = VK_NULL_HANDLE;
+    VkAllocationCallbacks alloc_callbacks = {};
+    alloc_callbacks.pfnAllocation = AllocCallbackFunc;
+    alloc_callbacks.pfnReallocation = ReallocCallbackFunc;
+    alloc_callbacks.pfnFree = FreeCallbackFunc;
+
+    InitAllocTracker(2048);
+
+    VkResult result = vkCreateInstance(info, &alloc_callbacks, &instance);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    uint32_t physicalCount = 0;
+    result = vkEnumeratePhysicalDevices(instance, &physicalCount, nullptr);
+    ASSERT_EQ(result, VK_SUCCESS);
+    ASSERT_GT(physicalCount, 0u);
+    std::vector<VkPhysicalDevice> physical(physicalCount);
+    result = vkEnumeratePhysicalDevices(instance, &physicalCount, physical.data());
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    uint32_t allocationCount = g_allocation_count;
+    for (uint32_t i = 0; i < 4; ++i) {
+        uint32_t count = 0;
+        result = vkEnumeratePhysicalDevices(instance, &count, nullptr);
+        ASSERT_EQ(result, VK_SUCCESS);
+        ASSERT_EQ(count, physicalCount);
+        std::vector<VkPhysicalDevice> again(count);
+        result = vkEnumeratePhysicalDevices(instance, &count, again.data());
+        ASSERT_EQ(result, VK_SUCCESS);
+        ASSERT_EQ(again, physical);
+    }
+    ASSERT_EQ(g_allocation_count, allocationCount);
+
+    vkDestroyInstance(instance, &alloc_callbacks);
+
+    // Make sure everything's been freed
+    ASSERT_EQ(true, IsAllocTrackerEmpty());
+    FreeAllocTracker();
+}
+
+// Physical device objects come from the instance's arena, so the first enumeration only allocates
+// the handle arrays and at most one more block of the arena.
+TEST(Allocation, InstanceArena) {
+    auto const info = VK::InstanceCreateInfo();
+    VkInstance instance = VK_NULL_HANDLE;
+    VkAllocationCallbacks alloc_callbacks = {};
+    alloc_callbacks.pfnAllocation = AllocCallbackFunc;
+    alloc_callbacks.pfnReallocation = ReallocCallbackFunc;
+    alloc_callbacks.pfnFree = FreeCallbackFunc;
+
+    InitAllocTracker(2048);
+
+    VkResult result = vkCreateInstance(info, &alloc_callbacks, &instance);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    uint32_t allocationCount = g_allocation_count;
+    uint32_t physicalCount = 0;
+    result = vkEnumeratePhysicalDevices(instance, &physicalCount, nullptr);
+    ASSERT_EQ(result, VK_SUCCESS);
+    ASSERT_GT(physicalCount, 0u);
+    std::vector<VkPhysicalDevice> physical(physicalCount);
+    result = vkEnumeratePhysicalDevices(instance, &physicalCount, physical.data());
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    uint32_t enumerateAllocations = g_allocation_count - allocationCount;
+    ASSERT_LT(enumerateAllocations, 2 + 2 * physicalCount);
+
+    vkDestroyInstance(instance, &alloc_callbacks);
+
+    // Make sure everything's been freed
+    ASSERT_EQ(true, IsAllocTrackerEmpty());
+    FreeAllocTracker();
+}
+
 // Test making sure the allocation functions are called to allocate and cleanup everything from
 // vkCreateInstance, to vkCreateDevicce, and then through their destructors.  With special
 // allocators used on both the instance and device.
@@ -1259,6 +2452,53 @@ TEST(Allocation, InstanceButNotDevice) {
     FreeAllocTracker();
 }
 
+// Devices created without an allocator reuse the records of destroyed ones, so creating the same
+// device again shouldn't allocate more from the instance than the first time did.
+TEST(Allocation, DeviceRecordsRecycled) {
+    auto const info = VK::InstanceCreateInfo();
+    VkInstance instance = VK_NULL_HANDLE;
+    VkAllocationCallbacks alloc_callbacks = {};
+    alloc_callbacks.pfnAllocation = AllocCallbackFunc;
+    alloc_callbacks.pfnReallocation = ReallocCallbackFunc;
+    alloc_callbacks.pfnFree = FreeCallbackFunc;
+
+    InitAllocTracker(2048);
+
+    VkResult result = vkCreateInstance(info, &alloc_callbacks, &instance);
+    ASSERT_EQ(result, VK_SUCCESS);
+
+    uint32_t physicalCount = 1;
+    VkPhysicalDevice physical = VK_NULL_HANDLE;
+    result = vkEnumeratePhysicalDevices(instance, &physicalCount, &physical);
+    ASSERT_TRUE(result == VK_SUCCESS || result == VK_INCOMPLETE);
+    ASSERT_EQ(physicalCount, 1u);
+
+    float const priorities[] = {0.0f};  // Temporary required due to MSVC bug.
+    VkDeviceQueueCreateInfo const queueInfo[1]{
+        VK::DeviceQueueCreateInfo().queueFamilyIndex(0).queueCount(1).pQueuePriorities(priorities)};
+    auto const deviceInfo = VK::DeviceCreateInfo().queueCreateInfoCount(1).pQueueCreateInfos(queueInfo);
+
+    uint32_t allocations[4];
+    for (uint32_t i = 0; i < 4; ++i) {
+        uint32_t allocationCount = g_allocation_count;
+        VkDevice device = VK_NULL_HANDLE;
+        result = vkCreateDevice(physical, deviceInfo, NULL, &device);
+        ASSERT_EQ(result, VK_SUCCESS);
+        vkDestroyDevice(device, NULL);
+        allocations[i] = g_allocation_count - allocationCount;
+    }
+    for (uint32_t i = 1; i < 4; ++i) {
+        ASSERT_LE(allocations[i], allocations[0]);
+        ASSERT_EQ(allocations[i], allocations[1]);
+    }
+
+    vkDestroyInstance(instance, &alloc_callbacks);
+
+    // Make sure everything's been freed
+    ASSERT_EQ(true, IsAllocTrackerEmpty());
+    FreeAllocTracker();
+}
+
 // Test making sure the allocation functions are called to allocate and cleanup everything from
 // vkCreateInstance, to vkCreateDevicce, and then through their destructors.  With special
 // allocators used on only the device and not the instance.
@@ -132,6 +132,51 @@ RunEnumerateInstanceExtensionPropertiesTest()
     echo "EnumerateInstanceExtensionProperties OnePass vs TwoPass test PASSED"
 }
 
+RunLogSinkTest()
+{
+    # Check that lines logged from several threads through the asynchronous sink come out whole and
+    # in order, once the ring buffer of 4096 slots has wrapped around.  Only the loader writes to
+    # stderr here.
+    output=$(VK_LOADER_DEBUG=all VK_LOADER_DEBUG_SINK=async \
+       GTEST_FILTER=LogSink.ConcurrentWriters \
+       ./vk_loader_validation_tests 2>&1 >/dev/null)
+
+    line='^\[ *[0-9]*\.[0-9]\{6\} *[0-9a-f]*\] \(INFO\|WARNING\|PERF\|ERROR\|DEBUG\)'
+    dropped='^\[loader log sink dropped [0-9]* lines\]$'
+
+    # Messages ending in a newline of their own leave empty lines
+    bad=$(echo "$output" | grep -v -e '^$' -e "$line" -e "$dropped" | head -n 1)
+    if [ -n "$bad" ]
+    then
+       echo "Log sink test FAILED - torn or unstamped line: $bad" >&2
+       exit 1
+    fi
+
+    count=$(echo "$output" | grep -c "$line")
+    if [ "$count" -le 4096 ]
+    then
+       echo "Log sink test FAILED - only $count lines written, the buffer never wrapped around" >&2
+       exit 1
+    fi
+
+    # Each thread's lines must come out in the order it logged them
+    threads=$(echo "$output" | grep "$line" | awk '
+        { gsub(/[][]/, ""); if (!($2 in last)) n++; else if ($1 + 0 < last[$2]) { print "unordered"; bad = 1; exit }
+          last[$2] = $1 + 0 }
+        END { if (!bad) print n + 0 }')
+    if [ "$threads" = "unordered" ]
+    then
+       echo "Log sink test FAILED - a thread's lines were written out of order" >&2
+       exit 1
+    fi
+    if [ "$threads" -lt 8 ]
+    then
+       echo "Log sink test FAILED - lines from only $threads threads" >&2
+       exit 1
+    fi
+    echo "Log sink test PASSED"
+}
+
 VK_LAYER_PATH="$PWD/layers"
 ./vk_loader_validation_tests
 
@@ -139,6 +184,7 @@ RunEnvironmentVariablePathsTest
 RunCreateInstanceTest
 RunEnumerateInstanceLayerPropertiesTest
 RunEnumerateInstanceExtensionPropertiesTest
+RunLogSinkTest
 
 # Test the wrap objects layer.
 ./run_wrap_objects_tests.sh || exit 1